@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "Fury/Log.h"
+#include "Fury/ThreadUtil.h"
+
+#include "Benchmark.h"
+
+namespace fury
+{
+	std::vector<Benchmark::Entry> &Benchmark::GetEntries()
+	{
+		// function local, so registering from other files' static init is safe.
+		static std::vector<Entry> entries;
+		return entries;
+	}
+
+	bool Benchmark::Register(const std::string &name, const Func &func)
+	{
+		Entry entry;
+		entry.name = name;
+		entry.func = func;
+		GetEntries().push_back(entry);
+		return true;
+	}
+
+	double Benchmark::GetTime()
+	{
+		return std::chrono::duration<double>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+	}
+
+	double Benchmark::Measure(unsigned int repeatCount, const std::function<void()> &func)
+	{
+		double bestTime = 0;
+		for (unsigned int i = 0; i < repeatCount; i++)
+		{
+			double startTime = GetTime();
+			func();
+			double time = (GetTime() - startTime) * 1000;
+
+			if (i == 0 || time < bestTime)
+				bestTime = time;
+		}
+		return bestTime;
+	}
+
+	void Benchmark::SetWorkerCount(unsigned int workerCount)
+	{
+		ThreadUtil::Instance().reset();
+		ThreadUtil::Initialize(workerCount);
+		ThreadUtil::Instance()->SetMainThread();
+	}
+
+	unsigned int Benchmark::GetMaxWorkerCount()
+	{
+		unsigned int threadCount = std::thread::hardware_concurrency();
+		return threadCount > 1 ? threadCount - 1 : 0;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	using namespace fury;
+
+	Log<0>::Initialize(LogLevel::INFO, nullptr, true, Formatter::Simple, false);
+
+	ThreadUtil::Initialize(Benchmark::GetMaxWorkerCount());
+	ThreadUtil::Instance()->SetMainThread();
+
+	int runCount = 0;
+	for (const auto &entry : Benchmark::GetEntries())
+	{
+		bool selected = argc < 2;
+		for (int i = 1; i < argc && !selected; i++)
+			selected = entry.name == argv[i];
+
+		if (!selected)
+			continue;
+
+		FURYI << "[" << entry.name << "]";
+		entry.func();
+		runCount++;
+	}
+
+	if (runCount == 0)
+	{
+		FURYE << "No benchmark matches, available ones are:";
+		for (const auto &entry : Benchmark::GetEntries())
+			FURYE << entry.name;
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
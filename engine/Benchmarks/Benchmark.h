@@ -0,0 +1,49 @@
+#ifndef _FURY_BENCHMARK_H_
+#define _FURY_BENCHMARK_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fury
+{
+	// Benchmarks register themselves with FURY_BENCHMARK(name),
+	// furybench runs all of them, or only the ones named in command line.
+	// Results are logged with FURYI.
+	class Benchmark
+	{
+	public:
+
+		typedef std::function<void()> Func;
+
+		struct Entry
+		{
+			std::string name;
+
+			Func func;
+		};
+
+		static std::vector<Entry> &GetEntries();
+
+		static bool Register(const std::string &name, const Func &func);
+
+		// in seconds.
+		static double GetTime();
+
+		// runs func repeatCount times, returns the fastest run in ms.
+		static double Measure(unsigned int repeatCount, const std::function<void()> &func);
+
+		// restarts ThreadUtil with workerCount workers.
+		static void SetWorkerCount(unsigned int workerCount);
+
+		// hardware threads - 1, the main thread works too.
+		static unsigned int GetMaxWorkerCount();
+	};
+}
+
+#define FURY_BENCHMARK(name) \
+	static void name##Benchmark(); \
+	static bool name##Registered = fury::Benchmark::Register(#name, name##Benchmark); \
+	static void name##Benchmark()
+
+#endif // _FURY_BENCHMARK_H_
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include <random>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/BoxBoundsArray.h"
+#include "Fury/Collidable.h"
+#include "Fury/Frustum.h"
+#include "Fury/Log.h"
+#include "Fury/MathUtil.h"
+#include "Fury/Matrix4.h"
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+// Frustum vs aabb culling, one virtual IsInsideFast call per aabb against
+// the batch kernel over a BoxBoundsArray.
+FURY_BENCHMARK(Culling)
+{
+	const unsigned int frustumCount = 32;
+
+	std::mt19937 random(2);
+	auto Random = [&](float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(random);
+	};
+
+	std::vector<Frustum> frustums(frustumCount);
+	for (auto &frustum : frustums)
+	{
+		frustum.Setup(0.8f, 16.0f / 9.0f, 1.0f, 600.0f);
+
+		Matrix4 matrix;
+		matrix.AppendRotation(MathUtil::EulerRadToQuat(Random(-3.1416f, 3.1416f), Random(-0.5f, 0.5f), 0.0f));
+		frustum.Transform(matrix);
+	}
+
+	for (unsigned int boxCount : { 1000u, 10000u, 100000u })
+	{
+		std::vector<BoxBounds> boxes;
+		BoxBoundsArray boxArray;
+		for (unsigned int i = 0; i < boxCount; i++)
+		{
+			Vector4 center(Random(-500, 500), Random(-500, 500), Random(-500, 500));
+			Vector4 extent(Random(0.1f, 10.0f), Random(0.1f, 10.0f), Random(0.1f, 10.0f), 0.0f);
+			boxes.push_back(BoxBounds(center - extent, center + extent));
+			boxArray.Add(boxes.back());
+		}
+
+		std::vector<unsigned char> visible(boxCount);
+		unsigned int nodeVisibleCount = 0, batchVisibleCount = 0;
+
+		double nodeTime = Benchmark::Measure(5, [&]()
+		{
+			nodeVisibleCount = 0;
+			for (const auto &frustum : frustums)
+			{
+				const Collidable &collider = frustum;
+				for (const auto &box : boxes)
+				{
+					if (collider.IsInsideFast(box))
+						nodeVisibleCount++;
+				}
+			}
+		});
+
+		double batchTime = Benchmark::Measure(5, [&]()
+		{
+			batchVisibleCount = 0;
+			for (const auto &frustum : frustums)
+				batchVisibleCount += frustum.IsInsideFast(boxArray, 0, boxCount, &visible[0]);
+		});
+
+		FURYI << boxCount << " aabbs x " << frustumCount << " frustums: per-node " << nodeTime << "ms, batch "
+			<< batchTime << "ms, speedup " << nodeTime / batchTime << "x";
+
+		if (nodeVisibleCount != batchVisibleCount)
+			FURYW << "per-node found " << nodeVisibleCount << " visible, batch found " << batchVisibleCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+#include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
+#include "Fury/IndirectBatcher.h"
+#include "Fury/InstanceBatcher.h"
+#include "Fury/Log.h"
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshArena.h"
+#include "Fury/MeshRender.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+namespace
+{
+	// furybench has no gl context, meshes get arena ranges through names only.
+	GLuint nextName = 1;
+
+	void APIENTRY FakeGenNames(GLsizei n, GLuint *names)
+	{
+		for (GLsizei i = 0; i < n; i++)
+			names[i] = nextName++;
+	}
+
+	void APIENTRY FakeDeleteNames(GLsizei, const GLuint *) {}
+
+	void APIENTRY FakeBindBuffer(GLenum, GLuint) {}
+
+	void APIENTRY FakeBufferData(GLenum, GLsizeiptr, const void *, GLenum) {}
+
+	void APIENTRY FakeBufferSubData(GLenum, GLintptr, GLsizeiptr, const void *) {}
+
+	void APIENTRY FakeCopyBufferSubData(GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr) {}
+
+	void APIENTRY FakeVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) {}
+
+	void APIENTRY FakeEnableVertexAttribArray(GLuint) {}
+
+	void FakeBindVertexArray(unsigned int) {}
+}
+
+// Indirect batch build of 30k sorted render units against InstanceBatcher's build of the same units, 
+// then 20k shadow casters in 4 lists. Every 10th mesh stays out of MeshArena.
+FURY_BENCHMARK(IndirectBatcher)
+{
+	glGenBuffers = FakeGenNames;
+	glDeleteBuffers = FakeDeleteNames;
+	glBindBuffer = FakeBindBuffer;
+	glBufferData = FakeBufferData;
+	glBufferSubData = FakeBufferSubData;
+	glCopyBufferSubData = FakeCopyBufferSubData;
+	glGenVertexArrays = FakeGenNames;
+	glDeleteVertexArrays = FakeDeleteNames;
+	glVertexAttribPointer = FakeVertexAttribPointer;
+	glEnableVertexAttribArray = FakeEnableVertexAttribArray;
+
+	auto functions = GLStateCache::GetGLFunctions();
+	functions.BindVertexArray = FakeBindVertexArray;
+	GLStateCache::Initialize();
+	GLStateCache::Instance()->SetFunctions(functions);
+	MeshArena::Initialize();
+
+	std::mt19937 random(5);
+	auto Random = [&](float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(random);
+	};
+
+	std::vector<Material::Ptr> materials;
+	for (unsigned int i = 0; i < 8; i++)
+		materials.push_back(Material::Create("benchmark_material"));
+
+	std::vector<Mesh::Ptr> meshes;
+	for (unsigned int i = 0; i < 300; i++)
+	{
+		auto mesh = Mesh::Create("benchmark_mesh");
+		for (unsigned int j = 0; j < 24 * 3; j++)
+			mesh->Positions.Data.push_back(Random(-1, 1));
+		for (unsigned int j = 0; j < 36; j++)
+			mesh->Indices.Data.push_back(random() % 24);
+
+		mesh->SetUseArena(i % 10 != 0);
+		if (mesh->GetUseArena())
+			mesh->UpdateBuffer();
+
+		meshes.push_back(mesh);
+	}
+
+	auto CreateNode = [&]()
+	{
+		auto sceneNode = SceneNode::Create("benchmark_node");
+		sceneNode->SetLocalPosition(Vector4(Random(-500, 500), Random(-500, 500), Random(-500, 500)));
+		sceneNode->UpdateTransforms();
+		return sceneNode;
+	};
+
+	RenderQuery query;
+	for (unsigned int i = 0; i < 30000; i++)
+	{
+		auto sceneNode = CreateNode();
+		sceneNode->AddComponent(MeshRender::Create(materials[random() % materials.size()], meshes[random() % meshes.size()]));
+		query.AddRenderable(sceneNode);
+	}
+	query.Sort(Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+
+	ShadowCasters casters(4);
+	for (unsigned int group = 0; group < casters.size(); group++)
+	{
+		for (unsigned int i = 0; i < 2000 * (group + 1); i++)
+		{
+			auto sceneNode = CreateNode();
+			sceneNode->AddComponent(MeshRender::Create(materials[0], meshes[random() % meshes.size()]));
+			casters[group].push_back(sceneNode);
+		}
+	}
+
+	auto indirectBatcher = IndirectBatcher::Create();
+	auto instanceBatcher = InstanceBatcher::Create();
+
+	std::ostringstream line;
+	line << query.opaqueUnits.size() << " units: indirect " << Benchmark::Measure(20, [&]() { indirectBatcher->Build(query.opaqueUnits); }) << "ms";
+	line << " (" << indirectBatcher->GetBatchCount() << " batches, " << indirectBatcher->GetCommandCount() << " commands)";
+	line << ", instanced " << Benchmark::Measure(20, [&]() { instanceBatcher->Build(query.opaqueUnits); }) << "ms";
+	line << " (" << instanceBatcher->GetBatchCount() << " batches)";
+	line << ", 20000 casters " << Benchmark::Measure(20, [&]() { indirectBatcher->Build(casters); }) << "ms";
+	line << " (" << indirectBatcher->GetBatchCount() << " batches)";
+
+	FURYI << line.str();
+
+	meshes.clear();
+	MeshArena::Instance().reset();
+	GLStateCache::Instance().reset();
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <random>
+#include <sstream>
+
+#include "Fury/Log.h"
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+// Render unit build of visible nodes, AddRenderable per node against chunked AddRenderables, 
+// then sorting. Chunked builds are measured with 0 (main thread only), 1, 2, 4 ... workers.
+FURY_BENCHMARK(RenderQueue)
+{
+	std::mt19937 random(9);
+	auto Random = [&](float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(random);
+	};
+
+	// every 4th material is transparent.
+	std::vector<Material::Ptr> materials;
+	for (unsigned int i = 0; i < 16; i++)
+	{
+		materials.push_back(Material::Create("benchmark_material"));
+		materials.back()->SetOpaque(i % 4 != 0);
+	}
+
+	std::vector<Mesh::Ptr> meshes;
+	for (unsigned int i = 0; i < 300; i++)
+		meshes.push_back(Mesh::Create("benchmark_mesh"));
+
+	for (unsigned int nodeCount : { 10000u, 50000u, 200000u })
+	{
+		std::vector<SceneNode::Ptr> sceneNodes;
+		for (unsigned int i = 0; i < nodeCount; i++)
+		{
+			auto sceneNode = SceneNode::Create("benchmark_node");
+			sceneNode->SetLocalPosition(Vector4(Random(-500, 500), Random(-500, 500), Random(-500, 500)));
+			sceneNode->UpdateTransforms();
+			sceneNode->AddComponent(MeshRender::Create(materials[random() % materials.size()], meshes[random() % meshes.size()]));
+			sceneNodes.push_back(sceneNode);
+		}
+
+		RenderQuery serialQuery, chunkedQuery;
+		Vector4 camPos(0.0f, 0.0f, 0.0f, 1.0f);
+
+		std::ostringstream line;
+		line << nodeCount << " nodes:";
+
+		line << " serial " << Benchmark::Measure(5, [&]()
+		{
+			serialQuery.Clear();
+			for (const auto &sceneNode : sceneNodes)
+				serialQuery.AddRenderable(sceneNode);
+		}) << "ms";
+
+		for (unsigned int workerCount = 0; workerCount <= Benchmark::GetMaxWorkerCount(); workerCount = workerCount == 0 ? 1 : workerCount * 2)
+		{
+			Benchmark::SetWorkerCount(workerCount);
+			line << ", " << workerCount << " workers " << Benchmark::Measure(5, [&]()
+			{
+				chunkedQuery.Clear();
+				chunkedQuery.AddRenderables(sceneNodes);
+			}) << "ms";
+		}
+
+		line << ", sort " << Benchmark::Measure(5, [&]() { chunkedQuery.Sort(camPos); }) << "ms";
+
+		Benchmark::SetWorkerCount(Benchmark::GetMaxWorkerCount());
+
+		FURYI << line.str();
+
+		if (serialQuery.opaqueUnits.size() != chunkedQuery.opaqueUnits.size() || 
+			serialQuery.transparentUnits.size() != chunkedQuery.transparentUnits.size())
+			FURYW << "serial and chunked builds made different units!";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include <cmath>
+#include <random>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/DynamicBVH.h"
+#include "Fury/Frustum.h"
+#include "Fury/LinearOcTree.h"
+#include "Fury/Log.h"
+#include "Fury/LooseOcTree.h"
+#include "Fury/MathUtil.h"
+#include "Fury/Matrix4.h"
+#include "Fury/OcTree.h"
+#include "Fury/SceneManager.h"
+#include "Fury/SceneNode.h"
+
+#include "Benchmark.h"
+#include "SceneManagerBenchmark.h"
+
+namespace fury
+{
+	SceneManagerBenchmark::Result SceneManagerBenchmark::Run(const std::string &name, const std::shared_ptr<SceneManager> &manager, 
+		BenchmarkScene scene, unsigned int nodeCount, unsigned int frameCount)
+	{
+		Result result;
+		result.name = name;
+		result.scene = scene;
+		result.addTime = result.updateTime = result.queryTime = 0;
+		result.visibleCount = 0;
+
+		// same seed, same scene for every manager.
+		std::mt19937 random(1234);
+		auto Random = [&](float min, float max)
+		{
+			return std::uniform_real_distribution<float>(min, max)(random);
+		};
+
+		const unsigned int clusterCount = 8;
+		std::vector<Vector4> clusters;
+		for (unsigned int i = 0; i < clusterCount; i++)
+			clusters.push_back(Vector4(Random(-2500, 2500), Random(-100, 100), Random(-2500, 2500)));
+
+		auto root = SceneNode::Create("benchmark_root");
+		std::vector<SceneNode::Ptr> sceneNodes;
+		std::vector<Vector4> velocities;
+
+		for (unsigned int i = 0; i < nodeCount; i++)
+		{
+			// 70% in clusters, 1% big ones.
+			Vector4 position = i % 10 < 7 ? 
+				clusters[i % clusterCount] + Vector4(Random(-50, 50), Random(-20, 20), Random(-50, 50), 0.0f) : 
+				Vector4(Random(-3000, 3000), Random(-200, 200), Random(-3000, 3000));
+			float size = i % 100 == 0 ? Random(20, 100) : Random(0.5f, 5.0f);
+
+			auto sceneNode = SceneNode::Create("benchmark_node");
+			sceneNode->SetModelAABB(BoxBounds(Vector4(-size), Vector4(size)));
+			sceneNode->SetLocalPosition(position);
+			root->AddChild(sceneNode);
+
+			sceneNodes.push_back(sceneNode);
+			velocities.push_back(Vector4(Random(-2, 2), Random(-0.5f, 0.5f), Random(-2, 2), 0.0f));
+		}
+
+		unsigned int moveStep = scene == BenchmarkScene::STATIC ? 0 : (scene == BenchmarkScene::MOSTLY_STATIC ? 20 : 1);
+
+		// nodes that never move are marked static, only LinearOcTree cares.
+		for (unsigned int i = 0; i < nodeCount; i++)
+			sceneNodes[i]->SetStatic(moveStep == 0 || i % moveStep != 0);
+
+		root->UpdateTransforms();
+
+		double startTime = Benchmark::GetTime();
+		manager->AddSceneNodeRecursively(root);
+		result.addTime = (Benchmark::GetTime() - startTime) * 1000;
+
+		Frustum frustum;
+		frustum.Setup(1.0f, 16.0f / 9.0f, 0.1f, 1500.0f);
+
+		SceneManager::SceneNodes visibleNodes;
+		unsigned long long visibleCount = 0;
+
+		for (unsigned int frame = 0; frame < frameCount; frame++)
+		{
+			startTime = Benchmark::GetTime();
+
+			if (moveStep > 0)
+			{
+				for (unsigned int i = 0; i < nodeCount; i += moveStep)
+				{
+					auto &sceneNode = sceneNodes[i];
+					sceneNode->SetLocalPosition(sceneNode->GetLocalPosition() + velocities[i]);
+				}
+
+				root->UpdateTransforms();
+			}
+
+			double updateEndTime = Benchmark::GetTime();
+
+			// camera circles the scene, looking at 4 directions.
+			float angle = frame * 6.2832f / frameCount;
+			Vector4 eye(std::cos(angle) * 2000.0f, 50.0f, std::sin(angle) * 2000.0f);
+
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				Matrix4 matrix;
+				matrix.AppendTranslation(eye);
+				matrix.AppendRotation(MathUtil::EulerRadToQuat(angle + i * 1.5708f, -0.1f, 0.0f));
+				frustum.Transform(matrix);
+
+				manager->GetVisibleSceneNodes(frustum, visibleNodes);
+				visibleCount += visibleNodes.size();
+			}
+
+			BoxBounds lightBounds(eye - Vector4(300.0f, 0.0f), eye + Vector4(300.0f, 0.0f));
+			manager->WalkScene(lightBounds, [&](const SceneNode::Ptr &)
+			{
+				visibleCount++;
+			});
+
+			double endTime = Benchmark::GetTime();
+			result.updateTime += (updateEndTime - startTime) * 1000;
+			result.queryTime += (endTime - updateEndTime) * 1000;
+		}
+
+		if (frameCount > 0)
+		{
+			result.updateTime /= frameCount;
+			result.queryTime /= frameCount;
+		}
+		result.visibleCount = visibleCount;
+
+		manager->Clear();
+
+		return result;
+	}
+
+	std::vector<SceneManagerBenchmark::Result> SceneManagerBenchmark::Compare(const std::vector<std::pair<std::string, Factory>> &factories, 
+		unsigned int nodeCount, unsigned int frameCount)
+	{
+		const char *sceneNames[] = { "static", "mostly_static", "dynamic" };
+
+		std::vector<Result> results;
+		for (unsigned int scene = 0; scene < 3; scene++)
+		{
+			for (const auto &pair : factories)
+			{
+				Result result = Run(pair.first, pair.second(), (BenchmarkScene)scene, nodeCount, frameCount);
+
+				FURYI << sceneNames[scene] << " " << result.name << ": add " << result.addTime << "ms, update " 
+					<< result.updateTime << "ms, query " << result.queryTime << "ms, visible " << result.visibleCount;
+
+				if (results.size() > 0 && results.back().scene == result.scene && results.back().visibleCount != result.visibleCount)
+					FURYW << result.name << " returned different results from " << results.back().name;
+
+				results.push_back(result);
+			}
+		}
+
+		return results;
+	}
+
+	std::vector<SceneManagerBenchmark::Result> SceneManagerBenchmark::Compare(unsigned int nodeCount, unsigned int frameCount)
+	{
+		std::vector<std::pair<std::string, Factory>> factories;
+
+		factories.push_back(std::make_pair(std::string("octree_default"), []()
+		{
+			return std::static_pointer_cast<SceneManager>(OcTree::Create(Vector4(-1000), Vector4(1000), 2));
+		}));
+
+		factories.push_back(std::make_pair(std::string("octree_fit"), []()
+		{
+			return std::static_pointer_cast<SceneManager>(OcTree::Create(Vector4(-3200), Vector4(3200), 8));
+		}));
+
+		factories.push_back(std::make_pair(std::string("loose_octree"), []()
+		{
+			return std::static_pointer_cast<SceneManager>(LooseOcTree::Create(Vector4(-3200), Vector4(3200), 8));
+		}));
+
+		factories.push_back(std::make_pair(std::string("linear_octree"), []()
+		{
+			return std::static_pointer_cast<SceneManager>(LinearOcTree::Create(Vector4(-3200), Vector4(3200), 8));
+		}));
+
+		factories.push_back(std::make_pair(std::string("dynamic_bvh"), []()
+		{
+			return std::static_pointer_cast<SceneManager>(DynamicBVH::Create());
+		}));
+
+		return Compare(factories, nodeCount, frameCount);
+	}
+}
+
+// Scene's default OcTree, a bigger OcTree, LooseOcTree, LinearOcTree and DynamicBVH on static, mostly static and dynamic scenes.
+FURY_BENCHMARK(SceneManager)
+{
+	fury::SceneManagerBenchmark::Compare();
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef _FURY_SCENE_MANAGER_BENCHMARK_H_
+#define _FURY_SCENE_MANAGER_BENCHMARK_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fury
+{
+	class SceneManager;
+
+	// how many scenenodes move each frame.
+	enum class BenchmarkScene : unsigned int
+	{
+		STATIC = 0,
+		// the same 5% every frame
+		MOSTLY_STATIC,
+		// all of them
+		DYNAMIC
+	};
+
+	// Runs the same scene and query workload against scene managers.
+	// The scene mixes dense clusters with sparse boxes spread over +-3000, 
+	// so parts of it are out of the default OcTree bounds.
+	// Each frame moves scenenodes, calls UpdateTransforms, then runs 4 frustum 
+	// queries along a camera path and 1 aabb query.
+	class SceneManagerBenchmark
+	{
+	public:
+
+		typedef std::function<std::shared_ptr<SceneManager>()> Factory;
+
+		struct Result
+		{
+			std::string name;
+
+			BenchmarkScene scene;
+
+			// ms, AddSceneNodeRecursively of the whole scene.
+			double addTime;
+
+			// ms per frame, moving scenenodes and UpdateTransforms.
+			double updateTime;
+
+			// ms per frame, all queries.
+			double queryTime;
+
+			// sum of all query results, same for every correct manager.
+			unsigned long long visibleCount;
+		};
+
+		static Result Run(const std::string &name, const std::shared_ptr<SceneManager> &manager, 
+			BenchmarkScene scene, unsigned int nodeCount = 20000, unsigned int frameCount = 60);
+
+		// runs every factory's manager on every scene, results are logged as well.
+		static std::vector<Result> Compare(const std::vector<std::pair<std::string, Factory>> &factories, 
+			unsigned int nodeCount = 20000, unsigned int frameCount = 60);
+
+		// Scene's default OcTree, a bigger OcTree, LooseOcTree, LinearOcTree and DynamicBVH.
+		static std::vector<Result> Compare(unsigned int nodeCount = 20000, unsigned int frameCount = 60);
+	};
+}
+
+#endif // _FURY_SCENE_MANAGER_BENCHMARK_H_
\ No newline at end of file
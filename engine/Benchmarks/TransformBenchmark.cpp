@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/Log.h"
+#include "Fury/MathUtil.h"
+#include "Fury/OcTree.h"
+#include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
+
+#include "Benchmark.h"
+
+using namespace fury;
+
+// World transform update of 100k scenenodes in an OcTree, every node changes each frame.
+// Hierarchies go from wide (parents among the first 64 nodes) to deep (parents among the last 3),
+// each one is updated serially and with 1, 2, 4 ... workers.
+FURY_BENCHMARK(Transform)
+{
+	const unsigned int nodeCount = 100000;
+
+	const char *shapeNames[] = { "wide", "medium", "deep" };
+	const unsigned int parentWindows[] = { 0, 50, 3 };
+
+	for (unsigned int shape = 0; shape < 3; shape++)
+	{
+		std::mt19937 random(7);
+		auto Random = [&](float min, float max)
+		{
+			return std::uniform_real_distribution<float>(min, max)(random);
+		};
+
+		auto root = SceneNode::Create("benchmark_root");
+		std::vector<SceneNode::Ptr> sceneNodes(1, root);
+		std::vector<unsigned int> depths(1, 0);
+
+		unsigned int parentWindow = parentWindows[shape];
+		for (unsigned int i = 0; i < nodeCount; i++)
+		{
+			auto sceneNode = SceneNode::Create("benchmark_node");
+			sceneNode->SetModelAABB(BoxBounds(Vector4(-1.0f), Vector4(1.0f)));
+			sceneNode->SetLocalPosition(Vector4(Random(-5, 5), Random(-5, 5), Random(-5, 5)));
+			sceneNode->SetLocalRoattion(MathUtil::EulerRadToQuat(Random(0, 0.5f), Random(0, 0.5f), 0.0f));
+
+			unsigned int count = sceneNodes.size();
+			unsigned int parent = parentWindow == 0 ? random() % std::min(count, 64u) :
+				count - 1 - random() % std::min(count, parentWindow);
+			sceneNodes[parent]->AddChild(sceneNode);
+			sceneNodes.push_back(sceneNode);
+			depths.push_back(depths[parent] + 1);
+		}
+
+		root->UpdateTransforms();
+
+		auto ocTree = OcTree::Create(Vector4(-1000), Vector4(1000), 6);
+		ocTree->AddSceneNodeRecursively(root);
+
+		std::ostringstream line;
+		line << shapeNames[shape] << " (depth " << *std::max_element(depths.begin(), depths.end()) << "):";
+
+		// moving the root changes every world transform.
+		unsigned int frame = 0;
+		auto Update = [&](bool parallel)
+		{
+			root->SetLocalPosition(Vector4((float)(++frame), 0.0f, 0.0f));
+			root->UpdateTransforms(parallel);
+		};
+
+		line << " serial " << Benchmark::Measure(5, [&]() { Update(false); }) << "ms";
+
+		for (unsigned int workerCount = 1; workerCount <= Benchmark::GetMaxWorkerCount(); workerCount *= 2)
+		{
+			Benchmark::SetWorkerCount(workerCount);
+			line << ", " << workerCount << " workers " << Benchmark::Measure(5, [&]() { Update(true); }) << "ms";
+		}
+
+		Benchmark::SetWorkerCount(Benchmark::GetMaxWorkerCount());
+
+		FURYI << line.str();
+
+		ocTree->Clear();
+	}
+}
\ No newline at end of file
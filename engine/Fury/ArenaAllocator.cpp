@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <iterator>
+
+#include "Fury/ArenaAllocator.h"
+
+namespace fury
+{
+	const unsigned int ArenaAllocator::INVALID = 0xffffffff;
+
+	ArenaAllocator::ArenaAllocator(unsigned int capacity)
+	{
+		Grow(capacity);
+	}
+
+	unsigned int ArenaAllocator::Allocate(unsigned int size)
+	{
+		if (size == 0)
+			return INVALID;
+
+		auto best = m_FreeRanges.end();
+		for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+		{
+			if (it->second >= size && (best == m_FreeRanges.end() || it->second < best->second))
+			{
+				best = it;
+				if (best->second == size)
+					break;
+			}
+		}
+
+		if (best == m_FreeRanges.end())
+			return INVALID;
+
+		unsigned int offset = best->first;
+		unsigned int remain = best->second - size;
+		m_FreeRanges.erase(best);
+		if (remain > 0)
+			m_FreeRanges.emplace(offset + size, remain);
+
+		unsigned int handle;
+		if (m_FreeHandles.size() > 0)
+		{
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+		else
+		{
+			handle = m_Blocks.size();
+			m_Blocks.push_back(Block());
+		}
+
+		m_Blocks[handle].offset = offset;
+		m_Blocks[handle].size = size;
+		m_Blocks[handle].live = true;
+
+		m_Used += size;
+
+		return handle;
+	}
+
+	void ArenaAllocator::Free(unsigned int handle)
+	{
+		if (!IsLive(handle))
+			return;
+
+		auto &block = m_Blocks[handle];
+		block.live = false;
+		m_FreeHandles.push_back(handle);
+		m_Used -= block.size;
+
+		unsigned int offset = block.offset;
+		unsigned int size = block.size;
+
+		// merge with next range
+		auto next = m_FreeRanges.lower_bound(offset);
+		if (next != m_FreeRanges.end() && next->first == offset + size)
+		{
+			size += next->second;
+			next = m_FreeRanges.erase(next);
+		}
+
+		// merge with previous range
+		if (next != m_FreeRanges.begin())
+		{
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == offset)
+			{
+				prev->second += size;
+				return;
+			}
+		}
+
+		m_FreeRanges.emplace(offset, size);
+	}
+
+	bool ArenaAllocator::IsLive(unsigned int handle) const
+	{
+		return handle < m_Blocks.size() && m_Blocks[handle].live;
+	}
+
+	unsigned int ArenaAllocator::GetOffset(unsigned int handle) const
+	{
+		return IsLive(handle) ? m_Blocks[handle].offset : INVALID;
+	}
+
+	unsigned int ArenaAllocator::GetSize(unsigned int handle) const
+	{
+		return IsLive(handle) ? m_Blocks[handle].size : 0;
+	}
+
+	void ArenaAllocator::Grow(unsigned int capacity)
+	{
+		if (capacity <= m_Capacity)
+			return;
+
+		unsigned int offset = m_Capacity;
+		unsigned int size = capacity - m_Capacity;
+		m_Capacity = capacity;
+
+		// extend the trailing free range if there is one.
+		if (m_FreeRanges.size() > 0)
+		{
+			auto last = std::prev(m_FreeRanges.end());
+			if (last->first + last->second == offset)
+			{
+				last->second += size;
+				return;
+			}
+		}
+
+		m_FreeRanges.emplace(offset, size);
+	}
+
+	void ArenaAllocator::Defragment(std::vector<ArenaMove> &moves)
+	{
+		std::vector<unsigned int> live;
+		live.reserve(m_Blocks.size());
+		for (unsigned int i = 0; i < m_Blocks.size(); i++)
+		{
+			if (m_Blocks[i].live)
+				live.push_back(i);
+		}
+
+		std::sort(live.begin(), live.end(), [&](unsigned int a, unsigned int b)
+		{
+			return m_Blocks[a].offset < m_Blocks[b].offset;
+		});
+
+		unsigned int offset = 0;
+		for (auto handle : live)
+		{
+			auto &block = m_Blocks[handle];
+			if (block.offset != offset)
+			{
+				ArenaMove move;
+				move.handle = handle;
+				move.srcOffset = block.offset;
+				move.destOffset = offset;
+				move.size = block.size;
+				moves.push_back(move);
+
+				block.offset = offset;
+			}
+			offset += block.size;
+		}
+
+		m_FreeRanges.clear();
+		if (offset < m_Capacity)
+			m_FreeRanges.emplace(offset, m_Capacity - offset);
+	}
+
+	void ArenaAllocator::Clear()
+	{
+		m_Blocks.clear();
+		m_FreeHandles.clear();
+		m_FreeRanges.clear();
+		m_Used = 0;
+
+		if (m_Capacity > 0)
+			m_FreeRanges.emplace(0, m_Capacity);
+	}
+
+	unsigned int ArenaAllocator::GetCapacity() const
+	{
+		return m_Capacity;
+	}
+
+	unsigned int ArenaAllocator::GetUsed() const
+	{
+		return m_Used;
+	}
+
+	unsigned int ArenaAllocator::GetFreeRangeCount() const
+	{
+		return m_FreeRanges.size();
+	}
+
+	unsigned int ArenaAllocator::GetLargestFreeRange() const
+	{
+		unsigned int largest = 0;
+		for (const auto &pair : m_FreeRanges)
+			largest = std::max(largest, pair.second);
+		return largest;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef _FURY_ARENAALLOCATOR_H_
+#define _FURY_ARENAALLOCATOR_H_
+
+#include <map>
+#include <vector>
+
+#include "Fury/Macros.h"
+
+namespace fury
+{
+	// a live block that Defragment moved, owner copies size units from srcOffset to destOffset.
+	struct FURY_API ArenaMove
+	{
+		unsigned int handle;
+
+		unsigned int srcOffset;
+
+		unsigned int destOffset;
+
+		unsigned int size;
+	};
+
+	// suballocates ranges of an abstract buffer, no gl involved. 
+	// sizes and offsets are in whatever unit the owner chooses, ie: vertices or indices.
+	// blocks are referenced by handles, so offsets can change when defragmenting.
+	class FURY_API ArenaAllocator final
+	{
+	public:
+
+		static const unsigned int INVALID;
+
+	private:
+
+		struct Block
+		{
+			unsigned int offset;
+
+			unsigned int size;
+
+			bool live;
+		};
+
+		std::vector<Block> m_Blocks;
+
+		std::vector<unsigned int> m_FreeHandles;
+
+		// offset -> size, neighbours are always merged.
+		std::map<unsigned int, unsigned int> m_FreeRanges;
+
+		unsigned int m_Capacity = 0;
+
+		unsigned int m_Used = 0;
+
+	public:
+
+		ArenaAllocator(unsigned int capacity = 0);
+
+		// best fit, returns INVALID if no free range is large enough or size is 0.
+		unsigned int Allocate(unsigned int size);
+
+		void Free(unsigned int handle);
+
+		bool IsLive(unsigned int handle) const;
+
+		unsigned int GetOffset(unsigned int handle) const;
+
+		unsigned int GetSize(unsigned int handle) const;
+
+		// adds free space at the end, capacity never shrinks.
+		void Grow(unsigned int capacity);
+
+		// packs live blocks to the front in their current order, 
+		// leaving one free range at the end. moves are in ascending offset order.
+		void Defragment(std::vector<ArenaMove> &moves);
+
+		void Clear();
+
+		unsigned int GetCapacity() const;
+
+		unsigned int GetUsed() const;
+
+		unsigned int GetFreeRangeCount() const;
+
+		unsigned int GetLargestFreeRange() const;
+	};
+}
+
+#endif // _FURY_ARENAALLOCATOR_H_
\ No newline at end of file
@@ -1,6 +1,9 @@
+#include <algorithm>
+
 #include "Fury/ArrayBuffers.h"
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
 
 namespace fury
 {
@@ -90,4 +93,110 @@ namespace fury
 	template class ArrayBuffer<int>;
 
 	template class ArrayBuffer<unsigned int>;
+
+	template class ArrayBuffer<unsigned char>;
+
+	// IndexBuffer class
+
+	unsigned int IndexBuffer::m_GlobalBytes = 0;
+
+	unsigned int IndexBuffer::m_GlobalSavedBytes = 0;
+
+	IndexBuffer::IndexBuffer(const std::string &name, unsigned int bufferUsage)
+		: ArrayBuffer<unsigned int>(name, GL_ELEMENT_ARRAY_BUFFER, bufferUsage), 
+		m_IndexType(GL_UNSIGNED_INT)
+	{
+		m_TypeIndex = typeid(IndexBuffer);
+	}
+
+	IndexBuffer::~IndexBuffer()
+	{
+		DeleteBuffer();
+	}
+
+	void IndexBuffer::UpdateBuffer()
+	{
+		if (!m_Dirty || Data.size() == 0)
+			return;
+
+		m_Dirty = false;
+
+		// 0xffff is left free for primitive restart.
+		unsigned int maxIndex = 0;
+		for (auto index : Data)
+			maxIndex = std::max(maxIndex, index);
+
+		unsigned int indexType = maxIndex < 0xffff ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		unsigned int indexSize = indexType == GL_UNSIGNED_SHORT ? 2 : 4;
+		unsigned int bytes = Data.size() * indexSize;
+
+		bool isNewBuffer = false;
+		if (m_ID == 0)
+		{
+			glGenBuffers(1, &m_ID);
+			isNewBuffer = true;
+		}
+
+		// element binding is vao state, keep the bound vao's (ie: MeshArena's) intact.
+		GLStateCache::Instance()->BindVertexArray(0);
+		glBindBuffer(m_BufferTarget, m_ID);
+
+		if (indexType == GL_UNSIGNED_SHORT)
+		{
+			std::vector<unsigned short> narrow(Data.begin(), Data.end());
+			if (isNewBuffer || bytes != m_Bytes)
+				glBufferData(m_BufferTarget, bytes, narrow.data(), m_BufferUsage);
+			else
+				glBufferSubData(m_BufferTarget, 0, bytes, narrow.data());
+		}
+		else
+		{
+			if (isNewBuffer || bytes != m_Bytes)
+				glBufferData(m_BufferTarget, bytes, Data.data(), m_BufferUsage);
+			else
+				glBufferSubData(m_BufferTarget, 0, bytes, Data.data());
+		}
+
+		glBindBuffer(m_BufferTarget, 0);
+
+		m_GlobalBytes -= m_Bytes;
+		m_GlobalSavedBytes -= m_Bytes / m_IndexSize * (4 - m_IndexSize);
+
+		m_IndexType = indexType;
+		m_IndexSize = indexSize;
+		m_Bytes = bytes;
+		m_SizeOld = Data.size();
+
+		m_GlobalBytes += m_Bytes;
+		m_GlobalSavedBytes += Data.size() * (4 - m_IndexSize);
+	}
+
+	void IndexBuffer::DeleteBuffer()
+	{
+		ArrayBuffer<unsigned int>::DeleteBuffer();
+
+		m_GlobalBytes -= m_Bytes;
+		m_GlobalSavedBytes -= m_Bytes / m_IndexSize * (4 - m_IndexSize);
+		m_Bytes = 0;
+	}
+
+	unsigned int IndexBuffer::GetIndexType() const
+	{
+		return m_IndexType;
+	}
+
+	unsigned int IndexBuffer::GetIndexSize() const
+	{
+		return m_IndexSize;
+	}
+
+	unsigned int IndexBuffer::GetGlobalBytes()
+	{
+		return m_GlobalBytes;
+	}
+
+	unsigned int IndexBuffer::GetGlobalSavedBytes()
+	{
+		return m_GlobalSavedBytes;
+	}
 }
\ No newline at end of file
@@ -51,6 +51,45 @@ namespace fury
 	typedef ArrayBuffer<int> ArrayBufferi;
 
 	typedef ArrayBuffer<unsigned int> ArrayBufferui;
+
+	typedef ArrayBuffer<unsigned char> ArrayBufferub;
+
+	// cpu side indices stay 32 bit, they are uploaded as 16 bit when every index fits.
+	class FURY_API IndexBuffer final : public ArrayBuffer<unsigned int>
+	{
+	private:
+
+		// live gpu index memory, and what 32 bit indices would have cost on top of it.
+		static unsigned int m_GlobalBytes;
+
+		static unsigned int m_GlobalSavedBytes;
+
+		unsigned int m_IndexType;
+
+		unsigned int m_IndexSize = 4;
+
+		unsigned int m_Bytes = 0;
+
+	public:
+
+		IndexBuffer(const std::string &name, unsigned int bufferUsage);
+
+		virtual ~IndexBuffer();
+
+		virtual void UpdateBuffer() override;
+
+		virtual void DeleteBuffer() override;
+
+		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, valid after UpdateBuffer.
+		unsigned int GetIndexType() const;
+
+		// 2 or 4.
+		unsigned int GetIndexSize() const;
+
+		static unsigned int GetGlobalBytes();
+
+		static unsigned int GetGlobalSavedBytes();
+	};
 }
 
 #endif // _FURY_ARRAYBUFFERS_H_
\ No newline at end of file
@@ -291,10 +291,8 @@ namespace fury
 
 	BoxBounds &BoxBounds::operator = (const BoxBounds &data)
 	{
-		if (data.GetInfinite())
-			SetInfinite(true);
-		else 
-			SetMinMax(data.GetMin(), data.GetMax());
+		m_Infinite = data.GetInfinite();
+		SetMinMax(data.GetMin(), data.GetMax());
 
 		return *this;
 	}
@@ -0,0 +1,116 @@
+#include <limits>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/BoxBoundsArray.h"
+
+namespace fury
+{
+	void BoxBoundsArray::Add(const BoxBounds &aabb)
+	{
+		m_CenterX.push_back(0.0f);
+		m_CenterY.push_back(0.0f);
+		m_CenterZ.push_back(0.0f);
+		m_ExtentX.push_back(0.0f);
+		m_ExtentY.push_back(0.0f);
+		m_ExtentZ.push_back(0.0f);
+
+		Set(m_CenterX.size() - 1, aabb);
+	}
+
+	void BoxBoundsArray::Set(unsigned int index, const BoxBounds &aabb)
+	{
+		if (aabb.GetInfinite())
+		{
+			float max = std::numeric_limits<float>::max();
+			m_CenterX[index] = m_CenterY[index] = m_CenterZ[index] = 0.0f;
+			m_ExtentX[index] = m_ExtentY[index] = m_ExtentZ[index] = max;
+		}
+		else
+		{
+			Vector4 center = aabb.GetCenter();
+			Vector4 extents = aabb.GetExtents();
+			m_CenterX[index] = center.x;
+			m_CenterY[index] = center.y;
+			m_CenterZ[index] = center.z;
+			m_ExtentX[index] = extents.x;
+			m_ExtentY[index] = extents.y;
+			m_ExtentZ[index] = extents.z;
+		}
+	}
+
+	void BoxBoundsArray::RemoveAt(unsigned int index)
+	{
+		m_CenterX.erase(m_CenterX.begin() + index);
+		m_CenterY.erase(m_CenterY.begin() + index);
+		m_CenterZ.erase(m_CenterZ.begin() + index);
+		m_ExtentX.erase(m_ExtentX.begin() + index);
+		m_ExtentY.erase(m_ExtentY.begin() + index);
+		m_ExtentZ.erase(m_ExtentZ.begin() + index);
+	}
+
+	void BoxBoundsArray::SwapRemoveAt(unsigned int index)
+	{
+		unsigned int last = m_CenterX.size() - 1;
+		if (index != last)
+		{
+			m_CenterX[index] = m_CenterX[last];
+			m_CenterY[index] = m_CenterY[last];
+			m_CenterZ[index] = m_CenterZ[last];
+			m_ExtentX[index] = m_ExtentX[last];
+			m_ExtentY[index] = m_ExtentY[last];
+			m_ExtentZ[index] = m_ExtentZ[last];
+		}
+
+		m_CenterX.pop_back();
+		m_CenterY.pop_back();
+		m_CenterZ.pop_back();
+		m_ExtentX.pop_back();
+		m_ExtentY.pop_back();
+		m_ExtentZ.pop_back();
+	}
+
+	void BoxBoundsArray::Clear()
+	{
+		m_CenterX.clear();
+		m_CenterY.clear();
+		m_CenterZ.clear();
+		m_ExtentX.clear();
+		m_ExtentY.clear();
+		m_ExtentZ.clear();
+	}
+
+	unsigned int BoxBoundsArray::GetSize() const
+	{
+		return m_CenterX.size();
+	}
+
+	const float *BoxBoundsArray::GetCenterX() const
+	{
+		return m_CenterX.data();
+	}
+
+	const float *BoxBoundsArray::GetCenterY() const
+	{
+		return m_CenterY.data();
+	}
+
+	const float *BoxBoundsArray::GetCenterZ() const
+	{
+		return m_CenterZ.data();
+	}
+
+	const float *BoxBoundsArray::GetExtentX() const
+	{
+		return m_ExtentX.data();
+	}
+
+	const float *BoxBoundsArray::GetExtentY() const
+	{
+		return m_ExtentY.data();
+	}
+
+	const float *BoxBoundsArray::GetExtentZ() const
+	{
+		return m_ExtentZ.data();
+	}
+}
\ No newline at end of file
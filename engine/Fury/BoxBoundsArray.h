@@ -0,0 +1,53 @@
+#ifndef _FURY_BOXBOUNDSARRAY_H_
+#define _FURY_BOXBOUNDSARRAY_H_
+
+#include <vector>
+
+#include "Fury/Macros.h"
+
+namespace fury
+{
+	class BoxBounds;
+
+	// Stores aabbs as center/extents in separate float arrays (SoA), 
+	// so they can be tested in batch by simd kernels. (see Frustum::IsInsideFast)
+	// Infinite aabbs are stored as zero center with max float extents.
+	class FURY_API BoxBoundsArray
+	{
+	protected:
+
+		std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+
+		std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+
+	public:
+
+		void Add(const BoxBounds &aabb);
+
+		void Set(unsigned int index, const BoxBounds &aabb);
+
+		// keeps the order of other aabbs.
+		void RemoveAt(unsigned int index);
+
+		// moves last aabb to index.
+		void SwapRemoveAt(unsigned int index);
+
+		void Clear();
+
+		unsigned int GetSize() const;
+
+		const float *GetCenterX() const;
+
+		const float *GetCenterY() const;
+
+		const float *GetCenterZ() const;
+
+		const float *GetExtentX() const;
+
+		const float *GetExtentY() const;
+
+		const float *GetExtentZ() const;
+	};
+}
+
+#endif // _FURY_BOXBOUNDSARRAY_H_
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "Fury/CommandBuffer.h"
+#include "Fury/Material.h"
+#include "Fury/Shader.h"
+#include "Fury/Texture.h"
+
+namespace fury
+{
+	CommandBuffer::Ptr CommandBuffer::Create()
+	{
+		return std::make_shared<CommandBuffer>();
+	}
+
+	void CommandBuffer::BindPass(const std::shared_ptr<Pass> &pass, bool clear)
+	{
+		AddCommand(CommandType::BIND_PASS, AddResource(pass), clear ? 1 : 0);
+	}
+
+	void CommandBuffer::UnBindPass(const std::shared_ptr<Pass> &pass)
+	{
+		AddCommand(CommandType::UNBIND_PASS, AddResource(pass));
+	}
+
+	void CommandBuffer::ClearPass(const std::shared_ptr<Pass> &pass)
+	{
+		AddCommand(CommandType::CLEAR_PASS, AddResource(pass));
+	}
+
+	void CommandBuffer::SetArrayTextureLayer(const std::shared_ptr<Pass> &pass, int index)
+	{
+		AddCommand(CommandType::SET_ARRAY_TEXTURE_LAYER, AddResource(pass), (unsigned int)index);
+	}
+
+	void CommandBuffer::SetCubeTextureIndex(const std::shared_ptr<Pass> &pass, int index)
+	{
+		AddCommand(CommandType::SET_CUBE_TEXTURE_INDEX, AddResource(pass), (unsigned int)index);
+	}
+
+	void CommandBuffer::SetPolygonOffset(bool enable, float factor, float units)
+	{
+		float data[2] = { factor, units };
+		AddCommand(CommandType::SET_POLYGON_OFFSET, enable ? 1 : 0, AddData(data, 2));
+	}
+
+	void CommandBuffer::Enable(unsigned int cap)
+	{
+		AddCommand(CommandType::ENABLE, cap);
+	}
+
+	void CommandBuffer::Disable(unsigned int cap)
+	{
+		AddCommand(CommandType::DISABLE, cap);
+	}
+
+	void CommandBuffer::CullFace(unsigned int mode)
+	{
+		AddCommand(CommandType::CULL_FACE, mode);
+	}
+
+	void CommandBuffer::BindShader(const std::shared_ptr<Shader> &shader)
+	{
+		AddCommand(CommandType::BIND_SHADER, AddResource(shader));
+	}
+
+	void CommandBuffer::UnBindShader(const std::shared_ptr<Shader> &shader)
+	{
+		AddCommand(CommandType::UNBIND_SHADER, AddResource(shader));
+	}
+
+	void CommandBuffer::BindCamera(const std::shared_ptr<Shader> &shader, const std::shared_ptr<SceneNode> &camNode)
+	{
+		Std140Block block;
+		if (shader->HasUniformBlock(UniformBlock::CAMERA))
+		{
+			if (UniformBuffer::PackCamera(camNode, block))
+				BindUniformBlock(UniformBlock::CAMERA, block);
+		}
+		else
+		{
+			AddCommand(CommandType::BIND_CAMERA, AddResource(shader), AddResource(camNode));
+		}
+	}
+
+	void CommandBuffer::BindLight(const std::shared_ptr<Shader> &shader, const std::shared_ptr<SceneNode> &lightNode)
+	{
+		Std140Block block;
+		if (shader->HasUniformBlock(UniformBlock::LIGHT))
+		{
+			if (UniformBuffer::PackLight(lightNode, block))
+				BindUniformBlock(UniformBlock::LIGHT, block);
+		}
+		else
+		{
+			AddCommand(CommandType::BIND_LIGHT, AddResource(shader), AddResource(lightNode));
+		}
+	}
+
+	void CommandBuffer::BindTexture(const std::shared_ptr<Shader> &shader, const std::shared_ptr<Texture> &texture)
+	{
+		BindTexture(shader, texture->GetName(), texture);
+	}
+
+	void CommandBuffer::BindTexture(const std::shared_ptr<Shader> &shader, const std::string &name, const std::shared_ptr<Texture> &texture)
+	{
+		BindTexture(shader, Shader::GetUniformID(name), texture);
+	}
+
+	void CommandBuffer::BindTexture(const std::shared_ptr<Shader> &shader, unsigned int uniformId, const std::shared_ptr<Texture> &texture)
+	{
+		AddCommand(CommandType::BIND_TEXTURE, AddResource(shader), AddResource(texture), uniformId);
+	}
+
+	void CommandBuffer::BindMaterial(const std::shared_ptr<Shader> &shader, const std::shared_ptr<Material> &material)
+	{
+		bool uniformBlock = shader->HasUniformBlock(UniformBlock::MATERIAL);
+		if (uniformBlock)
+			BindUniformBlock(UniformBlock::MATERIAL, material->GetUniformBlock());
+
+		AddCommand(CommandType::BIND_MATERIAL, AddResource(shader), AddResource(material), uniformBlock ? 1 : 0);
+	}
+
+	void CommandBuffer::BindMesh(const std::shared_ptr<Shader> &shader, const std::shared_ptr<Mesh> &mesh)
+	{
+		AddCommand(CommandType::BIND_MESH, AddResource(shader), AddResource(mesh));
+	}
+
+	void CommandBuffer::BindSubMesh(const std::shared_ptr<Shader> &shader, const std::shared_ptr<Mesh> &mesh, unsigned int index)
+	{
+		AddCommand(CommandType::BIND_SUBMESH, AddResource(shader), AddResource(mesh), index);
+	}
+
+	void CommandBuffer::BindMatrix(const std::shared_ptr<Shader> &shader, const std::string &name, const Matrix4 &matrix)
+	{
+		BindMatrix(shader, Shader::GetUniformID(name), matrix);
+	}
+
+	void CommandBuffer::BindMatrix(const std::shared_ptr<Shader> &shader, unsigned int uniformId, const Matrix4 &matrix)
+	{
+		AddCommand(CommandType::BIND_MATRIX, AddResource(shader), uniformId, AddData(matrix.Raw, 16));
+	}
+
+	void CommandBuffer::BindMatrices(const std::shared_ptr<Shader> &shader, const std::string &name, unsigned int count, const Matrix4 *matrices)
+	{
+		BindMatrices(shader, Shader::GetUniformID(name), count, matrices);
+	}
+
+	void CommandBuffer::BindMatrices(const std::shared_ptr<Shader> &shader, unsigned int uniformId, unsigned int count, const Matrix4 *matrices)
+	{
+		unsigned int offset = m_Data.size();
+		for (unsigned int i = 0; i < count; i++)
+			AddData(matrices[i].Raw, 16);
+
+		AddCommand(CommandType::BIND_MATRICES, AddResource(shader), uniformId, offset, count);
+	}
+
+	void CommandBuffer::BindFloat(const std::shared_ptr<Shader> &shader, const std::string &name, unsigned int count, const float *value)
+	{
+		BindFloat(shader, Shader::GetUniformID(name), count, value);
+	}
+
+	void CommandBuffer::BindFloat(const std::shared_ptr<Shader> &shader, unsigned int uniformId, unsigned int count, const float *value)
+	{
+		AddCommand(CommandType::BIND_FLOAT, AddResource(shader), uniformId, AddData(value, count), count);
+	}
+
+	void CommandBuffer::BindUniformBlock(UniformBlock block, const Std140Block &data)
+	{
+		AddCommand(CommandType::BIND_UNIFORM_BLOCK, (unsigned int)block, m_Blocks.size());
+		m_Blocks.push_back(data);
+	}
+
+	void CommandBuffer::BindInstances(const std::shared_ptr<Shader> &shader, const std::shared_ptr<InstanceBatcher> &batcher, unsigned int offset)
+	{
+		AddCommand(CommandType::BIND_INSTANCES, AddResource(shader), AddResource(batcher), offset);
+	}
+
+	void CommandBuffer::UnBindInstances(const std::shared_ptr<Shader> &shader, const std::shared_ptr<InstanceBatcher> &batcher)
+	{
+		AddCommand(CommandType::UNBIND_INSTANCES, AddResource(shader), AddResource(batcher));
+	}
+
+	void CommandBuffer::BindIndirect(const std::shared_ptr<Shader> &shader, const std::shared_ptr<IndirectBatcher> &batcher)
+	{
+		AddCommand(CommandType::BIND_INDIRECT, AddResource(shader), AddResource(batcher));
+	}
+
+	void CommandBuffer::UnBindIndirect(const std::shared_ptr<Shader> &shader, const std::shared_ptr<IndirectBatcher> &batcher)
+	{
+		AddCommand(CommandType::UNBIND_INDIRECT, AddResource(shader), AddResource(batcher));
+	}
+
+	void CommandBuffer::Draw(unsigned int indexCount, unsigned int instanceCount)
+	{
+		AddCommand(CommandType::DRAW, indexCount, instanceCount);
+	}
+
+	void CommandBuffer::DrawIndirect(const std::shared_ptr<IndirectBatcher> &batcher, unsigned int commandOffset, 
+		unsigned int commandCount, unsigned int indexType)
+	{
+		AddCommand(CommandType::DRAW_INDIRECT, AddResource(batcher), commandOffset, commandCount, indexType);
+	}
+
+	void CommandBuffer::RenderGui()
+	{
+		AddCommand(CommandType::RENDER_GUI);
+	}
+
+	const std::vector<RenderCommand> &CommandBuffer::GetCommands() const
+	{
+		return m_Commands;
+	}
+
+	unsigned int CommandBuffer::GetCommandCount() const
+	{
+		return m_Commands.size();
+	}
+
+	const float *CommandBuffer::GetData(unsigned int offset) const
+	{
+		return &m_Data[offset];
+	}
+
+	const Std140Block &CommandBuffer::GetBlock(unsigned int index) const
+	{
+		return m_Blocks[index];
+	}
+
+	void CommandBuffer::Clear()
+	{
+		m_Commands.clear();
+		m_Resources.clear();
+		m_ResourceIndices.clear();
+		m_Data.clear();
+		m_Blocks.clear();
+	}
+
+	void CommandBuffer::AddCommand(CommandType type, unsigned int arg0, unsigned int arg1, unsigned int arg2, unsigned int arg3)
+	{
+		RenderCommand command;
+		command.type = type;
+		command.args[0] = arg0;
+		command.args[1] = arg1;
+		command.args[2] = arg2;
+		command.args[3] = arg3;
+		m_Commands.push_back(command);
+	}
+
+	unsigned int CommandBuffer::AddResource(const std::shared_ptr<void> &ptr)
+	{
+		auto it = m_ResourceIndices.find(ptr.get());
+		if (it != m_ResourceIndices.end())
+			return it->second;
+
+		unsigned int index = m_Resources.size();
+		m_Resources.push_back(ptr);
+		m_ResourceIndices.emplace(ptr.get(), index);
+		return index;
+	}
+
+	unsigned int CommandBuffer::AddData(const float *data, unsigned int count)
+	{
+		unsigned int offset = m_Data.size();
+		m_Data.insert(m_Data.end(), data, data + count);
+		return offset;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#ifndef _FURY_COMMANDBUFFER_H_
+#define _FURY_COMMANDBUFFER_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Fury/Matrix4.h"
+#include "Fury/UniformBuffer.h"
+
+namespace fury
+{
+	class IndirectBatcher;
+
+	class InstanceBatcher;
+
+	class Material;
+
+	class Mesh;
+
+	class Pass;
+
+	class SceneNode;
+
+	class Shader;
+
+	class Texture;
+
+	enum class CommandType : unsigned int
+	{
+		BIND_PASS = 0, 
+		UNBIND_PASS, 
+		CLEAR_PASS, 
+		SET_ARRAY_TEXTURE_LAYER, 
+		SET_CUBE_TEXTURE_INDEX, 
+		SET_POLYGON_OFFSET, 
+		ENABLE, 
+		DISABLE, 
+		CULL_FACE, 
+		BIND_SHADER, 
+		UNBIND_SHADER, 
+		BIND_CAMERA, 
+		BIND_LIGHT, 
+		BIND_TEXTURE, 
+		BIND_MATERIAL, 
+		BIND_MESH, 
+		BIND_SUBMESH, 
+		BIND_MATRIX, 
+		BIND_MATRICES, 
+		BIND_FLOAT, 
+		BIND_UNIFORM_BLOCK, 
+		BIND_INSTANCES, 
+		UNBIND_INSTANCES, 
+		BIND_INDIRECT, 
+		UNBIND_INDIRECT, 
+		DRAW, 
+		DRAW_INDIRECT, 
+		RENDER_GUI, 
+		LENGTH
+	};
+
+	// args are indices into the buffer's resource and data tables or uniform ids, see CommandBuffer.
+	struct FURY_API RenderCommand
+	{
+		CommandType type;
+
+		unsigned int args[4];
+	};
+
+	// Records draw work as plain commands instead of calling gl directly, 
+	// a CommandExecutor replays them later.
+	// Objects referenced by commands are kept alive by the buffer until Clear.
+	class FURY_API CommandBuffer
+	{
+	public:
+
+		typedef std::shared_ptr<CommandBuffer> Ptr;
+
+		static Ptr Create();
+
+	protected:
+
+		std::vector<RenderCommand> m_Commands;
+
+		std::vector<std::shared_ptr<void>> m_Resources;
+
+		std::unordered_map<const void*, unsigned int> m_ResourceIndices;
+
+		std::vector<float> m_Data;
+
+		std::vector<Std140Block> m_Blocks;
+
+	public:
+
+		// pass
+
+		void BindPass(const std::shared_ptr<Pass> &pass, bool clear = true);
+
+		void UnBindPass(const std::shared_ptr<Pass> &pass);
+
+		// clear with the pass's own clear mode and color.
+		void ClearPass(const std::shared_ptr<Pass> &pass);
+
+		void SetArrayTextureLayer(const std::shared_ptr<Pass> &pass, int index);
+
+		void SetCubeTextureIndex(const std::shared_ptr<Pass> &pass, int index);
+
+		void SetPolygonOffset(bool enable, float factor = 0.0f, float units = 0.0f);
+
+		// gl state, set through GLStateCache.
+
+		void Enable(unsigned int cap);
+
+		void Disable(unsigned int cap);
+
+		void CullFace(unsigned int mode);
+
+		// shader
+
+		void BindShader(const std::shared_ptr<Shader> &shader);
+
+		void UnBindShader(const std::shared_ptr<Shader> &shader);
+
+		// shaders with the camera block get the block packed now, others get plain uniforms at replay.
+		void BindCamera(const std::shared_ptr<Shader> &shader, const std::shared_ptr<SceneNode> &camNode);
+
+		// same as BindCamera, for the light block.
+		void BindLight(const std::shared_ptr<Shader> &shader, const std::shared_ptr<SceneNode> &lightNode);
+
+		// bind to the uniform of texture's name.
+		void BindTexture(const std::shared_ptr<Shader> &shader, const std::shared_ptr<Texture> &texture);
+
+		void BindTexture(const std::shared_ptr<Shader> &shader, const std::string &name, const std::shared_ptr<Texture> &texture);
+
+		// uniformId from Shader::GetUniformID, the overloads below take one too.
+		void BindTexture(const std::shared_ptr<Shader> &shader, unsigned int uniformId, const std::shared_ptr<Texture> &texture);
+
+		// material block is packed now, textures and plain uniforms are bound at replay.
+		void BindMaterial(const std::shared_ptr<Shader> &shader, const std::shared_ptr<Material> &material);
+
+		void BindMesh(const std::shared_ptr<Shader> &shader, const std::shared_ptr<Mesh> &mesh);
+
+		void BindSubMesh(const std::shared_ptr<Shader> &shader, const std::shared_ptr<Mesh> &mesh, unsigned int index);
+
+		void BindMatrix(const std::shared_ptr<Shader> &shader, const std::string &name, const Matrix4 &matrix);
+
+		void BindMatrix(const std::shared_ptr<Shader> &shader, unsigned int uniformId, const Matrix4 &matrix);
+
+		void BindMatrices(const std::shared_ptr<Shader> &shader, const std::string &name, unsigned int count, const Matrix4 *matrices);
+
+		void BindMatrices(const std::shared_ptr<Shader> &shader, unsigned int uniformId, unsigned int count, const Matrix4 *matrices);
+
+		// count is 1 to 4.
+		void BindFloat(const std::shared_ptr<Shader> &shader, const std::string &name, unsigned int count, const float *value);
+
+		void BindFloat(const std::shared_ptr<Shader> &shader, unsigned int uniformId, unsigned int count, const float *value);
+
+		// data is copied, replay skips the upload if the binding point holds the same data.
+		void BindUniformBlock(UniformBlock block, const Std140Block &data);
+
+		void BindInstances(const std::shared_ptr<Shader> &shader, const std::shared_ptr<InstanceBatcher> &batcher, unsigned int offset);
+
+		void UnBindInstances(const std::shared_ptr<Shader> &shader, const std::shared_ptr<InstanceBatcher> &batcher);
+
+		// binds the batcher's matrices and its indirect command buffer.
+		void BindIndirect(const std::shared_ptr<Shader> &shader, const std::shared_ptr<IndirectBatcher> &batcher);
+
+		void UnBindIndirect(const std::shared_ptr<Shader> &shader, const std::shared_ptr<IndirectBatcher> &batcher);
+
+		// triangles from the bound index buffer, instanced if instanceCount > 0.
+		void Draw(unsigned int indexCount, unsigned int instanceCount = 0);
+
+		// one glMultiDrawElementsIndirect over the batcher's commands, needs the arena mesh bound.
+		void DrawIndirect(const std::shared_ptr<IndirectBatcher> &batcher, unsigned int commandOffset, 
+			unsigned int commandCount, unsigned int indexType);
+
+		// gui draw lists of the frame.
+		void RenderGui();
+
+		// replay
+
+		const std::vector<RenderCommand> &GetCommands() const;
+
+		unsigned int GetCommandCount() const;
+
+		template<class Type>
+		std::shared_ptr<Type> GetResource(unsigned int index) const;
+
+		const float *GetData(unsigned int offset) const;
+
+		const Std140Block &GetBlock(unsigned int index) const;
+
+		void Clear();
+
+	protected:
+
+		void AddCommand(CommandType type, unsigned int arg0 = 0, unsigned int arg1 = 0, unsigned int arg2 = 0, unsigned int arg3 = 0);
+
+		unsigned int AddResource(const std::shared_ptr<void> &ptr);
+
+		unsigned int AddData(const float *data, unsigned int count);
+	};
+
+	template<class Type>
+	std::shared_ptr<Type> CommandBuffer::GetResource(unsigned int index) const
+	{
+		return std::static_pointer_cast<Type>(m_Resources[index]);
+	}
+}
+
+#endif // _FURY_COMMANDBUFFER_H_
\ No newline at end of file
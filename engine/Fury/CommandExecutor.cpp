@@ -0,0 +1,221 @@
+#include "Fury/CommandExecutor.h"
+#include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
+#include "Fury/Gui.h"
+#include "Fury/IndirectBatcher.h"
+#include "Fury/InstanceBatcher.h"
+#include "Fury/Mesh.h"
+#include "Fury/Pass.h"
+#include "Fury/Shader.h"
+#include "Fury/Texture.h"
+#include "Fury/UniformBuffer.h"
+
+namespace fury
+{
+	GLCommandExecutor::Ptr GLCommandExecutor::Create()
+	{
+		return std::make_shared<GLCommandExecutor>();
+	}
+
+	void GLCommandExecutor::Execute(const CommandBuffer &buffer)
+	{
+		// range of the last bound mesh, known once the mesh is uploaded.
+		DrawRange range;
+
+		for (const auto &command : buffer.GetCommands())
+		{
+			const auto &args = command.args;
+			switch (command.type)
+			{
+			case CommandType::BIND_PASS:
+				buffer.GetResource<Pass>(args[0])->Bind(args[1] != 0);
+				break;
+			case CommandType::UNBIND_PASS:
+				buffer.GetResource<Pass>(args[0])->UnBind();
+				break;
+			case CommandType::CLEAR_PASS:
+			{
+				auto pass = buffer.GetResource<Pass>(args[0]);
+				pass->Clear(pass->GetClearMode(), pass->GetClearColor());
+				break;
+			}
+			case CommandType::SET_ARRAY_TEXTURE_LAYER:
+				buffer.GetResource<Pass>(args[0])->SetArrayTextureLayer((int)args[1]);
+				break;
+			case CommandType::SET_CUBE_TEXTURE_INDEX:
+				buffer.GetResource<Pass>(args[0])->SetCubeTextureIndex((int)args[1]);
+				break;
+			case CommandType::SET_POLYGON_OFFSET:
+				if (args[0] != 0)
+				{
+					auto data = buffer.GetData(args[1]);
+					GLStateCache::Instance()->Enable(GL_POLYGON_OFFSET_FILL);
+					glPolygonOffset(data[0], data[1]);
+				}
+				else
+				{
+					GLStateCache::Instance()->Disable(GL_POLYGON_OFFSET_FILL);
+				}
+				break;
+			case CommandType::ENABLE:
+				GLStateCache::Instance()->Enable(args[0]);
+				break;
+			case CommandType::DISABLE:
+				GLStateCache::Instance()->Disable(args[0]);
+				break;
+			case CommandType::CULL_FACE:
+				GLStateCache::Instance()->CullFace(args[0]);
+				break;
+			case CommandType::BIND_SHADER:
+				buffer.GetResource<Shader>(args[0])->Bind();
+				break;
+			case CommandType::UNBIND_SHADER:
+				buffer.GetResource<Shader>(args[0])->UnBind();
+				break;
+			case CommandType::BIND_CAMERA:
+				buffer.GetResource<Shader>(args[0])->BindCamera(buffer.GetResource<SceneNode>(args[1]));
+				break;
+			case CommandType::BIND_LIGHT:
+				buffer.GetResource<Shader>(args[0])->BindLight(buffer.GetResource<SceneNode>(args[1]));
+				break;
+			case CommandType::BIND_TEXTURE:
+				buffer.GetResource<Shader>(args[0])->BindTexture(args[2], buffer.GetResource<Texture>(args[1]));
+				break;
+			case CommandType::BIND_MATERIAL:
+				// a recorded material block is bound by its own command.
+				buffer.GetResource<Shader>(args[0])->BindMaterial(buffer.GetResource<Material>(args[1]), args[2] == 0);
+				break;
+			case CommandType::BIND_MESH:
+			{
+				auto mesh = buffer.GetResource<Mesh>(args[1]);
+				buffer.GetResource<Shader>(args[0])->BindMesh(mesh);
+				range = mesh->GetDrawRange();
+				break;
+			}
+			case CommandType::BIND_SUBMESH:
+			{
+				auto mesh = buffer.GetResource<Mesh>(args[1]);
+				buffer.GetResource<Shader>(args[0])->BindSubMesh(mesh, args[2]);
+				range = mesh->GetDrawRange(args[2]);
+				break;
+			}
+			case CommandType::BIND_MATRIX:
+				buffer.GetResource<Shader>(args[0])->BindMatrix(args[1], buffer.GetData(args[2]));
+				break;
+			case CommandType::BIND_MATRICES:
+				buffer.GetResource<Shader>(args[0])->BindMatrices(args[1], args[3], buffer.GetData(args[2]));
+				break;
+			case CommandType::BIND_FLOAT:
+				buffer.GetResource<Shader>(args[0])->BindFloat(args[1], args[3], 1, buffer.GetData(args[2]));
+				break;
+			case CommandType::BIND_UNIFORM_BLOCK:
+				UniformBuffer::Instance()->Bind((UniformBlock)args[0], buffer.GetBlock(args[1]));
+				break;
+			case CommandType::BIND_INSTANCES:
+			{
+				auto batcher = buffer.GetResource<InstanceBatcher>(args[1]);
+				batcher->UpdateBuffer();
+				buffer.GetResource<Shader>(args[0])->BindInstances(batcher->Instances, args[2]);
+				break;
+			}
+			case CommandType::UNBIND_INSTANCES:
+				buffer.GetResource<Shader>(args[0])->UnBindInstances(buffer.GetResource<InstanceBatcher>(args[1])->Instances);
+				break;
+			case CommandType::BIND_INDIRECT:
+			{
+				auto batcher = buffer.GetResource<IndirectBatcher>(args[1]);
+				batcher->UpdateBuffer();
+				buffer.GetResource<Shader>(args[0])->BindInstances(batcher->Matrices, 0);
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, batcher->Commands.GetID());
+				break;
+			}
+			case CommandType::UNBIND_INDIRECT:
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+				buffer.GetResource<Shader>(args[0])->UnBindInstances(buffer.GetResource<IndirectBatcher>(args[1])->Matrices);
+				break;
+			case CommandType::DRAW:
+				if (args[1] > 0)
+					glDrawElementsInstancedBaseVertex(GL_TRIANGLES, args[0], range.indexType, (void*)range.indexOffset, args[1], range.baseVertex);
+				else
+					glDrawElementsBaseVertex(GL_TRIANGLES, args[0], range.indexType, (void*)range.indexOffset, range.baseVertex);
+				break;
+			case CommandType::DRAW_INDIRECT:
+				glMultiDrawElementsIndirect(GL_TRIANGLES, args[3], 
+					(void*)(sizeof(unsigned int) * IndirectBatcher::COMMAND_SIZE * args[1]), args[2], 0);
+				break;
+			case CommandType::RENDER_GUI:
+#ifdef _FURY_GUI_IMP_
+				Gui::Render();
+#endif
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	NullCommandExecutor::Ptr NullCommandExecutor::Create()
+	{
+		return std::make_shared<NullCommandExecutor>();
+	}
+
+	NullCommandExecutor::NullCommandExecutor()
+	{
+		Reset();
+	}
+
+	void NullCommandExecutor::Execute(const CommandBuffer &buffer)
+	{
+		for (const auto &command : buffer.GetCommands())
+		{
+			m_CommandCounts[(unsigned int)command.type]++;
+
+			if (command.type == CommandType::DRAW)
+			{
+				unsigned int instances = command.args[1] > 0 ? command.args[1] : 1;
+				m_DrawCount++;
+				m_InstanceCount += instances;
+				m_IndexCount += command.args[0] * instances;
+			}
+			else if (command.type == CommandType::DRAW_INDIRECT)
+			{
+				auto batcher = buffer.GetResource<IndirectBatcher>(command.args[0]);
+				for (unsigned int i = 0; i < command.args[2]; i++)
+				{
+					auto indirect = batcher->GetCommand(command.args[1] + i);
+					m_DrawCount++;
+					m_InstanceCount += indirect.instanceCount;
+					m_IndexCount += indirect.count * indirect.instanceCount;
+				}
+			}
+		}
+	}
+
+	unsigned int NullCommandExecutor::GetCommandCount(CommandType type) const
+	{
+		return m_CommandCounts[(unsigned int)type];
+	}
+
+	unsigned int NullCommandExecutor::GetDrawCount() const
+	{
+		return m_DrawCount;
+	}
+
+	unsigned int NullCommandExecutor::GetInstanceCount() const
+	{
+		return m_InstanceCount;
+	}
+
+	unsigned int NullCommandExecutor::GetIndexCount() const
+	{
+		return m_IndexCount;
+	}
+
+	void NullCommandExecutor::Reset()
+	{
+		m_CommandCounts.fill(0);
+		m_DrawCount = 0;
+		m_InstanceCount = 0;
+		m_IndexCount = 0;
+	}
+}
\ No newline at end of file
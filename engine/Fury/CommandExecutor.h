@@ -0,0 +1,75 @@
+#ifndef _FURY_COMMANDEXECUTOR_H_
+#define _FURY_COMMANDEXECUTOR_H_
+
+#include <array>
+#include <memory>
+
+#include "Fury/CommandBuffer.h"
+
+namespace fury
+{
+	// replays a CommandBuffer.
+	class FURY_API CommandExecutor
+	{
+	public:
+
+		typedef std::shared_ptr<CommandExecutor> Ptr;
+
+		virtual ~CommandExecutor() {}
+
+		virtual void Execute(const CommandBuffer &buffer) = 0;
+	};
+
+	// issues the recorded gl calls, main thread only.
+	class FURY_API GLCommandExecutor : public CommandExecutor
+	{
+	public:
+
+		typedef std::shared_ptr<GLCommandExecutor> Ptr;
+
+		static Ptr Create();
+
+		virtual void Execute(const CommandBuffer &buffer) override;
+	};
+
+	// no gl calls, only counts what would be drawn. 
+	// for headless runs and draw call regression tests.
+	class FURY_API NullCommandExecutor : public CommandExecutor
+	{
+	public:
+
+		typedef std::shared_ptr<NullCommandExecutor> Ptr;
+
+		static Ptr Create();
+
+	protected:
+
+		std::array<unsigned int, (size_t)CommandType::LENGTH> m_CommandCounts;
+
+		unsigned int m_DrawCount;
+
+		unsigned int m_InstanceCount;
+
+		unsigned int m_IndexCount;
+
+	public:
+
+		NullCommandExecutor();
+
+		virtual void Execute(const CommandBuffer &buffer) override;
+
+		unsigned int GetCommandCount(CommandType type) const;
+
+		// a multi draw counts each of its commands.
+		unsigned int GetDrawCount() const;
+
+		// instanced draws count all instances, others count 1.
+		unsigned int GetInstanceCount() const;
+
+		unsigned int GetIndexCount() const;
+
+		void Reset();
+	};
+}
+
+#endif // _FURY_COMMANDEXECUTOR_H_
\ No newline at end of file
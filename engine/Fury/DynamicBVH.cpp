@@ -0,0 +1,481 @@
+#include <algorithm>
+
+#include "Fury/DynamicBVH.h"
+#include "Fury/Log.h"
+#include "Fury/SceneNode.h"
+
+namespace fury
+{
+	const unsigned int DynamicBVH::STACK_SIZE;
+
+	const float DynamicBVH::DISPLACEMENT_MULTIPLIER = 4.0f;
+
+	DynamicBVH::Ptr DynamicBVH::Create(float margin)
+	{
+		return std::make_shared<DynamicBVH>(margin);
+	}
+
+	DynamicBVH::DynamicBVH(float margin) : 
+		m_TypeIndex(typeid(DynamicBVH)), m_Root(-1), m_Margin(std::max(margin, 0.0f)), 
+		m_SceneNodeCount(0), m_UpdateMoveCount(0), m_UpdateSkipCount(0)
+	{
+
+	}
+
+	DynamicBVH::~DynamicBVH()
+	{
+		Clear();
+		FURYD << "DynamicBVH::~DynamicBVH";
+	}
+
+	std::type_index DynamicBVH::GetTypeIndex() const
+	{
+		return m_TypeIndex;
+	}
+
+	void DynamicBVH::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() == this)
+		{
+			UpdateSceneNode(sceneNode);
+			return;
+		}
+
+		BoxBounds aabb = sceneNode->GetWorldAABB();
+		m_SceneNodeCount++;
+
+		if (aabb.GetInfinite())
+		{
+			// cell 1 marks infinite ones.
+			sceneNode->SetSceneManager(this, 1, m_InfiniteNodes.size());
+			m_InfiniteNodes.push_back(sceneNode);
+			return;
+		}
+
+		int leaf = AllocateTreeNode();
+		TreeNode &treeNode = m_TreeNodes[leaf];
+		treeNode.aabb = BoxBounds(aabb.GetMin() - Vector4(m_Margin, 0.0f), aabb.GetMax() + Vector4(m_Margin, 0.0f));
+		treeNode.sceneNodeAABB = aabb;
+		treeNode.sceneNode = sceneNode;
+		treeNode.height = 0;
+
+		sceneNode->SetSceneManager(this, 0, leaf);
+		InsertLeaf(leaf);
+	}
+
+	void DynamicBVH::AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		AddSceneNode(sceneNode);
+
+		for (unsigned int i = 0; i < sceneNode->GetChildCount(); i++)
+			AddSceneNodeRecursively(sceneNode->GetChildAt(i));
+	}
+
+	void DynamicBVH::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() != this)
+			return;
+
+		unsigned int slot = sceneNode->GetSceneManagerSlot();
+		auto ptr = sceneNode;
+
+		if (sceneNode->GetSceneManagerCell() == 1)
+		{
+			// swap with last one, and let it know it's new slot.
+			auto &last = m_InfiniteNodes.back();
+			last->SetSceneManagerSlot(slot);
+			m_InfiniteNodes[slot] = last;
+			m_InfiniteNodes.pop_back();
+		}
+		else
+		{
+			RemoveLeaf(slot);
+			FreeTreeNode(slot);
+		}
+
+		ptr->SetSceneManager(nullptr);
+		m_SceneNodeCount--;
+	}
+
+	void DynamicBVH::UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() != this)
+			return;
+
+		BoxBounds aabb = sceneNode->GetWorldAABB();
+		bool infinite = sceneNode->GetSceneManagerCell() == 1;
+
+		if (!infinite && !aabb.GetInfinite())
+		{
+			int leaf = sceneNode->GetSceneManagerSlot();
+			TreeNode &treeNode = m_TreeNodes[leaf];
+			Vector4 displacement = aabb.GetCenter() - treeNode.sceneNodeAABB.GetCenter();
+			treeNode.sceneNodeAABB = aabb;
+
+			if (Contains(treeNode.aabb, aabb))
+			{
+				m_UpdateSkipCount++;
+				return;
+			}
+
+			// reinsert with a new fat aabb, the leaf keeps it's index.
+			// it's stretched along the movement, so steady moving scenenodes stay in it for a few frames.
+			Vector4 fatMin = aabb.GetMin() - Vector4(m_Margin, 0.0f);
+			Vector4 fatMax = aabb.GetMax() + Vector4(m_Margin, 0.0f);
+			Vector4 stretch = displacement * DISPLACEMENT_MULTIPLIER;
+
+			(stretch.x < 0.0f ? fatMin.x : fatMax.x) += stretch.x;
+			(stretch.y < 0.0f ? fatMin.y : fatMax.y) += stretch.y;
+			(stretch.z < 0.0f ? fatMin.z : fatMax.z) += stretch.z;
+
+			RemoveLeaf(leaf);
+			treeNode.aabb = BoxBounds(fatMin, fatMax);
+			InsertLeaf(leaf);
+		}
+		else if (infinite && aabb.GetInfinite())
+		{
+			m_UpdateSkipCount++;
+			return;
+		}
+		else
+		{
+			auto ptr = sceneNode;
+			RemoveSceneNode(ptr);
+			AddSceneNode(ptr);
+		}
+
+		m_UpdateMoveCount++;
+	}
+
+	void DynamicBVH::Clear()
+	{
+		for (auto &treeNode : m_TreeNodes)
+		{
+			if (treeNode.sceneNode != nullptr)
+				treeNode.sceneNode->SetSceneManager(nullptr);
+		}
+
+		for (auto &sceneNode : m_InfiniteNodes)
+			sceneNode->SetSceneManager(nullptr);
+
+		m_TreeNodes.clear();
+		m_FreeTreeNodes.clear();
+		m_InfiniteNodes.clear();
+		m_Root = -1;
+		m_SceneNodeCount = 0;
+	}
+
+	float DynamicBVH::GetMargin() const
+	{
+		return m_Margin;
+	}
+
+	unsigned int DynamicBVH::GetSceneNodeCount() const
+	{
+		return m_SceneNodeCount;
+	}
+
+	unsigned int DynamicBVH::GetTreeNodeCount() const
+	{
+		return m_TreeNodes.size() - m_FreeTreeNodes.size();
+	}
+
+	unsigned int DynamicBVH::GetHeight() const
+	{
+		return m_Root < 0 ? 0 : m_TreeNodes[m_Root].height + 1;
+	}
+
+	float DynamicBVH::GetAreaRatio() const
+	{
+		if (m_Root < 0)
+			return 0.0f;
+
+		float rootArea = GetArea(m_TreeNodes[m_Root].aabb);
+		if (rootArea <= 0.0f)
+			return 0.0f;
+
+		float totalArea = 0.0f;
+		for (const auto &treeNode : m_TreeNodes)
+		{
+			if (treeNode.height > 0)
+				totalArea += GetArea(treeNode.aabb);
+		}
+
+		return totalArea / rootArea;
+	}
+
+	unsigned int DynamicBVH::GetUpdateMoveCount() const
+	{
+		return m_UpdateMoveCount;
+	}
+
+	unsigned int DynamicBVH::GetUpdateSkipCount() const
+	{
+		return m_UpdateSkipCount;
+	}
+
+	void DynamicBVH::ResetStatistics()
+	{
+		m_UpdateMoveCount = 0;
+		m_UpdateSkipCount = 0;
+	}
+
+	int DynamicBVH::AllocateTreeNode()
+	{
+		int index;
+		if (m_FreeTreeNodes.size() > 0)
+		{
+			index = m_FreeTreeNodes.back();
+			m_FreeTreeNodes.pop_back();
+		}
+		else
+		{
+			index = m_TreeNodes.size();
+			m_TreeNodes.push_back(TreeNode());
+		}
+
+		TreeNode &treeNode = m_TreeNodes[index];
+		treeNode.parent = -1;
+		treeNode.child1 = -1;
+		treeNode.child2 = -1;
+		treeNode.height = 0;
+		return index;
+	}
+
+	void DynamicBVH::FreeTreeNode(int index)
+	{
+		TreeNode &treeNode = m_TreeNodes[index];
+		treeNode.sceneNode.reset();
+		treeNode.height = -1;
+		m_FreeTreeNodes.push_back(index);
+	}
+
+	void DynamicBVH::InsertLeaf(int leaf)
+	{
+		if (m_Root < 0)
+		{
+			m_Root = leaf;
+			m_TreeNodes[leaf].parent = -1;
+			return;
+		}
+
+		// find the sibling that adds the least surface area.
+		BoxBounds leafAABB = m_TreeNodes[leaf].aabb;
+		int index = m_Root;
+
+		while (m_TreeNodes[index].height > 0)
+		{
+			const TreeNode &treeNode = m_TreeNodes[index];
+
+			float area = GetArea(treeNode.aabb);
+			float combinedArea = GetCombinedArea(treeNode.aabb, leafAABB);
+
+			// cost of making a new parent for this node and the leaf.
+			float cost = 2.0f * combinedArea;
+
+			// minimum cost of pushing the leaf further down.
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto GetDescendCost = [&](int child)
+			{
+				const TreeNode &childNode = m_TreeNodes[child];
+				float childCost = GetCombinedArea(childNode.aabb, leafAABB);
+				if (childNode.height > 0)
+					childCost -= GetArea(childNode.aabb);
+				return childCost + inheritanceCost;
+			};
+
+			float cost1 = GetDescendCost(treeNode.child1);
+			float cost2 = GetDescendCost(treeNode.child2);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? treeNode.child1 : treeNode.child2;
+		}
+
+		int sibling = index;
+		int oldParent = m_TreeNodes[sibling].parent;
+		int newParent = AllocateTreeNode();
+
+		TreeNode &parentNode = m_TreeNodes[newParent];
+		parentNode.parent = oldParent;
+		parentNode.aabb = Combine(leafAABB, m_TreeNodes[sibling].aabb);
+		parentNode.height = m_TreeNodes[sibling].height + 1;
+		parentNode.child1 = sibling;
+		parentNode.child2 = leaf;
+
+		if (oldParent >= 0)
+		{
+			if (m_TreeNodes[oldParent].child1 == sibling)
+				m_TreeNodes[oldParent].child1 = newParent;
+			else
+				m_TreeNodes[oldParent].child2 = newParent;
+		}
+		else
+		{
+			m_Root = newParent;
+		}
+
+		m_TreeNodes[sibling].parent = newParent;
+		m_TreeNodes[leaf].parent = newParent;
+
+		Refit(newParent);
+	}
+
+	void DynamicBVH::RemoveLeaf(int leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = -1;
+			return;
+		}
+
+		int parent = m_TreeNodes[leaf].parent;
+		int grandParent = m_TreeNodes[parent].parent;
+		int sibling = m_TreeNodes[parent].child1 == leaf ? m_TreeNodes[parent].child2 : m_TreeNodes[parent].child1;
+
+		// sibling takes parent's place.
+		if (grandParent >= 0)
+		{
+			if (m_TreeNodes[grandParent].child1 == parent)
+				m_TreeNodes[grandParent].child1 = sibling;
+			else
+				m_TreeNodes[grandParent].child2 = sibling;
+
+			m_TreeNodes[sibling].parent = grandParent;
+			FreeTreeNode(parent);
+			Refit(grandParent);
+		}
+		else
+		{
+			m_Root = sibling;
+			m_TreeNodes[sibling].parent = -1;
+			FreeTreeNode(parent);
+		}
+
+		m_TreeNodes[leaf].parent = -1;
+	}
+
+	int DynamicBVH::Balance(int indexA)
+	{
+		TreeNode &A = m_TreeNodes[indexA];
+		if (A.height < 2)
+			return indexA;
+
+		int indexB = A.child1;
+		int indexC = A.child2;
+		TreeNode &B = m_TreeNodes[indexB];
+		TreeNode &C = m_TreeNodes[indexC];
+
+		int balance = C.height - B.height;
+
+		// C is higher, rotate it up.
+		// the higher of C's childs stays under C, the other one takes C's place under A.
+		auto Rotate = [&](int indexUp, TreeNode &up, TreeNode &other, bool upIsChild1) -> int
+		{
+			int indexF = up.child1;
+			int indexG = up.child2;
+			TreeNode &F = m_TreeNodes[indexF];
+			TreeNode &G = m_TreeNodes[indexG];
+
+			// swap A and up
+			up.child1 = indexA;
+			up.parent = A.parent;
+			A.parent = indexUp;
+
+			if (up.parent >= 0)
+			{
+				if (m_TreeNodes[up.parent].child1 == indexA)
+					m_TreeNodes[up.parent].child1 = indexUp;
+				else
+					m_TreeNodes[up.parent].child2 = indexUp;
+			}
+			else
+			{
+				m_Root = indexUp;
+			}
+
+			int indexKeep = F.height > G.height ? indexF : indexG;
+			int indexMove = F.height > G.height ? indexG : indexF;
+			TreeNode &keep = m_TreeNodes[indexKeep];
+			TreeNode &move = m_TreeNodes[indexMove];
+
+			up.child2 = indexKeep;
+			if (upIsChild1)
+				A.child1 = indexMove;
+			else
+				A.child2 = indexMove;
+			move.parent = indexA;
+
+			A.aabb = Combine(other.aabb, move.aabb);
+			up.aabb = Combine(A.aabb, keep.aabb);
+
+			A.height = 1 + std::max(other.height, move.height);
+			up.height = 1 + std::max(A.height, keep.height);
+
+			return indexUp;
+		};
+
+		if (balance > 1)
+			return Rotate(indexC, C, B, false);
+
+		if (balance < -1)
+			return Rotate(indexB, B, C, true);
+
+		return indexA;
+	}
+
+	void DynamicBVH::Refit(int index)
+	{
+		while (index >= 0)
+		{
+			index = Balance(index);
+
+			TreeNode &treeNode = m_TreeNodes[index];
+			const TreeNode &child1 = m_TreeNodes[treeNode.child1];
+			const TreeNode &child2 = m_TreeNodes[treeNode.child2];
+
+			treeNode.height = 1 + std::max(child1.height, child2.height);
+			treeNode.aabb = Combine(child1.aabb, child2.aabb);
+
+			index = treeNode.parent;
+		}
+	}
+
+	BoxBounds DynamicBVH::Combine(const BoxBounds &first, const BoxBounds &second)
+	{
+		Vector4 firstMin = first.GetMin(), firstMax = first.GetMax();
+		Vector4 secondMin = second.GetMin(), secondMax = second.GetMax();
+
+		return BoxBounds(
+			Vector4(std::min(firstMin.x, secondMin.x), std::min(firstMin.y, secondMin.y), std::min(firstMin.z, secondMin.z)), 
+			Vector4(std::max(firstMax.x, secondMax.x), std::max(firstMax.y, secondMax.y), std::max(firstMax.z, secondMax.z)));
+	}
+
+	float DynamicBVH::GetArea(const BoxBounds &aabb)
+	{
+		Vector4 size = aabb.GetSize();
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	float DynamicBVH::GetCombinedArea(const BoxBounds &first, const BoxBounds &second)
+	{
+		Vector4 firstMin = first.GetMin(), firstMax = first.GetMax();
+		Vector4 secondMin = second.GetMin(), secondMax = second.GetMax();
+
+		float x = std::max(firstMax.x, secondMax.x) - std::min(firstMin.x, secondMin.x);
+		float y = std::max(firstMax.y, secondMax.y) - std::min(firstMin.y, secondMin.y);
+		float z = std::max(firstMax.z, secondMax.z) - std::min(firstMin.z, secondMin.z);
+		return 2.0f * (x * y + y * z + z * x);
+	}
+
+	bool DynamicBVH::Contains(const BoxBounds &outer, const BoxBounds &inner)
+	{
+		Vector4 outerMin = outer.GetMin(), outerMax = outer.GetMax();
+		Vector4 innerMin = inner.GetMin(), innerMax = inner.GetMax();
+
+		return innerMin.x >= outerMin.x && innerMin.y >= outerMin.y && innerMin.z >= outerMin.z &&
+			innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+#ifndef _FURY_DYNAMIC_BVH_H_
+#define _FURY_DYNAMIC_BVH_H_
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/Frustum.h"
+#include "Fury/SceneManager.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	// Dynamic aabb tree, each leaf holds one scenenode with a fat aabb grown by margin, 
+	// a scenenode moving inside it's fat aabb costs nothing, otherwise it's leaf is 
+	// reinserted where it adds the least surface area, and ancestors are refit and 
+	// rotated on the way up to keep the tree balanced.
+	// Has no world bounds, works for scenes of any size or density.
+	// Scenenodes with infinite aabb are kept in a list and tested one by one.
+	// Holds a shared_ptr to attached scenenodes, see SceneNode::SetSceneManager.
+	class FURY_API DynamicBVH : public SceneManagerBase<DynamicBVH>
+	{
+	public:
+
+		typedef std::shared_ptr<DynamicBVH> Ptr;
+
+		static Ptr Create(float margin = 0.5f);
+
+		// balancing keeps height around 1.44 * log2(n), queries use a fixed-size stack, 
+		// deeper trees spill over to the heap.
+		static const unsigned int STACK_SIZE = 256;
+
+		// reinserted fat aabbs are stretched by this times the last movement.
+		static const float DISPLACEMENT_MULTIPLIER;
+
+	protected:
+
+		struct TreeNode
+		{
+			// fat for leafs, union of childs otherwise.
+			BoxBounds aabb;
+
+			int parent;
+
+			int child1;
+
+			int child2;
+
+			// leaf is 0, -1 if the tree node is free.
+			int height;
+
+			// leaf only
+			std::shared_ptr<SceneNode> sceneNode;
+
+			// scenenode's world aabb, leaf only.
+			BoxBounds sceneNodeAABB;
+		};
+
+		std::type_index m_TypeIndex;
+
+		std::vector<TreeNode> m_TreeNodes;
+
+		std::vector<int> m_FreeTreeNodes;
+
+		int m_Root;
+
+		float m_Margin;
+
+		unsigned int m_SceneNodeCount;
+
+		// scenenodes with infinite aabb, slot is the index.
+		std::vector<std::shared_ptr<SceneNode>> m_InfiniteNodes;
+
+		unsigned int m_UpdateMoveCount;
+
+		unsigned int m_UpdateSkipCount;
+
+	public:
+
+		DynamicBVH(float margin);
+
+		virtual ~DynamicBVH();
+
+		virtual std::type_index GetTypeIndex() const;
+
+		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		// only refreshes the cached aabb if it still fits the fat one.
+		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		// Non-virtual version of WalkScene.
+		// When collider is a Frustum, childs only test planes their parent straddles.
+		// visitor: void(const std::shared_ptr<SceneNode>&)
+		template<class Visitor>
+		void WalkSceneFast(const Collidable &collider, Visitor &&visitor) const;
+
+		virtual void Clear() override;
+
+		float GetMargin() const;
+
+		unsigned int GetSceneNodeCount() const;
+
+		unsigned int GetTreeNodeCount() const;
+
+		// 0 if empty, 1 if there's only one leaf.
+		unsigned int GetHeight() const;
+
+		// sum of internal tree nodes' surface area divided by root's, lower is better.
+		float GetAreaRatio() const;
+
+		// updates that reinserted a scenenode since last ResetStatistics.
+		unsigned int GetUpdateMoveCount() const;
+
+		// updates that stayed in the fat aabb since last ResetStatistics.
+		unsigned int GetUpdateSkipCount() const;
+
+		void ResetStatistics();
+
+	protected:
+
+		int AllocateTreeNode();
+
+		void FreeTreeNode(int index);
+
+		void InsertLeaf(int leaf);
+
+		void RemoveLeaf(int leaf);
+
+		// rotate index's subtree if it's unbalanced, returns the subtree's new root.
+		int Balance(int index);
+
+		// refit aabbs and heights from index up to root, balancing on the way.
+		void Refit(int index);
+
+		static BoxBounds Combine(const BoxBounds &first, const BoxBounds &second);
+
+		static float GetArea(const BoxBounds &aabb);
+
+		// area of Combine(first, second), without building it.
+		static float GetCombinedArea(const BoxBounds &first, const BoxBounds &second);
+
+		static bool Contains(const BoxBounds &outer, const BoxBounds &inner);
+	};
+
+	template<class Visitor>
+	void DynamicBVH::WalkSceneFast(const Collidable &collider, Visitor &&visitor) const
+	{
+		// planeMask holds the planes a tree node still needs to test, 0 means fully inside.
+		using TreeNodePair = std::pair<unsigned int, int>;
+
+		const Frustum *frustum = dynamic_cast<const Frustum*>(&collider);
+
+		for (const auto &sceneNode : m_InfiniteNodes)
+		{
+			if (collider.IsInsideFast(sceneNode->GetWorldAABB()))
+				visitor(sceneNode);
+		}
+
+		std::array<TreeNodePair, STACK_SIZE> possiblePairs;
+		std::vector<TreeNodePair> overflowPairs;
+		unsigned int top = 0;
+
+		auto Push = [&](unsigned int planeMask, int index)
+		{
+			if (top < STACK_SIZE)
+				possiblePairs[top++] = std::make_pair(planeMask, index);
+			else
+				overflowPairs.push_back(std::make_pair(planeMask, index));
+		};
+
+		if (m_Root >= 0)
+			Push(0x3Fu, m_Root);
+
+		while (top > 0 || !overflowPairs.empty())
+		{
+			// pop next possible node.
+			TreeNodePair pair;
+			if (overflowPairs.empty())
+			{
+				pair = possiblePairs[--top];
+			}
+			else
+			{
+				pair = overflowPairs.back();
+				overflowPairs.pop_back();
+			}
+
+			unsigned int planeMask = pair.first;
+			const TreeNode &treeNode = m_TreeNodes[pair.second];
+			bool isLeaf = treeNode.height == 0;
+
+			if (planeMask != 0)
+			{
+				// leafs test the scenenode's own aabb, not the fat one.
+				const BoxBounds &aabb = isLeaf ? treeNode.sceneNodeAABB : treeNode.aabb;
+
+				Side result = Side::STRADDLE;
+				if (frustum != nullptr)
+				{
+					result = IsInside(*frustum, aabb, planeMask);
+				}
+				else if (isLeaf)
+				{
+					result = collider.IsInsideFast(aabb) ? Side::IN : Side::OUT;
+				}
+				else
+				{
+					result = collider.IsInside(aabb);
+				}
+
+				if (result == Side::OUT)
+					continue;
+
+				if (result == Side::IN)
+					planeMask = 0;
+			}
+
+			if (isLeaf)
+			{
+				visitor(treeNode.sceneNode);
+				continue;
+			}
+
+			Push(planeMask, treeNode.child2);
+			Push(planeMask, treeNode.child1);
+		}
+	}
+}
+
+#endif // _FURY_DYNAMIC_BVH_H_
\ No newline at end of file
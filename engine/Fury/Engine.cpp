@@ -4,12 +4,15 @@
 #include "Fury/Engine.h"
 #include "Fury/FbxParser.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
 #include "Fury/Gui.h"
 #include "Fury/InputUtil.h"
 #include "Fury/Log.h"
+#include "Fury/MeshArena.h"
 #include "Fury/MeshUtil.h"
 #include "Fury/RenderUtil.h"
 #include "Fury/ThreadUtil.h"
+#include "Fury/UniformBuffer.h"
 #include "Fury/Vector4.h"
 
 namespace fury
@@ -44,6 +47,12 @@ namespace fury
 
 		int flag = gl::LoadGLFunctions();
 
+		GLStateCache::Initialize();
+
+		UniformBuffer::Initialize();
+
+		MeshArena::Initialize();
+
 		RenderUtil::Initialize();
 
 		BufferManager::Initialize();
@@ -178,7 +178,8 @@ namespace fury
 	{
 		std::make_pair(ShaderType::OTHER, "other"), 
 		std::make_pair(ShaderType::STATIC_MESH, "static_mesh"), 
-		std::make_pair(ShaderType::SKINNED_MESH, "skinned_mesh")
+		std::make_pair(ShaderType::SKINNED_MESH, "skinned_mesh"), 
+		std::make_pair(ShaderType::INSTANCED_MESH, "instanced_mesh")
 	};
 
 	const std::vector<std::pair<ShaderTexture, std::string>> EnumUtil::m_ShaderTexture =
@@ -196,6 +197,13 @@ namespace fury
 		GL_LINE_STRIP
 	};
 
+	const std::vector<std::pair<VertexFormat, std::string>> EnumUtil::m_VertexFormat =
+	{
+		std::make_pair(VertexFormat::SEPARATE, "separate"),
+		std::make_pair(VertexFormat::INTERLEAVED, "interleaved"),
+		std::make_pair(VertexFormat::QUANTIZED, "quantized")
+	};
+
 
 	std::string EnumUtil::ClearModeToString(ClearMode mode)
 	{
@@ -504,4 +512,19 @@ namespace fury
 	{
 		return m_LineMode[(unsigned int)mode];
 	}
+
+	std::string EnumUtil::VertexFormatToString(VertexFormat format)
+	{
+		return m_VertexFormat[(unsigned int)format].second;
+	}
+
+	VertexFormat EnumUtil::VertexFormatFromString(const std::string &name)
+	{
+		for (const auto &pair : m_VertexFormat)
+		{
+			if (pair.second == name)
+				return pair.first;
+		}
+		return VertexFormat::SEPARATE;
+	}
 }
\ No newline at end of file
@@ -138,7 +138,8 @@ namespace fury
 	{
 		OTHER = 0,
 		STATIC_MESH,
-		SKINNED_MESH
+		SKINNED_MESH,
+		INSTANCED_MESH
 	};
 
 	enum class ShaderTexture : unsigned int
@@ -156,6 +157,16 @@ namespace fury
 		LINE_STRIP
 	};
 
+	enum class VertexFormat : unsigned int
+	{
+		// one float buffer per attribute.
+		SEPARATE = 0,
+		// one buffer, compressed normals, tangents and uvs.
+		INTERLEAVED,
+		// INTERLEAVED with 16 bit positions.
+		QUANTIZED
+	};
+
 	class FURY_API EnumUtil final
 	{
 	private:
@@ -190,6 +201,8 @@ namespace fury
 
 		static const std::vector<unsigned int> m_LineMode;
 
+		static const std::vector<std::pair<VertexFormat, std::string>> m_VertexFormat;
+
 	public:
 
 		static std::string ClearModeToString(ClearMode mode);
@@ -279,6 +292,11 @@ namespace fury
 
 
 		static unsigned int LineModeToUnit(LineMode mode);
+
+
+		static std::string VertexFormatToString(VertexFormat format);
+
+		static VertexFormat VertexFormatFromString(const std::string &name);
 	};
 }
 
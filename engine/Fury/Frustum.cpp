@@ -1,12 +1,17 @@
 #include <cmath>
 
 #include "Fury/BoxBounds.h"
+#include "Fury/BoxBoundsArray.h"
 #include "Fury/Frustum.h"
 #include "Fury/Matrix4.h"
 #include "Fury/Plane.h"
 #include "Fury/SphereBounds.h"
 #include "Fury/Vector4.h"
 
+#if defined(FURY_SIMD_SSE)
+#include <immintrin.h>
+#endif
+
 namespace fury
 {
 	Frustum::Frustum(const Frustum &other)
@@ -165,6 +170,115 @@ namespace fury
 		return true;
 	}
 
+	unsigned int Frustum::IsInsideFast(const BoxBoundsArray &aabbs, unsigned int first, unsigned int count, 
+		unsigned char *visible, unsigned int planeMask) const
+	{
+		// an aabb is outside a plane when the distance of it's positive vertex is negative.
+		// dist(vertexP) = dot(n, center) + dot(abs(n), extents) + d
+		float nx[6], ny[6], nz[6], ax[6], ay[6], az[6], d[6];
+		int planeCount = 0;
+		for (int i = 0; i < 6; i++)
+		{
+			if ((planeMask & (1 << i)) == 0)
+				continue;
+
+			Vector4 normal = m_Planes[i].GetNormal();
+			nx[planeCount] = normal.x;
+			ny[planeCount] = normal.y;
+			nz[planeCount] = normal.z;
+			ax[planeCount] = std::fabs(normal.x);
+			ay[planeCount] = std::fabs(normal.y);
+			az[planeCount] = std::fabs(normal.z);
+			d[planeCount] = m_Planes[i].GetDistance();
+			planeCount++;
+		}
+
+		const float *cx = aabbs.GetCenterX() + first;
+		const float *cy = aabbs.GetCenterY() + first;
+		const float *cz = aabbs.GetCenterZ() + first;
+		const float *ex = aabbs.GetExtentX() + first;
+		const float *ey = aabbs.GetExtentY() + first;
+		const float *ez = aabbs.GetExtentZ() + first;
+
+		unsigned int visibleCount = 0;
+		unsigned int i = 0;
+
+#if defined(FURY_SIMD_AVX)
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 vcx = _mm256_loadu_ps(cx + i), vcy = _mm256_loadu_ps(cy + i), vcz = _mm256_loadu_ps(cz + i);
+			__m256 vex = _mm256_loadu_ps(ex + i), vey = _mm256_loadu_ps(ey + i), vez = _mm256_loadu_ps(ez + i);
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			for (int j = 0; j < planeCount; j++)
+			{
+				__m256 dist = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(vcx, _mm256_set1_ps(nx[j])), _mm256_mul_ps(vcy, _mm256_set1_ps(ny[j]))),
+					_mm256_add_ps(_mm256_mul_ps(vcz, _mm256_set1_ps(nz[j])), _mm256_set1_ps(d[j])));
+				dist = _mm256_add_ps(dist, _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(vex, _mm256_set1_ps(ax[j])), _mm256_mul_ps(vey, _mm256_set1_ps(ay[j]))),
+					_mm256_mul_ps(vez, _mm256_set1_ps(az[j]))));
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_GE_OQ));
+			}
+
+			int mask = _mm256_movemask_ps(inside);
+			for (int j = 0; j < 8; j++)
+			{
+				visible[i + j] = (mask >> j) & 1;
+				visibleCount += visible[i + j];
+			}
+		}
+#endif
+
+#if defined(FURY_SIMD_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 vcx = _mm_loadu_ps(cx + i), vcy = _mm_loadu_ps(cy + i), vcz = _mm_loadu_ps(cz + i);
+			__m128 vex = _mm_loadu_ps(ex + i), vey = _mm_loadu_ps(ey + i), vez = _mm_loadu_ps(ez + i);
+			__m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+
+			for (int j = 0; j < planeCount; j++)
+			{
+				__m128 dist = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(vcx, _mm_set1_ps(nx[j])), _mm_mul_ps(vcy, _mm_set1_ps(ny[j]))),
+					_mm_add_ps(_mm_mul_ps(vcz, _mm_set1_ps(nz[j])), _mm_set1_ps(d[j])));
+				dist = _mm_add_ps(dist, _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(vex, _mm_set1_ps(ax[j])), _mm_mul_ps(vey, _mm_set1_ps(ay[j]))),
+					_mm_mul_ps(vez, _mm_set1_ps(az[j]))));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, _mm_setzero_ps()));
+			}
+
+			int mask = _mm_movemask_ps(inside);
+			for (int j = 0; j < 4; j++)
+			{
+				visible[i + j] = (mask >> j) & 1;
+				visibleCount += visible[i + j];
+			}
+		}
+#endif
+
+		// scalar path for the remaining aabbs.
+		for (; i < count; i++)
+		{
+			unsigned char inside = 1;
+			for (int j = 0; j < planeCount && inside; j++)
+			{
+				float dist = cx[i] * nx[j] + cy[i] * ny[j] + cz[i] * nz[j] + d[j] + 
+					ex[i] * ax[j] + ey[i] * ay[j] + ez[i] * az[j];
+				inside = dist >= 0.0f ? 1 : 0;
+			}
+			visible[i] = inside;
+			visibleCount += inside;
+		}
+
+		return visibleCount;
+	}
+
+	const Plane &Frustum::GetPlane(unsigned int index) const
+	{
+		return m_Planes[index];
+	}
+
 	std::array<Vector4, 8> Frustum::GetCurrentCorners() const
 	{
 		return m_CurrentCorners;
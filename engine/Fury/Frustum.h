@@ -11,6 +11,8 @@ namespace fury
 {
 	class BoxBounds;
 
+	class BoxBoundsArray;
+
 	class SphereBounds;
 
 	class FURY_API Frustum : public Collidable
@@ -52,6 +54,16 @@ namespace fury
 
 		virtual bool IsInsideFast(Vector4 point) const;
 
+		// batch version of IsInsideFast(aabb), tests aabbs in [first, first + count).
+		// writes 1 to visible[i - first] if aabb i is visible, 0 otherwise.
+		// only planes whose bit is set in planeMask are tested.
+		// uses sse/avx when available, returns the number of visible aabbs.
+		unsigned int IsInsideFast(const BoxBoundsArray &aabbs, unsigned int first, unsigned int count, 
+			unsigned char *visible, unsigned int planeMask = 0x3F) const;
+
+		// top, bottom, left, right, near, far
+		const Plane &GetPlane(unsigned int index) const;
+
 		// ntl, ntr, nbl, nbr, ftl, ftr, fbl, fbr
 		std::array<Vector4, 8> GetCurrentCorners() const;
 
@@ -4,29 +4,40 @@
 #include "Fury/AnimationClip.h"
 #include "Fury/AnimationPlayer.h"
 #include "Fury/AnimationUtil.h"
+#include "Fury/ArenaAllocator.h"
 #include "Fury/ArrayBuffers.h"
 #include "Fury/BoxBounds.h"
+#include "Fury/BoxBoundsArray.h"
 #include "Fury/Buffer.h"
 #include "Fury/BufferManager.h"
 #include "Fury/Camera.h"
 #include "Fury/Component.h"
 #include "Fury/Color.h"
 #include "Fury/Collidable.h"
+#include "Fury/CommandBuffer.h"
+#include "Fury/CommandExecutor.h"
+#include "Fury/DynamicBVH.h"
 #include "Fury/Engine.h"
 #include "Fury/Entity.h"
 #include "Fury/EntityManager.h"
 #include "Fury/FileUtil.h"
 #include "Fury/FbxParser.h"
 #include "Fury/Frustum.h"
+#include "Fury/GLStateCache.h"
 #include "Fury/Gui.h"
+#include "Fury/IndirectBatcher.h"
 #include "Fury/InputUtil.h"
+#include "Fury/InstanceBatcher.h"
 #include "Fury/Joint.h"
 #include "Fury/Light.h"
+#include "Fury/LinearOcTree.h"
 #include "Fury/Log.h"
+#include "Fury/LooseOcTree.h"
 #include "Fury/MathUtil.h"
 #include "Fury/Material.h"
 #include "Fury/Matrix4.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshArena.h"
 #include "Fury/MeshRender.h"
 #include "Fury/MeshUtil.h"
 #include "Fury/OcTree.h"
@@ -45,11 +56,16 @@
 #include "Fury/Shader.h"
 #include "Fury/Singleton.h"
 #include "Fury/SphereBounds.h"
+#include "Fury/TaskGraph.h"
 #include "Fury/Texture.h"
 #include "Fury/ThreadUtil.h"
 #include "Fury/Transform.h"
+#include "Fury/TransformStore.h"
 #include "Fury/TypeComparable.h"
 #include "Fury/Uniform.h"
+#include "Fury/UniformBuffer.h"
 #include "Fury/Vector4.h"
+#include "Fury/VertexPacker.h"
+#include "Fury/WorkStealingQueue.h"
 
 #endif // _FURY_FURY_H_
\ No newline at end of file
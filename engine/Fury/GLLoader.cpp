@@ -445,6 +445,20 @@ void (CODEGEN_FUNCPTR *_ptrc_glTexStorage1D)(GLenum target, GLsizei levels, GLen
 void (CODEGEN_FUNCPTR *_ptrc_glTexStorage2D)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height) = NULL;
 void (CODEGEN_FUNCPTR *_ptrc_glTexStorage3D)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth) = NULL;
 
+void (CODEGEN_FUNCPTR *_ptrc_glMultiDrawElementsIndirect)(GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride) = NULL;
+
+int ogl_ext_ARB_base_instance = 0;
+int ogl_ext_ARB_draw_indirect = 0;
+int ogl_ext_ARB_multi_draw_indirect = 0;
+
+static int Load_ARB_multi_draw_indirect(void)
+{
+	int numFailed = 0;
+	_ptrc_glMultiDrawElementsIndirect = (void (CODEGEN_FUNCPTR *)(GLenum, GLenum, const void *, GLsizei, GLsizei))IntGetProcAddress("glMultiDrawElementsIndirect");
+	if (!_ptrc_glMultiDrawElementsIndirect) numFailed++;
+	return numFailed;
+}
+
 static int Load_Version_3_3(void)
 {
 	int numFailed = 0;
@@ -1155,11 +1169,13 @@ typedef struct ogl_StrToExtMap_s
 	PFN_LOADFUNCPOINTERS LoadExtension;
 } ogl_StrToExtMap;
 
-static ogl_StrToExtMap ExtensionMap[1] = {
-	{"", NULL, NULL}
+static ogl_StrToExtMap ExtensionMap[3] = {
+	{"GL_ARB_base_instance", &ogl_ext_ARB_base_instance, NULL},
+	{"GL_ARB_draw_indirect", &ogl_ext_ARB_draw_indirect, NULL},
+	{"GL_ARB_multi_draw_indirect", &ogl_ext_ARB_multi_draw_indirect, Load_ARB_multi_draw_indirect},
 };
 
-static int g_extensionMapSize = 0;
+static int g_extensionMapSize = 3;
 
 static ogl_StrToExtMap *FindExtEntry(const char *extensionName)
 {
@@ -1176,6 +1192,9 @@ static ogl_StrToExtMap *FindExtEntry(const char *extensionName)
 
 static void ClearExtensionVars(void)
 {
+	ogl_ext_ARB_base_instance = 0;
+	ogl_ext_ARB_draw_indirect = 0;
+	ogl_ext_ARB_multi_draw_indirect = 0;
 }
 
 static void LoadExtByName(const char *extensionName)
@@ -1228,6 +1247,10 @@ int gl::LoadGLFunctions()
 	
 	ProcExtsFromExtList();
 	numFailed = Load_Version_3_3();
+
+	// core since 4.3, drivers don't always list it as an extension.
+	if (!_ptrc_glMultiDrawElementsIndirect)
+		Load_ARB_multi_draw_indirect();
 	
 	if(numFailed == 0)
 		return 1;
@@ -1269,3 +1292,15 @@ int gl::IsVersionGEQ(int majorVersion, int minorVersion)
 	return 0;
 }
 
+int gl::IsMultiDrawIndirectSupported(void)
+{
+	if (!_ptrc_glMultiDrawElementsIndirect)
+		return 0;
+
+	// baseInstance is reserved in the indirect command without 4.2 / ARB_base_instance.
+	if (IsVersionGEQ(4, 3))
+		return 1;
+
+	return ogl_ext_ARB_multi_draw_indirect == 1 && ogl_ext_ARB_draw_indirect == 1 &&
+		(ogl_ext_ARB_base_instance == 1 || IsVersionGEQ(4, 2));
+}
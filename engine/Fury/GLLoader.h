@@ -152,6 +152,13 @@ typedef GLintptr GLvdpauSurfaceNV;
 extern "C" {
 #endif /*__cplusplus*/
 
+extern int ogl_ext_ARB_base_instance;
+extern int ogl_ext_ARB_draw_indirect;
+extern int ogl_ext_ARB_multi_draw_indirect;
+
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#define GL_DRAW_INDIRECT_BUFFER_BINDING 0x8F43
+
 #define GL_ALPHA 0x1906
 #define GL_ALWAYS 0x0207
 #define GL_AND 0x1501
@@ -1687,6 +1694,9 @@ extern "C" {
 	extern void (CODEGEN_FUNCPTR *_ptrc_glTexStorage3D)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth);
 #define glTexStorage3D _ptrc_glTexStorage3D
 
+	extern void (CODEGEN_FUNCPTR *_ptrc_glMultiDrawElementsIndirect)(GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride);
+#define glMultiDrawElementsIndirect _ptrc_glMultiDrawElementsIndirect
+
 namespace gl
 {
 	int LoadGLFunctions();
@@ -1694,6 +1704,9 @@ namespace gl
 	int GetMinorVersion(void);
 	int GetMajorVersion(void);
 	int IsVersionGEQ(int majorVersion, int minorVersion);
+
+	// glMultiDrawElementsIndirect with a usable baseInstance field.
+	int IsMultiDrawIndirectSupported(void);
 }
 
 #ifdef __cplusplus
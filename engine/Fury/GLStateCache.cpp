@@ -0,0 +1,305 @@
+#include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
+
+namespace fury
+{
+	namespace
+	{
+		const unsigned int UNKNOWN = 0xFFFFFFFF;
+
+		// order of GLStateCache::m_Caps.
+		const unsigned int CACHED_CAPS[] = 
+		{
+			GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST, GL_FRAMEBUFFER_SRGB, GL_POLYGON_OFFSET_FILL
+		};
+
+		// order of GLStateCache::m_Textures.
+		const unsigned int CACHED_TEXTURE_TARGETS[] = 
+		{
+			GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP
+		};
+
+		// gl functions are loaded at runtime, so wrap them instead of taking their address.
+		void GLEnable(unsigned int cap) { glEnable(cap); }
+		void GLDisable(unsigned int cap) { glDisable(cap); }
+		void GLUseProgram(unsigned int program) { glUseProgram(program); }
+		void GLBindVertexArray(unsigned int vao) { glBindVertexArray(vao); }
+		void GLBindFramebuffer(unsigned int target, unsigned int framebuffer) { glBindFramebuffer(target, framebuffer); }
+		void GLActiveTexture(unsigned int unit) { glActiveTexture(unit); }
+		void GLBindTexture(unsigned int target, unsigned int texture) { glBindTexture(target, texture); }
+		void GLViewport(int x, int y, int width, int height) { glViewport(x, y, width, height); }
+		void GLDepthFunc(unsigned int func) { glDepthFunc(func); }
+		void GLDepthMask(unsigned char flag) { glDepthMask(flag); }
+		void GLBlendFunc(unsigned int src, unsigned int dest) { glBlendFunc(src, dest); }
+		void GLBlendEquation(unsigned int mode) { glBlendEquation(mode); }
+		void GLCullFace(unsigned int mode) { glCullFace(mode); }
+	}
+
+	const unsigned int GLStateCache::MAX_TEXTURE_UNITS;
+
+	GLFunctions GLStateCache::GetGLFunctions()
+	{
+		GLFunctions functions;
+		functions.Enable = GLEnable;
+		functions.Disable = GLDisable;
+		functions.UseProgram = GLUseProgram;
+		functions.BindVertexArray = GLBindVertexArray;
+		functions.BindFramebuffer = GLBindFramebuffer;
+		functions.ActiveTexture = GLActiveTexture;
+		functions.BindTexture = GLBindTexture;
+		functions.Viewport = GLViewport;
+		functions.DepthFunc = GLDepthFunc;
+		functions.DepthMask = GLDepthMask;
+		functions.BlendFunc = GLBlendFunc;
+		functions.BlendEquation = GLBlendEquation;
+		functions.CullFace = GLCullFace;
+		return functions;
+	}
+
+	void GLStateCache::ForgetProgram(unsigned int program)
+	{
+		if (m_Instance != nullptr && m_Instance->m_Program == program)
+			m_Instance->m_Program = UNKNOWN;
+	}
+
+	void GLStateCache::ForgetVertexArray(unsigned int vao)
+	{
+		if (m_Instance != nullptr && m_Instance->m_VAO == vao)
+			m_Instance->m_VAO = UNKNOWN;
+	}
+
+	void GLStateCache::ForgetFramebuffer(unsigned int framebuffer)
+	{
+		if (m_Instance != nullptr && m_Instance->m_Framebuffer == framebuffer)
+			m_Instance->m_Framebuffer = UNKNOWN;
+	}
+
+	void GLStateCache::ForgetTexture(unsigned int texture)
+	{
+		if (m_Instance == nullptr)
+			return;
+
+		for (auto &unit : m_Instance->m_Textures)
+		{
+			for (auto &bound : unit)
+			{
+				if (bound == texture)
+					bound = UNKNOWN;
+			}
+		}
+	}
+
+	GLStateCache::GLStateCache() : GLStateCache(GetGLFunctions())
+	{
+
+	}
+
+	GLStateCache::GLStateCache(const GLFunctions &functions) : m_Functions(functions)
+	{
+		Invalidate();
+	}
+
+	void GLStateCache::SetFunctions(const GLFunctions &functions)
+	{
+		m_Functions = functions;
+		Invalidate();
+	}
+
+	void GLStateCache::Invalidate()
+	{
+		m_Caps.fill(-1);
+		m_Program = m_VAO = m_Framebuffer = m_ActiveTexture = UNKNOWN;
+
+		for (auto &unit : m_Textures)
+			unit.fill(UNKNOWN);
+
+		m_Viewport.fill(-1);
+		m_DepthFunc = UNKNOWN;
+		m_DepthMask = -1;
+		m_BlendSrc = m_BlendDest = m_BlendEquation = UNKNOWN;
+		m_CullFace = UNKNOWN;
+	}
+
+	void GLStateCache::Enable(unsigned int cap)
+	{
+		SetEnabled(cap, true);
+	}
+
+	void GLStateCache::Disable(unsigned int cap)
+	{
+		SetEnabled(cap, false);
+	}
+
+	void GLStateCache::SetEnabled(unsigned int cap, bool enabled)
+	{
+		int index = GetCapIndex(cap);
+		int state = enabled ? 1 : 0;
+
+		if (!Filter(index < 0 || m_Caps[index] != state))
+			return;
+
+		if (index >= 0)
+			m_Caps[index] = state;
+
+		if (enabled)
+			m_Functions.Enable(cap);
+		else
+			m_Functions.Disable(cap);
+	}
+
+	void GLStateCache::UseProgram(unsigned int program)
+	{
+		if (!Filter(m_Program != program))
+			return;
+
+		m_Program = program;
+		m_Functions.UseProgram(program);
+	}
+
+	void GLStateCache::BindVertexArray(unsigned int vao)
+	{
+		if (!Filter(m_VAO != vao))
+			return;
+
+		m_VAO = vao;
+		m_Functions.BindVertexArray(vao);
+	}
+
+	void GLStateCache::BindFramebuffer(unsigned int framebuffer)
+	{
+		if (!Filter(m_Framebuffer != framebuffer))
+			return;
+
+		m_Framebuffer = framebuffer;
+		m_Functions.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	}
+
+	void GLStateCache::ActiveTexture(unsigned int unit)
+	{
+		if (!Filter(m_ActiveTexture != unit))
+			return;
+
+		m_ActiveTexture = unit;
+		m_Functions.ActiveTexture(unit);
+	}
+
+	void GLStateCache::BindTexture(unsigned int target, unsigned int texture)
+	{
+		unsigned int unit = m_ActiveTexture - GL_TEXTURE0;
+		int index = GetTextureTargetIndex(target);
+		bool cached = index >= 0 && unit < MAX_TEXTURE_UNITS;
+
+		if (!Filter(!cached || m_Textures[unit][index] != texture))
+			return;
+
+		if (cached)
+			m_Textures[unit][index] = texture;
+
+		m_Functions.BindTexture(target, texture);
+	}
+
+	void GLStateCache::Viewport(int x, int y, int width, int height)
+	{
+		if (!Filter(m_Viewport[0] != x || m_Viewport[1] != y || m_Viewport[2] != width || m_Viewport[3] != height))
+			return;
+
+		m_Viewport[0] = x;
+		m_Viewport[1] = y;
+		m_Viewport[2] = width;
+		m_Viewport[3] = height;
+		m_Functions.Viewport(x, y, width, height);
+	}
+
+	void GLStateCache::DepthFunc(unsigned int func)
+	{
+		if (!Filter(m_DepthFunc != func))
+			return;
+
+		m_DepthFunc = func;
+		m_Functions.DepthFunc(func);
+	}
+
+	void GLStateCache::DepthMask(bool flag)
+	{
+		int state = flag ? 1 : 0;
+		if (!Filter(m_DepthMask != state))
+			return;
+
+		m_DepthMask = state;
+		m_Functions.DepthMask(flag ? GL_TRUE : GL_FALSE);
+	}
+
+	void GLStateCache::BlendFunc(unsigned int src, unsigned int dest)
+	{
+		if (!Filter(m_BlendSrc != src || m_BlendDest != dest))
+			return;
+
+		m_BlendSrc = src;
+		m_BlendDest = dest;
+		m_Functions.BlendFunc(src, dest);
+	}
+
+	void GLStateCache::BlendEquation(unsigned int mode)
+	{
+		if (!Filter(m_BlendEquation != mode))
+			return;
+
+		m_BlendEquation = mode;
+		m_Functions.BlendEquation(mode);
+	}
+
+	void GLStateCache::CullFace(unsigned int mode)
+	{
+		if (!Filter(m_CullFace != mode))
+			return;
+
+		m_CullFace = mode;
+		m_Functions.CullFace(mode);
+	}
+
+	unsigned int GLStateCache::GetIssuedCount() const
+	{
+		return m_IssuedCount;
+	}
+
+	unsigned int GLStateCache::GetSkippedCount() const
+	{
+		return m_SkippedCount;
+	}
+
+	void GLStateCache::ResetCounters()
+	{
+		m_IssuedCount = 0;
+		m_SkippedCount = 0;
+	}
+
+	bool GLStateCache::Filter(bool changed)
+	{
+		if (changed)
+			m_IssuedCount++;
+		else
+			m_SkippedCount++;
+
+		return changed;
+	}
+
+	int GLStateCache::GetCapIndex(unsigned int cap) const
+	{
+		for (int i = 0; i < (int)m_Caps.size(); i++)
+		{
+			if (CACHED_CAPS[i] == cap)
+				return i;
+		}
+		return -1;
+	}
+
+	int GLStateCache::GetTextureTargetIndex(unsigned int target) const
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			if (CACHED_TEXTURE_TARGETS[i] == target)
+				return i;
+		}
+		return -1;
+	}
+}
\ No newline at end of file
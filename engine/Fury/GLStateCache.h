@@ -0,0 +1,163 @@
+#ifndef _FURY_GLSTATECACHE_H_
+#define _FURY_GLSTATECACHE_H_
+
+#include <array>
+#include <memory>
+
+#include "Fury/Singleton.h"
+
+namespace fury
+{
+	// gl entry points used by GLStateCache,
+	// tests can swap them for fake ones to run without a context.
+	struct FURY_API GLFunctions
+	{
+		void(*Enable)(unsigned int cap);
+
+		void(*Disable)(unsigned int cap);
+
+		void(*UseProgram)(unsigned int program);
+
+		void(*BindVertexArray)(unsigned int vao);
+
+		void(*BindFramebuffer)(unsigned int target, unsigned int framebuffer);
+
+		void(*ActiveTexture)(unsigned int unit);
+
+		void(*BindTexture)(unsigned int target, unsigned int texture);
+
+		void(*Viewport)(int x, int y, int width, int height);
+
+		void(*DepthFunc)(unsigned int func);
+
+		void(*DepthMask)(unsigned char flag);
+
+		void(*BlendFunc)(unsigned int src, unsigned int dest);
+
+		void(*BlendEquation)(unsigned int mode);
+
+		void(*CullFace)(unsigned int mode);
+	};
+
+	// Remembers bound objects and fixed function states, and drops calls that change nothing.
+	// Every state it tracks should be changed through it,
+	// code that calls gl directly must call Invalidate afterwards.
+	// A state is unknown until first set, so the first call always goes to gl.
+	class FURY_API GLStateCache final : public Singleton<GLStateCache>
+	{
+	public:
+
+		typedef std::shared_ptr<GLStateCache> Ptr;
+
+		// texture units tracked, binds on higher units are always issued.
+		static const unsigned int MAX_TEXTURE_UNITS = 16;
+
+		// the real gl functions, only callable after gl::LoadGLFunctions.
+		static GLFunctions GetGLFunctions();
+
+		// deleted gl names may be reused, these make sure the next bind is issued.
+		static void ForgetProgram(unsigned int program);
+
+		static void ForgetVertexArray(unsigned int vao);
+
+		static void ForgetFramebuffer(unsigned int framebuffer);
+
+		static void ForgetTexture(unsigned int texture);
+
+	private:
+
+		GLFunctions m_Functions;
+
+		unsigned int m_IssuedCount = 0;
+
+		unsigned int m_SkippedCount = 0;
+
+		// -1 is unknown.
+		std::array<int, 6> m_Caps;
+
+		unsigned int m_Program;
+
+		unsigned int m_VAO;
+
+		unsigned int m_Framebuffer;
+
+		unsigned int m_ActiveTexture;
+
+		// [unit][2d, 2d array, cube map]
+		std::array<std::array<unsigned int, 3>, MAX_TEXTURE_UNITS> m_Textures;
+
+		std::array<int, 4> m_Viewport;
+
+		unsigned int m_DepthFunc;
+
+		int m_DepthMask;
+
+		unsigned int m_BlendSrc;
+
+		unsigned int m_BlendDest;
+
+		unsigned int m_BlendEquation;
+
+		unsigned int m_CullFace;
+
+	public:
+
+		GLStateCache();
+
+		GLStateCache(const GLFunctions &functions);
+
+		void SetFunctions(const GLFunctions &functions);
+
+		// forget all states, call after gl states are changed elsewhere.
+		void Invalidate();
+
+		void Enable(unsigned int cap);
+
+		void Disable(unsigned int cap);
+
+		void SetEnabled(unsigned int cap, bool enabled);
+
+		void UseProgram(unsigned int program);
+
+		void BindVertexArray(unsigned int vao);
+
+		// binds to GL_FRAMEBUFFER.
+		void BindFramebuffer(unsigned int framebuffer);
+
+		// GL_TEXTURE0 + index.
+		void ActiveTexture(unsigned int unit);
+
+		// binds to the active texture unit.
+		void BindTexture(unsigned int target, unsigned int texture);
+
+		void Viewport(int x, int y, int width, int height);
+
+		void DepthFunc(unsigned int func);
+
+		void DepthMask(bool flag);
+
+		void BlendFunc(unsigned int src, unsigned int dest);
+
+		void BlendEquation(unsigned int mode);
+
+		void CullFace(unsigned int mode);
+
+		// calls that reached gl since ResetCounters.
+		unsigned int GetIssuedCount() const;
+
+		// calls dropped since ResetCounters.
+		unsigned int GetSkippedCount() const;
+
+		void ResetCounters();
+
+	private:
+
+		bool Filter(bool changed);
+
+		int GetCapIndex(unsigned int cap) const;
+
+		int GetTextureTargetIndex(unsigned int target) const;
+	};
+}
+
+#endif // _FURY_GLSTATECACHE_H_
\ No newline at end of file
@@ -16,8 +16,10 @@
 #include "Fury/EntityManager.h"
 #include "Fury/Frustum.h"
 #include "Fury/InputUtil.h"
+#include "Fury/MeshArena.h"
 #include "Fury/Gui.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
 #include "Fury/Pipeline.h"
 #include "Fury/RenderUtil.h"
 
@@ -163,6 +165,7 @@ namespace fury
 			glBindVertexArray(0);
 
 			m_Shader->UnBind();
+			GLStateCache::Instance()->Invalidate();
 
 			return true;
 		}
@@ -171,6 +174,7 @@ namespace fury
 		{
 			if (m_VAO != 0)
 			{
+				GLStateCache::ForgetVertexArray(m_VAO);
 				glDeleteVertexArrays(1, &m_VAO);
 				m_VAO = 0;
 			}
@@ -185,6 +189,7 @@ namespace fury
 
 			if (m_FontTexture)
 			{
+				GLStateCache::ForgetTexture(m_FontTexture);
 				glDeleteTextures(1, &m_FontTexture);
 				ImGui::GetIO().Fonts->TexID = 0;
 				m_FontTexture = 0;
@@ -283,6 +288,9 @@ namespace fury
 			if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
 			if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
 			glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
+
+			// gl states were changed behind the cache.
+			GLStateCache::Instance()->Invalidate();
 		}
 
 		void HandleEvent(sf::Event &event)
@@ -428,6 +436,11 @@ namespace fury
 
 			ImGui::Text("CPU Mem: %u mb", BufferManager::Instance()->GetMemoryInMegaByte(false));
 			ImGui::Text("GPU Mem: %u mb", BufferManager::Instance()->GetMemoryInMegaByte(true));
+			ImGui::Text("Index Mem: %u kb (16 bit saved %u kb)", IndexBuffer::GetGlobalBytes() / 1000, 
+				IndexBuffer::GetGlobalSavedBytes() / 1000);
+			ImGui::Text("Arena Vertices: %u/%u Indices: %u/%u", MeshArena::Instance()->GetVertexCount(), 
+				MeshArena::Instance()->GetVertexCapacity(), MeshArena::Instance()->GetIndexCount(), 
+				MeshArena::Instance()->GetIndexCapacity());
 
 			ImGui::Separator();
 
@@ -436,6 +449,16 @@ namespace fury
 			ImGui::Text("Mesh: %i", RenderUtil::Instance()->GetMeshCount());
 			ImGui::Text("SkinnedMesh: %i", RenderUtil::Instance()->GetSkinnedMeshCount());
 			ImGui::Text("Light: %i", RenderUtil::Instance()->GetLightCount());
+			ImGui::Text("Shader/Material/Mesh Binds: %i/%i/%i", RenderUtil::Instance()->GetShaderBindCount(),
+				RenderUtil::Instance()->GetMaterialBindCount(), RenderUtil::Instance()->GetMeshBindCount());
+			ImGui::Text("GL States Issued/Skipped: %i/%i", RenderUtil::Instance()->GetIssuedStateCount(),
+				RenderUtil::Instance()->GetSkippedStateCount());
+			ImGui::Text("Uniform Blocks Uploaded/Reused: %i/%i", RenderUtil::Instance()->GetUniformBlockUploadCount(),
+				RenderUtil::Instance()->GetUniformBlockReuseCount());
+			ImGui::Text("Plane Tests/Cache Hits: %i/%i", RenderUtil::Instance()->GetPlaneTestCount(),
+				RenderUtil::Instance()->GetPlaneCacheHitCount());
+			ImGui::Text("Node Updates Moved/Skipped: %i/%i", RenderUtil::Instance()->GetUpdateMoveCount(),
+				RenderUtil::Instance()->GetUpdateSkipCount());
 
 			// switches
 			{
@@ -455,6 +478,10 @@ namespace fury
 				ImGui::Checkbox("Use Cascaded Shadow Map", &use_csm);
 				Pipeline::Active->SetSwitch(PipelineSwitch::CASCADED_SHADOW_MAP, use_csm);
 
+				static bool use_instancing = true;
+				ImGui::Checkbox("Use Instancing", &use_instancing);
+				Pipeline::Active->SetSwitch(PipelineSwitch::INSTANCING, use_instancing);
+
 				ImGui::Separator();
 
 				ImGui::Checkbox("Show GBuffer Window", &showGBufferWindow);
@@ -0,0 +1,296 @@
+#include <algorithm>
+
+#include "Fury/IndirectBatcher.h"
+#include "Fury/GLLoader.h"
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+
+namespace fury
+{
+	const unsigned int IndirectBatcher::COMMAND_SIZE = 5;
+
+	IndirectBatcher::Ptr IndirectBatcher::Create(unsigned int minDraws)
+	{
+		return std::make_shared<IndirectBatcher>(minDraws);
+	}
+
+	IndirectBatcher::IndirectBatcher(unsigned int minDraws) : 
+		m_MinDraws(minDraws < 2 ? 2 : minDraws), m_MatrixCount(0),
+		Matrices("instance_matrix", GL_ARRAY_BUFFER, GL_STREAM_DRAW), 
+		Commands("draw_commands", GL_DRAW_INDIRECT_BUFFER, GL_STREAM_DRAW)
+	{
+
+	}
+
+	void IndirectBatcher::Build(const std::vector<RenderUnit> &units)
+	{
+		Clear();
+
+		unsigned int count = units.size();
+		unsigned int first = 0;
+		while (first < count)
+		{
+			const auto &unit = units[first];
+
+			unsigned int last = first + 1;
+			if (!unit.mesh->IsSkinnedMesh() && unit.mesh->IsInArena())
+			{
+				while (last < count && units[last].material == unit.material && 
+					!units[last].mesh->IsSkinnedMesh() && units[last].mesh->IsInArena())
+					last++;
+			}
+
+			unsigned int runSize = last - first;
+			if (runSize >= m_MinDraws)
+			{
+				IndirectBatch batch;
+				batch.first = first;
+				batch.count = runSize;
+				batch.commandOffset = GetCommandCount();
+
+				for (unsigned int i = first; i < last; i++)
+				{
+					const auto &current = units[i];
+					auto range = current.mesh->GetSubMeshCount() > 0 ? 
+						current.mesh->GetDrawRange(current.subMesh) : current.mesh->GetDrawRange();
+					AddDraw(batch, current.node, current.material, range);
+				}
+
+				m_Batches.push_back(batch);
+			}
+			else
+			{
+				for (unsigned int i = first; i < last; i++)
+				{
+					IndirectBatch batch;
+					batch.first = i;
+					batch.count = 1;
+					m_Batches.push_back(batch);
+				}
+			}
+
+			first = last;
+		}
+
+		Matrices.SetDirty();
+		Commands.SetDirty();
+	}
+
+	void IndirectBatcher::Build(const std::vector<std::vector<std::shared_ptr<SceneNode>>> &casters)
+	{
+		Clear();
+
+		std::vector<unsigned int> arenaCasters;
+		std::vector<unsigned int> otherCasters;
+		std::vector<std::shared_ptr<MeshRender>> arenaRenders;
+
+		for (unsigned int group = 0; group < casters.size(); group++)
+		{
+			const auto &nodes = casters[group];
+
+			arenaCasters.clear();
+			otherCasters.clear();
+			arenaRenders.clear();
+
+			for (unsigned int i = 0; i < nodes.size(); i++)
+			{
+				auto render = nodes[i]->GetComponent<MeshRender>();
+				if (render->GetMesh()->IsInArena())
+				{
+					arenaCasters.push_back(i);
+					arenaRenders.push_back(render);
+				}
+				else
+				{
+					otherCasters.push_back(i);
+				}
+			}
+
+			if (arenaCasters.size() >= m_MinDraws)
+			{
+				IndirectBatch batch;
+				batch.first = arenaCasters.front();
+				batch.count = arenaCasters.size();
+				batch.group = group;
+				batch.commandOffset = GetCommandCount();
+
+				for (unsigned int i = 0; i < arenaCasters.size(); i++)
+				{
+					const auto &render = arenaRenders[i];
+					AddDraw(batch, nodes[arenaCasters[i]], render->GetMaterial(), render->GetMesh()->GetDrawRange());
+				}
+
+				m_Batches.push_back(batch);
+			}
+			else
+			{
+				otherCasters.insert(otherCasters.end(), arenaCasters.begin(), arenaCasters.end());
+			}
+
+			for (auto i : otherCasters)
+			{
+				IndirectBatch batch;
+				batch.first = i;
+				batch.count = 1;
+				batch.group = group;
+				m_Batches.push_back(batch);
+			}
+		}
+
+		Matrices.SetDirty();
+		Commands.SetDirty();
+	}
+
+	void IndirectBatcher::Clear()
+	{
+		m_Batches.clear();
+		m_DrawData.clear();
+		m_Materials.clear();
+		m_MaterialIndices.clear();
+		m_MatrixCount = 0;
+		Matrices.Data.clear();
+		Commands.Data.clear();
+	}
+
+	const std::vector<IndirectBatch> &IndirectBatcher::GetBatches() const
+	{
+		return m_Batches;
+	}
+
+	unsigned int IndirectBatcher::GetBatchCount() const
+	{
+		return m_Batches.size();
+	}
+
+	unsigned int IndirectBatcher::GetIndirectBatchCount() const
+	{
+		unsigned int count = 0;
+		for (const auto &batch : m_Batches)
+		{
+			if (batch.IsIndirect())
+				count++;
+		}
+		return count;
+	}
+
+	unsigned int IndirectBatcher::GetCommandCount() const
+	{
+		return Commands.Data.size() / COMMAND_SIZE;
+	}
+
+	DrawElementsIndirectCommand IndirectBatcher::GetCommand(unsigned int index) const
+	{
+		const unsigned int *src = &Commands.Data[index * COMMAND_SIZE];
+
+		DrawElementsIndirectCommand command;
+		command.count = src[0];
+		command.instanceCount = src[1];
+		command.firstIndex = src[2];
+		command.baseVertex = (int)src[3];
+		command.baseInstance = src[4];
+		return command;
+	}
+
+	unsigned int IndirectBatcher::GetIndexCount(const IndirectBatch &batch) const
+	{
+		unsigned int count = 0;
+		for (unsigned int i = 0; i < batch.commandCount; i++)
+		{
+			const unsigned int *src = &Commands.Data[(batch.commandOffset + i) * COMMAND_SIZE];
+			count += src[0] * src[1];
+		}
+		return count;
+	}
+
+	const std::vector<IndirectDrawData> &IndirectBatcher::GetDrawData() const
+	{
+		return m_DrawData;
+	}
+
+	const std::vector<std::shared_ptr<Material>> &IndirectBatcher::GetMaterials() const
+	{
+		return m_Materials;
+	}
+
+	unsigned int IndirectBatcher::GetMatrixCount() const
+	{
+		return m_MatrixCount;
+	}
+
+	unsigned int IndirectBatcher::GetMinDraws() const
+	{
+		return m_MinDraws;
+	}
+
+	void IndirectBatcher::SetMinDraws(unsigned int count)
+	{
+		m_MinDraws = count < 2 ? 2 : count;
+	}
+
+	void IndirectBatcher::UpdateBuffer()
+	{
+		if (m_MatrixCount > 0)
+		{
+			Matrices.UpdateBuffer();
+			Commands.UpdateBuffer();
+		}
+	}
+
+	void IndirectBatcher::AddDraw(IndirectBatch &batch, const std::shared_ptr<SceneNode> &node, 
+		const std::shared_ptr<Material> &material, const DrawRange &range)
+	{
+		unsigned int indexSize = range.indexType == GL_UNSIGNED_SHORT ? 2 : 4;
+		unsigned int firstIndex = range.indexOffset / indexSize;
+		unsigned int materialIndex = GetMaterialIndex(material);
+
+		batch.indexType = range.indexType;
+
+		Matrices.Data.resize((m_MatrixCount + 1) * 16);
+		const float *src = node->GetWorldMatrix().Raw;
+		std::copy(src, src + 16, &Matrices.Data[m_MatrixCount * 16]);
+
+		// matrices of a command are contiguous, so growing instanceCount is enough.
+		if (batch.commandCount > 0)
+		{
+			unsigned int *last = &Commands.Data[Commands.Data.size() - COMMAND_SIZE];
+			if (last[0] == range.indexCount && last[2] == firstIndex && (int)last[3] == range.baseVertex && 
+				m_DrawData.back().materialIndex == materialIndex)
+			{
+				last[1]++;
+				m_MatrixCount++;
+				return;
+			}
+		}
+
+		unsigned int command[COMMAND_SIZE];
+		command[0] = range.indexCount;
+		command[1] = 1;
+		command[2] = firstIndex;
+		command[3] = (unsigned int)range.baseVertex;
+		command[4] = m_MatrixCount;
+		Commands.Data.insert(Commands.Data.end(), command, command + COMMAND_SIZE);
+
+		IndirectDrawData data;
+		data.matrixIndex = m_MatrixCount;
+		data.materialIndex = materialIndex;
+		m_DrawData.push_back(data);
+
+		batch.commandCount++;
+		m_MatrixCount++;
+	}
+
+	unsigned int IndirectBatcher::GetMaterialIndex(const std::shared_ptr<Material> &material)
+	{
+		auto it = m_MaterialIndices.find(material.get());
+		if (it != m_MaterialIndices.end())
+			return it->second;
+
+		unsigned int index = m_Materials.size();
+		m_Materials.push_back(material);
+		m_MaterialIndices.emplace(material.get(), index);
+		return index;
+	}
+}
\ No newline at end of file
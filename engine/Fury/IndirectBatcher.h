@@ -0,0 +1,153 @@
+#ifndef _FURY_INDIRECTBATCHER_H_
+#define _FURY_INDIRECTBATCHER_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Fury/ArrayBuffers.h"
+
+namespace fury
+{
+	class Material;
+
+	class SceneNode;
+
+	struct DrawRange;
+
+	struct RenderUnit;
+
+	// same layout as gl's DrawElementsIndirectCommand, 5 uints.
+	struct FURY_API DrawElementsIndirectCommand
+	{
+		unsigned int count = 0;
+
+		unsigned int instanceCount = 0;
+
+		unsigned int firstIndex = 0;
+
+		int baseVertex = 0;
+
+		// first world matrix in the matrix buffer.
+		unsigned int baseInstance = 0;
+	};
+
+	// per command data.
+	struct FURY_API IndirectDrawData
+	{
+		unsigned int matrixIndex = 0;
+
+		// into IndirectBatcher::GetMaterials.
+		unsigned int materialIndex = 0;
+	};
+
+	// a run of units or casters that can be submitted with one multi draw.
+	struct FURY_API IndirectBatch
+	{
+		// first unit or caster in its list.
+		unsigned int first = 0;
+
+		unsigned int count = 0;
+
+		// caster list of the batch, 0 for render units.
+		unsigned int group = 0;
+
+		// first command in the command buffer, -1 if drawn one by one.
+		int commandOffset = -1;
+
+		unsigned int commandCount = 0;
+
+		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+		unsigned int indexType = 0;
+
+		bool IsIndirect() const
+		{
+			return commandOffset >= 0;
+		}
+	};
+
+	// Builds glMultiDrawElementsIndirect commands for meshes living in MeshArena.
+	// Neighbour render units sharing a material become one batch, 
+	// neighbours sharing mesh and sub mesh become one instanced command.
+	// Skinned meshes, meshes outside the arena and short runs are left as single unit batches.
+	// World matrices are packed into Matrices, 16 floats per instance, 
+	// read through the instance_matrix attribute at baseInstance.
+	// Commands are packed into Commands, 5 uints each.
+	class FURY_API IndirectBatcher
+	{
+	public:
+
+		typedef std::shared_ptr<IndirectBatcher> Ptr;
+
+		static Ptr Create(unsigned int minDraws = 2);
+
+		static const unsigned int COMMAND_SIZE;
+
+	protected:
+
+		unsigned int m_MinDraws;
+
+		std::vector<IndirectBatch> m_Batches;
+
+		std::vector<IndirectDrawData> m_DrawData;
+
+		std::vector<std::shared_ptr<Material>> m_Materials;
+
+		std::unordered_map<const Material*, unsigned int> m_MaterialIndices;
+
+		unsigned int m_MatrixCount;
+
+	public:
+
+		ArrayBufferf Matrices;
+
+		ArrayBufferui Commands;
+
+		IndirectBatcher(unsigned int minDraws = 2);
+
+		// units should be sorted by RenderQuery::Sort first.
+		void Build(const std::vector<RenderUnit> &units);
+
+		// one group per caster list, whole meshes, for depth only passes.
+		// batches come out sorted by group.
+		void Build(const std::vector<std::vector<std::shared_ptr<SceneNode>>> &casters);
+
+		void Clear();
+
+		const std::vector<IndirectBatch> &GetBatches() const;
+
+		unsigned int GetBatchCount() const;
+
+		unsigned int GetIndirectBatchCount() const;
+
+		unsigned int GetCommandCount() const;
+
+		DrawElementsIndirectCommand GetCommand(unsigned int index) const;
+
+		// indices drawn by all commands of the batch, instances included.
+		unsigned int GetIndexCount(const IndirectBatch &batch) const;
+
+		const std::vector<IndirectDrawData> &GetDrawData() const;
+
+		const std::vector<std::shared_ptr<Material>> &GetMaterials() const;
+
+		unsigned int GetMatrixCount() const;
+
+		unsigned int GetMinDraws() const;
+
+		void SetMinDraws(unsigned int count);
+
+		// upload matrices and commands, needs a gl context.
+		void UpdateBuffer();
+
+	protected:
+
+		// neighbour draws of the same range in a batch share one command.
+		void AddDraw(IndirectBatch &batch, const std::shared_ptr<SceneNode> &node, 
+			const std::shared_ptr<Material> &material, const DrawRange &range);
+
+		unsigned int GetMaterialIndex(const std::shared_ptr<Material> &material);
+	};
+}
+
+#endif // _FURY_INDIRECTBATCHER_H_
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <algorithm>
+
+#include "Fury/InstanceBatcher.h"
+#include "Fury/GLLoader.h"
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+
+namespace fury
+{
+	InstanceBatcher::Ptr InstanceBatcher::Create(unsigned int minInstances)
+	{
+		return std::make_shared<InstanceBatcher>(minInstances);
+	}
+
+	InstanceBatcher::InstanceBatcher(unsigned int minInstances) : 
+		m_MinInstances(minInstances < 2 ? 2 : minInstances), m_InstanceCount(0),
+		Instances("instance_matrix", GL_ARRAY_BUFFER, GL_STREAM_DRAW)
+	{
+
+	}
+
+	void InstanceBatcher::Build(const std::vector<RenderUnit> &units)
+	{
+		Clear();
+
+		unsigned int count = units.size();
+		unsigned int first = 0;
+		while (first < count)
+		{
+			const auto &unit = units[first];
+
+			unsigned int last = first + 1;
+			if (!unit.mesh->IsSkinnedMesh())
+			{
+				while (last < count && units[last].mesh == unit.mesh && 
+					units[last].subMesh == unit.subMesh && units[last].material == unit.material)
+					last++;
+			}
+
+			unsigned int runSize = last - first;
+			if (runSize >= m_MinInstances)
+			{
+				InstanceBatch batch;
+				batch.first = first;
+				batch.count = runSize;
+				batch.instanceOffset = m_InstanceCount;
+				m_Batches.push_back(batch);
+
+				Instances.Data.resize((m_InstanceCount + runSize) * 16);
+				float *dst = &Instances.Data[m_InstanceCount * 16];
+				for (unsigned int i = first; i < last; i++, dst += 16)
+				{
+					const float *src = units[i].node->GetWorldMatrix().Raw;
+					std::copy(src, src + 16, dst);
+				}
+
+				m_InstanceCount += runSize;
+			}
+			else
+			{
+				for (unsigned int i = first; i < last; i++)
+				{
+					InstanceBatch batch;
+					batch.first = i;
+					batch.count = 1;
+					m_Batches.push_back(batch);
+				}
+			}
+
+			first = last;
+		}
+
+		Instances.SetDirty();
+	}
+
+	void InstanceBatcher::Clear()
+	{
+		m_Batches.clear();
+		m_InstanceCount = 0;
+		Instances.Data.clear();
+	}
+
+	const std::vector<InstanceBatch> &InstanceBatcher::GetBatches() const
+	{
+		return m_Batches;
+	}
+
+	unsigned int InstanceBatcher::GetBatchCount() const
+	{
+		return m_Batches.size();
+	}
+
+	unsigned int InstanceBatcher::GetInstancedBatchCount() const
+	{
+		unsigned int count = 0;
+		for (const auto &batch : m_Batches)
+		{
+			if (batch.IsInstanced())
+				count++;
+		}
+		return count;
+	}
+
+	unsigned int InstanceBatcher::GetInstanceCount() const
+	{
+		return m_InstanceCount;
+	}
+
+	unsigned int InstanceBatcher::GetMinInstances() const
+	{
+		return m_MinInstances;
+	}
+
+	void InstanceBatcher::SetMinInstances(unsigned int count)
+	{
+		m_MinInstances = count < 2 ? 2 : count;
+	}
+
+	void InstanceBatcher::UpdateBuffer()
+	{
+		if (m_InstanceCount > 0)
+			Instances.UpdateBuffer();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef _FURY_INSTANCEBATCHER_H_
+#define _FURY_INSTANCEBATCHER_H_
+
+#include <memory>
+#include <vector>
+
+#include "Fury/ArrayBuffers.h"
+
+namespace fury
+{
+	struct RenderUnit;
+
+	// a run of sorted render units that can be drawn together.
+	struct FURY_API InstanceBatch
+	{
+		// first unit in the unit list.
+		unsigned int first = 0;
+
+		unsigned int count = 0;
+
+		// first world matrix in the instance buffer, -1 if not instanced.
+		int instanceOffset = -1;
+
+		bool IsInstanced() const
+		{
+			return instanceOffset >= 0;
+		}
+	};
+
+	// Groups sorted render units into instance batches.
+	// Neighbour units sharing mesh, sub mesh and material become one batch, 
+	// materials pick the shader, so a batch also shares its shader.
+	// Skinned meshes and short runs are left as single unit batches.
+	// World matrices of instanced batches are packed into Instances, 
+	// 16 floats per instance, same layout as Matrix4::Raw.
+	class FURY_API InstanceBatcher
+	{
+	public:
+
+		typedef std::shared_ptr<InstanceBatcher> Ptr;
+
+		static Ptr Create(unsigned int minInstances = 2);
+
+	protected:
+
+		unsigned int m_MinInstances;
+
+		std::vector<InstanceBatch> m_Batches;
+
+		unsigned int m_InstanceCount;
+
+	public:
+
+		ArrayBufferf Instances;
+
+		InstanceBatcher(unsigned int minInstances = 2);
+
+		// units should be sorted by RenderQuery::Sort first.
+		void Build(const std::vector<RenderUnit> &units);
+
+		void Clear();
+
+		const std::vector<InstanceBatch> &GetBatches() const;
+
+		unsigned int GetBatchCount() const;
+
+		unsigned int GetInstancedBatchCount() const;
+
+		unsigned int GetInstanceCount() const;
+
+		unsigned int GetMinInstances() const;
+
+		void SetMinInstances(unsigned int count);
+
+		// upload instance data, needs a gl context.
+		void UpdateBuffer();
+	};
+}
+
+#endif // _FURY_INSTANCEBATCHER_H_
\ No newline at end of file
@@ -0,0 +1,358 @@
+#include <algorithm>
+
+#include "Fury/LinearOcTree.h"
+#include "Fury/Log.h"
+#include "Fury/OcTreeNode.h"
+#include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	const unsigned int LinearOcTree::MAX_DEPTH;
+
+	const unsigned int LinearOcTree::LEAF_SIZE;
+
+	const unsigned int LinearOcTree::GRAIN_SIZE = 1024;
+
+	LinearOcTree::Ptr LinearOcTree::Create(Vector4 min, Vector4 max, unsigned int maxDepth)
+	{
+		return std::make_shared<LinearOcTree>(min, max, maxDepth);
+	}
+
+	LinearOcTree::LinearOcTree(Vector4 min, Vector4 max, unsigned int maxDepth) :
+		m_TypeIndex(typeid(LinearOcTree)), m_Min(min), m_Max(max), 
+		m_MaxDepth(std::min(maxDepth, MAX_DEPTH)), m_StaticNodeCount(0)
+	{
+		if (maxDepth > MAX_DEPTH)
+			FURYW << "LinearOcTree maxDepth clamped to " << MAX_DEPTH;
+
+		m_DynamicTree = OcTree::Create(min, max, maxDepth);
+	}
+
+	LinearOcTree::~LinearOcTree()
+	{
+		Clear();
+		FURYD << "LinearOcTree::~LinearOcTree";
+	}
+
+	std::type_index LinearOcTree::GetTypeIndex() const
+	{
+		return m_TypeIndex;
+	}
+
+	void LinearOcTree::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() == this)
+			UpdateSceneNode(sceneNode);
+		else
+			m_DynamicTree->AddSceneNode(sceneNode);
+	}
+
+	void LinearOcTree::AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		SceneNodes staticNodes;
+		staticNodes.reserve(m_StaticNodeCount);
+
+		for (const auto &staticNode : m_StaticNodes)
+		{
+			if (staticNode != nullptr)
+				staticNodes.push_back(staticNode);
+		}
+
+		// collect new static scenenodes, the rest go to dynamic tree.
+		std::vector<SceneNode::Ptr> pendingNodes;
+		pendingNodes.push_back(sceneNode);
+
+		while (pendingNodes.size() > 0)
+		{
+			SceneNode::Ptr node = pendingNodes.back();
+			pendingNodes.pop_back();
+
+			if (node->GetSceneManager() != this)
+			{
+				if (node->GetStatic() && !node->GetWorldAABB().GetInfinite())
+				{
+					node->RemoveFromOcTree(false);
+					staticNodes.push_back(node);
+				}
+				else if (IsInDynamicTree(node))
+				{
+					// OcTree would add it twice.
+					m_DynamicTree->UpdateSceneNode(node);
+				}
+				else
+				{
+					m_DynamicTree->AddSceneNode(node);
+				}
+			}
+
+			for (unsigned int i = 0; i < node->GetChildCount(); i++)
+				pendingNodes.push_back(node->GetChildAt(i));
+		}
+
+		Build(staticNodes);
+	}
+
+	void LinearOcTree::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() == this)
+			RemoveStaticNode(sceneNode);
+		else
+			m_DynamicTree->RemoveSceneNode(sceneNode);
+	}
+
+	void LinearOcTree::UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() != this)
+		{
+			m_DynamicTree->UpdateSceneNode(sceneNode);
+			return;
+		}
+
+		// the linear tree's bounds are fixed after build.
+		auto ptr = sceneNode;
+		RemoveStaticNode(ptr);
+		m_DynamicTree->AddSceneNode(ptr);
+	}
+
+	void LinearOcTree::Build()
+	{
+		SceneNodes staticNodes;
+		staticNodes.reserve(m_StaticNodeCount);
+
+		for (const auto &staticNode : m_StaticNodes)
+		{
+			if (staticNode != nullptr)
+				staticNodes.push_back(staticNode);
+		}
+
+		Build(staticNodes);
+	}
+
+	void LinearOcTree::Clear()
+	{
+		for (auto &sceneNode : m_StaticNodes)
+		{
+			if (sceneNode != nullptr)
+				sceneNode->SetSceneManager(nullptr);
+		}
+
+		m_StaticNodes.clear();
+		m_StaticNodeAABBs.Clear();
+		m_StaticNodeCount = 0;
+		m_TreeNodes.clear();
+
+		m_DynamicTree->Clear();
+	}
+
+	unsigned int LinearOcTree::GetMaxDepth() const
+	{
+		return m_MaxDepth;
+	}
+
+	unsigned int LinearOcTree::GetTreeNodeCount() const
+	{
+		return m_TreeNodes.size();
+	}
+
+	unsigned int LinearOcTree::GetStaticSceneNodeCount() const
+	{
+		return m_StaticNodeCount;
+	}
+
+	std::shared_ptr<OcTree> LinearOcTree::GetDynamicTree() const
+	{
+		return m_DynamicTree;
+	}
+
+	void LinearOcTree::Build(const SceneNodes &staticNodes)
+	{
+		unsigned int count = staticNodes.size();
+
+		// run func(first, last) on chunks of GRAIN_SIZE, on workers if it's worth it.
+		auto ForEachChunk = [&](unsigned int size, const std::function<void(unsigned int, unsigned int)> &func)
+		{
+			unsigned int sizeChunkCount = (size + GRAIN_SIZE - 1) / GRAIN_SIZE;
+			if (sizeChunkCount < 2 || ThreadUtil::Instance()->GetWorkerCount() == 0)
+			{
+				func(0, size);
+				return;
+			}
+
+			ThreadUtil::Instance()->ParallelFor(sizeChunkCount, [&](unsigned int chunk)
+			{
+				func(chunk * GRAIN_SIZE, std::min(size, (chunk + 1) * GRAIN_SIZE));
+			});
+		};
+
+		// morton codes of centers
+		std::vector<unsigned int> codes(count);
+		ForEachChunk(count, [&](unsigned int first, unsigned int last)
+		{
+			for (unsigned int i = first; i < last; i++)
+				codes[i] = GetMortonCode(staticNodes[i]->GetWorldAABB().GetCenter());
+		});
+
+		// lsd radix sort, 8 bits per pass, stable so equal codes keep their order.
+		std::vector<unsigned int> order(count), sortedOrder(count), sortedCodes(count);
+		for (unsigned int i = 0; i < count; i++)
+			order[i] = i;
+
+		for (unsigned int shift = 0; shift < 3 * MAX_DEPTH; shift += 8)
+		{
+			std::array<unsigned int, 257> offsets;
+			offsets.fill(0);
+
+			for (unsigned int i = 0; i < count; i++)
+				offsets[((codes[i] >> shift) & 0xFF) + 1]++;
+
+			for (unsigned int i = 1; i < offsets.size(); i++)
+				offsets[i] += offsets[i - 1];
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				unsigned int dest = offsets[(codes[i] >> shift) & 0xFF]++;
+				sortedCodes[dest] = codes[i];
+				sortedOrder[dest] = order[i];
+			}
+
+			codes.swap(sortedCodes);
+			order.swap(sortedOrder);
+		}
+
+		// drop old links, then store scenenodes in sorted order.
+		for (auto &sceneNode : m_StaticNodes)
+		{
+			if (sceneNode != nullptr)
+				sceneNode->SetSceneManager(nullptr);
+		}
+
+		m_StaticNodes.resize(count);
+		m_StaticNodeAABBs.Clear();
+		m_StaticNodeCount = count;
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const auto &sceneNode = staticNodes[order[i]];
+			m_StaticNodes[i] = sceneNode;
+			m_StaticNodeAABBs.Add(sceneNode->GetWorldAABB());
+			sceneNode->SetSceneManager(this, 0, i);
+		}
+
+		// tree nodes in depth first order.
+		m_TreeNodes.clear();
+		if (count > 0)
+			BuildTreeNode(codes, 0, count, 0);
+
+		// leaf bounds first, then parents from the back, childs always come after their parent.
+		std::vector<unsigned int> leafs;
+		for (unsigned int i = 0; i < m_TreeNodes.size(); i++)
+		{
+			if (m_TreeNodes[i].leaf)
+				leafs.push_back(i);
+		}
+
+		ForEachChunk(leafs.size(), [&](unsigned int first, unsigned int last)
+		{
+			for (unsigned int i = first; i < last; i++)
+			{
+				TreeNode &treeNode = m_TreeNodes[leafs[i]];
+				treeNode.aabb = BoxBounds(true);
+				for (unsigned int j = treeNode.first; j < treeNode.first + treeNode.count; j++)
+					treeNode.aabb.Encapsulate(m_StaticNodes[j]->GetWorldAABB());
+			}
+		});
+
+		for (unsigned int i = m_TreeNodes.size(); i-- > 0;)
+		{
+			TreeNode &treeNode = m_TreeNodes[i];
+			if (treeNode.leaf)
+				continue;
+
+			treeNode.aabb = BoxBounds(true);
+			for (unsigned int child = i + 1; child < treeNode.skip; child = m_TreeNodes[child].skip)
+				treeNode.aabb.Encapsulate(m_TreeNodes[child].aabb);
+		}
+
+		FURYD << "LinearOcTree built " << count << " static scenenodes into " << m_TreeNodes.size() << " tree nodes.";
+	}
+
+	bool LinearOcTree::IsInDynamicTree(const std::shared_ptr<SceneNode> &sceneNode) const
+	{
+		auto treeNode = sceneNode->GetOcTreeNode();
+		return treeNode != nullptr && &treeNode->GetManager() == m_DynamicTree.get();
+	}
+
+	unsigned int LinearOcTree::GetMortonCode(Vector4 point) const
+	{
+		const float cellCount = (float)(1u << MAX_DEPTH);
+		Vector4 size = m_Max - m_Min;
+
+		// 0 ... 1023 on each axis.
+		float coords[3] = {
+			(point.x - m_Min.x) / size.x * cellCount, 
+			(point.y - m_Min.y) / size.y * cellCount, 
+			(point.z - m_Min.z) / size.z * cellCount
+		};
+
+		// spread 10 bits to every third bit, x takes the lowest.
+		unsigned int code = 0;
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			unsigned int value = (unsigned int)std::max(0.0f, std::min(coords[i], cellCount - 1.0f));
+			value = (value | (value << 16)) & 0x030000FF;
+			value = (value | (value << 8)) & 0x0300F00F;
+			value = (value | (value << 4)) & 0x030C30C3;
+			value = (value | (value << 2)) & 0x09249249;
+			code |= value << i;
+		}
+
+		return code;
+	}
+
+	unsigned int LinearOcTree::BuildTreeNode(const std::vector<unsigned int> &codes, unsigned int first, unsigned int last, unsigned int depth)
+	{
+		unsigned int index = m_TreeNodes.size();
+
+		TreeNode treeNode;
+		treeNode.first = first;
+		treeNode.count = last - first;
+		treeNode.skip = 0;
+		treeNode.depth = depth;
+		treeNode.leaf = last - first <= LEAF_SIZE || depth >= m_MaxDepth;
+		m_TreeNodes.push_back(treeNode);
+
+		if (!m_TreeNodes[index].leaf)
+		{
+			// codes share the top 3 * depth bits, childs are runs of the next 3 bits.
+			unsigned int shift = 3 * (MAX_DEPTH - depth - 1);
+			unsigned int childFirst = first;
+
+			while (childFirst < last)
+			{
+				unsigned int child = (codes[childFirst] >> shift) & 7;
+				unsigned int childLast = childFirst + 1;
+				while (childLast < last && ((codes[childLast] >> shift) & 7) == child)
+					childLast++;
+
+				BuildTreeNode(codes, childFirst, childLast, depth + 1);
+				childFirst = childLast;
+			}
+		}
+
+		m_TreeNodes[index].skip = m_TreeNodes.size();
+		return index;
+	}
+
+	void LinearOcTree::RemoveStaticNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		unsigned int slot = sceneNode->GetSceneManagerSlot();
+		if (slot >= m_StaticNodes.size() || m_StaticNodes[slot] != sceneNode)
+			return;
+
+		// keep the slot so tree node ranges stay valid, bounds only shrink on next Build.
+		sceneNode->SetSceneManager(nullptr);
+		m_StaticNodes[slot] = nullptr;
+		m_StaticNodeCount--;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+#ifndef _FURY_LINEAR_OCTREE_H_
+#define _FURY_LINEAR_OCTREE_H_
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/BoxBoundsArray.h"
+#include "Fury/Frustum.h"
+#include "Fury/OcTree.h"
+#include "Fury/SceneManager.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	// Linear octree for static geometry, with an OcTree for everything else.
+	// AddSceneNodeRecursively sorts static scenenodes (see SceneNode::SetStatic) by the 
+	// morton code of their centers and builds the tree in one pass, tree nodes are stored 
+	// depth first in a flat array, each one covers a contiguous range of sorted scenenodes 
+	// and it's bounds fit them tightly, so culling needs no stack or pointers.
+	// Single AddSceneNode calls, non-static scenenodes and static ones that moved 
+	// go to the dynamic OcTree.
+	class FURY_API LinearOcTree : public SceneManagerBase<LinearOcTree>
+	{
+	public:
+
+		typedef std::shared_ptr<LinearOcTree> Ptr;
+
+		static Ptr Create(Vector4 min, Vector4 max, unsigned int maxDepth = 6);
+
+		// morton codes use 10 bits per axis.
+		static const unsigned int MAX_DEPTH = 10;
+
+		// tree nodes with fewer scenenodes are not split.
+		static const unsigned int LEAF_SIZE = 32;
+
+		static const unsigned int GRAIN_SIZE;
+
+	protected:
+
+		struct TreeNode
+		{
+			// tight bounds of it's scenenodes.
+			BoxBounds aabb;
+
+			// range in m_StaticNodes, childs' ranges included.
+			unsigned int first;
+
+			unsigned int count;
+
+			// index of the next tree node after this subtree.
+			unsigned int skip;
+
+			unsigned int depth;
+
+			bool leaf;
+		};
+
+		std::type_index m_TypeIndex;
+
+		Vector4 m_Min;
+
+		Vector4 m_Max;
+
+		unsigned int m_MaxDepth;
+
+		std::vector<TreeNode> m_TreeNodes;
+
+		// sorted by morton code, removed ones are left as nullptr until next build.
+		std::vector<std::shared_ptr<SceneNode>> m_StaticNodes;
+
+		// world aabbs of m_StaticNodes, in the same order.
+		BoxBoundsArray m_StaticNodeAABBs;
+
+		unsigned int m_StaticNodeCount;
+
+		std::shared_ptr<OcTree> m_DynamicTree;
+
+	public:
+
+		LinearOcTree(Vector4 min, Vector4 max, unsigned int maxDepth);
+
+		virtual ~LinearOcTree();
+
+		virtual std::type_index GetTypeIndex() const;
+
+		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		// static scenenodes in this subtree are built into the linear tree with the existing ones.
+		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		// a static scenenode that moved is handed to the dynamic tree.
+		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		// Non-virtual version of WalkScene, walks the linear tree then the dynamic one.
+		// visitor: void(const std::shared_ptr<SceneNode>&)
+		template<class Visitor>
+		void WalkSceneFast(const Collidable &collider, Visitor &&visitor) const;
+
+		// rebuild the linear tree from current static scenenodes, drops removed ones.
+		void Build();
+
+		virtual void Clear() override;
+
+		unsigned int GetMaxDepth() const;
+
+		unsigned int GetTreeNodeCount() const;
+
+		unsigned int GetStaticSceneNodeCount() const;
+
+		std::shared_ptr<OcTree> GetDynamicTree() const;
+
+	protected:
+
+		void Build(const SceneNodes &staticNodes);
+
+		bool IsInDynamicTree(const std::shared_ptr<SceneNode> &sceneNode) const;
+
+		// morton code of point's cell at max depth, points out of bounds are clamped.
+		unsigned int GetMortonCode(Vector4 point) const;
+
+		// append tree nodes for sorted codes in [first, last), returns the subtree's root index.
+		unsigned int BuildTreeNode(const std::vector<unsigned int> &codes, unsigned int first, unsigned int last, unsigned int depth);
+
+		void RemoveStaticNode(const std::shared_ptr<SceneNode> &sceneNode);
+	};
+
+	template<class Visitor>
+	void LinearOcTree::WalkSceneFast(const Collidable &collider, Visitor &&visitor) const
+	{
+		const Frustum *frustum = dynamic_cast<const Frustum*>(&collider);
+
+		const unsigned int batchSize = 64;
+		std::array<unsigned char, batchSize> visible;
+
+		// planes each depth's current tree node still needs to test, childs start with their parent's.
+		std::array<unsigned int, MAX_DEPTH + 1> planeMasks;
+
+		unsigned int index = 0;
+		unsigned int treeNodeCount = m_TreeNodes.size();
+
+		while (index < treeNodeCount)
+		{
+			const TreeNode &treeNode = m_TreeNodes[index];
+			unsigned int planeMask = treeNode.depth == 0 ? 0x3Fu : planeMasks[treeNode.depth - 1];
+
+			if (planeMask != 0)
+			{
+				Side result = Side::STRADDLE;
+				if (frustum != nullptr)
+				{
+					result = IsInside(*frustum, treeNode.aabb, planeMask);
+				}
+				else
+				{
+					result = collider.IsInside(treeNode.aabb);
+				}
+
+				if (result == Side::OUT)
+				{
+					index = treeNode.skip;
+					continue;
+				}
+
+				if (result == Side::IN)
+					planeMask = 0;
+			}
+
+			unsigned int first = treeNode.first;
+			unsigned int last = treeNode.first + treeNode.count;
+
+			// the whole subtree is visible, it's scenenodes are contiguous.
+			if (planeMask == 0)
+			{
+				for (unsigned int i = first; i < last; i++)
+				{
+					if (m_StaticNodes[i] != nullptr)
+						visitor(m_StaticNodes[i]);
+				}
+
+				index = treeNode.skip;
+				continue;
+			}
+
+			if (!treeNode.leaf)
+			{
+				planeMasks[treeNode.depth] = planeMask;
+				index++;
+				continue;
+			}
+
+			// test leaf's scenenodes
+			if (frustum != nullptr)
+			{
+				for (unsigned int batchFirst = first; batchFirst < last; batchFirst += batchSize)
+				{
+					unsigned int count = std::min(last - batchFirst, batchSize);
+					if (frustum->IsInsideFast(m_StaticNodeAABBs, batchFirst, count, visible.data(), planeMask) == 0)
+						continue;
+
+					for (unsigned int i = 0; i < count; i++)
+					{
+						if (visible[i] && m_StaticNodes[batchFirst + i] != nullptr)
+							visitor(m_StaticNodes[batchFirst + i]);
+					}
+				}
+			}
+			else
+			{
+				for (unsigned int i = first; i < last; i++)
+				{
+					const auto &sceneNode = m_StaticNodes[i];
+					if (sceneNode != nullptr && collider.IsInsideFast(sceneNode->GetWorldAABB()))
+						visitor(sceneNode);
+				}
+			}
+
+			index = treeNode.skip;
+		}
+
+		m_DynamicTree->WalkSceneFast(collider, visitor);
+	}
+}
+
+#endif // _FURY_LINEAR_OCTREE_H_
\ No newline at end of file
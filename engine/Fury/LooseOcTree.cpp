@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Fury/Log.h"
+#include "Fury/LooseOcTree.h"
+#include "Fury/SceneNode.h"
+
+namespace fury
+{
+	const unsigned int LooseOcTree::MAX_DEPTH;
+
+	LooseOcTree::Ptr LooseOcTree::Create(Vector4 min, Vector4 max, unsigned int maxDepth, float looseness)
+	{
+		return std::make_shared<LooseOcTree>(min, max, maxDepth, looseness);
+	}
+
+	LooseOcTree::LooseOcTree(Vector4 min, Vector4 max, unsigned int maxDepth, float looseness) :
+		m_TypeIndex(typeid(LooseOcTree)), m_Min(min), m_Max(max), 
+		m_MaxDepth(std::min(maxDepth, MAX_DEPTH)), m_Looseness(looseness), 
+		m_UpdateMoveCount(0), m_UpdateSkipCount(0)
+	{
+		if (maxDepth > MAX_DEPTH)
+			FURYW << "LooseOcTree maxDepth clamped to " << MAX_DEPTH;
+
+		if (looseness <= 1.0f)
+		{
+			FURYW << "LooseOcTree looseness must be greater than 1, 2 is used.";
+			m_Looseness = 2.0f;
+		}
+
+		CreateTreeNode(0, 0, 0, 0, 0);
+	}
+
+	LooseOcTree::~LooseOcTree()
+	{
+		Clear();
+		FURYD << "LooseOcTree::~LooseOcTree";
+	}
+
+	std::type_index LooseOcTree::GetTypeIndex() const
+	{
+		return m_TypeIndex;
+	}
+
+	void LooseOcTree::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() == this)
+		{
+			UpdateSceneNode(sceneNode);
+			return;
+		}
+
+		AddSceneNode(sceneNode, GetFitTreeNode(sceneNode->GetWorldAABB()));
+	}
+
+	void LooseOcTree::AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		AddSceneNode(sceneNode);
+
+		for (unsigned int i = 0; i < sceneNode->GetChildCount(); i++)
+			AddSceneNodeRecursively(sceneNode->GetChildAt(i));
+	}
+
+	void LooseOcTree::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() != this)
+			return;
+
+		RemoveSceneNode(sceneNode, sceneNode->GetSceneManagerCell());
+		sceneNode->SetSceneManager(nullptr);
+	}
+
+	void LooseOcTree::UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (sceneNode->GetSceneManager() != this)
+			return;
+
+		BoxBounds aabb = sceneNode->GetWorldAABB();
+		unsigned int oldTreeNode = sceneNode->GetSceneManagerCell();
+		unsigned int newTreeNode = GetFitTreeNode(aabb);
+
+		if (oldTreeNode == newTreeNode)
+		{
+			m_TreeNodes[oldTreeNode].sceneNodeAABBs.Set(sceneNode->GetSceneManagerSlot(), aabb);
+			m_UpdateSkipCount++;
+		}
+		else
+		{
+			// keep a ref, the tree might hold the last one.
+			auto ptr = sceneNode;
+			RemoveSceneNode(ptr, oldTreeNode);
+
+			// the new cell is freed with the old one if it was just created below it.
+			AddSceneNode(ptr, GetFitTreeNode(aabb));
+			m_UpdateMoveCount++;
+		}
+	}
+
+	void LooseOcTree::Clear()
+	{
+		for (auto &treeNode : m_TreeNodes)
+		{
+			for (auto &sceneNode : treeNode.sceneNodes)
+				sceneNode->SetSceneManager(nullptr);
+		}
+
+		m_TreeNodes.clear();
+		m_FreeTreeNodes.clear();
+		CreateTreeNode(0, 0, 0, 0, 0);
+	}
+
+	float LooseOcTree::GetLooseness() const
+	{
+		return m_Looseness;
+	}
+
+	unsigned int LooseOcTree::GetMaxDepth() const
+	{
+		return m_MaxDepth;
+	}
+
+	unsigned int LooseOcTree::GetTreeNodeCount() const
+	{
+		return m_TreeNodes.size() - m_FreeTreeNodes.size();
+	}
+
+	unsigned int LooseOcTree::GetSceneNodeCount() const
+	{
+		return m_TreeNodes[0].totalSceneNodeCount;
+	}
+
+	unsigned int LooseOcTree::GetRootSceneNodeCount() const
+	{
+		return m_TreeNodes[0].sceneNodes.size();
+	}
+
+	unsigned int LooseOcTree::GetSceneNodeCountAt(unsigned int depth) const
+	{
+		unsigned int count = 0;
+		for (const auto &treeNode : m_TreeNodes)
+		{
+			if (treeNode.depth == depth)
+				count += treeNode.sceneNodes.size();
+		}
+		return count;
+	}
+
+	unsigned int LooseOcTree::GetUpdateMoveCount() const
+	{
+		return m_UpdateMoveCount;
+	}
+
+	unsigned int LooseOcTree::GetUpdateSkipCount() const
+	{
+		return m_UpdateSkipCount;
+	}
+
+	void LooseOcTree::ResetStatistics()
+	{
+		m_UpdateMoveCount = 0;
+		m_UpdateSkipCount = 0;
+	}
+
+	unsigned int LooseOcTree::GetFitTreeNode(const BoxBounds &aabb)
+	{
+		if (aabb.GetInfinite())
+			return 0;
+
+		Vector4 center = aabb.GetCenter();
+		Vector4 size = aabb.GetSize();
+
+		const float centers[3] = { center.x - m_Min.x, center.y - m_Min.y, center.z - m_Min.z };
+		const float sizes[3] = { size.x, size.y, size.z };
+		const float treeSizes[3] = { m_Max.x - m_Min.x, m_Max.y - m_Min.y, m_Max.z - m_Min.z };
+
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			if (centers[i] < 0.0f || centers[i] >= treeSizes[i])
+				return 0;
+		}
+
+		// deepest level whose loose cells still hold the aabb from anywhere in the cell, 
+		// that's size <= (looseness - 1) * cellSize on every axis.
+		float ratio = std::numeric_limits<float>::max();
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			if (sizes[i] > 0.0f)
+				ratio = std::min(ratio, (m_Looseness - 1.0f) * treeSizes[i] / sizes[i]);
+		}
+
+		if (ratio < 2.0f)
+			return 0;
+
+		unsigned int depth = m_MaxDepth;
+		if (ratio < (float)(1u << m_MaxDepth))
+			depth = (unsigned int)std::floor(std::log2(ratio));
+
+		// cell coordinates at that depth, then walk down by their bits.
+		unsigned int cellCount = 1u << depth;
+		unsigned int coords[3];
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			unsigned int coord = (unsigned int)(centers[i] / treeSizes[i] * cellCount);
+			coords[i] = std::min(coord, cellCount - 1);
+		}
+
+		unsigned int treeNode = 0;
+		for (unsigned int level = 1; level <= depth; level++)
+		{
+			unsigned int shift = depth - level;
+			unsigned int x = coords[0] >> shift, y = coords[1] >> shift, z = coords[2] >> shift;
+			unsigned int childIndex = (x & 1) | ((y & 1) << 1) | ((z & 1) << 2);
+
+			int child = m_TreeNodes[treeNode].childs[childIndex];
+			if (child < 0)
+			{
+				child = CreateTreeNode(treeNode, level, x, y, z);
+				m_TreeNodes[treeNode].childs[childIndex] = child;
+			}
+
+			treeNode = child;
+		}
+
+		return treeNode;
+	}
+
+	unsigned int LooseOcTree::CreateTreeNode(unsigned int parent, unsigned int depth, unsigned int x, unsigned int y, unsigned int z)
+	{
+		Vector4 cellSize = (m_Max - m_Min) / (float)(1u << depth);
+		Vector4 center = m_Min + Vector4(cellSize.x * (x + 0.5f), cellSize.y * (y + 0.5f), cellSize.z * (z + 0.5f), 0.0f);
+		Vector4 extents = cellSize * (0.5f * m_Looseness);
+		extents.w = 0.0f;
+
+		TreeNode treeNode;
+		treeNode.aabb = BoxBounds(center - extents, center + extents);
+		treeNode.parent = depth == 0 ? -1 : (int)parent;
+		std::fill(treeNode.childs, treeNode.childs + 8, -1);
+		treeNode.depth = depth;
+		treeNode.totalSceneNodeCount = 0;
+
+		if (!m_FreeTreeNodes.empty())
+		{
+			unsigned int index = m_FreeTreeNodes.back();
+			m_FreeTreeNodes.pop_back();
+			m_TreeNodes[index] = std::move(treeNode);
+			return index;
+		}
+
+		m_TreeNodes.push_back(std::move(treeNode));
+		return m_TreeNodes.size() - 1;
+	}
+
+	void LooseOcTree::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode, unsigned int treeNode)
+	{
+		auto &target = m_TreeNodes[treeNode];
+		sceneNode->SetSceneManager(this, treeNode, target.sceneNodes.size());
+		target.sceneNodes.push_back(sceneNode);
+		target.sceneNodeAABBs.Add(sceneNode->GetWorldAABB());
+
+		for (int i = (int)treeNode; i >= 0; i = m_TreeNodes[i].parent)
+			m_TreeNodes[i].totalSceneNodeCount++;
+	}
+
+	void LooseOcTree::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode, unsigned int treeNode)
+	{
+		auto &target = m_TreeNodes[treeNode];
+		unsigned int slot = sceneNode->GetSceneManagerSlot();
+
+		// swap with last one, and let it know it's new slot.
+		auto &last = target.sceneNodes.back();
+		last->SetSceneManagerSlot(slot);
+		target.sceneNodes[slot] = last;
+		target.sceneNodes.pop_back();
+		target.sceneNodeAABBs.SwapRemoveAt(slot);
+
+		for (int i = (int)treeNode; i >= 0; i = m_TreeNodes[i].parent)
+			m_TreeNodes[i].totalSceneNodeCount--;
+
+		// unlink the highest empty cell from it's parent, root always stays.
+		int empty = -1;
+		for (int i = (int)treeNode; i > 0 && m_TreeNodes[i].totalSceneNodeCount == 0; i = m_TreeNodes[i].parent)
+			empty = i;
+
+		if (empty > 0)
+		{
+			auto &childs = m_TreeNodes[m_TreeNodes[empty].parent].childs;
+			std::replace(childs, childs + 8, empty, -1);
+			FreeTreeNode(empty);
+		}
+	}
+
+	void LooseOcTree::FreeTreeNode(unsigned int treeNode)
+	{
+		for (int child : m_TreeNodes[treeNode].childs)
+		{
+			if (child >= 0)
+				FreeTreeNode(child);
+		}
+
+		std::fill(m_TreeNodes[treeNode].childs, m_TreeNodes[treeNode].childs + 8, -1);
+		m_FreeTreeNodes.push_back(treeNode);
+	}
+}
\ No newline at end of file
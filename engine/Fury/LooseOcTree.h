@@ -0,0 +1,231 @@
+#ifndef _FURY_LOOSE_OCTREE_H_
+#define _FURY_LOOSE_OCTREE_H_
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/BoxBoundsArray.h"
+#include "Fury/Frustum.h"
+#include "Fury/SceneManager.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	// Loose octree, each cell's bounds are enlarged by looseness around it's center, 
+	// so a scenenode only needs to fit a cell by size, not by position.
+	// The cell's depth comes from the scenenode's size and the cell from it's center, 
+	// no split plane tests, and straddling scenenodes don't pile up in upper levels.
+	// Scenenodes with infinite aabb or center out of tree bounds live in root.
+	// Cells are created on demand and freed again when their last scenenode leaves, 
+	// so the tree only holds cells on the way to non-empty ones.
+	// Holds a shared_ptr to attached scenenodes, see SceneNode::SetSceneManager.
+	class FURY_API LooseOcTree : public SceneManagerBase<LooseOcTree>
+	{
+	public:
+
+		typedef std::shared_ptr<LooseOcTree> Ptr;
+
+		static Ptr Create(Vector4 min, Vector4 max, unsigned int maxDepth = 6, float looseness = 2.0f);
+
+		// maxDepth is clamped to this, so WalkSceneFast can use a fixed-size stack.
+		static const unsigned int MAX_DEPTH = 16;
+
+	protected:
+
+		struct TreeNode
+		{
+			// loose bounds
+			BoxBounds aabb;
+
+			int parent;
+
+			int childs[8];
+
+			unsigned int depth;
+
+			unsigned int totalSceneNodeCount;
+
+			std::vector<std::shared_ptr<SceneNode>> sceneNodes;
+
+			// world aabbs of sceneNodes, in the same order.
+			BoxBoundsArray sceneNodeAABBs;
+		};
+
+		std::type_index m_TypeIndex;
+
+		// root is always the first one.
+		std::vector<TreeNode> m_TreeNodes;
+
+		// indices of freed tree nodes, reused by CreateTreeNode.
+		std::vector<unsigned int> m_FreeTreeNodes;
+
+		Vector4 m_Min;
+
+		Vector4 m_Max;
+
+		unsigned int m_MaxDepth;
+
+		float m_Looseness;
+
+		unsigned int m_UpdateMoveCount;
+
+		unsigned int m_UpdateSkipCount;
+
+	public:
+
+		LooseOcTree(Vector4 min, Vector4 max, unsigned int maxDepth, float looseness);
+
+		virtual ~LooseOcTree();
+
+		virtual std::type_index GetTypeIndex() const;
+
+		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		// stays in place if the scenenode still belongs to the same cell.
+		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		// Non-virtual version of WalkScene, see OcTree::WalkSceneFast.
+		// visitor: void(const std::shared_ptr<SceneNode>&)
+		template<class Visitor>
+		void WalkSceneFast(const Collidable &collider, Visitor &&visitor) const;
+
+		virtual void Clear() override;
+
+		float GetLooseness() const;
+
+		unsigned int GetMaxDepth() const;
+
+		// tree nodes in use, freed ones are not counted.
+		unsigned int GetTreeNodeCount() const;
+
+		unsigned int GetSceneNodeCount() const;
+
+		// scenenodes in root, the ones culled one by one.
+		unsigned int GetRootSceneNodeCount() const;
+
+		// scenenodes stored at depth.
+		unsigned int GetSceneNodeCountAt(unsigned int depth) const;
+
+		// updates that moved a scenenode to another cell since last ResetStatistics.
+		unsigned int GetUpdateMoveCount() const;
+
+		// updates that kept a scenenode in it's cell since last ResetStatistics.
+		unsigned int GetUpdateSkipCount() const;
+
+		// call this once per frame to get per frame statistics.
+		void ResetStatistics();
+
+	protected:
+
+		// index of the tree node the aabb belongs to, missing tree nodes on the way are created.
+		unsigned int GetFitTreeNode(const BoxBounds &aabb);
+
+		unsigned int CreateTreeNode(unsigned int parent, unsigned int depth, unsigned int x, unsigned int y, unsigned int z);
+
+		void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode, unsigned int treeNode);
+
+		// frees the highest empty cell above treeNode too.
+		void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode, unsigned int treeNode);
+
+		// treeNode and it's subtree must be empty.
+		void FreeTreeNode(unsigned int treeNode);
+	};
+
+	template<class Visitor>
+	void LooseOcTree::WalkSceneFast(const Collidable &collider, Visitor &&visitor) const
+	{
+		// planeMask holds the planes a tree node still needs to test, 0 means fully inside.
+		using TreeNodePair = std::pair<unsigned int, const TreeNode*>;
+
+		const Frustum *frustum = dynamic_cast<const Frustum*>(&collider);
+
+		const unsigned int batchSize = 64;
+		std::array<unsigned char, batchSize> visible;
+
+		// each level pops 1 node and pushes at most 8 childs.
+		std::array<TreeNodePair, 7 * MAX_DEPTH + 8> possiblePairs;
+		unsigned int top = 0;
+
+		const TreeNode *root = &m_TreeNodes[0];
+		if (root->totalSceneNodeCount > 0)
+			possiblePairs[top++] = std::make_pair(0x3Fu, root);
+
+		while (top > 0)
+		{
+			// pop next possible node.
+			unsigned int planeMask = possiblePairs[--top].first;
+			const TreeNode *treeNode = possiblePairs[top].second;
+
+			// root also holds scenenodes out of it's bounds, so it's never rejected as a whole.
+			if (planeMask != 0 && treeNode != root)
+			{
+				Side result = Side::STRADDLE;
+				if (frustum != nullptr)
+				{
+					result = IsInside(*frustum, treeNode->aabb, planeMask);
+				}
+				else
+				{
+					result = collider.IsInside(treeNode->aabb);
+				}
+
+				if (result == Side::OUT)
+					continue;
+
+				if (result == Side::IN)
+					planeMask = 0;
+			}
+
+			// test currentTreeNode's belonging sceneNodes
+			const auto &sceneNodes = treeNode->sceneNodes;
+			if (planeMask == 0)
+			{
+				for (const auto &sceneNode : sceneNodes)
+					visitor(sceneNode);
+			}
+			else if (frustum != nullptr)
+			{
+				unsigned int sceneNodeCount = sceneNodes.size();
+				for (unsigned int first = 0; first < sceneNodeCount; first += batchSize)
+				{
+					unsigned int count = std::min(sceneNodeCount - first, batchSize);
+					if (frustum->IsInsideFast(treeNode->sceneNodeAABBs, first, count, visible.data(), planeMask) == 0)
+						continue;
+
+					for (unsigned int i = 0; i < count; i++)
+					{
+						if (visible[i])
+							visitor(sceneNodes[first + i]);
+					}
+				}
+			}
+			else
+			{
+				for (const auto &sceneNode : sceneNodes)
+				{
+					if (collider.IsInsideFast(sceneNode->GetWorldAABB()))
+						visitor(sceneNode);
+				}
+			}
+
+			// push currentTreeNode's non-empty childs.
+			for (int i = 0; i < 8; i++)
+			{
+				int child = treeNode->childs[i];
+				if (child >= 0 && m_TreeNodes[child].totalSceneNodeCount > 0)
+					possiblePairs[top++] = std::make_pair(planeMask, &m_TreeNodes[child]);
+			}
+		}
+	}
+}
+
+#endif // _FURY_LOOSE_OCTREE_H_
\ No newline at end of file
@@ -38,4 +38,12 @@ do {} while (false)
 
 #define FURY_MIPMAP_LEVEL 5
 
+// simd instruction set used by batch kernels, scalar code is used when none is available.
+#if defined(__AVX__)
+	#define FURY_SIMD_AVX
+	#define FURY_SIMD_SSE
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define FURY_SIMD_SSE
+#endif
+
 #endif // _FURY_MACROS_H_
\ No newline at end of file
@@ -243,6 +243,9 @@ namespace fury
 	{
 		m_Textures.clear();
 		m_Uniforms.clear();
+		m_TextureIDs.clear();
+		m_UniformIDs.clear();
+		m_UniformBlockDirty = true;
 	}
 
 	unsigned int Material::GetTextureFlags() const
@@ -274,6 +277,10 @@ namespace fury
 			m_Textures[name] = ptr;
 		}
 
+		m_TextureIDs.clear();
+		for (auto &pair : m_Textures)
+			m_TextureIDs.emplace_back(Shader::GetUniformID(pair.first), pair.second);
+
 		// calculate new matching shaderType
 		bool hasTexture = false;
 		m_TextureFlags = 0;
@@ -323,6 +330,12 @@ namespace fury
 		{
 			m_Uniforms[name] = ptr;
 		}
+
+		m_UniformIDs.clear();
+		for (auto &pair : m_Uniforms)
+			m_UniformIDs.emplace_back(Shader::GetUniformID(pair.first), pair.second);
+
+		m_UniformBlockDirty = true;
 	}
 
 	std::shared_ptr<UniformBase> Material::GetUniform(const std::string &name)
@@ -339,6 +352,47 @@ namespace fury
 		return m_Uniforms.size();
 	}
 
+	const Std140Block &Material::GetUniformBlock()
+	{
+		unsigned int version = 0;
+		for (const auto &pair : m_UniformIDs)
+			version += pair.second->GetVersion();
+
+		if (!m_UniformBlockDirty && version == m_UniformVersion)
+			return m_UniformBlock;
+
+		auto getFloat = [&](const std::string &name, unsigned int index, float defaultValue) -> float
+		{
+			auto it = m_Uniforms.find(name);
+			if (it == m_Uniforms.end() || index >= it->second->GetSize())
+				return defaultValue;
+			return it->second->GetFloatAt(index);
+		};
+
+		auto addColor = [&](const std::string &name)
+		{
+			m_UniformBlock.AddVec3(getFloat(name, 0, 0.0f), getFloat(name, 1, 0.0f), getFloat(name, 2, 0.0f));
+		};
+
+		// same layout as MaterialBlock in glsl.
+		m_UniformBlock.Clear();
+		addColor(AMBIENT_COLOR);
+		m_UniformBlock.AddFloat(getFloat(AMBIENT_FACTOR, 0, 1.0f));
+		addColor(DIFFUSE_COLOR);
+		m_UniformBlock.AddFloat(getFloat(DIFFUSE_FACTOR, 0, 1.0f));
+		addColor(SPECULAR_COLOR);
+		m_UniformBlock.AddFloat(getFloat(SPECULAR_FACTOR, 0, 1.0f));
+		addColor(EMISSIVE_COLOR);
+		m_UniformBlock.AddFloat(getFloat(EMISSIVE_FACTOR, 0, 1.0f));
+		m_UniformBlock.AddFloat(getFloat(SHININESS, 0, 0.0f));
+		m_UniformBlock.AddFloat(getFloat(TRANSPARENCY, 0, 0.0f));
+		m_UniformBlock.AddUInt(m_ID);
+
+		m_UniformBlockDirty = false;
+		m_UniformVersion = version;
+		return m_UniformBlock;
+	}
+
 	void Material::SetShaderForPass(unsigned int index, const std::shared_ptr<Shader> &shader)
 	{
 		if (index >= m_Shaders.size())
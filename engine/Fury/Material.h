@@ -6,6 +6,7 @@
 #include "Fury/Entity.h"
 #include "Fury/EnumUtil.h"
 #include "Fury/Buffer.h"
+#include "Fury/UniformBuffer.h"
 
 namespace fury
 {
@@ -69,6 +70,19 @@ namespace fury
 
 		UniformMap m_Uniforms;
 
+		// same entries keyed by Shader::GetUniformID, so binding needs no string lookups.
+		std::vector<std::pair<unsigned int, std::shared_ptr<Texture>>> m_TextureIDs;
+
+		std::vector<std::pair<unsigned int, std::shared_ptr<UniformBase>>> m_UniformIDs;
+
+		Std140Block m_UniformBlock;
+
+		bool m_UniformBlockDirty = true;
+
+		// sum of uniform versions when m_UniformBlock was packed, 
+		// catches values changed through GetUniform.
+		unsigned int m_UniformVersion = 0;
+
 		std::vector<std::shared_ptr<Shader>> m_Shaders;
 
 		unsigned int m_TextureFlags;
@@ -105,6 +119,9 @@ namespace fury
 
 		unsigned int GetUniformCount() const;
 
+		// uniforms packed for shaders using UniformBlock::MATERIAL, repacked after SetUniform or a uniform's data changes.
+		const Std140Block &GetUniformBlock();
+
 		void SetShaderForPass(unsigned int index, const std::shared_ptr<Shader> &shader);
 
 		std::shared_ptr<Shader> GetShaderForPass(unsigned int index);
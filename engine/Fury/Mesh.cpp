@@ -2,7 +2,9 @@
 
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshArena.h"
 #include "Fury/SceneNode.h"
 #include "Fury/Joint.h"
 
@@ -16,7 +18,7 @@ namespace fury
 	}
 
 	SubMesh::SubMesh() :
-		m_VAO(0), Indices("vertex_index", GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW),
+		m_VAO(0), m_ArenaIndices(MeshArena::INVALID), Indices("vertex_index", GL_STATIC_DRAW),
 		m_TypeIndex(typeid(SubMesh))
 	{
 
@@ -36,6 +38,7 @@ namespace fury
 
 		if (m_VAO != 0)
 		{
+			GLStateCache::ForgetVertexArray(m_VAO);
 			glDeleteVertexArrays(1, &m_VAO);
 			m_VAO = 0;
 		}
@@ -54,6 +57,7 @@ namespace fury
 
 		if (m_VAO != 0)
 		{
+			GLStateCache::ForgetVertexArray(m_VAO);
 			glDeleteVertexArrays(1, &m_VAO);
 			m_VAO = 0;
 		}
@@ -78,14 +82,28 @@ namespace fury
 		return std::make_shared<Mesh>(name);
 	}
 
-	Mesh::Mesh(const std::string &name) : Entity(name), m_VAO(0),
-		Indices("vertex_index", GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW),
+	unsigned int Mesh::m_GlobalID = 0;
+
+	unsigned int Mesh::GetMeshID()
+	{
+		return ++m_GlobalID;
+	}
+
+	unsigned int Mesh::GetID() const
+	{
+		return m_ID;
+	}
+
+	Mesh::Mesh(const std::string &name) : Entity(name), m_ID(GetMeshID()), m_VAO(0),
+		m_ArenaVertices(MeshArena::INVALID), m_ArenaIndices(MeshArena::INVALID),
+		Indices("vertex_index", GL_STATIC_DRAW),
 		Positions("vertex_position", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
 		Normals("vertex_normal", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
 		Tangents("vertex_tangent", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
 		UVs("vertex_uv", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
 		IDs("bone_ids", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
-		Weights("bone_weights", GL_ARRAY_BUFFER, GL_STATIC_DRAW)
+		Weights("bone_weights", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
+		Vertices("vertex_data", GL_ARRAY_BUFFER, GL_STATIC_DRAW)
 	{
 		m_TypeIndex = typeid(Mesh);
 	};
@@ -129,6 +147,10 @@ namespace fury
 
 		LoadMemberValue(wrapper, "cast_shadows", m_CastShadows);
 
+		std::string str;
+		if (LoadMemberValue(wrapper, "vertex_format", str))
+			m_VertexFormat = EnumUtil::VertexFormatFromString(str);
+
 		// model aabb
 		LoadMemberValue(wrapper, "aabb", m_AABB);
 
@@ -163,6 +185,9 @@ namespace fury
 		SaveKey(wrapper, "cast_shadows");
 		SaveValue(wrapper, m_CastShadows);
 
+		SaveKey(wrapper, "vertex_format");
+		SaveValue(wrapper, EnumUtil::VertexFormatToString(m_VertexFormat));
+
 		SaveKey(wrapper, "positions");
 		SaveArray(wrapper, Positions.Data);
 
@@ -253,18 +278,50 @@ namespace fury
 
 	void Mesh::UpdateBuffer()
 	{
-		Positions.UpdateBuffer();
-		Normals.UpdateBuffer();
-		Tangents.UpdateBuffer();
-		UVs.UpdateBuffer();
-		Weights.UpdateBuffer();
-		IDs.UpdateBuffer();
-		Indices.UpdateBuffer();
+		ReleaseArena();
+
+		if (UpdateArenaBuffer())
+			return;
 
-		m_Dirty = Indices.GetDirty() || Positions.GetDirty();
+		if (m_VertexFormat == VertexFormat::SEPARATE)
+		{
+			Vertices.DeleteBuffer();
+			m_VertexLayout = VertexLayout();
+
+			Positions.UpdateBuffer();
+			Normals.UpdateBuffer();
+			Tangents.UpdateBuffer();
+			UVs.UpdateBuffer();
+			Weights.UpdateBuffer();
+			IDs.UpdateBuffer();
+			Indices.UpdateBuffer();
+
+			m_Dirty = Indices.GetDirty() || Positions.GetDirty();
+		}
+		else
+		{
+			Positions.DeleteBuffer();
+			Normals.DeleteBuffer();
+			Tangents.DeleteBuffer();
+			UVs.DeleteBuffer();
+			Weights.DeleteBuffer();
+			IDs.DeleteBuffer();
+
+			// source arrays stay on cpu for bounds and serialization, 
+			// the packed copy is dropped once it's uploaded.
+			m_VertexLayout = VertexPacker::Pack(*this, m_VertexFormat, Vertices.Data);
+			Vertices.SetDirty();
+			Vertices.UpdateBuffer();
+			std::vector<unsigned char>().swap(Vertices.Data);
+
+			Indices.UpdateBuffer();
+
+			m_Dirty = Indices.GetDirty() || Vertices.GetDirty();
+		}
 
 		if (m_VAO != 0)
 		{
+			GLStateCache::ForgetVertexArray(m_VAO);
 			glDeleteVertexArrays(1, &m_VAO);
 			m_VAO = 0;
 		}
@@ -287,8 +344,11 @@ namespace fury
 	{
 		m_Dirty = true;
 
+		ReleaseArena();
+
 		if (m_VAO != 0)
 		{
+			GLStateCache::ForgetVertexArray(m_VAO);
 			glDeleteVertexArrays(1, &m_VAO);
 			m_VAO = 0;
 		}
@@ -299,6 +359,7 @@ namespace fury
 		Weights.DeleteBuffer();
 		IDs.DeleteBuffer();
 		Indices.DeleteBuffer();
+		Vertices.DeleteBuffer();
 
 		for (auto subMesh : m_SubMeshes)
 			if (subMesh != nullptr)
@@ -372,4 +433,164 @@ namespace fury
 	{
 		m_CastShadows = state;
 	}
+
+	void Mesh::SetVertexFormat(VertexFormat format)
+	{
+		if (m_VertexFormat != format)
+		{
+			m_VertexFormat = format;
+			m_Dirty = true;
+		}
+	}
+
+	VertexFormat Mesh::GetVertexFormat() const
+	{
+		return m_VertexFormat;
+	}
+
+	const VertexLayout &Mesh::GetVertexLayout() const
+	{
+		return m_VertexLayout;
+	}
+
+	void Mesh::SetUseArena(bool state)
+	{
+		if (m_UseArena != state)
+		{
+			m_UseArena = state;
+			m_Dirty = true;
+		}
+	}
+
+	bool Mesh::GetUseArena() const
+	{
+		return m_UseArena;
+	}
+
+	bool Mesh::IsInArena() const
+	{
+		return m_ArenaVertices != MeshArena::INVALID;
+	}
+
+	DrawRange Mesh::GetDrawRange() const
+	{
+		DrawRange range;
+		range.indexCount = Indices.Data.size();
+
+		if (IsInArena())
+		{
+			auto &arena = MeshArena::Instance();
+			range.indexType = GL_UNSIGNED_SHORT;
+			range.indexOffset = arena->GetIndexOffset(m_ArenaIndices);
+			range.baseVertex = arena->GetBaseVertex(m_ArenaVertices);
+		}
+		else
+		{
+			range.indexType = Indices.GetIndexType();
+		}
+
+		return range;
+	}
+
+	DrawRange Mesh::GetDrawRange(unsigned int subMesh) const
+	{
+		auto ptr = GetSubMeshAt(subMesh);
+		if (ptr == nullptr)
+			return DrawRange();
+
+		DrawRange range;
+		range.indexCount = ptr->Indices.Data.size();
+
+		if (IsInArena())
+		{
+			auto &arena = MeshArena::Instance();
+			range.indexType = GL_UNSIGNED_SHORT;
+			range.indexOffset = arena->GetIndexOffset(ptr->m_ArenaIndices);
+			range.baseVertex = arena->GetBaseVertex(m_ArenaVertices);
+		}
+		else
+		{
+			range.indexType = ptr->Indices.GetIndexType();
+		}
+
+		return range;
+	}
+
+	bool Mesh::UpdateArenaBuffer()
+	{
+		unsigned int vertexCount = Positions.Data.size() / 3;
+		if (!m_UseArena || IsSkinnedMesh() || vertexCount == 0 || vertexCount >= 0xffff)
+			return false;
+
+		auto &arena = MeshArena::Instance();
+
+		std::vector<unsigned char> vertices;
+		VertexPacker::Pack(*this, MeshArena::GetVertexLayout(), vertices);
+
+		m_ArenaVertices = arena->AllocateVertices(vertices);
+		m_ArenaIndices = arena->AllocateIndices(Indices.Data);
+
+		bool success = m_ArenaVertices != MeshArena::INVALID && m_ArenaIndices != MeshArena::INVALID;
+		for (auto subMesh : m_SubMeshes)
+		{
+			if (subMesh == nullptr)
+				continue;
+
+			subMesh->m_ArenaIndices = arena->AllocateIndices(subMesh->Indices.Data);
+			success = success && subMesh->m_ArenaIndices != MeshArena::INVALID;
+		}
+
+		if (!success)
+		{
+			FURYW << "Failed to store " << m_Name << " in MeshArena!";
+			ReleaseArena();
+			return false;
+		}
+
+		// own buffers aren't needed while the mesh is in the arena.
+		if (m_VAO != 0)
+		{
+			GLStateCache::ForgetVertexArray(m_VAO);
+			glDeleteVertexArrays(1, &m_VAO);
+			m_VAO = 0;
+		}
+		Positions.DeleteBuffer();
+		Normals.DeleteBuffer();
+		Tangents.DeleteBuffer();
+		UVs.DeleteBuffer();
+		Weights.DeleteBuffer();
+		IDs.DeleteBuffer();
+		Indices.DeleteBuffer();
+		Vertices.DeleteBuffer();
+
+		for (auto subMesh : m_SubMeshes)
+		{
+			if (subMesh != nullptr)
+			{
+				subMesh->DeleteBuffer();
+				subMesh->m_Dirty = false;
+			}
+		}
+
+		m_VertexLayout = MeshArena::GetVertexLayout();
+		m_Dirty = false;
+
+		return true;
+	}
+
+	void Mesh::ReleaseArena()
+	{
+		MeshArena::FreeVertices(m_ArenaVertices);
+		MeshArena::FreeIndices(m_ArenaIndices);
+		m_ArenaVertices = m_ArenaIndices = MeshArena::INVALID;
+
+		for (auto subMesh : m_SubMeshes)
+		{
+			if (subMesh != nullptr)
+			{
+				MeshArena::FreeIndices(subMesh->m_ArenaIndices);
+				subMesh->m_ArenaIndices = MeshArena::INVALID;
+			}
+		}
+	}
 }
\ No newline at end of file
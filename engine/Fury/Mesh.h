@@ -8,15 +8,32 @@
 #include "Fury/ArrayBuffers.h"
 #include "Fury/BoxBounds.h"
 #include "Fury/Buffer.h"
+#include "Fury/VertexPacker.h"
 
 namespace fury
 {
+	// where a mesh's or submesh's indices are once it's bound.
+	struct FURY_API DrawRange
+	{
+		unsigned int indexCount = 0;
+
+		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+		unsigned int indexType = 0;
+
+		// in bytes
+		size_t indexOffset = 0;
+
+		int baseVertex = 0;
+	};
+
 	class FURY_API SubMesh final : public Buffer, public TypeComparable
 	{
 	public:
 
 		friend class Shader;
 
+		friend class Mesh;
+
 		typedef std::shared_ptr<SubMesh> Ptr;
 
 		static Ptr Create();
@@ -27,9 +44,11 @@ namespace fury
 
 		unsigned int m_VAO;
 
+		unsigned int m_ArenaIndices;
+
 	public:
 
-		ArrayBufferui Indices;
+		IndexBuffer Indices;
 
 		SubMesh();
 
@@ -61,8 +80,21 @@ namespace fury
 
 		static Ptr Create(const std::string &name);
 
+	private:
+
+		static unsigned int m_GlobalID;
+
 	protected:
 
+		unsigned int GetMeshID();
+
+		// false if mesh doesn't use or doesn't fit the arena.
+		bool UpdateArenaBuffer();
+
+		void ReleaseArena();
+
+		unsigned int m_ID;
+
 		unsigned int m_VAO;
 
 		BoxBounds m_AABB;
@@ -77,6 +109,16 @@ namespace fury
 
 		bool m_CastShadows = false;
 
+		VertexFormat m_VertexFormat = VertexFormat::SEPARATE;
+
+		VertexLayout m_VertexLayout;
+
+		bool m_UseArena = false;
+
+		unsigned int m_ArenaVertices;
+
+		unsigned int m_ArenaIndices;
+
 	public:
 
 		ArrayBufferf Positions;
@@ -91,7 +133,10 @@ namespace fury
 
 		ArrayBufferui IDs;
 
-		ArrayBufferui Indices;
+		IndexBuffer Indices;
+
+		// interleaved vertex data, only used when vertex format isn't SEPARATE.
+		ArrayBufferub Vertices;
 
 		Mesh(const std::string &name);
 
@@ -131,6 +176,29 @@ namespace fury
 		bool GetCastShadows() const;
 
 		void SetCastShadows(bool state);
+
+		// takes effect on next UpdateBuffer.
+		void SetVertexFormat(VertexFormat format);
+
+		VertexFormat GetVertexFormat() const;
+
+		// layout of the uploaded Vertices, stride is 0 when vertex format is SEPARATE.
+		const VertexLayout &GetVertexLayout() const;
+
+		// static meshes with less than 65535 vertices can be stored in MeshArena,
+		// others keep their own buffers. takes effect on next UpdateBuffer.
+		void SetUseArena(bool state);
+
+		bool GetUseArena() const;
+
+		bool IsInArena() const;
+
+		DrawRange GetDrawRange() const;
+
+		DrawRange GetDrawRange(unsigned int subMesh) const;
+
+		// get this mesh's unique identifier for rendering.
+		unsigned int GetID() const;
 	};
 }
 
@@ -0,0 +1,263 @@
+#include <algorithm>
+
+#include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
+#include "Fury/Log.h"
+#include "Fury/MeshArena.h"
+
+namespace fury
+{
+	namespace
+	{
+		VertexLayout CreateArenaLayout()
+		{
+			VertexLayout layout;
+			layout.position = 0;
+			layout.normal = 12;
+			layout.tangent = 16;
+			layout.uv = 20;
+			layout.stride = 24;
+			return layout;
+		}
+
+		// same order as GetVertexLayout()'s attributes.
+		const char *ATTRIBUTE_NAMES[] = { "vertex_position", "vertex_normal", "vertex_tangent", "vertex_uv" };
+	}
+
+	const unsigned int MeshArena::DEFAULT_VERTEX_COUNT = 65536;
+
+	const unsigned int MeshArena::DEFAULT_INDEX_COUNT = 196608;
+
+	const unsigned int MeshArena::INVALID = ArenaAllocator::INVALID;
+
+	const VertexLayout MeshArena::m_VertexLayout = CreateArenaLayout();
+
+	const VertexLayout &MeshArena::GetVertexLayout()
+	{
+		return m_VertexLayout;
+	}
+
+	void MeshArena::BindAttribLocations(unsigned int program)
+	{
+		for (unsigned int i = 0; i < 4; i++)
+			glBindAttribLocation(program, i, ATTRIBUTE_NAMES[i]);
+	}
+
+	void MeshArena::FreeVertices(unsigned int handle)
+	{
+		if (m_Instance != nullptr)
+			m_Instance->m_Vertices.Free(handle);
+	}
+
+	void MeshArena::FreeIndices(unsigned int handle)
+	{
+		if (m_Instance != nullptr)
+			m_Instance->m_Indices.Free(handle);
+	}
+
+	MeshArena::MeshArena(unsigned int vertexCount, unsigned int indexCount)
+		: m_Vertices(vertexCount), m_Indices(indexCount)
+	{
+		glGenBuffers(1, &m_VBO);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_VBO);
+		glBufferData(GL_COPY_WRITE_BUFFER, vertexCount * m_VertexLayout.stride, nullptr, GL_STATIC_DRAW);
+
+		glGenBuffers(1, &m_EBO);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_EBO);
+		glBufferData(GL_COPY_WRITE_BUFFER, indexCount * sizeof(unsigned short), nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		glGenVertexArrays(1, &m_VAO);
+		SetupVertexArray();
+	}
+
+	MeshArena::~MeshArena()
+	{
+		if (m_VAO != 0)
+		{
+			GLStateCache::ForgetVertexArray(m_VAO);
+			glDeleteVertexArrays(1, &m_VAO);
+		}
+		if (m_VBO != 0)
+			glDeleteBuffers(1, &m_VBO);
+		if (m_EBO != 0)
+			glDeleteBuffers(1, &m_EBO);
+	}
+
+	unsigned int MeshArena::AllocateVertices(const std::vector<unsigned char> &data)
+	{
+		unsigned int count = data.size() / m_VertexLayout.stride;
+		if (count == 0)
+			return INVALID;
+
+		unsigned int handle = m_Vertices.Allocate(count);
+		if (handle == INVALID)
+		{
+			Reserve(m_Vertices, m_VBO, m_VertexLayout.stride, count);
+			handle = m_Vertices.Allocate(count);
+		}
+
+		if (handle != INVALID)
+		{
+			// uploads never touch the element binding of the bound vao.
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_VBO);
+			glBufferSubData(GL_COPY_WRITE_BUFFER, m_Vertices.GetOffset(handle) * m_VertexLayout.stride, 
+				count * m_VertexLayout.stride, data.data());
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		}
+
+		return handle;
+	}
+
+	unsigned int MeshArena::AllocateIndices(const std::vector<unsigned int> &data)
+	{
+		unsigned int count = data.size();
+		if (count == 0)
+			return INVALID;
+
+		unsigned int handle = m_Indices.Allocate(count);
+		if (handle == INVALID)
+		{
+			Reserve(m_Indices, m_EBO, sizeof(unsigned short), count);
+			handle = m_Indices.Allocate(count);
+		}
+
+		if (handle != INVALID)
+		{
+			std::vector<unsigned short> narrow(data.begin(), data.end());
+
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_EBO);
+			glBufferSubData(GL_COPY_WRITE_BUFFER, m_Indices.GetOffset(handle) * sizeof(unsigned short), 
+				count * sizeof(unsigned short), narrow.data());
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		}
+
+		return handle;
+	}
+
+	int MeshArena::GetBaseVertex(unsigned int handle) const
+	{
+		return (int)m_Vertices.GetOffset(handle);
+	}
+
+	size_t MeshArena::GetIndexOffset(unsigned int handle) const
+	{
+		return m_Indices.GetOffset(handle) * sizeof(unsigned short);
+	}
+
+	unsigned int MeshArena::GetVertexArray() const
+	{
+		return m_VAO;
+	}
+
+	void MeshArena::Defragment()
+	{
+		Relocate(m_Vertices, m_VBO, m_VertexLayout.stride);
+		Relocate(m_Indices, m_EBO, sizeof(unsigned short));
+		SetupVertexArray();
+	}
+
+	unsigned int MeshArena::GetDefragmentCount() const
+	{
+		return m_DefragmentCount;
+	}
+
+	unsigned int MeshArena::GetVertexCount() const
+	{
+		return m_Vertices.GetUsed();
+	}
+
+	unsigned int MeshArena::GetVertexCapacity() const
+	{
+		return m_Vertices.GetCapacity();
+	}
+
+	unsigned int MeshArena::GetIndexCount() const
+	{
+		return m_Indices.GetUsed();
+	}
+
+	unsigned int MeshArena::GetIndexCapacity() const
+	{
+		return m_Indices.GetCapacity();
+	}
+
+	void MeshArena::Reserve(ArenaAllocator &allocator, unsigned int &buffer, unsigned int unitSize, unsigned int size)
+	{
+		// enough space in total, it's only fragmented.
+		if (allocator.GetCapacity() - allocator.GetUsed() < size)
+		{
+			unsigned int capacity = std::max(allocator.GetCapacity() * 2, allocator.GetUsed() + size);
+			FURYD << "MeshArena grows from " << allocator.GetCapacity() << " to " << capacity;
+			allocator.Grow(capacity);
+		}
+
+		Relocate(allocator, buffer, unitSize);
+		SetupVertexArray();
+	}
+
+	void MeshArena::Relocate(ArenaAllocator &allocator, unsigned int &buffer, unsigned int unitSize)
+	{
+		std::vector<ArenaMove> moves;
+		allocator.Defragment(moves);
+
+		// same-buffer copies can't overlap, so blocks move into a fresh buffer.
+		unsigned int newBuffer = 0;
+		glGenBuffers(1, &newBuffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, allocator.GetCapacity() * unitSize, nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+
+		// blocks that didn't move are copied in place, in one run between moved blocks.
+		std::vector<ArenaMove> copies;
+		unsigned int offset = 0;
+		for (const auto &move : moves)
+		{
+			if (move.destOffset > offset)
+			{
+				ArenaMove stay = { ArenaAllocator::INVALID, offset, offset, move.destOffset - offset };
+				copies.push_back(stay);
+			}
+			copies.push_back(move);
+			offset = move.destOffset + move.size;
+		}
+		if (allocator.GetUsed() > offset)
+		{
+			ArenaMove stay = { ArenaAllocator::INVALID, offset, offset, allocator.GetUsed() - offset };
+			copies.push_back(stay);
+		}
+
+		for (const auto &copy : copies)
+		{
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, copy.srcOffset * unitSize, 
+				copy.destOffset * unitSize, copy.size * unitSize);
+		}
+
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		glDeleteBuffers(1, &buffer);
+		buffer = newBuffer;
+
+		m_DefragmentCount++;
+	}
+
+	void MeshArena::SetupVertexArray()
+	{
+		GLStateCache::Instance()->BindVertexArray(m_VAO);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+
+		const auto &layout = m_VertexLayout;
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, layout.stride, (void*)(size_t)layout.position);
+		glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, layout.stride, (void*)(size_t)layout.normal);
+		glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, layout.stride, (void*)(size_t)layout.tangent);
+		glVertexAttribPointer(3, 2, GL_HALF_FLOAT, GL_FALSE, layout.stride, (void*)(size_t)layout.uv);
+		for (unsigned int i = 0; i < 4; i++)
+			glEnableVertexAttribArray(i);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		GLStateCache::Instance()->BindVertexArray(0);
+	}
+}
\ No newline at end of file
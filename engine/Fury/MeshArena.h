@@ -0,0 +1,97 @@
+#ifndef _FURY_MESHARENA_H_
+#define _FURY_MESHARENA_H_
+
+#include <vector>
+
+#include "Fury/ArenaAllocator.h"
+#include "Fury/Singleton.h"
+#include "Fury/VertexPacker.h"
+
+namespace fury
+{
+	// a few large vertex/index buffers shared by static meshes.
+	// meshes draw with base vertex and first index offsets, so consecutive draws
+	// of different meshes keep the same vao bound.
+	// vertices use GetVertexLayout(), indices are 16 bit and local to their mesh.
+	class FURY_API MeshArena final : public Singleton<MeshArena>
+	{
+	public:
+
+		typedef std::shared_ptr<MeshArena> Ptr;
+
+		static const unsigned int DEFAULT_VERTEX_COUNT;
+
+		static const unsigned int DEFAULT_INDEX_COUNT;
+
+		static const unsigned int INVALID;
+
+		static const VertexLayout &GetVertexLayout();
+
+		// call before linking a program, arena attributes live at fixed locations.
+		static void BindAttribLocations(unsigned int program);
+
+		// safe to call after the arena is gone.
+		static void FreeVertices(unsigned int handle);
+
+		static void FreeIndices(unsigned int handle);
+
+	private:
+
+		static const VertexLayout m_VertexLayout;
+
+		ArenaAllocator m_Vertices;
+
+		ArenaAllocator m_Indices;
+
+		unsigned int m_VAO = 0;
+
+		unsigned int m_VBO = 0;
+
+		unsigned int m_EBO = 0;
+
+		unsigned int m_DefragmentCount = 0;
+
+	public:
+
+		MeshArena(unsigned int vertexCount = DEFAULT_VERTEX_COUNT, unsigned int indexCount = DEFAULT_INDEX_COUNT);
+
+		~MeshArena();
+
+		// data is packed with GetVertexLayout(), returns INVALID if it can't be stored.
+		unsigned int AllocateVertices(const std::vector<unsigned char> &data);
+
+		unsigned int AllocateIndices(const std::vector<unsigned int> &data);
+
+		int GetBaseVertex(unsigned int handle) const;
+
+		// byte offset into the index buffer.
+		size_t GetIndexOffset(unsigned int handle) const;
+
+		unsigned int GetVertexArray() const;
+
+		// compacts both buffers, the arena does this itself when an allocation doesn't fit.
+		void Defragment();
+
+		unsigned int GetDefragmentCount() const;
+
+		unsigned int GetVertexCount() const;
+
+		unsigned int GetVertexCapacity() const;
+
+		unsigned int GetIndexCount() const;
+
+		unsigned int GetIndexCapacity() const;
+
+	private:
+
+		// makes room for size units, defragmenting or growing the buffer.
+		void Reserve(ArenaAllocator &allocator, unsigned int &buffer, unsigned int unitSize, unsigned int size);
+
+		// moves allocator's blocks into a new buffer of its current capacity.
+		void Relocate(ArenaAllocator &allocator, unsigned int &buffer, unsigned int unitSize);
+
+		void SetupVertexArray();
+	};
+}
+
+#endif // _FURY_MESHARENA_H_
\ No newline at end of file
@@ -458,7 +458,12 @@ namespace fury
 			}
 		}
 
-		if (updateBuffer)
+		if (updateBuffer && (mesh->GetVertexFormat() != VertexFormat::SEPARATE || mesh->IsInArena()))
+		{
+			// packed vertices are rebuilt from the arrays on next bind.
+			mesh->SetDirty();
+		}
+		else if (updateBuffer)
 		{
 			mesh->Positions.SetDirty();
 			mesh->Positions.UpdateBuffer();
@@ -805,9 +810,15 @@ namespace fury
 				{
 					subMesh->Indices.Data[j] = replaceIndices[subMesh->Indices.Data[j]] & ~0x80000000;
 				}
+				subMesh->Indices.SetDirty();
+				subMesh->SetDirty();
 			}
 		}
 
+		// fewer vertices might fit 16 bit indices now.
+		mesh->Indices.SetDirty();
+		mesh->SetDirty();
+
 		FURYD << mesh->GetName() << "[vtx: " << mesh->Positions.Data.size() / 3 << " tris: " << mesh->Indices.Data.size() / 3 << "]";
 	}
 
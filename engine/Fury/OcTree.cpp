@@ -1,27 +1,30 @@
-#include <deque>
+#include <algorithm>
 
 #include "Fury/Frustum.h"
-#include "Fury/Light.h"
 #include "Fury/Material.h"
-#include "Fury/Mesh.h"
-#include "Fury/MeshRender.h"
 #include "Fury/OcTreeNode.h"
 #include "Fury/OcTree.h"
-#include "Fury/RenderQuery.h"
 #include "Fury/SceneNode.h"
 #include "Fury/SphereBounds.h"
 #include "Fury/Log.h"
 
 namespace fury
 {
+	const unsigned int OcTree::MAX_DEPTH;
+
 	OcTree::Ptr OcTree::Create(Vector4 min, Vector4 max, unsigned int maxDepth)
 	{
 		return std::make_shared<OcTree>(min, max, maxDepth);
 	}
 
 	OcTree::OcTree(Vector4 min, Vector4 max, unsigned int maxDepth) :
-		m_TypeIndex(typeid(OcTree)), m_MaxDepth(maxDepth)
+		m_TypeIndex(typeid(OcTree)), m_MaxDepth(std::min(maxDepth, MAX_DEPTH)), 
+		m_BaseAABB(min, max), m_BaseMaxDepth(m_MaxDepth), m_AutoResize(true), m_GrowCount(0), m_ShrinkCount(0), 
+		m_PlaneTestCount(0), m_PlaneCacheHitCount(0), m_UpdateMoveCount(0), m_UpdateSkipCount(0)
 	{
+		if (maxDepth > MAX_DEPTH)
+			FURYW << "OcTree maxDepth clamped to " << MAX_DEPTH;
+
 		m_Root = OcTreeNode::Create(*this, nullptr, min, max);
 	}
 
@@ -38,6 +41,13 @@ namespace fury
 
 	void OcTree::AddSceneNode(const SceneNode::Ptr &sceneNode)
 	{
+		if (m_Root->m_TotalSceneNodeCount == 0)
+			Shrink();
+
+		BoxBounds nodeBounds = sceneNode->GetWorldAABB();
+		if (ShouldGrow(nodeBounds))
+			Grow(nodeBounds);
+
 		AddSceneNode(sceneNode, m_Root, 0);
 	}
 
@@ -56,153 +66,218 @@ namespace fury
 
 	void OcTree::UpdateSceneNode(const SceneNode::Ptr &sceneNode)
 	{
-		sceneNode->RemoveFromOcTree(false);
-		AddSceneNode(sceneNode);
-	}
+		OcTreeNode::Ptr treeNode = sceneNode->GetOcTreeNode();
+		if (treeNode == nullptr)
+		{
+			AddSceneNode(sceneNode);
+			return;
+		}
 
-	void OcTree::GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear) const
-	{
-		if (clear)
-			renderQuery->Clear();
+		BoxBounds nodeBounds = sceneNode->GetWorldAABB();
+		bool contains = treeNode->Contains(nodeBounds);
 
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		// root also keeps what's out of it's bounds, unless it can grow.
+		if (contains || (treeNode == m_Root && !ShouldGrow(nodeBounds)))
 		{
-			if (sceneNode->GetComponent<Light>() != nullptr)
-				renderQuery->AddLight(sceneNode);
-			
-			if (auto render = sceneNode->GetComponent<MeshRender>())
+			bool fitsChild = contains && treeNode->GetDepth() < m_MaxDepth && 
+				treeNode->IsTwiceSize(nodeBounds) && !treeNode->IsStraddling(nodeBounds);
+
+			if (!fitsChild)
 			{
-				if (render->GetRenderable())
-					renderQuery->AddRenderable(sceneNode);
+				treeNode->UpdateSceneNode(sceneNode);
+				m_UpdateSkipCount++;
+				return;
 			}
-		});
-	}
+		}
 
-	void OcTree::GetVisibleSceneNodes(const Collidable &collider, SceneNodes &sceneNodes, bool clear) const
-	{
-		if (clear)
-			sceneNodes.clear();
+		// walk up to the closest tree node that still contains it, then down from there.
+		OcTreeNode::Ptr startNode = treeNode;
+		while (startNode != m_Root && !startNode->Contains(nodeBounds))
+			startNode = startNode->m_Parent;
+
+		treeNode->RemoveSceneNode(sceneNode);
 
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode) 
+		if (startNode == m_Root && ShouldGrow(nodeBounds))
 		{
-			sceneNodes.push_back(sceneNode);
-		});
+			Grow(nodeBounds);
+			startNode = m_Root;
+		}
+
+		AddSceneNode(sceneNode, startNode, startNode->GetDepth());
+		m_UpdateMoveCount++;
 	}
 
-	void OcTree::GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear) const
+	void OcTree::Reset(Vector4 min, Vector4 max, unsigned int maxDepth)
 	{
-		if (clear)
-			renderables.clear();
+		if (maxDepth > MAX_DEPTH)
+			FURYW << "OcTree maxDepth clamped to " << MAX_DEPTH;
 
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
-		{
-			auto render = sceneNode->GetComponent<MeshRender>();
-			if (render != nullptr && render->GetRenderable())
-				renderables.push_back(sceneNode);
-		});
+		m_MaxDepth = std::min(maxDepth, MAX_DEPTH);
+		m_BaseAABB = BoxBounds(min, max);
+		m_BaseMaxDepth = m_MaxDepth;
+		m_GrowCount = 0;
+		m_ShrinkCount = 0;
+
+		m_Root.reset();
+		m_Root = OcTreeNode::Create(*this, nullptr, min, max);
 	}
 
-	void OcTree::GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear) const
+	void OcTree::Clear()
 	{
-		if (clear)
-			renderables.clear();
-
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
-		{
-			auto render = sceneNode->GetComponent<MeshRender>();
-			if (render != nullptr && render->GetRenderable() && render->GetMesh()->GetCastShadows())
-				renderables.push_back(sceneNode);
-		});
+		m_Root->Clear();
 	}
 
-	void OcTree::GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear) const
+	void OcTree::SetAutoResize(bool value)
 	{
-		if (clear)
-			lights.clear();
-
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
-		{
-			if (sceneNode->GetComponent<Light>() != nullptr)
-				lights.push_back(sceneNode);
+		m_AutoResize = value;
+	}
 
-		});
+	bool OcTree::GetAutoResize() const
+	{
+		return m_AutoResize;
 	}
 
-	void OcTree::GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear) const
+	void OcTree::Shrink()
 	{
-		if (clear)
+		if (m_Root->m_TotalSceneNodeCount == 0)
 		{
-			renderables.clear();
-			lights.clear();
+			if (m_MaxDepth != m_BaseMaxDepth || m_Root->m_AABB != m_BaseAABB)
+			{
+				m_Root->Clear();
+				m_Root->m_AABB = m_BaseAABB;
+				m_MaxDepth = m_BaseMaxDepth;
+				m_ShrinkCount++;
+			}
+			return;
 		}
 
-		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		while (m_MaxDepth > m_BaseMaxDepth && m_Root->m_SceneNodes.size() == 0)
 		{
-			auto render = sceneNode->GetComponent<MeshRender>();
-			if (render != nullptr && render->GetRenderable())
-				renderables.push_back(sceneNode);
-			else if (sceneNode->GetComponent<Light>() != nullptr)
-				lights.push_back(sceneNode);
+			int onlyChild = -1;
+			for (int i = 0; i < 8; i++)
+			{
+				auto child = m_Root->m_Childs[i];
+				if (child != nullptr && child->m_TotalSceneNodeCount > 0)
+				{
+					if (onlyChild >= 0)
+						return;
+					onlyChild = i;
+				}
+			}
+
+			// the child takes root's place, empty siblings are dropped.
+			OcTreeNode::Ptr newRoot = m_Root->m_Childs[onlyChild];
+			m_Root->m_Childs[onlyChild] = nullptr;
+			m_Root->Clear();
 
-		});
+			newRoot->m_Parent = nullptr;
+			newRoot->SetDepth(0);
+			m_Root = newRoot;
+			m_MaxDepth--;
+			m_ShrinkCount++;
+		}
+	}
+
+	BoxBounds OcTree::GetBounds() const
+	{
+		return m_Root->GetAABB();
 	}
 
-	void OcTree::WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const
+	unsigned int OcTree::GetMaxDepth() const
 	{
-		using TreeNodePair = std::pair<bool, OcTreeNode::Ptr>;
+		return m_MaxDepth;
+	}
 
-		std::deque<TreeNodePair> possiblePairs;
-		possiblePairs.push_back(std::make_pair(false, m_Root));
+	unsigned int OcTree::GetRootSceneNodeCount() const
+	{
+		return m_Root->m_SceneNodes.size();
+	}
 
-		while (!possiblePairs.empty())
+	unsigned int OcTree::GetOutOfBoundsSceneNodeCount() const
+	{
+		unsigned int count = 0;
+		for (const auto &sceneNode : m_Root->m_SceneNodes)
 		{
-			// pop next possible node.
-			TreeNodePair currentPair = possiblePairs.back();
-			possiblePairs.pop_back();
+			if (!m_Root->Contains(sceneNode->GetWorldAABB()))
+				count++;
+		}
+		return count;
+	}
+
+	unsigned int OcTree::GetGrowCount() const
+	{
+		return m_GrowCount;
+	}
 
-			// procced
-			bool tested = currentPair.first;
-			OcTreeNode::Ptr treeNode = currentPair.second;
+	unsigned int OcTree::GetShrinkCount() const
+	{
+		return m_ShrinkCount;
+	}
 
-			if (treeNode->GetTotalSceneNodeCount() > 0)
-			{
-				Side result = tested ? Side::IN : collider.IsInside(treeNode->GetAABB());
+	unsigned int OcTree::GetPlaneTestCount() const
+	{
+		return m_PlaneTestCount.load(std::memory_order_relaxed);
+	}
 
-				if (result != Side::OUT)
-				{
-					if (result == Side::IN)
-						tested = true;
-
-					// test currentTreeNode's belonging sceneNodes
-					int sceneNodeCount = treeNode->GetSceneNodeCount();
-					for (int i = 0; i < sceneNodeCount; i++)
-					{
-						SceneNode::Ptr sceneNode = treeNode->GetSceneNodeAt(i);
-						if (tested || collider.IsInsideFast(sceneNode->GetWorldAABB()))
-							filterFunc(sceneNode);
-					}
-
-					// add currentTreeNode's childs to possiblePairs vector.
-					for (int i = 0; i < 8; i++)
-					{
-						OcTreeNode::Ptr childNode = treeNode->GetChildAt(i);
-						if (childNode != nullptr && childNode->GetTotalSceneNodeCount() > 0)
-							possiblePairs.push_back(std::make_pair(tested, childNode));
-					}
-				}
-			}
-		}
+	unsigned int OcTree::GetPlaneCacheHitCount() const
+	{
+		return m_PlaneCacheHitCount.load(std::memory_order_relaxed);
 	}
 
-	void OcTree::Reset(Vector4 min, Vector4 max, unsigned int maxDepth)
+	unsigned int OcTree::GetUpdateMoveCount() const
 	{
-		m_Root.reset();
-		m_Root = OcTreeNode::Create(*this, nullptr, min, max);
+		return m_UpdateMoveCount;
 	}
 
-	void OcTree::Clear()
+	unsigned int OcTree::GetUpdateSkipCount() const
 	{
-		m_Root->Clear();
+		return m_UpdateSkipCount;
+	}
+
+	void OcTree::ResetStatistics()
+	{
+		m_PlaneTestCount = 0;
+		m_PlaneCacheHitCount = 0;
+		m_UpdateMoveCount = 0;
+		m_UpdateSkipCount = 0;
+	}
+
+	Side OcTree::IsInside(const Frustum &frustum, const OcTreeNode &treeNode, unsigned int &planeMask, unsigned int &planeTests) const
+	{
+		const BoxBounds &aabb = treeNode.m_AABB;
+
+		// most nodes rejected last time are rejected by the same plane again.
+		unsigned int lastOutPlane = treeNode.m_LastOutPlane.load(std::memory_order_relaxed);
+		if (planeMask & (1 << lastOutPlane))
+		{
+			planeTests++;
+			Side side = frustum.GetPlane(lastOutPlane).IsInside(aabb);
+			if (side == Side::OUT)
+			{
+				m_PlaneCacheHitCount.fetch_add(1, std::memory_order_relaxed);
+				return Side::OUT;
+			}
+			else if (side == Side::IN)
+			{
+				planeMask &= ~(1 << lastOutPlane);
+			}
+		}
+
+		// then the rest, the one that rejects it is cached for next time.
+		unsigned int cachedMask = planeMask & (1 << lastOutPlane);
+		unsigned int restMask = planeMask & ~cachedMask;
+		unsigned int outPlane = lastOutPlane;
+
+		Side side = SceneManager::IsInside(frustum, aabb, restMask, &planeTests, &outPlane);
+		planeMask = restMask | cachedMask;
+
+		if (side == Side::OUT)
+		{
+			treeNode.m_LastOutPlane.store(outPlane, std::memory_order_relaxed);
+			return Side::OUT;
+		}
+
+		return planeMask == 0 ? Side::IN : Side::STRADDLE;
 	}
 
 	void OcTree::AddSceneNode(const SceneNode::Ptr &sceneNode, const OcTreeNode::Ptr &treeNode, unsigned int depth)
@@ -221,4 +296,65 @@ namespace fury
 		}
 	}
 
+	bool OcTree::ShouldGrow(const BoxBounds &aabb) const
+	{
+		return m_AutoResize && m_MaxDepth < MAX_DEPTH && !aabb.GetInfinite() && !m_Root->Contains(aabb);
+	}
+
+	void OcTree::Grow(const BoxBounds &aabb)
+	{
+		// take out root's scenenodes that are out of it's bounds, the old root will be a child.
+		SceneNodes outNodes;
+		for (const auto &sceneNode : SceneNodes(m_Root->m_SceneNodes))
+		{
+			if (!m_Root->Contains(sceneNode->GetWorldAABB()))
+			{
+				outNodes.push_back(sceneNode);
+				m_Root->RemoveSceneNode(sceneNode);
+			}
+		}
+
+		Vector4 center = aabb.GetCenter();
+
+		while (m_MaxDepth < MAX_DEPTH && !m_Root->Contains(aabb))
+		{
+			Vector4 oldMin = m_Root->m_AABB.GetMin();
+			Vector4 oldMax = m_Root->m_AABB.GetMax();
+			Vector4 oldSize = m_Root->m_AABB.GetSize();
+			Vector4 oldCenter = m_Root->m_AABB.GetCenter();
+
+			// double the size towards aabb on each axis, 
+			// old root takes the lower half if root grew to the positive side.
+			bool negativeX = center.x < oldCenter.x;
+			bool negativeY = center.y < oldCenter.y;
+			bool negativeZ = center.z < oldCenter.z;
+
+			Vector4 min(negativeX ? oldMin.x - oldSize.x : oldMin.x, 
+				negativeY ? oldMin.y - oldSize.y : oldMin.y, 
+				negativeZ ? oldMin.z - oldSize.z : oldMin.z);
+			Vector4 max(negativeX ? oldMax.x : oldMax.x + oldSize.x, 
+				negativeY ? oldMax.y : oldMax.y + oldSize.y, 
+				negativeZ ? oldMax.z : oldMax.z + oldSize.z);
+
+			// same layout as OcTreeNode::GetFitNode.
+			int childIndex = (negativeZ ? 0 : 1) + (negativeY ? 0 : 2) + (negativeX ? 0 : 4);
+
+			OcTreeNode::Ptr newRoot = OcTreeNode::Create(*this, nullptr, min, max);
+			newRoot->m_Childs[childIndex] = m_Root;
+			newRoot->m_TotalSceneNodeCount = m_Root->m_TotalSceneNodeCount;
+
+			m_Root->m_Parent = newRoot;
+			m_Root = newRoot;
+			m_Root->SetDepth(0);
+			m_MaxDepth++;
+			m_GrowCount++;
+		}
+
+		if (m_MaxDepth == MAX_DEPTH && !m_Root->Contains(aabb))
+			FURYW << "OcTree reached max depth " << MAX_DEPTH << ", scenenodes out of bounds are kept in root.";
+
+		for (const auto &sceneNode : outNodes)
+			AddSceneNode(sceneNode, m_Root, 0);
+	}
+
 }
\ No newline at end of file
@@ -1,23 +1,30 @@
 #ifndef _FURY_OCTREE_H_
 #define _FURY_OCTREE_H_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <typeindex>
 
+#include "Fury/Collidable.h"
 #include "Fury/Color.h"
+#include "Fury/Frustum.h"
+#include "Fury/OcTreeNode.h"
 #include "SceneManager.h"
 #include "Fury/Vector4.h"
 
 namespace fury
 {
-	class OcTreeNode;
-
 	// OcTree holds a shared_ptr to attached scenenodes.
 	// When you need to destory a scenenode.
 	// Call node.RemoveFromOcTree(true) + node.RemoveFromParent() + node.reset().
 	// You'll destory this node and all it's childs.
-	class FURY_API OcTree : public SceneManager, public std::enable_shared_from_this<OcTree>
+	// When auto resize is on, a scenenode out of bounds makes root grow towards it, 
+	// the old root becomes a child of the new one and max depth grows with it, 
+	// so cell sizes stay the same. See Shrink for the way back.
+	class FURY_API OcTree : public SceneManagerBase<OcTree>, public std::enable_shared_from_this<OcTree>
 	{
 	public:
 
@@ -25,6 +32,9 @@ namespace fury
 
 		static Ptr Create(Vector4 min, Vector4 max, unsigned int maxDepth = 6);
 
+		// maxDepth is clamped to this, so WalkSceneFast can use a fixed-size stack.
+		static const unsigned int MAX_DEPTH = 16;
+
 	protected:
 
 		std::type_index m_TypeIndex;
@@ -33,6 +43,25 @@ namespace fury
 
 		unsigned int m_MaxDepth;
 
+		// bounds and max depth given at construction or Reset, root never shrinks below them.
+		BoxBounds m_BaseAABB;
+
+		unsigned int m_BaseMaxDepth;
+
+		bool m_AutoResize;
+
+		unsigned int m_GrowCount;
+
+		unsigned int m_ShrinkCount;
+
+		mutable std::atomic<unsigned int> m_PlaneTestCount;
+
+		mutable std::atomic<unsigned int> m_PlaneCacheHitCount;
+
+		unsigned int m_UpdateMoveCount;
+
+		unsigned int m_UpdateSkipCount;
+
 	public:
 
 		OcTree(Vector4 min, Vector4 max, unsigned int maxDepth);
@@ -47,31 +76,173 @@ namespace fury
 
 		virtual void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
 
+		// stays in place if the scenenode still fits it's tree node and not a child of it, 
+		// otherwise it's moved from the closest tree node that still holds it.
 		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
 
-		virtual void GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear = true) const;
+		// Non-virtual version of WalkScene.
+		// Uses a fixed-size stack of raw tree node pointers and passes visible scenenodes 
+		// by reference to the visitor, so no allocation or refcounting happens during traversal.
+		// When collider is a Frustum, childs only test planes their parent straddles, 
+		// each tree node tests the plane that rejected it last time first, 
+		// and tree node's scenenodes are culled in batch with simd.
+		// visitor: void(const std::shared_ptr<SceneNode>&)
+		template<class Visitor>
+		void WalkSceneFast(const Collidable &collider, Visitor &&visitor) const;
 
-		virtual void GetVisibleSceneNodes(const Collidable &collider, SceneNodes &sceneNodes, bool clear = true) const;
+		virtual void Reset(Vector4 min, Vector4 max, unsigned int maxDepth);
 
-		virtual void GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear = true) const;
+		virtual void Clear();
 
-		virtual void GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear = true) const;
+		// on by default, scenenodes out of bounds stay in root when it's off, 
+		// or when max depth reached MAX_DEPTH.
+		void SetAutoResize(bool value);
 
-		virtual void GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear = true) const;
+		bool GetAutoResize() const;
 
-		virtual void GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear = true) const;
+		// Collapse root into it's only non-empty child while root holds no scenenodes, 
+		// not below the base bounds' level. An empty tree goes back to base bounds.
+		// Done on AddSceneNode when the tree is empty, call it after removing lots of scenenodes.
+		void Shrink();
 
-		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const;
+		BoxBounds GetBounds() const;
 
-		virtual void Reset(Vector4 min, Vector4 max, unsigned int maxDepth);
+		unsigned int GetMaxDepth() const;
 
-		virtual void Clear();
+		// scenenodes held by root itself, they're culled one by one.
+		unsigned int GetRootSceneNodeCount() const;
+
+		// scenenodes held by root that are not inside it's bounds.
+		unsigned int GetOutOfBoundsSceneNodeCount() const;
+
+		// times root grew or shrank, since construction or Reset.
+		unsigned int GetGrowCount() const;
+
+		unsigned int GetShrinkCount() const;
+
+		// frustum plane tests done by queries since last ResetStatistics.
+		unsigned int GetPlaneTestCount() const;
+
+		// tree nodes rejected by their cached plane since last ResetStatistics.
+		unsigned int GetPlaneCacheHitCount() const;
+
+		// updates that moved a scenenode to another tree node since last ResetStatistics.
+		unsigned int GetUpdateMoveCount() const;
+
+		// updates that kept a scenenode in it's tree node since last ResetStatistics.
+		unsigned int GetUpdateSkipCount() const;
+
+		// call this once per frame to get per frame statistics.
+		void ResetStatistics();
 
 	protected:
 
+		// test treeNode with frustum planes in planeMask, bits of planes treeNode is fully inside are cleared.
+		Side IsInside(const Frustum &frustum, const OcTreeNode &treeNode, unsigned int &planeMask, unsigned int &planeTests) const;
+
 		void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode, const std::shared_ptr<OcTreeNode> &treeNode, unsigned int depth);
 
+		bool ShouldGrow(const BoxBounds &aabb) const;
+
+		// grow root until aabb is inside or max depth reaches MAX_DEPTH, 
+		// root's scenenodes out of it's bounds are added again from the new root.
+		void Grow(const BoxBounds &aabb);
+
 	};
+
+	template<class Visitor>
+	void OcTree::WalkSceneFast(const Collidable &collider, Visitor &&visitor) const
+	{
+		// planeMask holds the planes a tree node still needs to test, 0 means fully inside.
+		using TreeNodePair = std::pair<unsigned int, const OcTreeNode*>;
+
+		const Frustum *frustum = dynamic_cast<const Frustum*>(&collider);
+		unsigned int planeTests = 0;
+
+		const unsigned int batchSize = 64;
+		std::array<unsigned char, batchSize> visible;
+
+		// each level pops 1 node and pushes at most 8 childs.
+		std::array<TreeNodePair, 7 * MAX_DEPTH + 8> possiblePairs;
+		unsigned int top = 0;
+
+		if (m_Root->m_TotalSceneNodeCount > 0)
+			possiblePairs[top++] = std::make_pair(0x3Fu, m_Root.get());
+
+		while (top > 0)
+		{
+			// pop next possible node.
+			unsigned int planeMask = possiblePairs[--top].first;
+			const OcTreeNode *treeNode = possiblePairs[top].second;
+
+			// root holds scenenodes out of it's bounds, they're tested one by one 
+			// even if root itself is rejected.
+			bool isRoot = treeNode == m_Root.get();
+			Side result = Side::STRADDLE;
+
+			if (planeMask != 0)
+			{
+				result = frustum != nullptr ? IsInside(*frustum, *treeNode, planeMask, planeTests) : 
+					collider.IsInside(treeNode->m_AABB);
+
+				if (result == Side::OUT && !isRoot)
+					continue;
+
+				if (result == Side::IN)
+					planeMask = 0;
+			}
+
+			// test currentTreeNode's belonging sceneNodes
+			const auto &sceneNodes = treeNode->m_SceneNodes;
+			if (planeMask == 0 && !isRoot)
+			{
+				for (const auto &sceneNode : sceneNodes)
+					visitor(sceneNode);
+			}
+			else if (frustum != nullptr)
+			{
+				unsigned int sceneNodeMask = isRoot ? 0x3F : planeMask;
+
+				unsigned int sceneNodeCount = sceneNodes.size();
+				for (unsigned int i = 0; i < 6; i++)
+					planeTests += ((sceneNodeMask >> i) & 1) * sceneNodeCount;
+
+				for (unsigned int first = 0; first < sceneNodeCount; first += batchSize)
+				{
+					unsigned int count = std::min(sceneNodeCount - first, batchSize);
+					if (frustum->IsInsideFast(treeNode->m_SceneNodeAABBs, first, count, visible.data(), sceneNodeMask) == 0)
+						continue;
+
+					for (unsigned int i = 0; i < count; i++)
+					{
+						if (visible[i])
+							visitor(sceneNodes[first + i]);
+					}
+				}
+			}
+			else
+			{
+				for (const auto &sceneNode : sceneNodes)
+				{
+					if (collider.IsInsideFast(sceneNode->GetWorldAABB()))
+						visitor(sceneNode);
+				}
+			}
+
+			if (result == Side::OUT)
+				continue;
+
+			// push currentTreeNode's non-empty childs.
+			for (int i = 0; i < 8; i++)
+			{
+				const OcTreeNode *childNode = treeNode->m_Childs[i].get();
+				if (childNode != nullptr && childNode->m_TotalSceneNodeCount > 0)
+					possiblePairs[top++] = std::make_pair(planeMask, childNode);
+			}
+		}
+
+		m_PlaneTestCount.fetch_add(planeTests, std::memory_order_relaxed);
+	}
 }
 
 #endif // _FURY_OCTREE_H_
\ No newline at end of file
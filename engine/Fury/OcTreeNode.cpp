@@ -14,8 +14,9 @@ namespace fury
 	}
 
 	OcTreeNode::OcTreeNode(OcTree &manager, const OcTreeNode::Ptr &parent, Vector4 min, Vector4 max) :
-		m_TypeIndex(typeid(OcTreeNode)), m_Manager(manager), m_Parent(parent), 
-		m_AABB(min, max), m_IsLeaf(false), m_TotalSceneNodeCount(0)
+		m_TypeIndex(typeid(OcTreeNode)), m_AABB(min, max), m_Manager(manager), m_Parent(parent), 
+		m_IsLeaf(false), m_Depth(parent == nullptr ? 0 : parent->m_Depth + 1), m_TotalSceneNodeCount(0), 
+		m_LastOutPlane(0)
 	{
 
 	}
@@ -47,19 +48,42 @@ namespace fury
 		return m_IsLeaf;
 	}
 
-	OcTreeNode::Ptr OcTreeNode::GetFitNode(BoxBounds other)
+	unsigned int OcTreeNode::GetDepth() const
+	{
+		return m_Depth;
+	}
+
+	bool OcTreeNode::Contains(const BoxBounds &other) const
 	{
-		Vector4 treeCenter = m_AABB.GetCenter();
 		Vector4 treeMin = m_AABB.GetMin();
 		Vector4 treeMax = m_AABB.GetMax();
 
 		Vector4 otherMin = other.GetMin();
 		Vector4 otherMax = other.GetMax();
 
+		return otherMin.x > treeMin.x && otherMin.y > treeMin.y && otherMin.z > treeMin.z &&
+			otherMax.x < treeMax.x && otherMax.y < treeMax.y && otherMax.z < treeMax.z;
+	}
+
+	bool OcTreeNode::IsStraddling(const BoxBounds &other) const
+	{
+		Vector4 treeCenter = m_AABB.GetCenter();
+
+		Vector4 otherMin = other.GetMin();
+		Vector4 otherMax = other.GetMax();
+
+		return (otherMin.x < treeCenter.x && otherMax.x > treeCenter.x) || 
+			(otherMin.y < treeCenter.y && otherMax.y > treeCenter.y) || 
+			(otherMin.z < treeCenter.z && otherMax.z > treeCenter.z);
+	}
+
+	OcTreeNode::Ptr OcTreeNode::GetFitNode(BoxBounds other)
+	{
+		Vector4 treeCenter = m_AABB.GetCenter();
+
 		// test if boungbox is within this treeNode.
 
-		if (otherMin.x <= treeMin.x || otherMin.y <= treeMin.y || otherMin.z <= treeMin.z ||
-			otherMax.x >= treeMax.x || otherMax.y >= treeMax.y || otherMax.z >= treeMax.z)
+		if (!Contains(other))
 			return shared_from_this();
 
 		// test with split planes to find the correct child to fit in.
@@ -89,20 +113,29 @@ namespace fury
 			}
 		}
 
-		Vector4 treeExtents = m_AABB.GetExtents();
+		Vector4 treeMin = m_AABB.GetMin();
+		Vector4 treeMax = m_AABB.GetMax();
 
 		OcTreeNode::Ptr child = m_Childs[childIndex];
 		if (child == nullptr)
 		{
+			// take faces from this tree node as they are, so childs don't stick out by rounding.
+			Vector4 aabbMin(
+				collideResult[2] ? treeMin.x : treeCenter.x,
+				collideResult[1] ? treeMin.y : treeCenter.y,
+				collideResult[0] ? treeMin.z : treeCenter.z,
+				1.0f
+			);
+
 			Vector4 aabbMax(
-				(collideResult[2] ? 0 : 1) * treeExtents.x + treeCenter.x,
-				(collideResult[1] ? 0 : 1) * treeExtents.y + treeCenter.y,
-				(collideResult[0] ? 0 : 1) * treeExtents.z + treeCenter.z,
+				collideResult[2] ? treeCenter.x : treeMax.x,
+				collideResult[1] ? treeCenter.y : treeMax.y,
+				collideResult[0] ? treeCenter.z : treeMax.z,
 				1.0f
 			);
 
 			m_Childs[childIndex] = child = OcTreeNode::Create(
-				m_Manager, shared_from_this(), aabbMax - treeExtents, aabbMax);
+				m_Manager, shared_from_this(), aabbMin, aabbMax);
 		}
 
 		return child;
@@ -134,6 +167,11 @@ namespace fury
 			return nullptr;
 	}
 
+	const BoxBoundsArray &OcTreeNode::GetSceneNodeAABBs() const
+	{
+		return m_SceneNodeAABBs;
+	}
+
 	unsigned int OcTreeNode::GetTotalSceneNodeCount() const
 	{
 		return m_TotalSceneNodeCount;
@@ -145,6 +183,7 @@ namespace fury
 			sceneNode->SetOcTreeNode(nullptr);
 		
 		m_SceneNodes.clear();
+		m_SceneNodeAABBs.Clear();
 		m_IsLeaf = true;
 
 		for (int i = 0; i < 8; i++)
@@ -157,26 +196,45 @@ namespace fury
 
 	void OcTreeNode::AddSceneNode(const std::shared_ptr<SceneNode> &node)
 	{
+		node->m_OcTreeSlot = m_SceneNodes.size();
 		m_SceneNodes.push_back(node);
+		m_SceneNodeAABBs.Add(node->GetWorldAABB());
 		node->SetOcTreeNode(shared_from_this());
 		IncreaseSceneNodeCount();
 	}
 
 	void OcTreeNode::RemoveSceneNode(const std::shared_ptr<SceneNode> &node)
 	{
-		auto it = m_SceneNodes.begin();
-		while (it != m_SceneNodes.end())
-		{
-			if (*it == node)
-				break;
-			++it;
-		}
+		unsigned int slot = node->m_OcTreeSlot;
+		if (slot >= m_SceneNodes.size() || m_SceneNodes[slot] != node)
+			return;
+
+		// swap with last one, and let it know it's new slot.
+		auto &last = m_SceneNodes.back();
+		last->m_OcTreeSlot = slot;
+		m_SceneNodes[slot] = last;
+		m_SceneNodes.pop_back();
+		m_SceneNodeAABBs.SwapRemoveAt(slot);
 
-		if (it != m_SceneNodes.end())
+		node->SetOcTreeNode(nullptr);
+		DecreaseSceneNodeCount();
+	}
+
+	void OcTreeNode::UpdateSceneNode(const std::shared_ptr<SceneNode> &node)
+	{
+		unsigned int slot = node->m_OcTreeSlot;
+		if (slot < m_SceneNodes.size() && m_SceneNodes[slot] == node)
+			m_SceneNodeAABBs.Set(slot, node->GetWorldAABB());
+	}
+
+	void OcTreeNode::SetDepth(unsigned int depth)
+	{
+		m_Depth = depth;
+
+		for (int i = 0; i < 8; i++)
 		{
-			m_SceneNodes.erase(it);
-			node->SetOcTreeNode(nullptr);
-			DecreaseSceneNodeCount();
+			if (auto child = m_Childs[i])
+				child->SetDepth(depth + 1);
 		}
 	}
 
@@ -1,6 +1,9 @@
 #ifndef _FURY_OCTREENODE_H_
 #define _FURY_OCTREENODE_H_
 
+#include <atomic>
+
+#include "Fury/BoxBoundsArray.h"
 #include "Fury/SceneNode.h"
 
 namespace fury
@@ -41,12 +44,20 @@ namespace fury
 
 		std::vector<std::shared_ptr<SceneNode>> m_SceneNodes;
 
+		// world aabbs of m_SceneNodes, in the same order.
+		BoxBoundsArray m_SceneNodeAABBs;
+
 		OcTreeNode::Ptr m_Parent;
 
 		bool m_IsLeaf;
 
+		unsigned int m_Depth;
+
 		unsigned int m_TotalSceneNodeCount;
 
+		// index of the frustum plane that rejected this node last time, tested first next time.
+		mutable std::atomic<unsigned int> m_LastOutPlane;
+
 	public:
 
 		OcTreeNode(OcTree &manager, const OcTreeNode::Ptr &parent, 
@@ -64,6 +75,15 @@ namespace fury
 
 		bool IsLeaf() const;
 
+		// root is 0.
+		unsigned int GetDepth() const;
+
+		// true if other is strictly inside this tree node.
+		bool Contains(const BoxBounds &other) const;
+
+		// true if other crosses one of the split planes at this tree node's center.
+		bool IsStraddling(const BoxBounds &other) const;
+
 		OcTreeNode::Ptr GetFitNode(BoxBounds other);
 
 		std::shared_ptr<OcTreeNode> GetChildAt(unsigned int index) const;
@@ -72,6 +92,8 @@ namespace fury
 
 		std::shared_ptr<SceneNode> GetSceneNodeAt(unsigned int index) const;
 
+		const BoxBoundsArray &GetSceneNodeAABBs() const;
+
 		unsigned int GetTotalSceneNodeCount() const;
 
 		void Clear();
@@ -80,8 +102,14 @@ namespace fury
 
 		void RemoveSceneNode(const std::shared_ptr<SceneNode> &node);
 
+		// refresh the cached world aabb of node.
+		void UpdateSceneNode(const std::shared_ptr<SceneNode> &node);
+
 	protected:
 
+		// set depth of this tree node, childs get the following ones.
+		void SetDepth(unsigned int depth);
+
 		void IncreaseSceneNodeCount();
 
 		void DecreaseSceneNodeCount();
@@ -1,4 +1,5 @@
 #include "Fury/Camera.h"
+#include "Fury/GLStateCache.h"
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
 #include "Fury/Pass.h"
@@ -483,7 +484,7 @@ namespace fury
 		}
 
 		if (!m_Binded)
-			glBindFramebuffer(GL_FRAMEBUFFER, m_FrameBuffer);
+			GLStateCache::Instance()->BindFramebuffer(m_FrameBuffer);
 
 		m_ViewPortWidth = m_ViewPortHeight = 0;
 		m_ColorAttachmentCount = 0;
@@ -562,7 +563,7 @@ namespace fury
 		}
 
 		if (!m_Binded)
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			GLStateCache::Instance()->BindFramebuffer(0);
 
 		m_RenderTargetDirty = false;
 	}
@@ -573,7 +574,7 @@ namespace fury
 			return;
 
 		if (!m_Binded)
-			glBindFramebuffer(GL_FRAMEBUFFER, m_FrameBuffer);
+			GLStateCache::Instance()->BindFramebuffer(m_FrameBuffer);
 
 		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, 0, 0);
 		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, 0, 0);
@@ -583,7 +584,7 @@ namespace fury
 		glDrawBuffers(0, GL_NONE);
 
 		if (!m_Binded)
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			GLStateCache::Instance()->BindFramebuffer(0);
 
 		m_ViewPortWidth = m_ViewPortHeight = 0;
 	}
@@ -591,7 +592,10 @@ namespace fury
 	void Pass::DeleteFrameBuffer()
 	{
 		if (m_FrameBuffer != 0)
+		{
+			GLStateCache::ForgetFramebuffer(m_FrameBuffer);
 			glDeleteFramebuffers(1, &m_FrameBuffer);
+		}
 
 		m_FrameBuffer = 0;
 		m_ColorAttachmentCount = 0;
@@ -648,35 +652,35 @@ namespace fury
 
 		m_Binded = true;
 
-		glBindFramebuffer(GL_FRAMEBUFFER, m_FrameBuffer);
-		glViewport(0, 0, m_ViewPortWidth, m_ViewPortHeight);
+		GLStateCache::Instance()->BindFramebuffer(m_FrameBuffer);
+		GLStateCache::Instance()->Viewport(0, 0, m_ViewPortWidth, m_ViewPortHeight);
 
 		if (clear)
 			Clear(m_ClearMode, m_ClearColor);
 
-		glEnable(GL_DEPTH_TEST);
-		glDepthFunc(EnumUtil::CompareModeToUint(m_CompareMode));
+		GLStateCache::Instance()->Enable(GL_DEPTH_TEST);
+		GLStateCache::Instance()->DepthFunc(EnumUtil::CompareModeToUint(m_CompareMode));
 
 		if (m_BlendMode != BlendMode::REPLACE)
 		{
-			glEnable(GL_BLEND);
-			glBlendFunc(EnumUtil::BlendModeSrc(m_BlendMode),
+			GLStateCache::Instance()->Enable(GL_BLEND);
+			GLStateCache::Instance()->BlendFunc(EnumUtil::BlendModeSrc(m_BlendMode),
 				EnumUtil::BlendModeDest(m_BlendMode));
-			glBlendEquation(EnumUtil::BlendModeOp(m_BlendMode));
+			GLStateCache::Instance()->BlendEquation(EnumUtil::BlendModeOp(m_BlendMode));
 		}
 		else
 		{
-			glDisable(GL_BLEND);
+			GLStateCache::Instance()->Disable(GL_BLEND);
 		}
 
 		if (m_CullMode != CullMode::NONE)
 		{
-			glEnable(GL_CULL_FACE);
-			glCullFace(EnumUtil::CullModeToUint(m_CullMode).second);
+			GLStateCache::Instance()->Enable(GL_CULL_FACE);
+			GLStateCache::Instance()->CullFace(EnumUtil::CullModeToUint(m_CullMode).second);
 		}
 		else
 		{
-			glDisable(GL_CULL_FACE);
+			GLStateCache::Instance()->Disable(GL_CULL_FACE);
 		}
 	}
 
@@ -688,6 +692,6 @@ namespace fury
 			if (texture->GetMipmap())
 				texture->GenerateMipMap();
 		}
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLStateCache::Instance()->BindFramebuffer(0);
 	}
 }
\ No newline at end of file
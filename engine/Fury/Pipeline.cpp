@@ -3,18 +3,26 @@
 
 #include "Fury/BoxBounds.h"
 #include "Fury/Camera.h"
+#include "Fury/CommandBuffer.h"
+#include "Fury/CommandExecutor.h"
+#include "Fury/DynamicBVH.h"
+#include "Fury/GLStateCache.h"
 #include "Fury/Log.h"
 #include "Fury/Light.h"
+#include "Fury/LinearOcTree.h"
+#include "Fury/LooseOcTree.h"
 #include "Fury/EnumUtil.h"
 #include "Fury/EntityManager.h"
 #include "Fury/Scene.h"
 #include "Fury/FileUtil.h"
 #include "Fury/Frustum.h"
 #include "Fury/GLLoader.h"
+#include "Fury/IndirectBatcher.h"
 #include "Fury/Material.h"
 #include "Fury/MathUtil.h"
 #include "Fury/Mesh.h"
 #include "Fury/MeshRender.h"
+#include "Fury/OcTree.h"
 #include "Fury/Pipeline.h"
 #include "Fury/Pass.h"
 #include "Fury/RenderUtil.h"
@@ -24,6 +32,7 @@
 #include "Fury/Shader.h"
 #include "Fury/SphereBounds.h"
 #include "Fury/Texture.h"
+#include "Fury/ThreadUtil.h"
 
 namespace fury
 {
@@ -35,6 +44,10 @@ namespace fury
 
 		m_SharedPass = Pass::Create("SharedPass");
 
+		m_CommandBuffer = CommandBuffer::Create();
+		m_CommandExecutor = GLCommandExecutor::Create();
+		m_ShadowBatcher = IndirectBatcher::Create();
+
 		m_OffsetMatrix = Matrix4({
 			0.5, 0.0, 0.0, 0.0,
 			0.0, 0.5, 0.0, 0.0,
@@ -251,6 +264,27 @@ namespace fury
 		return m_EntityManager->Get<Shader>(name);
 	}
 
+	std::shared_ptr<CommandExecutor> Pipeline::GetCommandExecutor() const
+	{
+		return m_CommandExecutor;
+	}
+
+	void Pipeline::SetCommandExecutor(const std::shared_ptr<CommandExecutor> &executor)
+	{
+		m_CommandExecutor = executor;
+	}
+
+	void Pipeline::FlushCommands()
+	{
+		m_CommandExecutor->Execute(*m_CommandBuffer);
+		m_CommandBuffer->Clear();
+	}
+
+	bool Pipeline::CanDrawIndirect()
+	{
+		return IsSwitchOn(PipelineSwitch::MULTI_DRAW_INDIRECT) && gl::IsMultiDrawIndirectSupported() != 0;
+	}
+
 	std::shared_ptr<SceneNode> Pipeline::GetCurrentCamera() const
 	{
 		return m_CurrentCamera;
@@ -261,6 +295,166 @@ namespace fury
 		m_CurrentCamera = ptr;
 	}
 
+	void Pipeline::QueryVisibility(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<RenderQuery> &query)
+	{
+		ASSERT_MSG(m_CurrentCamera != nullptr, "Pipeline.m_CurrentCamera not found!");
+
+		sceneManager->GetRenderQuery(m_CurrentCamera->GetComponent<Camera>()->GetFrustum(), query);
+
+		auto camPos = m_CurrentCamera->GetWorldPosition();
+		unsigned int lightCount = query->lightNodes.size();
+		query->shadowCasters.clear();
+		query->shadowCasters.resize(lightCount);
+
+		// last job sorts camera's units, others query one light each.
+		ThreadUtil::Instance()->ParallelFor(lightCount + 1, [&](unsigned int index)
+		{
+			if (index == lightCount)
+			{
+				query->Sort(camPos);
+				return;
+			}
+
+			auto &node = query->lightNodes[index];
+			auto light = node->GetComponent<Light>();
+			if (light != nullptr && light->GetCastShadows())
+				query->shadowCasters[index] = QueryShadowCasters(sceneManager, node);
+		});
+	}
+
+	ShadowCasters Pipeline::QueryShadowCasters(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &node)
+	{
+		auto type = node->GetComponent<Light>()->GetType();
+		if (type == LightType::DIRECTIONAL)
+		{
+			if (IsSwitchOn(PipelineSwitch::CASCADED_SHADOW_MAP))
+				return QueryCascadedShadowCasters(sceneManager);
+			else
+				return QueryDirLightShadowCasters(sceneManager);
+		}
+		else if (type == LightType::POINT)
+		{
+			return QueryPointLightShadowCasters(sceneManager, node);
+		}
+		else
+		{
+			return QuerySpotLightShadowCasters(sceneManager, node);
+		}
+	}
+
+	ShadowCasters Pipeline::QueryCascadedShadowCasters(const std::shared_ptr<SceneManager> &sceneManager)
+	{
+		auto camera = m_CurrentCamera->GetComponent<Camera>();
+		auto frustums = GetCascadedFrustums(4);
+
+		// find shadow casters
+		fury::SceneManager::SceneNodes casterAll;
+		sceneManager->GetVisibleShadowCasters(camera->GetFrustum(), casterAll);
+
+		ShadowCasters casterArrays(frustums.size());
+		for (unsigned int i = 0; i < frustums.size(); i++)
+			FilterNodes(frustums[i], casterAll, casterArrays[i]);
+
+		// use camera aabb to include more possible shadow casters to cast shadows.
+		if (camera->GetShadowBounds(false).GetExtents().SquareLength() > 0)
+			sceneManager->GetVisibleShadowCasters(camera->GetShadowBounds(), casterArrays[0], false);
+
+		return casterArrays;
+	}
+
+	ShadowCasters Pipeline::QueryDirLightShadowCasters(const std::shared_ptr<SceneManager> &sceneManager)
+	{
+		auto camera = m_CurrentCamera->GetComponent<Camera>();
+
+		// gen camera frustum
+		auto camFrustum = camera->GetFrustum(camera->GetNear(), camera->GetShadowFar());
+
+		// find shadow casters
+		ShadowCasters casterArrays(1);
+		sceneManager->GetVisibleShadowCasters(camFrustum, casterArrays[0], false);
+
+		// use camera aabb to include more possible shadow casters to cast shadows.
+		if (camera->GetShadowBounds(false).GetExtents().SquareLength() > 0)
+			sceneManager->GetVisibleShadowCasters(camera->GetShadowBounds(), casterArrays[0], false);
+
+		return casterArrays;
+	}
+
+	ShadowCasters Pipeline::QueryPointLightShadowCasters(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &node)
+	{
+		auto radius = node->GetComponent<Light>()->GetRadius();
+		auto lightPos = node->GetWorldPosition();
+
+		fury::SceneManager::SceneNodes casterAll;
+		sceneManager->GetVisibleShadowCasters(SphereBounds(lightPos, radius), casterAll);
+
+		// each cube face only draws casters inside it's own frustum.
+		auto dirMatrices = GetCubeFaceMatrices(lightPos);
+		ShadowCasters casterArrays(dirMatrices.size());
+		for (unsigned int i = 0; i < dirMatrices.size(); i++)
+		{
+			Frustum frustum;
+			frustum.Setup(MathUtil::DegToRad * 90.0f, 1.0f, 1.0f, radius);
+			frustum.Transform(dirMatrices[i].Inverse());
+			FilterNodes(frustum, casterAll, casterArrays[i]);
+		}
+
+		return casterArrays;
+	}
+
+	ShadowCasters Pipeline::QuerySpotLightShadowCasters(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &node)
+	{
+		auto light = node->GetComponent<Light>();
+
+		Frustum frustum;
+		frustum.Setup(light->GetOutterAngle(), 1.0f, 1.0f, light->GetRadius());
+		frustum.Transform(GetSpotLightMatrix(node).Inverse());
+
+		// find shadow casters
+		ShadowCasters casterArrays(1);
+		sceneManager->GetVisibleRenderables(frustum, casterArrays[0]);
+
+		return casterArrays;
+	}
+
+	std::vector<Frustum> Pipeline::GetCascadedFrustums(unsigned int count)
+	{
+		auto camera = m_CurrentCamera->GetComponent<Camera>();
+
+		std::vector<Frustum> frustums(count);
+		float average = (camera->GetFar() - camera->GetNear()) / (float)count;
+		float curNear = camera->GetNear();
+		float curFar = curNear;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			curFar += average;
+			frustums[i] = camera->GetFrustum(curNear, curFar);
+			curNear += average;
+		}
+
+		return frustums;
+	}
+
+	std::vector<Matrix4> Pipeline::GetCubeFaceMatrices(Vector4 position)
+	{
+		// right, left, top, bottom, back, front
+		std::vector<Matrix4> dirMatrices(6);
+		dirMatrices[0].LookAt(position, position + Vector4(1.0f, 0.0f, 0.0f), Vector4(0.0f, -1.0f, 0.0f));
+		dirMatrices[1].LookAt(position, position + Vector4(-1.0f, 0.0f, 0.0f), Vector4(0.0f, -1.0f, 0.0f));
+		dirMatrices[2].LookAt(position, position + Vector4(0.0f, 1.0f, 0.0f), Vector4(0.0f, 0.0f, 1.0f));
+		dirMatrices[3].LookAt(position, position + Vector4(0.0f, -1.0f, 0.0f), Vector4(0.0f, 0.0f, -1.0f));
+		dirMatrices[4].LookAt(position, position + Vector4(0.0f, 0.0f, 1.0f), Vector4(0.0f, -1.0f, 0.0f));
+		dirMatrices[5].LookAt(position, position + Vector4(0.0f, 0.0f, -1.0f), Vector4(0.0f, -1.0f, 0.0f));
+		return dirMatrices;
+	}
+
+	Matrix4 Pipeline::GetSpotLightMatrix(const std::shared_ptr<SceneNode> &node)
+	{
+		Matrix4 lightMatrix;
+		lightMatrix.Rotate(MathUtil::AxisRadToQuat(Vector4::XAxis, MathUtil::DegToRad * 90.0f));
+		return lightMatrix * node->GetInvertWorldMatrix();
+	}
+
 	void Pipeline::FilterNodes(const Collidable &collider, std::vector<std::shared_ptr<SceneNode>> &possibles, std::vector<std::shared_ptr<SceneNode>> &collisions)
 	{
 		collisions.erase(collisions.begin(), collisions.end());
@@ -272,7 +466,7 @@ namespace fury
 		}
 	}
 
-	Matrix4 Pipeline::GetCropMatrix(Matrix4 lightMatrix, Frustum frustum, std::vector<std::shared_ptr<SceneNode>> &casters)
+	Matrix4 Pipeline::GetCropMatrix(Matrix4 lightMatrix, Frustum frustum, const std::vector<std::shared_ptr<SceneNode>> &casters)
 	{
 		// limit z
 		auto corners = frustum.GetCurrentCorners();
@@ -338,12 +532,14 @@ namespace fury
 		return projMatrix * cropMatrix;
 	}
 
-	std::pair<std::shared_ptr<Texture>, std::vector<Matrix4>> Pipeline::DrawCascadedShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	std::pair<std::shared_ptr<Texture>, std::vector<Matrix4>> Pipeline::DrawCascadedShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+		const ShadowCasters *shadowCasters)
 	{
 		const int numSplit = 4;
 
 		// get pointers
 		auto depth_shader = GetShaderByName("leagcy_depth_shader");
+		auto indirect_shader = CanDrawIndirect() ? GetShaderByName("leagcy_depth_instanced_shader") : nullptr;
 		auto depth_buffer = Texture::GetTemporary(1024, 1024, 4, TextureFormat::DEPTH24, TextureType::TEXTURE_2D_ARRAY);
 		depth_buffer->SetBorderColor(Color::White);
 		depth_buffer->SetWrapMode(WrapMode::CLAMP_TO_BORDER);
@@ -358,32 +554,16 @@ namespace fury
 		lightMatrix = lightMatrix * node->GetInvertWorldMatrix();
 
 		// build frustums
-		std::array<Frustum, numSplit> frustums;
-		float average = (camera->GetFar() - camera->GetNear()) / (float)numSplit;
-		float curNear = camera->GetNear();
-		float curFar = curNear;
-		for (int i = 0; i < numSplit; i++)
-		{
-			curFar += average;
-			frustums[i] = camera->GetFrustum(curNear, curFar);
-			curNear += average;
-		}
-
-		// find shadow casters
-		fury::SceneManager::SceneNodes casterAll;
-		sceneManager->GetVisibleShadowCasters(camera->GetFrustum(), casterAll);
+		auto frustums = GetCascadedFrustums(numSplit);
 
-		std::array<fury::SceneManager::SceneNodes, numSplit> casterArrays;
-		for (int i = 0; i < numSplit; i++)
+		// find shadow casters, unless given ones match the splits.
+		ShadowCasters queriedCasters;
+		if (shadowCasters == nullptr || shadowCasters->size() != numSplit)
 		{
-			auto &casters = casterArrays[i];
-			auto &frustum = frustums[i];
-			FilterNodes(frustum, casterAll, casters);
+			queriedCasters = QueryCascadedShadowCasters(sceneManager);
+			shadowCasters = &queriedCasters;
 		}
-
-		// use camera aabb to include more possible shadow casters to cast shadows.
-		if (camera->GetShadowBounds(false).GetExtents().SquareLength() > 0)
-			sceneManager->GetVisibleShadowCasters(camera->GetShadowBounds(), casterArrays[0], false);
+		auto &casterArrays = *shadowCasters;
 
 		// build projection/crop matrices
 		std::array<Matrix4, numSplit> projMatrices;
@@ -406,40 +586,94 @@ namespace fury
 			m_SharedPass->SetCompareMode(CompareMode::LESS);
 			m_SharedPass->SetCullMode(CullMode::BACK);
 
-			m_SharedPass->Bind();
+			m_CommandBuffer->BindPass(m_SharedPass);
+
+			m_CommandBuffer->SetPolygonOffset(true, 1.0f, 1024.0f);
+
+			// casters in the mesh arena are drawn with one multi draw per split.
+			if (indirect_shader != nullptr)
+				m_ShadowBatcher->Build(casterArrays);
 
-			glEnable(GL_POLYGON_OFFSET_FILL);
-			glPolygonOffset(1.0f, 1024.0f);
+			Shader::Ptr current_shader = nullptr;
+			unsigned int batchIndex = 0;
+			int split = 0;
 
-			depth_shader->Bind();
-			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &lightMatrix.Raw[0]);
+			auto UseShader = [&](const Shader::Ptr &shader)
+			{
+				if (current_shader == shader)
+					return;
+
+				current_shader = shader;
+				m_CommandBuffer->BindShader(shader);
+				m_CommandBuffer->BindMatrix(shader, GetUniformIDs().invertViewMatrix, lightMatrix);
+				m_CommandBuffer->BindMatrix(shader, GetUniformIDs().projectionMatrix, projMatrices[split]);
+			};
+
+			auto DrawCaster = [&](const SceneNode::Ptr &caster)
+			{
+				auto casterRender = caster->GetComponent<MeshRender>();
+				auto casterMesh = casterRender->GetMesh();
+
+				UseShader(depth_shader);
+
+				m_CommandBuffer->BindMesh(depth_shader, casterMesh);
+				m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().worldMatrix, caster->GetWorldMatrix());
+
+				m_CommandBuffer->Draw(casterMesh->Indices.Data.size());
+				RenderUtil::Instance()->IncreaseDrawCall();
+
+				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
+			};
+
+			UseShader(depth_shader);
 
 			for (int i = 0; i < numSplit; i++)
 			{
-				depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrices[i].Raw[0]);
+				split = i;
+
+				// the other shader gets this split's projection when it's bound.
+				m_CommandBuffer->BindMatrix(current_shader, GetUniformIDs().projectionMatrix, projMatrices[i]);
 
-				m_SharedPass->SetArrayTextureLayer(i);
+				m_CommandBuffer->SetArrayTextureLayer(m_SharedPass, i);
 
 				auto &casters = casterArrays[i];
-				for (auto &caster : casters)
+
+				if (indirect_shader == nullptr)
 				{
-					auto casterRender = caster->GetComponent<MeshRender>();
-					auto casterMesh = casterRender->GetMesh();
+					for (auto &caster : casters)
+						DrawCaster(caster);
+					continue;
+				}
 
-					depth_shader->BindMesh(casterMesh);
-					depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
+				const auto &batches = m_ShadowBatcher->GetBatches();
+				for (; batchIndex < batches.size() && batches[batchIndex].group == (unsigned int)i; batchIndex++)
+				{
+					const auto &batch = batches[batchIndex];
+					if (!batch.IsIndirect())
+					{
+						DrawCaster(casters[batch.first]);
+						continue;
+					}
 
-					glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
-					RenderUtil::Instance()->IncreaseDrawCall();
+					UseShader(indirect_shader);
 
-					RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
+					// any arena mesh binds the shared vertex array.
+					m_CommandBuffer->BindMesh(indirect_shader, casters[batch.first]->GetComponent<MeshRender>()->GetMesh());
+					m_CommandBuffer->BindIndirect(indirect_shader, m_ShadowBatcher);
+					m_CommandBuffer->DrawIndirect(m_ShadowBatcher, batch.commandOffset, batch.commandCount, batch.indexType);
+					m_CommandBuffer->UnBindIndirect(indirect_shader, m_ShadowBatcher);
+
+					RenderUtil::Instance()->IncreaseDrawCall();
+					RenderUtil::Instance()->IncreaseTriangleCount(m_ShadowBatcher->GetIndexCount(batch));
 				}
 			}
 
-			glDisable(GL_POLYGON_OFFSET_FILL);
-			depth_shader->UnBind();
+			m_CommandBuffer->SetPolygonOffset(false);
+			m_CommandBuffer->UnBindShader(current_shader);
 
-			m_SharedPass->UnBind();
+			m_CommandBuffer->UnBindPass(m_SharedPass);
+
+			FlushCommands();
 		}
 
 		std::vector<Matrix4> matrices;
@@ -449,7 +683,8 @@ namespace fury
 		return std::make_pair(depth_buffer, matrices);
 	}
 
-	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawDirLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawDirLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+		const ShadowCasters *shadowCasters)
 	{
 		// get pointers
 		auto depth_shader = GetShaderByName("leagcy_depth_shader");
@@ -469,13 +704,14 @@ namespace fury
 		// gen camera frustum
 		auto camFrustum = camera->GetFrustum(camera->GetNear(), camera->GetShadowFar());
 
-		// find shadow casters
-		fury::SceneManager::SceneNodes casters;
-		sceneManager->GetVisibleShadowCasters(camFrustum, casters, false);
-
-		// use camera aabb to include more possible shadow casters to cast shadows.
-		if (camera->GetShadowBounds(false).GetExtents().SquareLength() > 0)
-			sceneManager->GetVisibleShadowCasters(camera->GetShadowBounds(), casters, false);
+		// find shadow casters, unless given ones match.
+		ShadowCasters queriedCasters;
+		if (shadowCasters == nullptr || shadowCasters->size() != 1)
+		{
+			queriedCasters = QueryDirLightShadowCasters(sceneManager);
+			shadowCasters = &queriedCasters;
+		}
+		auto &casters = (*shadowCasters)[0];
 
 		// gen projection matrix for light.
 		Matrix4 projMatrix = GetCropMatrix(lightMatrix, camFrustum, casters);
@@ -491,39 +727,41 @@ namespace fury
 			m_SharedPass->SetCompareMode(CompareMode::LESS);
 			m_SharedPass->SetCullMode(CullMode::BACK);
 
-			m_SharedPass->Bind();
+			m_CommandBuffer->BindPass(m_SharedPass);
 
-			glEnable(GL_POLYGON_OFFSET_FILL);
-			glPolygonOffset(1.0f, 1024.0f);
+			m_CommandBuffer->SetPolygonOffset(true, 1.0f, 1024.0f);
 
-			depth_shader->Bind();
-			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &lightMatrix.Raw[0]);
-			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrix.Raw[0]);
+			m_CommandBuffer->BindShader(depth_shader);
+			m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().invertViewMatrix, lightMatrix);
+			m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().projectionMatrix, projMatrix);
 
 			for (auto &caster : casters)
 			{
 				auto casterRender = caster->GetComponent<MeshRender>();
 				auto casterMesh = casterRender->GetMesh();
 
-				depth_shader->BindMesh(casterMesh);
-				depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
+				m_CommandBuffer->BindMesh(depth_shader, casterMesh);
+				m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().worldMatrix, caster->GetWorldMatrix());
 
-				glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+				m_CommandBuffer->Draw(casterMesh->Indices.Data.size());
 				RenderUtil::Instance()->IncreaseDrawCall();
 
 				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
 			}
 
-			glDisable(GL_POLYGON_OFFSET_FILL);
-			depth_shader->UnBind();
+			m_CommandBuffer->SetPolygonOffset(false);
+			m_CommandBuffer->UnBindShader(depth_shader);
+
+			m_CommandBuffer->UnBindPass(m_SharedPass);
 
-			m_SharedPass->UnBind();
+			FlushCommands();
 		}
 
 		return std::make_pair(depth_buffer, m_OffsetMatrix * projMatrix * lightMatrix * m_CurrentCamera->GetWorldMatrix());
 	}
 
-	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawPointLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawPointLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+		const ShadowCasters *shadowCasters)
 	{
 		auto depth_shader = GetShaderByName("cube_depth_shader");
 		auto depth_buffer = Texture::GetTemporary(512, 512, 0, TextureFormat::DEPTH24, TextureType::TEXTURE_CUBE_MAP);
@@ -535,27 +773,22 @@ namespace fury
 
 		auto light = node->GetComponent<Light>();
 		auto radius = light->GetRadius();
-		auto lightSphere = SphereBounds(node->GetWorldPosition(), radius);
 
-		// TODO: filter casters for all six directions.
-		fury::SceneManager::SceneNodes casters;
-		sceneManager->GetVisibleShadowCasters(lightSphere, casters);
+		// find shadow casters of each face, unless given ones match.
+		ShadowCasters queriedCasters;
+		if (shadowCasters == nullptr || shadowCasters->size() != 6)
+		{
+			queriedCasters = QueryPointLightShadowCasters(sceneManager, node);
+			shadowCasters = &queriedCasters;
+		}
 
 		float aspect = (float)depth_buffer->GetWidth() / depth_buffer->GetHeight();
 		Matrix4 projMatrix;
 		projMatrix.PerspectiveFov(MathUtil::DegToRad * 90.0f, aspect, 1.0f, radius);
 
 		// dir matrices that points camera to all 6 directions.
-		// right, left, top, bottom, back, front
-		std::array<Matrix4, 6> dirMatrices;
-
 		auto lightPos = node->GetWorldPosition();
-		dirMatrices[0].LookAt(lightPos, lightPos + Vector4(1.0f, 0.0f, 0.0f), Vector4(0.0f, -1.0f, 0.0f));
-		dirMatrices[1].LookAt(lightPos, lightPos + Vector4(-1.0f, 0.0f, 0.0f), Vector4(0.0f, -1.0f, 0.0f));
-		dirMatrices[2].LookAt(lightPos, lightPos + Vector4(0.0f, 1.0f, 0.0f), Vector4(0.0f, 0.0f, 1.0f));
-		dirMatrices[3].LookAt(lightPos, lightPos + Vector4(0.0f, -1.0f, 0.0f), Vector4(0.0f, 0.0f, -1.0f));
-		dirMatrices[4].LookAt(lightPos, lightPos + Vector4(0.0f, 0.0f, 1.0f), Vector4(0.0f, -1.0f, 0.0f));
-		dirMatrices[5].LookAt(lightPos, lightPos + Vector4(0.0f, 0.0f, -1.0f), Vector4(0.0f, -1.0f, 0.0f));
+		auto dirMatrices = GetCubeFaceMatrices(lightPos);
 
 		// draw casters to depth map, aka shadow map.
 		{
@@ -568,34 +801,34 @@ namespace fury
 			m_SharedPass->SetCompareMode(CompareMode::LESS);
 			m_SharedPass->SetCullMode(CullMode::BACK);
 
-			m_SharedPass->Bind();
+			m_CommandBuffer->BindPass(m_SharedPass);
 
 			/*glEnable(GL_POLYGON_OFFSET_FILL);
 			glPolygonOffset(factor, units);*/
 
-			depth_shader->Bind();
-			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrix.Raw[0]);
-			depth_shader->BindFloat("light_far", radius);
-			depth_shader->BindFloat("light_pos", lightPos.x, lightPos.y, lightPos.z);
+			m_CommandBuffer->BindShader(depth_shader);
+			m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().projectionMatrix, projMatrix);
+			m_CommandBuffer->BindFloat(depth_shader, GetUniformIDs().lightFar, 1, &radius);
+			m_CommandBuffer->BindFloat(depth_shader, GetUniformIDs().lightPos, 3, &lightPos.x);
 
 			for (int i = 0; i < 6; i++)
 			{
 				// TODO: test if it's necessary to clear after attach new cubemap face.
-				m_SharedPass->SetCubeTextureIndex(i);
-				m_SharedPass->Clear(m_SharedPass->GetClearMode(), m_SharedPass->GetClearColor());
+				m_CommandBuffer->SetCubeTextureIndex(m_SharedPass, i);
+				m_CommandBuffer->ClearPass(m_SharedPass);
 
-				for (auto &caster : casters)
+				for (auto &caster : (*shadowCasters)[i])
 				{
 					auto casterRender = caster->GetComponent<MeshRender>();
 					auto casterMesh = casterRender->GetMesh();
 
 					auto ivm = dirMatrices[i];
 
-					depth_shader->BindMesh(casterMesh);
-					depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &ivm.Raw[0]);
-					depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
+					m_CommandBuffer->BindMesh(depth_shader, casterMesh);
+					m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().invertViewMatrix, ivm);
+					m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().worldMatrix, caster->GetWorldMatrix());
 
-					glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+					m_CommandBuffer->Draw(casterMesh->Indices.Data.size());
 					RenderUtil::Instance()->IncreaseDrawCall();
 
 					RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
@@ -603,15 +836,18 @@ namespace fury
 			}
 
 			//glDisable(GL_POLYGON_OFFSET_FILL);
-			depth_shader->UnBind();
+			m_CommandBuffer->UnBindShader(depth_shader);
 
-			m_SharedPass->UnBind();
+			m_CommandBuffer->UnBindPass(m_SharedPass);
+
+			FlushCommands();
 		}
 
 		return std::make_pair(depth_buffer, m_CurrentCamera->GetWorldMatrix());
 	}
 
-	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawSpotLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawSpotLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+		const ShadowCasters *shadowCasters)
 	{
 		// get pointers
 		auto depth_shader = GetShaderByName("leagcy_depth_shader");
@@ -626,22 +862,21 @@ namespace fury
 		auto light = node->GetComponent<Light>();
 		auto radius = light->GetRadius();
 
-		Matrix4 lightMatrix;
-		lightMatrix.Rotate(MathUtil::AxisRadToQuat(Vector4::XAxis, MathUtil::DegToRad * 90.0f));
-		lightMatrix = lightMatrix * node->GetInvertWorldMatrix();
-
-		Frustum frustum;
-		frustum.Setup(light->GetOutterAngle(), 1.0f, 1.0f, light->GetRadius());
-		frustum.Transform(lightMatrix.Inverse());
+		Matrix4 lightMatrix = GetSpotLightMatrix(node);
 
 		// gen projection matrix for light.
 		float aspect = (float)depth_buffer->GetWidth() / depth_buffer->GetHeight();
 		Matrix4 projMatrix;
 		projMatrix.PerspectiveFov(light->GetOutterAngle(), aspect, 1.0f, radius);
 
-		// find shadow casters
-		fury::SceneManager::SceneNodes casters;
-		sceneManager->GetVisibleRenderables(frustum, casters);
+		// find shadow casters, unless given ones match.
+		ShadowCasters queriedCasters;
+		if (shadowCasters == nullptr || shadowCasters->size() != 1)
+		{
+			queriedCasters = QuerySpotLightShadowCasters(sceneManager, node);
+			shadowCasters = &queriedCasters;
+		}
+		auto &casters = (*shadowCasters)[0];
 
 		// draw casters to depth map, aka shadow map.
 		{
@@ -654,48 +889,66 @@ namespace fury
 			m_SharedPass->SetCompareMode(CompareMode::LESS);
 			m_SharedPass->SetCullMode(CullMode::BACK);
 
-			m_SharedPass->Bind();
+			m_CommandBuffer->BindPass(m_SharedPass);
 
-			glEnable(GL_POLYGON_OFFSET_FILL);
-			glPolygonOffset(1.0f, 1024.0f);
+			m_CommandBuffer->SetPolygonOffset(true, 1.0f, 1024.0f);
 
-			depth_shader->Bind();
-			depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &lightMatrix.Raw[0]);
-			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrix.Raw[0]);
+			m_CommandBuffer->BindShader(depth_shader);
+			m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().invertViewMatrix, lightMatrix);
+			m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().projectionMatrix, projMatrix);
 
 			for (auto &caster : casters)
 			{
 				auto casterRender = caster->GetComponent<MeshRender>();
 				auto casterMesh = casterRender->GetMesh();
 
-				depth_shader->BindMesh(casterMesh);
-				depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
+				m_CommandBuffer->BindMesh(depth_shader, casterMesh);
+				m_CommandBuffer->BindMatrix(depth_shader, GetUniformIDs().worldMatrix, caster->GetWorldMatrix());
 
-				glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+				m_CommandBuffer->Draw(casterMesh->Indices.Data.size());
 				RenderUtil::Instance()->IncreaseDrawCall();
 
 				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
 			}
 
-			glDisable(GL_POLYGON_OFFSET_FILL);
-			depth_shader->UnBind();
+			m_CommandBuffer->SetPolygonOffset(false);
+			m_CommandBuffer->UnBindShader(depth_shader);
+
+			m_CommandBuffer->UnBindPass(m_SharedPass);
 
-			m_SharedPass->UnBind();
+			FlushCommands();
 		}
 
 		return std::make_pair(depth_buffer, m_OffsetMatrix * projMatrix * lightMatrix * m_CurrentCamera->GetWorldMatrix());
 	}
 
+	const Pipeline::UniformIDs &Pipeline::GetUniformIDs()
+	{
+		// not at static init, Matrix4's names might not be constructed yet.
+		static const UniformIDs uniformIDs = {
+			Shader::GetUniformID(Matrix4::WORLD_MATRIX), 
+			Shader::GetUniformID(Matrix4::INVERT_VIEW_MATRIX), 
+			Shader::GetUniformID(Matrix4::PROJECTION_MATRIX), 
+			Shader::GetUniformID("light_far"), 
+			Shader::GetUniformID("light_pos"), 
+			Shader::GetUniformID("shadow_buffer"), 
+			Shader::GetUniformID("shadow_matrix"), 
+			Shader::GetUniformID("shadow_far")
+		};
+
+		return uniformIDs;
+	}
+
 	void Pipeline::DrawDebug(const std::shared_ptr<RenderQuery> &query)
 	{
 		ASSERT_MSG(m_CurrentCamera != nullptr, "PrelightPipeline.m_CurrentCamera not found!");
 
 		glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_CULL_FACE);
-		glCullFace(GL_BACK);
-		glDisable(GL_BLEND);
+		GLStateCache::Instance()->Enable(GL_DEPTH_TEST);
+		GLStateCache::Instance()->Enable(GL_CULL_FACE);
+		GLStateCache::Instance()->CullFace(GL_BACK);
+		GLStateCache::Instance()->Disable(GL_BLEND);
 
 		auto meshBoundsOn = IsSwitchOn(PipelineSwitch::MESH_BOUNDS);
 		auto customBoundsOn = IsSwitchOn(PipelineSwitch::CUSTOM_BOUNDS);
@@ -743,6 +996,40 @@ namespace fury
 
 		renderUtil->EndDrawMeshes();
 
-		glDisable(GL_DEPTH_TEST);
+		GLStateCache::Instance()->Disable(GL_DEPTH_TEST);
+	}
+
+	void Pipeline::CollectStatistics(const std::shared_ptr<SceneManager> &sceneManager)
+	{
+		auto renderUtil = RenderUtil::Instance();
+
+		// LinearOcTree's static part is never updated, it's dynamic tree has the counters.
+		auto ocTree = std::dynamic_pointer_cast<OcTree>(sceneManager);
+		if (auto linearOcTree = std::dynamic_pointer_cast<LinearOcTree>(sceneManager))
+			ocTree = linearOcTree->GetDynamicTree();
+
+		if (ocTree != nullptr)
+		{
+			renderUtil->IncreasePlaneTestCount(ocTree->GetPlaneTestCount());
+			renderUtil->IncreasePlaneCacheHitCount(ocTree->GetPlaneCacheHitCount());
+			renderUtil->IncreaseUpdateMoveCount(ocTree->GetUpdateMoveCount());
+			renderUtil->IncreaseUpdateSkipCount(ocTree->GetUpdateSkipCount());
+
+			ocTree->ResetStatistics();
+		}
+		else if (auto bvh = std::dynamic_pointer_cast<DynamicBVH>(sceneManager))
+		{
+			renderUtil->IncreaseUpdateMoveCount(bvh->GetUpdateMoveCount());
+			renderUtil->IncreaseUpdateSkipCount(bvh->GetUpdateSkipCount());
+
+			bvh->ResetStatistics();
+		}
+		else if (auto looseOcTree = std::dynamic_pointer_cast<LooseOcTree>(sceneManager))
+		{
+			renderUtil->IncreaseUpdateMoveCount(looseOcTree->GetUpdateMoveCount());
+			renderUtil->IncreaseUpdateSkipCount(looseOcTree->GetUpdateSkipCount());
+
+			looseOcTree->ResetStatistics();
+		}
 	}
 }
\ No newline at end of file
@@ -5,8 +5,10 @@
 #include <unordered_map>
 #include <string>
 #include <bitset>
+#include <vector>
 
 #include "Fury/Entity.h"
+#include "Fury/RenderQuery.h"
 
 namespace fury
 {
@@ -14,8 +16,14 @@ namespace fury
 
 	class Collidable;
 
+	class CommandBuffer;
+
+	class CommandExecutor;
+
 	class Frustum;
 
+	class IndirectBatcher;
+
 	class Material;
 
 	class Mesh;
@@ -42,6 +50,8 @@ namespace fury
 		MESH_BOUNDS, 
 		LIGHT_BOUNDS, 
 		CUSTOM_BOUNDS, 
+		INSTANCING, 
+		MULTI_DRAW_INDIRECT, 
 		LENGTH
 	};
 
@@ -77,6 +87,14 @@ namespace fury
 
 		Matrix4 m_OffsetMatrix;
 
+		// draw calls are recorded here, and replayed by m_CommandExecutor in FlushCommands.
+		std::shared_ptr<CommandBuffer> m_CommandBuffer;
+
+		std::shared_ptr<CommandExecutor> m_CommandExecutor;
+
+		// shadow casters of all cascades, when multi draw indirect is on.
+		std::shared_ptr<IndirectBatcher> m_ShadowBatcher;
+
 		// end rendering
 
 		// debug
@@ -120,31 +138,94 @@ namespace fury
 
 		std::shared_ptr<Shader> GetShaderByName(const std::string &name);
 
+		std::shared_ptr<CommandExecutor> GetCommandExecutor() const;
+
+		// gl executor by default, NullCommandExecutor for headless runs.
+		void SetCommandExecutor(const std::shared_ptr<CommandExecutor> &executor);
+
 		std::shared_ptr<SceneNode> GetCurrentCamera() const;
 
 		void SetCurrentCamera(const std::shared_ptr<SceneNode> &ptr);
 
 		// begin shaodw mapping
 
+		// camera query, then shadow caster queries of visible lights, and sorting.
+		// the latter are independent jobs on ThreadUtil workers, all finished before returning.
+		void QueryVisibility(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<RenderQuery> &query);
+
+		// casters for each shadow view of the light, no gl calls, safe to run on workers.
+		ShadowCasters QueryShadowCasters(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &node);
+
+		ShadowCasters QueryCascadedShadowCasters(const std::shared_ptr<SceneManager> &sceneManager);
+
+		ShadowCasters QueryDirLightShadowCasters(const std::shared_ptr<SceneManager> &sceneManager);
+
+		ShadowCasters QueryPointLightShadowCasters(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &node);
+
+		ShadowCasters QuerySpotLightShadowCasters(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &node);
+
 		void FilterNodes(const Collidable &collider, std::vector<std::shared_ptr<SceneNode>> &possibles, std::vector<std::shared_ptr<SceneNode>> &collisions);
 
-		Matrix4 GetCropMatrix(Matrix4 lightMatrix, Frustum frustum, std::vector<std::shared_ptr<SceneNode>> &casters);
+		Matrix4 GetCropMatrix(Matrix4 lightMatrix, Frustum frustum, const std::vector<std::shared_ptr<SceneNode>> &casters);
 
-		std::pair<std::shared_ptr<Texture>, std::vector<Matrix4>> DrawCascadedShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
+		std::pair<std::shared_ptr<Texture>, std::vector<Matrix4>> DrawCascadedShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+			const ShadowCasters *shadowCasters = nullptr);
 
-		std::pair<std::shared_ptr<Texture>, Matrix4> DrawDirLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
+		std::pair<std::shared_ptr<Texture>, Matrix4> DrawDirLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+			const ShadowCasters *shadowCasters = nullptr);
 
-		std::pair<std::shared_ptr<Texture>, Matrix4> DrawPointLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
+		std::pair<std::shared_ptr<Texture>, Matrix4> DrawPointLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+			const ShadowCasters *shadowCasters = nullptr);
 
-		std::pair<std::shared_ptr<Texture>, Matrix4> DrawSpotLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
+		std::pair<std::shared_ptr<Texture>, Matrix4> DrawSpotLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+			const ShadowCasters *shadowCasters = nullptr);
 
 		// end shaodw mapping
 
 	protected: 
 
+		// ids of the uniforms bound per draw or per light, see Shader::GetUniformID.
+		struct UniformIDs
+		{
+			unsigned int worldMatrix;
+
+			unsigned int invertViewMatrix;
+
+			unsigned int projectionMatrix;
+
+			unsigned int lightFar;
+
+			unsigned int lightPos;
+
+			unsigned int shadowBuffer;
+
+			unsigned int shadowMatrix;
+
+			unsigned int shadowFar;
+		};
+
+		// resolved on first call.
+		static const UniformIDs &GetUniformIDs();
+
 		void DrawDebug(const std::shared_ptr<RenderQuery> &query);
 
+		// moves scene manager's counters to RenderUtil and resets them, once per frame.
+		void CollectStatistics(const std::shared_ptr<SceneManager> &sceneManager);
+
+		// replay and clear recorded commands, call before any inline gl call.
+		void FlushCommands();
+
+		// switch is on and the driver has glMultiDrawElementsIndirect.
+		bool CanDrawIndirect();
+
 		void SortPassByIndex();
+
+		std::vector<Frustum> GetCascadedFrustums(unsigned int count);
+
+		// view matrices of cubemap faces.
+		std::vector<Matrix4> GetCubeFaceMatrices(Vector4 position);
+
+		Matrix4 GetSpotLightMatrix(const std::shared_ptr<SceneNode> &node);
 	};
 }
 
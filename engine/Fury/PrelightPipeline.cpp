@@ -3,11 +3,11 @@
 #include <unordered_map>
 
 #include "Fury/Camera.h"
+#include "Fury/CommandBuffer.h"
 #include "Fury/Log.h"
 #include "Fury/EnumUtil.h"
 #include "Fury/Frustum.h"
 #include "Fury/GLLoader.h"
-#include "Fury/Gui.h"
 #include "Fury/Light.h"
 #include "Fury/MathUtil.h"
 #include "Fury/Material.h"
@@ -32,10 +32,13 @@ namespace fury
 	}
 
 	PrelightPipeline::PrelightPipeline(const std::string &name)
-		: Pipeline(name)
+		: Pipeline(name), m_OpaqueBatcher(InstanceBatcher::Create()), m_TransparentBatcher(InstanceBatcher::Create()), 
+		m_IndirectBatcher(IndirectBatcher::Create())
 	{
 		m_TypeIndex = typeid(PrelightPipeline);
 		SetSwitch(PipelineSwitch::CASCADED_SHADOW_MAP, true);
+		SetSwitch(PipelineSwitch::INSTANCING, true);
+		SetSwitch(PipelineSwitch::MULTI_DRAW_INDIRECT, true);
 	}
 
 	bool PrelightPipeline::Load(const void* wrapper, bool object)
@@ -55,6 +58,18 @@ namespace fury
 		else
 			SetSwitch(PipelineSwitch::CASCADED_SHADOW_MAP, true);
 
+		boolValue = IsSwitchOn(PipelineSwitch::INSTANCING);
+		if (LoadMemberValue(wrapper, "instancing", boolValue))
+			SetSwitch(PipelineSwitch::INSTANCING, boolValue);
+		else
+			SetSwitch(PipelineSwitch::INSTANCING, true);
+
+		boolValue = IsSwitchOn(PipelineSwitch::MULTI_DRAW_INDIRECT);
+		if (LoadMemberValue(wrapper, "multi_draw_indirect", boolValue))
+			SetSwitch(PipelineSwitch::MULTI_DRAW_INDIRECT, boolValue);
+		else
+			SetSwitch(PipelineSwitch::MULTI_DRAW_INDIRECT, true);
+
 		return true;
 	}
 
@@ -68,6 +83,12 @@ namespace fury
 		SaveKey(wrapper, "cascaded_shadow_map");
 		SaveValue(wrapper, IsSwitchOn(PipelineSwitch::CASCADED_SHADOW_MAP));
 
+		SaveKey(wrapper, "instancing");
+		SaveValue(wrapper, IsSwitchOn(PipelineSwitch::INSTANCING));
+
+		SaveKey(wrapper, "multi_draw_indirect");
+		SaveValue(wrapper, IsSwitchOn(PipelineSwitch::MULTI_DRAW_INDIRECT));
+
 		if (object)
 			EndObject(wrapper);
 	}
@@ -82,10 +103,22 @@ namespace fury
 		m_CurrentMesh = nullptr;
 		SortPassByIndex();
 
-		// find visible nodes
+		// find visible nodes and shadow casters, before any gl call.
 		RenderQuery::Ptr query = RenderQuery::Create();
-		sceneManager->GetRenderQuery(m_CurrentCamera->GetComponent<Camera>()->GetFrustum(), query);
-		query->Sort(m_CurrentCamera->GetWorldPosition());
+		QueryVisibility(sceneManager, query);
+
+		// group sorted units into instance batches.
+		bool instancing = IsSwitchOn(PipelineSwitch::INSTANCING);
+		if (instancing)
+		{
+			m_OpaqueBatcher->Build(query->opaqueUnits);
+			m_TransparentBatcher->Build(query->transparentUnits);
+		}
+
+		// opaque units in the mesh arena go through multi draw indirect when the driver has it.
+		bool indirect = CanDrawIndirect();
+		if (indirect)
+			m_IndirectBatcher->Build(query->opaqueUnits);
 
 		// draw passes
 
@@ -105,50 +138,66 @@ namespace fury
 
 			// enable gamma correction on last pass
 			if (i == passCount - 1)
-				glEnable(GL_FRAMEBUFFER_SRGB);
+				m_CommandBuffer->Enable(GL_FRAMEBUFFER_SRGB);
 
-			if (drawMode == DrawMode::OPAQUE)
-			{
-				pass->Bind();
-				for (const auto &unit : query->opaqueUnits)
-					DrawUnit(pass, unit);
-			}
-			else if (drawMode == DrawMode::TRANSPARENT)
+			if (drawMode == DrawMode::OPAQUE || drawMode == DrawMode::TRANSPARENT)
 			{
-				pass->Bind();
-				for (const auto &unit : query->transparentUnits)
-					DrawUnit(pass, unit);
+				bool opaque = drawMode == DrawMode::OPAQUE;
+				const auto &units = opaque ? query->opaqueUnits : query->transparentUnits;
+
+				m_CommandBuffer->BindPass(pass);
+				if (opaque && indirect)
+				{
+					DrawIndirectBatches(pass, units, m_IndirectBatcher);
+				}
+				else if (instancing)
+				{
+					DrawBatches(pass, units, opaque ? m_OpaqueBatcher : m_TransparentBatcher);
+				}
+				else
+				{
+					for (const auto &unit : units)
+						DrawUnit(pass, unit);
+				}
+				m_CommandBuffer->UnBindPass(pass);
 			}
 			else if (drawMode == DrawMode::QUAD)
 			{
-				pass->Bind();
+				m_CommandBuffer->BindPass(pass);
 				DrawQuad(pass);
+				m_CommandBuffer->UnBindPass(pass);
 			}
 			else if (drawMode == DrawMode::LIGHT)
 			{
-				pass->Bind(true);
+				m_CommandBuffer->BindPass(pass);
 
-				for (const auto &node : query->lightNodes)
+				// lights without queried casters query them while drawing.
+				const ShadowCasters noCasters;
+				for (unsigned int j = 0; j < query->lightNodes.size(); j++)
 				{
+					const auto &node = query->lightNodes[j];
+					const auto &casters = j < query->shadowCasters.size() ? query->shadowCasters[j] : noCasters;
 					if (auto ptr = node->GetComponent<Light>())
 					{
 						if (ptr->GetType() == LightType::DIRECTIONAL)
-							DrawDirLight(sceneManager, pass, node);
+							DrawDirLight(sceneManager, pass, node, casters);
 						else if (ptr->GetType() == LightType::POINT)
-							DrawPointLight(sceneManager, pass, node);
+							DrawPointLight(sceneManager, pass, node, casters);
 						else
-							DrawSpotLight(sceneManager, pass, node);
+							DrawSpotLight(sceneManager, pass, node, casters);
 					}
 				}
-			}
 
-			pass->UnBind();
+				m_CommandBuffer->UnBindPass(pass);
+			}
 
 			if (i == passCount - 1)
-				glDisable(GL_FRAMEBUFFER_SRGB);
+				m_CommandBuffer->Disable(GL_FRAMEBUFFER_SRGB);
 
 			if (m_CurrentShader != nullptr)
-				m_CurrentShader->UnBind();
+				m_CommandBuffer->UnBindShader(m_CurrentShader);
+
+			FlushCommands();
 
 			m_CurrentShader = nullptr;
 			m_CurrentMateral = nullptr;
@@ -160,8 +209,11 @@ namespace fury
 			PipelineSwitch::MESH_BOUNDS }, true))
 			DrawDebug(query);
 
+		CollectStatistics(sceneManager);
+
 		// gui
-		Gui::Render();
+		m_CommandBuffer->RenderGui();
+		FlushCommands();
 
 		// post
 		m_CurrentShader = nullptr;
@@ -169,22 +221,15 @@ namespace fury
 		m_CurrentMesh = nullptr;
 	}
 
-	void PrelightPipeline::DrawUnit(const std::shared_ptr<Pass> &pass, const RenderUnit &unit)
+	bool PrelightPipeline::BindUnitState(const std::shared_ptr<Pass> &pass, const std::shared_ptr<Shader> &shader, const RenderUnit &unit)
 	{
-		auto node = unit.node;
 		auto mesh = unit.mesh;
 		auto material = unit.material;
 
-		auto shader = material->GetShaderForPass(pass->GetRenderIndex());
-
-		if (shader == nullptr)
-			shader = pass->GetShader(mesh->IsSkinnedMesh() ? ShaderType::SKINNED_MESH : ShaderType::STATIC_MESH,
-			material->GetTextureFlags());
-
 		if (shader == nullptr)
 		{
-			FURYW << "Failed to draw " << node->GetName() << ", shader not found!";
-			return;
+			FURYW << "Failed to draw " << unit.node->GetName() << ", shader not found!";
+			return false;
 		}
 
 		bool materialChanged = material != m_CurrentMateral;
@@ -200,35 +245,54 @@ namespace fury
 		{
 			materialChanged = meshChanged = true;
 
-			shader->Bind();
-			shader->BindCamera(m_CurrentCamera);
+			m_CommandBuffer->BindShader(shader);
+			m_CommandBuffer->BindCamera(shader, m_CurrentCamera);
 
 			for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
-			{
-				auto ptr = pass->GetTextureAt(i, true);
-				shader->BindTexture(ptr->GetName(), ptr);
-			}
+				m_CommandBuffer->BindTexture(shader, pass->GetTextureAt(i, true));
 		}
 
 		if (materialChanged)
-			shader->BindMaterial(material);
+			m_CommandBuffer->BindMaterial(shader, material);
 
-		shader->BindMatrix(Matrix4::WORLD_MATRIX, node->GetWorldMatrix());
+		RenderUtil::Instance()->IncreaseShaderBindCount(shaderChanged ? 1 : 0);
+		RenderUtil::Instance()->IncreaseMaterialBindCount(materialChanged ? 1 : 0);
+		RenderUtil::Instance()->IncreaseMeshBindCount(meshChanged ? 1 : 0);
 
 		if (meshChanged)
-			shader->BindMesh(mesh);
+			m_CommandBuffer->BindMesh(shader, mesh);
+
+		return true;
+	}
+
+	void PrelightPipeline::DrawUnit(const std::shared_ptr<Pass> &pass, const RenderUnit &unit)
+	{
+		auto node = unit.node;
+		auto mesh = unit.mesh;
+		auto material = unit.material;
+
+		auto shader = material->GetShaderForPass(pass->GetRenderIndex());
+
+		if (shader == nullptr)
+			shader = pass->GetShader(mesh->IsSkinnedMesh() ? ShaderType::SKINNED_MESH : ShaderType::STATIC_MESH,
+			material->GetTextureFlags());
+
+		if (!BindUnitState(pass, shader, unit))
+			return;
+
+		m_CommandBuffer->BindMatrix(shader, GetUniformIDs().worldMatrix, node->GetWorldMatrix());
 
 		if (mesh->GetSubMeshCount() > 0)
 		{
 			auto subMesh = mesh->GetSubMeshAt(unit.subMesh);
-			shader->BindSubMesh(mesh, unit.subMesh);
-			glDrawElements(GL_TRIANGLES, subMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+			m_CommandBuffer->BindSubMesh(shader, mesh, unit.subMesh);
+			m_CommandBuffer->Draw(subMesh->Indices.Data.size());
 
 			RenderUtil::Instance()->IncreaseTriangleCount(subMesh->Indices.Data.size());
 		}
 		else
 		{
-			glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+			m_CommandBuffer->Draw(mesh->Indices.Data.size());
 
 			RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.Data.size());
 		}
@@ -244,7 +308,105 @@ namespace fury
 		RenderUtil::Instance()->IncreaseDrawCall();
 	}
 
-	void PrelightPipeline::DrawPointLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	void PrelightPipeline::DrawBatches(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const InstanceBatcher::Ptr &batcher)
+	{
+		for (const auto &batch : batcher->GetBatches())
+		{
+			if (batch.IsInstanced())
+				DrawInstances(pass, units, batch, batcher);
+			else
+				DrawUnit(pass, units[batch.first]);
+		}
+	}
+
+	void PrelightPipeline::DrawInstances(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const InstanceBatch &batch,
+		const InstanceBatcher::Ptr &batcher)
+	{
+		const auto &unit = units[batch.first];
+		auto mesh = unit.mesh;
+		auto material = unit.material;
+
+		// materials with their own shader are drawn one by one.
+		Shader::Ptr shader = nullptr;
+		if (material->GetShaderForPass(pass->GetRenderIndex()) == nullptr)
+			shader = pass->GetShader(ShaderType::INSTANCED_MESH, material->GetTextureFlags());
+
+		if (shader == nullptr)
+		{
+			for (unsigned int i = 0; i < batch.count; i++)
+				DrawUnit(pass, units[batch.first + i]);
+			return;
+		}
+
+		if (!BindUnitState(pass, shader, unit))
+			return;
+
+		m_CommandBuffer->BindInstances(shader, batcher, batch.instanceOffset);
+
+		unsigned int indexCount = 0;
+		if (mesh->GetSubMeshCount() > 0)
+		{
+			m_CommandBuffer->BindSubMesh(shader, mesh, unit.subMesh);
+			indexCount = mesh->GetSubMeshAt(unit.subMesh)->Indices.Data.size();
+		}
+		else
+		{
+			indexCount = mesh->Indices.Data.size();
+		}
+
+		m_CommandBuffer->Draw(indexCount, batch.count);
+
+		m_CommandBuffer->UnBindInstances(shader, batcher);
+
+		RenderUtil::Instance()->IncreaseTriangleCount(indexCount * batch.count);
+		RenderUtil::Instance()->IncreaseMeshCount(batch.count);
+		RenderUtil::Instance()->IncreaseDrawCall();
+	}
+
+	void PrelightPipeline::DrawIndirectBatches(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const IndirectBatcher::Ptr &batcher)
+	{
+		for (const auto &batch : batcher->GetBatches())
+		{
+			if (batch.IsIndirect())
+				DrawIndirect(pass, units, batch, batcher);
+			else
+				DrawUnit(pass, units[batch.first]);
+		}
+	}
+
+	void PrelightPipeline::DrawIndirect(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const IndirectBatch &batch,
+		const IndirectBatcher::Ptr &batcher)
+	{
+		const auto &unit = units[batch.first];
+		auto material = unit.material;
+
+		// materials with their own shader are drawn one by one.
+		Shader::Ptr shader = nullptr;
+		if (material->GetShaderForPass(pass->GetRenderIndex()) == nullptr)
+			shader = pass->GetShader(ShaderType::INSTANCED_MESH, material->GetTextureFlags());
+
+		if (shader == nullptr)
+		{
+			for (unsigned int i = 0; i < batch.count; i++)
+				DrawUnit(pass, units[batch.first + i]);
+			return;
+		}
+
+		// binds the shared arena vertex array, every unit of the batch lives there.
+		if (!BindUnitState(pass, shader, unit))
+			return;
+
+		m_CommandBuffer->BindIndirect(shader, batcher);
+		m_CommandBuffer->DrawIndirect(batcher, batch.commandOffset, batch.commandCount, batch.indexType);
+		m_CommandBuffer->UnBindIndirect(shader, batcher);
+
+		RenderUtil::Instance()->IncreaseTriangleCount(batcher->GetIndexCount(batch));
+		RenderUtil::Instance()->IncreaseMeshCount(batch.count);
+		RenderUtil::Instance()->IncreaseDrawCall();
+	}
+
+	void PrelightPipeline::DrawPointLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+		const ShadowCasters &shadowCasters)
 	{
 		auto light = node->GetComponent<Light>();
 		auto camPtr = m_CurrentCamera->GetComponent<Camera>();
@@ -266,63 +428,64 @@ namespace fury
 		// draw shadowMap if we castShadows.
 		std::pair<Texture::Ptr, Matrix4> shadowData;
 		if (castShadows)
-			shadowData = DrawPointLightShadowMap(sceneManager, pass, node);
+			shadowData = DrawPointLightShadowMap(sceneManager, pass, node, &shadowCasters);
 
 		// ready to draw light volumn
-		pass->Bind(false);
+		m_CommandBuffer->BindPass(pass, false);
 
 		// change depthTest && face culling state.
 		{
 			float camNear = (camPtr->GetFrustum().GetCurrentCorners()[0] - camPos).Length();
 			if (SphereBounds(node->GetWorldPosition(), light->GetRadius() + camNear).IsInsideFast(camPos))
 			{
-				glDisable(GL_DEPTH_TEST);
-				glCullFace(GL_FRONT);
+				m_CommandBuffer->Disable(GL_DEPTH_TEST);
+				m_CommandBuffer->CullFace(GL_FRONT);
 			}
 			else
 			{
-				glEnable(GL_DEPTH_TEST);
-				glCullFace(GL_BACK);
+				m_CommandBuffer->Enable(GL_DEPTH_TEST);
+				m_CommandBuffer->CullFace(GL_BACK);
 			}
 
 			worldMatrix.AppendScale(Vector4(light->GetRadius(), 0.0f));
 		}
 
-		shader->Bind();
+		m_CommandBuffer->BindShader(shader);
 
-		shader->BindCamera(m_CurrentCamera);
-		shader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
+		m_CommandBuffer->BindCamera(shader, m_CurrentCamera);
+		m_CommandBuffer->BindMatrix(shader, GetUniformIDs().worldMatrix, worldMatrix);
 
 		if (castShadows && shadowData.first != nullptr)
 		{
-			shader->BindTexture("shadow_buffer", shadowData.first);
-			shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+			m_CommandBuffer->BindTexture(shader, GetUniformIDs().shadowBuffer, shadowData.first);
+			m_CommandBuffer->BindMatrix(shader, GetUniformIDs().shadowMatrix, shadowData.second);
 		}
 
-		shader->BindLight(node);
-		shader->BindMesh(mesh);
+		m_CommandBuffer->BindLight(shader, node);
+		m_CommandBuffer->BindMesh(shader, mesh);
 
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
-		{
-			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
-		}
+			m_CommandBuffer->BindTexture(shader, pass->GetTextureAt(i, true));
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		m_CommandBuffer->Draw(mesh->Indices.Data.size());
 
-		shader->UnBind();
+		m_CommandBuffer->UnBindShader(shader);
 
 		RenderUtil::Instance()->IncreaseDrawCall();
 		RenderUtil::Instance()->IncreaseLightCount();
 
-		pass->UnBind();
+		m_CommandBuffer->UnBindPass(pass);
+
+		// shadow buffer goes back to the pool below, draw before it can be reused.
+		FlushCommands();
 
 		// collect used shadow buffer
 		if (castShadows)
 			Texture::ReleaseTemporary(shadowData.first);
 	}
 
-	void PrelightPipeline::DrawDirLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	void PrelightPipeline::DrawDirLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+		const ShadowCasters &shadowCasters)
 	{
 		auto light = node->GetComponent<Light>();
 		auto camPtr = m_CurrentCamera->GetComponent<Camera>();
@@ -349,58 +512,59 @@ namespace fury
 		if (castShadows)
 		{
 			if (useCascaded)
-				cascadedShadowData = DrawCascadedShadowMap(sceneManager, pass, node);
+				cascadedShadowData = DrawCascadedShadowMap(sceneManager, pass, node, &shadowCasters);
 			else
-				shadowData = DrawDirLightShadowMap(sceneManager, pass, node);
+				shadowData = DrawDirLightShadowMap(sceneManager, pass, node, &shadowCasters);
 		}
 
 		// ready to draw light volumn
-		pass->Bind(false);
+		m_CommandBuffer->BindPass(pass, false);
 
 		// change depthTest && face culling state.
-		glEnable(GL_DEPTH_TEST);
-		glCullFace(GL_BACK);
+		m_CommandBuffer->Enable(GL_DEPTH_TEST);
+		m_CommandBuffer->CullFace(GL_BACK);
 
-		shader->Bind();
+		m_CommandBuffer->BindShader(shader);
 
-		shader->BindCamera(m_CurrentCamera);
-		shader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
+		m_CommandBuffer->BindCamera(shader, m_CurrentCamera);
+		m_CommandBuffer->BindMatrix(shader, GetUniformIDs().worldMatrix, worldMatrix);
 
 		if (castShadows)
 		{
 			if (useCascaded && cascadedShadowData.first != nullptr)
 			{
-				shader->BindTexture("shadow_buffer", cascadedShadowData.first);
+				m_CommandBuffer->BindTexture(shader, GetUniformIDs().shadowBuffer, cascadedShadowData.first);
 				// for cacasded shadow maps
-				shader->BindMatrices("shadow_matrix", cascadedShadowData.second.size(), &cascadedShadowData.second[0]);
+				m_CommandBuffer->BindMatrices(shader, GetUniformIDs().shadowMatrix, cascadedShadowData.second.size(), &cascadedShadowData.second[0]);
 				float base = camPtr->GetFar() - camPtr->GetNear();
 				float average = base / 4.0f;
-				shader->BindFloat("shadow_far", average, average * 2, average * 3, average * 4);
+				float shadowFar[4] = { average, average * 2, average * 3, average * 4 };
+				m_CommandBuffer->BindFloat(shader, GetUniformIDs().shadowFar, 4, shadowFar);
 			}
 			else if (shadowData.first != nullptr)
 			{
-				shader->BindTexture("shadow_buffer", shadowData.first);
-				shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+				m_CommandBuffer->BindTexture(shader, GetUniformIDs().shadowBuffer, shadowData.first);
+				m_CommandBuffer->BindMatrix(shader, GetUniformIDs().shadowMatrix, shadowData.second);
 			}
 		}
 
-		shader->BindLight(node);
-		shader->BindMesh(mesh);
+		m_CommandBuffer->BindLight(shader, node);
+		m_CommandBuffer->BindMesh(shader, mesh);
 
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
-		{
-			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
-		}
+			m_CommandBuffer->BindTexture(shader, pass->GetTextureAt(i, true));
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		m_CommandBuffer->Draw(mesh->Indices.Data.size());
 
-		shader->UnBind();
+		m_CommandBuffer->UnBindShader(shader);
 
 		RenderUtil::Instance()->IncreaseDrawCall();
 		RenderUtil::Instance()->IncreaseLightCount();
 
-		pass->UnBind();
+		m_CommandBuffer->UnBindPass(pass);
+
+		// shadow buffer goes back to the pool below, draw before it can be reused.
+		FlushCommands();
 
 		// collect used shadow buffer
 		if (castShadows)
@@ -412,7 +576,8 @@ namespace fury
 		}
 	}
 
-	void PrelightPipeline::DrawSpotLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	void PrelightPipeline::DrawSpotLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+		const ShadowCasters &shadowCasters)
 	{
 		auto light = node->GetComponent<Light>();
 		auto camPtr = m_CurrentCamera->GetComponent<Camera>();
@@ -434,10 +599,10 @@ namespace fury
 		// draw shadowMap if we castShadows.
 		std::pair<Texture::Ptr, Matrix4> shadowData;
 		if (castShadows)
-			shadowData = DrawSpotLightShadowMap(sceneManager, pass, node);
+			shadowData = DrawSpotLightShadowMap(sceneManager, pass, node, &shadowCasters);
 
 		// ready to draw light volumn
-		pass->Bind(false);
+		m_CommandBuffer->BindPass(pass, false);
 
 		// change depthTest && face culling state.
 		{
@@ -454,44 +619,44 @@ namespace fury
 
 			if (MathUtil::PointInCone(coneCenter, coneDir, height, theta, camPos))
 			{
-				glDisable(GL_DEPTH_TEST);
-				glCullFace(GL_FRONT);
+				m_CommandBuffer->Disable(GL_DEPTH_TEST);
+				m_CommandBuffer->CullFace(GL_FRONT);
 			}
 			else
 			{
-				glEnable(GL_DEPTH_TEST);
-				glCullFace(GL_BACK);
+				m_CommandBuffer->Enable(GL_DEPTH_TEST);
+				m_CommandBuffer->CullFace(GL_BACK);
 			}
 		}
 
-		shader->Bind();
+		m_CommandBuffer->BindShader(shader);
 
-		shader->BindCamera(m_CurrentCamera);
-		shader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
+		m_CommandBuffer->BindCamera(shader, m_CurrentCamera);
+		m_CommandBuffer->BindMatrix(shader, GetUniformIDs().worldMatrix, worldMatrix);
 
 		if (castShadows && shadowData.first != nullptr)
 		{
-			shader->BindTexture("shadow_buffer", shadowData.first);
-			shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+			m_CommandBuffer->BindTexture(shader, GetUniformIDs().shadowBuffer, shadowData.first);
+			m_CommandBuffer->BindMatrix(shader, GetUniformIDs().shadowMatrix, shadowData.second);
 		}
 
-		shader->BindLight(node);
-		shader->BindMesh(mesh);
+		m_CommandBuffer->BindLight(shader, node);
+		m_CommandBuffer->BindMesh(shader, mesh);
 
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
-		{
-			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
-		}
+			m_CommandBuffer->BindTexture(shader, pass->GetTextureAt(i, true));
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		m_CommandBuffer->Draw(mesh->Indices.Data.size());
 
-		shader->UnBind();
+		m_CommandBuffer->UnBindShader(shader);
 
 		RenderUtil::Instance()->IncreaseDrawCall();
 		RenderUtil::Instance()->IncreaseLightCount();
 
-		pass->UnBind();
+		m_CommandBuffer->UnBindPass(pass);
+
+		// shadow buffer goes back to the pool below, draw before it can be reused.
+		FlushCommands();
 
 		// collect used shadow buffer
 		if (castShadows)
@@ -509,20 +674,17 @@ namespace fury
 			return;
 		}
 
-		shader->Bind();
+		m_CommandBuffer->BindShader(shader);
 
-		shader->BindMesh(mesh);
-		shader->BindCamera(m_CurrentCamera);
+		m_CommandBuffer->BindMesh(shader, mesh);
+		m_CommandBuffer->BindCamera(shader, m_CurrentCamera);
 
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
-		{
-			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
-		}
+			m_CommandBuffer->BindTexture(shader, pass->GetTextureAt(i, true));
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		m_CommandBuffer->Draw(mesh->Indices.Data.size());
 
-		shader->UnBind();
+		m_CommandBuffer->UnBindShader(shader);
 
 		RenderUtil::Instance()->IncreaseDrawCall();
 		RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.Data.size());
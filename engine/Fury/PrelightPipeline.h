@@ -7,6 +7,8 @@
 #include <vector>
 #include <initializer_list>
 
+#include "Fury/IndirectBatcher.h"
+#include "Fury/InstanceBatcher.h"
 #include "Fury/Pipeline.h"
 #include "Fury/Matrix4.h"
 
@@ -38,13 +40,37 @@ namespace fury
 
 	protected:
 
+		InstanceBatcher::Ptr m_OpaqueBatcher;
+
+		InstanceBatcher::Ptr m_TransparentBatcher;
+
+		IndirectBatcher::Ptr m_IndirectBatcher;
+
+		// returns false if shader is nullptr.
+		bool BindUnitState(const std::shared_ptr<Pass> &pass, const std::shared_ptr<Shader> &shader, const RenderUnit &unit);
+
 		void DrawUnit(const std::shared_ptr<Pass> &pass, const RenderUnit &unit);
 
-		void DrawPointLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
+		void DrawBatches(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const InstanceBatcher::Ptr &batcher);
+
+		// falls back to DrawUnit if the pass has no instanced shader for this material.
+		void DrawInstances(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const InstanceBatch &batch, 
+			const InstanceBatcher::Ptr &batcher);
+
+		void DrawIndirectBatches(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const IndirectBatcher::Ptr &batcher);
+
+		// falls back to DrawUnit if the pass has no instanced shader for this material.
+		void DrawIndirect(const std::shared_ptr<Pass> &pass, const std::vector<RenderUnit> &units, const IndirectBatch &batch, 
+			const IndirectBatcher::Ptr &batcher);
+
+		void DrawPointLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+			const ShadowCasters &shadowCasters);
 
-		void DrawDirLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
+		void DrawDirLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+			const ShadowCasters &shadowCasters);
 
-		void DrawSpotLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
+		void DrawSpotLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node, 
+			const ShadowCasters &shadowCasters);
 
 		void DrawQuad(const std::shared_ptr<Pass> &pass);
 	};
@@ -9,9 +9,12 @@
 
 #include "Fury/Log.h"
 #include "Fury/Light.h"
+#include "Fury/ThreadUtil.h"
 
 namespace fury
 {
+	const unsigned int RenderQuery::GRAIN_SIZE = 1024;
+
 	RenderQuery::Ptr RenderQuery::Create()
 	{
 		return std::make_shared<RenderQuery>();
@@ -19,31 +22,109 @@ namespace fury
 
 	void RenderQuery::AddRenderable(const std::shared_ptr<SceneNode> &node)
 	{
-		auto render = node->GetComponent<MeshRender>();
-		auto mesh = render->GetMesh();
+		AddRenderable(node, node->GetComponent<MeshRender>());
+	}
+
+	void RenderQuery::AddRenderable(const std::shared_ptr<SceneNode> &node, const std::shared_ptr<MeshRender> &render)
+	{
+		BuildUnits(node, *render, opaqueUnits, transparentUnits);
+		renderableNodes.push_back(node);
+	}
+
+	void RenderQuery::AddRenderables(const std::vector<std::shared_ptr<SceneNode>> &nodes)
+	{
+		std::vector<std::shared_ptr<MeshRender>> renders;
+		renders.reserve(nodes.size());
+		for (const auto &node : nodes)
+			renders.push_back(node->GetComponent<MeshRender>());
+
+		AddRenderables(nodes, renders);
+	}
+
+	void RenderQuery::AddRenderables(const std::vector<std::shared_ptr<SceneNode>> &nodes, const std::vector<std::shared_ptr<MeshRender>> &renders)
+	{
+		unsigned int count = nodes.size();
+		unsigned int chunkCount = (count + GRAIN_SIZE - 1) / GRAIN_SIZE;
+
+		if (chunkCount < 2 || ThreadUtil::Instance()->GetWorkerCount() == 0)
+		{
+			for (unsigned int i = 0; i < count; i++)
+				AddRenderable(nodes[i], renders[i]);
+			return;
+		}
+
+		// each chunk builds its own lists, so workers never share a vector.
+		std::vector<std::vector<RenderUnit>> opaqueChunks(chunkCount), transparentChunks(chunkCount);
+
+		ThreadUtil::Instance()->ParallelFor(chunkCount, [&](unsigned int chunk)
+		{
+			unsigned int last = std::min(count, (chunk + 1) * GRAIN_SIZE);
+			opaqueChunks[chunk].reserve(GRAIN_SIZE);
+			for (unsigned int i = chunk * GRAIN_SIZE; i < last; i++)
+				BuildUnits(nodes[i], *renders[i], opaqueChunks[chunk], transparentChunks[chunk]);
+		});
+
+		// chunk offsets in the merged lists, then move chunks to their own ranges.
+		std::vector<unsigned int> opaqueOffsets(chunkCount), transparentOffsets(chunkCount);
+		unsigned int opaqueSize = opaqueUnits.size(), transparentSize = transparentUnits.size();
+		for (unsigned int i = 0; i < chunkCount; i++)
+		{
+			opaqueOffsets[i] = opaqueSize;
+			transparentOffsets[i] = transparentSize;
+			opaqueSize += opaqueChunks[i].size();
+			transparentSize += transparentChunks[i].size();
+		}
+
+		opaqueUnits.resize(opaqueSize);
+		transparentUnits.resize(transparentSize);
+
+		ThreadUtil::Instance()->ParallelFor(chunkCount, [&](unsigned int chunk)
+		{
+			std::move(opaqueChunks[chunk].begin(), opaqueChunks[chunk].end(), opaqueUnits.begin() + opaqueOffsets[chunk]);
+			std::move(transparentChunks[chunk].begin(), transparentChunks[chunk].end(), transparentUnits.begin() + transparentOffsets[chunk]);
+		});
+
+		renderableNodes.insert(renderableNodes.end(), nodes.begin(), nodes.end());
+	}
+
+	void RenderQuery::BuildUnits(const std::shared_ptr<SceneNode> &node, const MeshRender &render, std::vector<RenderUnit> &opaques, std::vector<RenderUnit> &transparents)
+	{
+		auto mesh = render.GetMesh();
 		auto subMeshCount = mesh->GetSubMeshCount();
 		if (subMeshCount > 0)
 		{
 			for (unsigned int i = 0; i < subMeshCount; i++)
 			{
 				auto subMesh = mesh->GetSubMeshAt(i);
-				auto material = render->GetMaterial(i);
-				if (material->GetOpaque())
-					opaqueUnits.push_back(RenderUnit(node, mesh, material, i));
-				else
-					transparentUnits.push_back(RenderUnit(node, mesh, material, i));
+				auto material = render.GetMaterial(i);
+				bool opaque = material->GetOpaque();
+				auto &units = opaque ? opaques : transparents;
+				units.push_back(RenderUnit(node, mesh, material, i));
+				units.back().sortKey = GetStateKey(units.back(), !opaque);
 			}
 		}
 		else
 		{
-			auto material = render->GetMaterial();
-			if (material->GetOpaque())
-				opaqueUnits.push_back(RenderUnit(node, mesh, material, -1));
-			else
-				transparentUnits.push_back(RenderUnit(node, mesh, material, -1));
+			auto material = render.GetMaterial();
+			bool opaque = material->GetOpaque();
+			auto &units = opaque ? opaques : transparents;
+			units.push_back(RenderUnit(node, mesh, material, -1));
+			units.back().sortKey = GetStateKey(units.back(), !opaque);
 		}
+	}
 
-		renderableNodes.push_back(node);
+	unsigned long long RenderQuery::GetStateKey(const RenderUnit &unit, bool transparent)
+	{
+		unsigned long long shader = ((unit.material->GetTextureFlags() & 0x7F) << 1) | (unit.mesh->IsSkinnedMesh() ? 1 : 0);
+		unsigned long long material = unit.material->GetID();
+		unsigned long long mesh = unit.mesh->GetID();
+
+		// [depth:24 inverted][shader:8][material:16][mesh:16]
+		// [shader:8][material:20][mesh:16][depth:20]
+		if (transparent)
+			return (shader << 32) | ((material & 0xFFFF) << 16) | (mesh & 0xFFFF);
+		else
+			return (shader << 56) | ((material & 0xFFFFF) << 36) | ((mesh & 0xFFFF) << 20);
 	}
 
 	void RenderQuery::AddLight(const std::shared_ptr<SceneNode> &node)
@@ -53,20 +134,116 @@ namespace fury
 
 	void RenderQuery::Sort(Vector4 camPos)
 	{
-		std::sort(opaqueUnits.begin(), opaqueUnits.end(), [&camPos](const RenderUnit &a, const RenderUnit &b) -> bool
+		SortUnits(opaqueUnits, camPos, false);
+		SortUnits(transparentUnits, camPos, true);
+
+		/*std::sort(lightNodes.begin(), lightNodes.end(), [](const SceneNode::Ptr &a, const SceneNode::Ptr &b) -> bool
 		{
-			return a.node->GetWorldPosition().Distance(camPos) < b.node->GetWorldPosition().Distance(camPos);
+			return b->GetComponent<Light>()->GetCastShadows();
+		});*/
+	}
+
+	void RenderQuery::SortUnits(std::vector<RenderUnit> &units, Vector4 camPos, bool transparent)
+	{
+		unsigned int count = units.size();
+		if (count < 2)
+			return;
+
+		unsigned int chunkCount = (count + GRAIN_SIZE - 1) / GRAIN_SIZE;
+
+		std::vector<float> distances(count);
+		float maxDistance = ThreadUtil::Instance()->ParallelReduce(chunkCount, 0.0f, [&](unsigned int chunk) -> float
+		{
+			float chunkMax = 0.0f;
+			unsigned int last = std::min(count, (chunk + 1) * GRAIN_SIZE);
+			for (unsigned int i = chunk * GRAIN_SIZE; i < last; i++)
+			{
+				distances[i] = units[i].node->GetWorldPosition().Distance(camPos);
+				chunkMax = std::max(chunkMax, distances[i]);
+			}
+			return chunkMax;
+		}, [](float a, float b) -> float
+		{
+			return std::max(a, b);
 		});
 
-		std::sort(transparentUnits.begin(), transparentUnits.end(), [&camPos](const RenderUnit &a, const RenderUnit &b) -> bool
+		// quantize depth to the query's own range.
+		unsigned int depthBits = transparent ? 24 : 20;
+		unsigned long long depthMax = (1ull << depthBits) - 1;
+		float depthScale = maxDistance > 0.0f ? (float)depthMax / maxDistance : 0.0f;
+
+		// state part was computed when the unit was added.
+		unsigned long long stateMask = transparent ? (1ull << 40) - 1 : ~depthMax;
+
+		std::vector<SortEntry> entries(count);
+		ThreadUtil::Instance()->ParallelFor(chunkCount, [&](unsigned int chunk)
 		{
-			return a.node->GetWorldPosition().Distance(camPos) > b.node->GetWorldPosition().Distance(camPos);
+			unsigned int last = std::min(count, (chunk + 1) * GRAIN_SIZE);
+			for (unsigned int i = chunk * GRAIN_SIZE; i < last; i++)
+			{
+				auto &unit = units[i];
+
+				unsigned long long depth = std::min((unsigned long long)(distances[i] * depthScale), depthMax);
+				unsigned long long state = unit.sortKey & stateMask;
+
+				if (transparent)
+					unit.sortKey = ((depthMax - depth) << 40) | state;
+				else
+					unit.sortKey = state | depth;
+
+				entries[i] = SortEntry(unit.sortKey, i);
+			}
 		});
 
-		/*std::sort(lightNodes.begin(), lightNodes.end(), [](const SceneNode::Ptr &a, const SceneNode::Ptr &b) -> bool
+		RadixSort(entries);
+
+		std::vector<RenderUnit> sorted;
+		sorted.reserve(count);
+		for (auto &entry : entries)
+			sorted.push_back(std::move(units[entry.second]));
+
+		units.swap(sorted);
+	}
+
+	void RenderQuery::RadixSort(std::vector<SortEntry> &entries)
+	{
+		unsigned int count = entries.size();
+		if (count < 2)
+			return;
+
+		std::vector<SortEntry> buffer(count);
+
+		SortEntry *src = &entries[0];
+		SortEntry *dst = &buffer[0];
+
+		unsigned int histogram[256];
+
+		for (unsigned int shift = 0; shift < 64; shift += 8)
 		{
-			return b->GetComponent<Light>()->GetCastShadows();
-		});*/
+			std::fill(histogram, histogram + 256, 0);
+			for (unsigned int i = 0; i < count; i++)
+				histogram[(src[i].first >> shift) & 0xFF]++;
+
+			// skip digits that are the same for all keys.
+			if (histogram[(src[0].first >> shift) & 0xFF] == count)
+				continue;
+
+			unsigned int offset = 0;
+			for (unsigned int i = 0; i < 256; i++)
+			{
+				unsigned int size = histogram[i];
+				histogram[i] = offset;
+				offset += size;
+			}
+
+			for (unsigned int i = 0; i < count; i++)
+				dst[histogram[(src[i].first >> shift) & 0xFF]++] = src[i];
+
+			std::swap(src, dst);
+		}
+
+		if (src != &entries[0])
+			entries.swap(buffer);
 	}
 
 	void RenderQuery::Clear()
@@ -75,5 +252,6 @@ namespace fury
 		transparentUnits.clear();
 		renderableNodes.clear();
 		lightNodes.clear();
+		shadowCasters.clear();
 	}
 }
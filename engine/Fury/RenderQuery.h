@@ -2,6 +2,7 @@
 #define _FURY_RENDERQUERY_H_
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "Fury/Vector4.h"
@@ -14,6 +15,11 @@ namespace fury
 
 	class Mesh;
 
+	class MeshRender;
+
+	// shadow casters of each shadow view of a light. (cascade split, cube face ...)
+	typedef std::vector<std::vector<std::shared_ptr<SceneNode>>> ShadowCasters;
+
 	struct FURY_API RenderUnit
 	{
 		std::shared_ptr<SceneNode> node;
@@ -24,6 +30,11 @@ namespace fury
 
 		int subMesh = 0;
 
+		// packed draw order, state part set by RenderQuery::AddRenderable, depth by RenderQuery::Sort.
+		unsigned long long sortKey = 0;
+
+		RenderUnit() {}
+
 		RenderUnit(const std::shared_ptr<SceneNode> &node, const std::shared_ptr<Mesh> &mesh,
 			const std::shared_ptr<Material> &material, int subMesh)
 		{
@@ -42,6 +53,9 @@ namespace fury
 
 		static Ptr Create();
 
+		// nodes or units per job when building or sorting in parallel.
+		static const unsigned int GRAIN_SIZE;
+
 		std::vector<RenderUnit> opaqueUnits;
 
 		std::vector<RenderUnit> transparentUnits;
@@ -50,13 +64,43 @@ namespace fury
 
 		std::vector<std::shared_ptr<SceneNode>> lightNodes;
 
+		// same order as lightNodes, empty if that light casts no shadows.
+		std::vector<ShadowCasters> shadowCasters;
+
 		void AddRenderable(const std::shared_ptr<SceneNode> &node);
 
+		// render is node's MeshRender, when the caller already has it.
+		void AddRenderable(const std::shared_ptr<SceneNode> &node, const std::shared_ptr<MeshRender> &render);
+
+		// same as AddRenderable for each node, units are built in chunks on ThreadUtil workers, 
+		// and appended in node order.
+		void AddRenderables(const std::vector<std::shared_ptr<SceneNode>> &nodes);
+
+		// renders[i] is nodes[i]'s MeshRender, so workers don't look them up again.
+		void AddRenderables(const std::vector<std::shared_ptr<SceneNode>> &nodes, const std::vector<std::shared_ptr<MeshRender>> &renders);
+
 		void AddLight(const std::shared_ptr<SceneNode> &node);
 
+		// opaque units: shader, material, mesh, then front to back.
+		// transparent units: back to front, then shader, material, mesh.
 		void Sort(Vector4 camPos);
 
 		void Clear();
+
+	protected:
+
+		// (sort key, unit index)
+		typedef std::pair<unsigned long long, unsigned int> SortEntry;
+
+		static void BuildUnits(const std::shared_ptr<SceneNode> &node, const MeshRender &render, std::vector<RenderUnit> &opaques, std::vector<RenderUnit> &transparents);
+
+		// shader, material and mesh part of the sort key, Sort fills in the depth.
+		static unsigned long long GetStateKey(const RenderUnit &unit, bool transparent);
+
+		static void SortUnits(std::vector<RenderUnit> &units, Vector4 camPos, bool transparent);
+
+		// lsd radix sort by key, 8 bits per pass, stable.
+		static void RadixSort(std::vector<SortEntry> &entries);
 	};
 }
 
@@ -1,5 +1,6 @@
 #include <SFML/System/Time.hpp>
 
+#include "Fury/GLStateCache.h"
 #include "Fury/RenderUtil.h"
 #include "Fury/GLLoader.h"
 #include "Fury/Log.h"
@@ -10,11 +11,19 @@
 #include "Fury/Mesh.h"
 #include "Fury/MeshUtil.h"
 #include "Fury/Texture.h"
+#include "Fury/UniformBuffer.h"
 
 namespace fury
 {
 	RenderUtil::RenderUtil()
 	{
+		// gl functions aren't loaded in headless runs, only counters are usable there.
+		if (glGenVertexArrays == nullptr)
+		{
+			FURYW << "No gl context, RenderUtil only keeps counters.";
+			return;
+		}
+
 		// blit shader
 		{
 			const char *blit_vs = 
@@ -71,14 +80,14 @@ namespace fury
 		glGenVertexArrays(1, &m_LineVAO);
 		glGenBuffers(1, &m_LineVBO);
 
-		glBindVertexArray(m_LineVAO);
+		GLStateCache::Instance()->BindVertexArray(m_LineVAO);
 
 		glBindBuffer(GL_ARRAY_BUFFER, m_LineVBO);
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
 		glEnableVertexAttribArray(0);
 
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindVertexArray(0);
+		GLStateCache::Instance()->BindVertexArray(0);
 
 		m_DebugShader->UnBind();
 		}
@@ -93,7 +102,10 @@ namespace fury
 	RenderUtil::~RenderUtil()
 	{
 		if (m_LineVAO != 0)
+		{
+			GLStateCache::ForgetVertexArray(m_LineVAO);
 			glDeleteVertexArrays(1, &m_LineVAO);
+		}
 
 		if (m_LineVBO != 0)
 			glDeleteBuffers(1, &m_LineVBO);
@@ -121,7 +133,8 @@ namespace fury
 		shader->BindTexture(src);
 		shader->BindMesh(MeshUtil::GetUnitQuad());
 
-		glDrawElements(GL_TRIANGLES, MeshUtil::GetUnitQuad()->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		auto range = MeshUtil::GetUnitQuad()->GetDrawRange();
+		glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, range.indexType, (void*)range.indexOffset, range.baseVertex);
 
 		shader->UnBind();
 
@@ -144,7 +157,7 @@ namespace fury
 		m_DebugShader->BindCamera(camera);
 		m_DebugShader->BindMatrix(Matrix4::WORLD_MATRIX, Matrix4());
 
-		glBindVertexArray(m_LineVAO);
+		GLStateCache::Instance()->BindVertexArray(m_LineVAO);
 		glBindBuffer(GL_ARRAY_BUFFER, m_LineVBO);
 	}
 
@@ -219,7 +232,7 @@ namespace fury
 	{
 		m_DrawingLine = false;
 
-		glBindVertexArray(0);
+		GLStateCache::Instance()->BindVertexArray(0);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 		m_DebugShader->UnBind();
@@ -247,7 +260,8 @@ namespace fury
 		m_DebugShader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
 		m_DebugShader->BindMesh(mesh);
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		auto range = mesh->GetDrawRange();
+		glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, range.indexType, (void*)range.indexOffset, range.baseVertex);
 
 		m_DrawCall++;
 	}
@@ -267,6 +281,15 @@ namespace fury
 		m_TriangleCount = 0;
 		m_SkinnedMeshCount = 0;
 		m_LightCount = 0;
+		m_ShaderBindCount = 0;
+		m_MaterialBindCount = 0;
+		m_MeshBindCount = 0;
+		m_PlaneTestCount = 0;
+		m_PlaneCacheHitCount = 0;
+		m_UpdateMoveCount = 0;
+		m_UpdateSkipCount = 0;
+		GLStateCache::Instance()->ResetCounters();
+		UniformBuffer::Instance()->ResetCounters();
 
 		m_FrameClock.restart();
 
@@ -328,4 +351,94 @@ namespace fury
 	{
 		return m_LightCount;
 	}
+
+	void RenderUtil::IncreaseShaderBindCount(unsigned int count)
+	{
+		m_ShaderBindCount += count;
+	}
+
+	unsigned int RenderUtil::GetShaderBindCount()
+	{
+		return m_ShaderBindCount;
+	}
+
+	void RenderUtil::IncreaseMaterialBindCount(unsigned int count)
+	{
+		m_MaterialBindCount += count;
+	}
+
+	unsigned int RenderUtil::GetMaterialBindCount()
+	{
+		return m_MaterialBindCount;
+	}
+
+	void RenderUtil::IncreaseMeshBindCount(unsigned int count)
+	{
+		m_MeshBindCount += count;
+	}
+
+	unsigned int RenderUtil::GetMeshBindCount()
+	{
+		return m_MeshBindCount;
+	}
+
+	void RenderUtil::IncreasePlaneTestCount(unsigned int count)
+	{
+		m_PlaneTestCount += count;
+	}
+
+	unsigned int RenderUtil::GetPlaneTestCount()
+	{
+		return m_PlaneTestCount;
+	}
+
+	void RenderUtil::IncreasePlaneCacheHitCount(unsigned int count)
+	{
+		m_PlaneCacheHitCount += count;
+	}
+
+	unsigned int RenderUtil::GetPlaneCacheHitCount()
+	{
+		return m_PlaneCacheHitCount;
+	}
+
+	void RenderUtil::IncreaseUpdateMoveCount(unsigned int count)
+	{
+		m_UpdateMoveCount += count;
+	}
+
+	unsigned int RenderUtil::GetUpdateMoveCount()
+	{
+		return m_UpdateMoveCount;
+	}
+
+	void RenderUtil::IncreaseUpdateSkipCount(unsigned int count)
+	{
+		m_UpdateSkipCount += count;
+	}
+
+	unsigned int RenderUtil::GetUpdateSkipCount()
+	{
+		return m_UpdateSkipCount;
+	}
+
+	unsigned int RenderUtil::GetIssuedStateCount()
+	{
+		return GLStateCache::Instance()->GetIssuedCount();
+	}
+
+	unsigned int RenderUtil::GetSkippedStateCount()
+	{
+		return GLStateCache::Instance()->GetSkippedCount();
+	}
+
+	unsigned int RenderUtil::GetUniformBlockUploadCount()
+	{
+		return UniformBuffer::Instance()->GetUploadCount();
+	}
+
+	unsigned int RenderUtil::GetUniformBlockReuseCount()
+	{
+		return UniformBuffer::Instance()->GetReuseCount();
+	}
 }
\ No newline at end of file
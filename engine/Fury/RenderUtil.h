@@ -57,6 +57,20 @@ namespace fury
 
 		unsigned int m_LightCount = 0;
 
+		unsigned int m_ShaderBindCount = 0;
+
+		unsigned int m_MaterialBindCount = 0;
+
+		unsigned int m_MeshBindCount = 0;
+
+		unsigned int m_PlaneTestCount = 0;
+
+		unsigned int m_PlaneCacheHitCount = 0;
+
+		unsigned int m_UpdateMoveCount = 0;
+
+		unsigned int m_UpdateSkipCount = 0;
+
 		sf::Clock m_FrameClock;
 
 		bool m_DrawingLine = false;
@@ -121,6 +135,50 @@ namespace fury
 		void IncreaseLightCount(unsigned int count = 1);
 
 		unsigned int GetLightCount();
+
+		void IncreaseShaderBindCount(unsigned int count = 1);
+
+		unsigned int GetShaderBindCount();
+
+		void IncreaseMaterialBindCount(unsigned int count = 1);
+
+		unsigned int GetMaterialBindCount();
+
+		void IncreaseMeshBindCount(unsigned int count = 1);
+
+		unsigned int GetMeshBindCount();
+
+		// frustum plane tests done by scene manager queries.
+		void IncreasePlaneTestCount(unsigned int count = 1);
+
+		unsigned int GetPlaneTestCount();
+
+		// tree nodes rejected by their cached plane.
+		void IncreasePlaneCacheHitCount(unsigned int count = 1);
+
+		unsigned int GetPlaneCacheHitCount();
+
+		// scenenode updates that moved the node in the scene manager.
+		void IncreaseUpdateMoveCount(unsigned int count = 1);
+
+		unsigned int GetUpdateMoveCount();
+
+		// scenenode updates the scene manager skipped, the node still fits where it is.
+		void IncreaseUpdateSkipCount(unsigned int count = 1);
+
+		unsigned int GetUpdateSkipCount();
+
+		// gl state changes sent to gl this frame.
+		unsigned int GetIssuedStateCount();
+
+		// redundant gl state changes dropped by GLStateCache this frame.
+		unsigned int GetSkippedStateCount();
+
+		// uniform blocks uploaded to UniformBuffer this frame.
+		unsigned int GetUniformBlockUploadCount();
+
+		// uniform block binds that reused the bound data this frame.
+		unsigned int GetUniformBlockReuseCount();
 	};
 }
 
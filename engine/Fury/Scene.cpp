@@ -111,7 +111,8 @@ namespace fury
 			return false;
 		}
 
-		// setup scene manager
+		// apply transforms, then setup scene manager
+		m_RootNode->UpdateTransforms();
 		m_SceneManager->AddSceneNodeRecursively(m_RootNode);
 
 		return true;
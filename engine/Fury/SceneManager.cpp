@@ -0,0 +1,45 @@
+#include "Fury/Light.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneManager.h"
+#include "Fury/SceneNode.h"
+
+namespace fury
+{
+	bool SceneManager::IsRenderable(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		return GetRenderable(sceneNode) != nullptr;
+	}
+
+	std::shared_ptr<MeshRender> SceneManager::GetRenderable(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		auto render = sceneNode->GetComponent<MeshRender>();
+		if (render != nullptr && render->GetRenderable())
+			return render;
+		return nullptr;
+	}
+
+	bool SceneManager::IsShadowCaster(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		auto render = sceneNode->GetComponent<MeshRender>();
+		return render != nullptr && render->GetRenderable() && render->GetMesh()->GetCastShadows();
+	}
+
+	bool SceneManager::IsLight(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		return sceneNode->GetComponent<Light>() != nullptr;
+	}
+
+	void SceneManager::FillRenderQuery(RenderQuery &renderQuery, const SceneNodes &renderables, 
+		const std::vector<std::shared_ptr<MeshRender>> &renders, const SceneNodes &lights, bool clear)
+	{
+		if (clear)
+			renderQuery.Clear();
+
+		for (const auto &light : lights)
+			renderQuery.AddLight(light);
+
+		renderQuery.AddRenderables(renderables, renders);
+	}
+}
\ No newline at end of file
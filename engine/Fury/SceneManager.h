@@ -5,12 +5,17 @@
 #include <memory>
 #include <functional>
 
+#include "Fury/Frustum.h"
 #include "Macros.h"
 
 namespace fury
 {
+	class BoxBounds;
+
 	class Collidable;
 
+	class MeshRender;
+
 	class RenderQuery;
 
 	class SceneNode;
@@ -35,6 +40,9 @@ namespace fury
 
 		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode) = 0;
 
+		// const queries must be safe to call from multiple threads at once, 
+		// as long as no scenenode is added, removed or updated meanwhile.
+
 		virtual void GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear = true) const = 0;
 
 		virtual void GetVisibleSceneNodes(const Collidable &collider, SceneNodes &visibleNodes, bool clear = true) const = 0;
@@ -50,6 +58,161 @@ namespace fury
 		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const = 0;
 
 		virtual void Clear() = 0;
+
+	protected:
+
+		// test aabb with frustum planes in planeMask, bits of planes it's fully inside are cleared.
+		// planeTests counts the planes tested, outPlane is the one that rejected it.
+		static Side IsInside(const Frustum &frustum, const BoxBounds &aabb, unsigned int &planeMask, 
+			unsigned int *planeTests = nullptr, unsigned int *outPlane = nullptr);
+
+		// per scenenode parts of the queries, shared by all managers.
+
+		static bool IsRenderable(const std::shared_ptr<SceneNode> &sceneNode);
+
+		// sceneNode's MeshRender if it's renderable, otherwise nullptr.
+		static std::shared_ptr<MeshRender> GetRenderable(const std::shared_ptr<SceneNode> &sceneNode);
+
+		static bool IsShadowCaster(const std::shared_ptr<SceneNode> &sceneNode);
+
+		static bool IsLight(const std::shared_ptr<SceneNode> &sceneNode);
+
+		// render units are built in parallel after the walk, from the MeshRenders found during it.
+		static void FillRenderQuery(RenderQuery &renderQuery, const SceneNodes &renderables, 
+			const std::vector<std::shared_ptr<MeshRender>> &renders, const SceneNodes &lights, bool clear);
+	};
+
+	inline Side SceneManager::IsInside(const Frustum &frustum, const BoxBounds &aabb, unsigned int &planeMask, 
+		unsigned int *planeTests, unsigned int *outPlane)
+	{
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			if ((planeMask & (1 << i)) == 0)
+				continue;
+
+			if (planeTests != nullptr)
+				(*planeTests)++;
+
+			Side side = frustum.GetPlane(i).IsInside(aabb);
+			if (side == Side::OUT)
+			{
+				if (outPlane != nullptr)
+					*outPlane = i;
+				return Side::OUT;
+			}
+			else if (side == Side::IN)
+			{
+				planeMask &= ~(1 << i);
+			}
+		}
+
+		return planeMask == 0 ? Side::IN : Side::STRADDLE;
+	}
+
+	// Implements SceneManager's queries with Manager's non-virtual WalkSceneFast, 
+	// so each manager only provides the traversal.
+	// Manager::WalkSceneFast(collider, visitor), visitor: void(const std::shared_ptr<SceneNode>&)
+	template<class Manager>
+	class SceneManagerBase : public SceneManager
+	{
+	public:
+
+		virtual void GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear = true) const override
+		{
+			SceneNodes renderables, lights;
+			std::vector<std::shared_ptr<MeshRender>> renders;
+
+			GetManager().WalkSceneFast(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+			{
+				if (IsLight(sceneNode))
+					lights.push_back(sceneNode);
+
+				auto render = GetRenderable(sceneNode);
+				if (render != nullptr)
+				{
+					renderables.push_back(sceneNode);
+					renders.push_back(std::move(render));
+				}
+			});
+
+			FillRenderQuery(*renderQuery, renderables, renders, lights, clear);
+		}
+
+		virtual void GetVisibleSceneNodes(const Collidable &collider, SceneNodes &sceneNodes, bool clear = true) const override
+		{
+			if (clear)
+				sceneNodes.clear();
+
+			GetManager().WalkSceneFast(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+			{
+				sceneNodes.push_back(sceneNode);
+			});
+		}
+
+		virtual void GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear = true) const override
+		{
+			if (clear)
+				renderables.clear();
+
+			GetManager().WalkSceneFast(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+			{
+				if (IsRenderable(sceneNode))
+					renderables.push_back(sceneNode);
+			});
+		}
+
+		virtual void GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear = true) const override
+		{
+			if (clear)
+				renderables.clear();
+
+			GetManager().WalkSceneFast(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+			{
+				if (IsShadowCaster(sceneNode))
+					renderables.push_back(sceneNode);
+			});
+		}
+
+		virtual void GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear = true) const override
+		{
+			if (clear)
+				lights.clear();
+
+			GetManager().WalkSceneFast(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+			{
+				if (IsLight(sceneNode))
+					lights.push_back(sceneNode);
+			});
+		}
+
+		virtual void GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear = true) const override
+		{
+			if (clear)
+			{
+				renderables.clear();
+				lights.clear();
+			}
+
+			GetManager().WalkSceneFast(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+			{
+				if (IsRenderable(sceneNode))
+					renderables.push_back(sceneNode);
+				else if (IsLight(sceneNode))
+					lights.push_back(sceneNode);
+			});
+		}
+
+		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const override
+		{
+			GetManager().WalkSceneFast(collider, filterFunc);
+		}
+
+	protected:
+
+		const Manager &GetManager() const
+		{
+			return static_cast<const Manager&>(*this);
+		}
 	};
 }
 
@@ -4,12 +4,15 @@
 #include "Fury/Light.h"
 #include "Fury/OcTreeNode.h"
 #include "Fury/OcTree.h"
+#include "Fury/SceneManager.h"
 #include "Fury/SceneNode.h"
 #include "Fury/EntityManager.h"
 #include "Fury/Scene.h"
 #include "Fury/MeshRender.h"
 #include "Fury/Mesh.h"
 #include "Fury/Material.h"
+#include "Fury/ThreadUtil.h"
+#include "Fury/TransformStore.h"
 
 namespace fury
 {
@@ -25,7 +28,9 @@ namespace fury
 	}
 
 	SceneNode::SceneNode(const std::string &name)
-		: Entity(name), m_LocalScale(1.0f, 1.0f, 1.0f, 1.0f), m_TransformDirty(true)
+		: Entity(name), m_OcTreeSlot(0), m_SceneManager(nullptr), m_SceneManagerCell(0), m_SceneManagerSlot(0), 
+		m_Static(false), m_TransformDirty(true), m_ChildTransformDirty(false), 
+		m_LocalScale(1.0f, 1.0f, 1.0f, 1.0f), m_TransformStore(nullptr), m_TransformIndex(0)
 	{
 		m_TypeIndex = typeid(SceneNode);
 		OnTransformChange = Signal<const Ptr&>::Create();
@@ -33,6 +38,9 @@ namespace fury
 
 	SceneNode::~SceneNode()
 	{
+		if (m_TransformStore != nullptr)
+			m_TransformStore->Invalidate();
+
 		RemoveAllComponents(true);
 		RemoveAllChilds();
 		//FURYD << m_Name << " destoried.";
@@ -77,6 +85,9 @@ namespace fury
 		// model aabb
 		LoadMemberValue(wrapper, "aabb", m_ModelAABB);
 
+		// optional
+		LoadMemberValue(wrapper, "static", m_Static);
+
 		// apply transforms
 		Recompose(true);
 
@@ -147,17 +158,20 @@ namespace fury
 		Entity::Save(wrapper, false);
 
 		SaveKey(wrapper, "pos");
-		SaveValue(wrapper, m_LocalPosition);
+		SaveValue(wrapper, GetLocalPosition());
 
 		SaveKey(wrapper, "rot");
-		SaveValue(wrapper, m_LocalRotation);
+		SaveValue(wrapper, GetLocalRoattion());
 
 		SaveKey(wrapper, "scl");
-		SaveValue(wrapper, m_LocalScale);
+		SaveValue(wrapper, GetLocalScale());
 
 		SaveKey(wrapper, "aabb");
 		SaveValue(wrapper, m_ModelAABB);
 
+		SaveKey(wrapper, "static");
+		SaveValue(wrapper, m_Static);
+
 		SaveKey(wrapper, "components");
 		StartArray(wrapper);
 		for (auto pair : m_Components)
@@ -181,9 +195,10 @@ namespace fury
 		for (auto &comp : m_Components)
 			ptr->AddComponent(comp.second->Clone());
 		// clone translations
-		ptr->SetLocalPosition(m_LocalPosition);
-		ptr->SetLocalRoattion(m_LocalRotation);
-		ptr->SetLocalScale(m_LocalScale);
+		ptr->SetLocalPosition(GetLocalPosition());
+		ptr->SetLocalRoattion(GetLocalRoattion());
+		ptr->SetLocalScale(GetLocalScale());
+		ptr->SetStatic(m_Static);
 		return ptr;
 	}
 
@@ -196,6 +211,8 @@ namespace fury
 	{
 		if (!m_OcTreeNode.expired())
 			m_OcTreeNode.lock()->RemoveSceneNode(shared_from_this());
+		else if (m_SceneManager != nullptr)
+			m_SceneManager->RemoveSceneNode(shared_from_this());
 
 		if (recursively)
 		{
@@ -204,17 +221,60 @@ namespace fury
 		}
 	}
 
+	std::shared_ptr<OcTreeNode> SceneNode::GetOcTreeNode() const
+	{
+		return m_OcTreeNode.lock();
+	}
+
+	void SceneNode::SetSceneManager(SceneManager *manager, unsigned int cell, unsigned int slot)
+	{
+		m_SceneManager = manager;
+		m_SceneManagerCell = cell;
+		m_SceneManagerSlot = slot;
+	}
+
+	SceneManager *SceneNode::GetSceneManager() const
+	{
+		return m_SceneManager;
+	}
+
+	unsigned int SceneNode::GetSceneManagerCell() const
+	{
+		return m_SceneManagerCell;
+	}
+
+	unsigned int SceneNode::GetSceneManagerSlot() const
+	{
+		return m_SceneManagerSlot;
+	}
+
+	void SceneNode::SetSceneManagerSlot(unsigned int slot)
+	{
+		m_SceneManagerSlot = slot;
+	}
+
 	void SceneNode::SetModelAABB(const BoxBounds &aabb)
 	{
-		if (aabb.GetInfinite())
+		m_ModelAABB = aabb;
+		UpdateAABB();
+
+		// octree caches world aabbs, keep it in sync.
+		if (!m_OcTreeNode.expired())
+			m_OcTreeNode.lock()->GetManager().UpdateSceneNode(shared_from_this());
+		else if (m_SceneManager != nullptr)
+			m_SceneManager->UpdateSceneNode(shared_from_this());
+	}
+
+	void SceneNode::UpdateAABB()
+	{
+		if (m_ModelAABB.GetInfinite())
 		{
-			m_ModelAABB = m_LocalAABB = m_WorldAABB = aabb;
+			m_LocalAABB = m_WorldAABB = m_ModelAABB;
 		}
 		else
 		{
-			m_ModelAABB = aabb;
-			m_LocalAABB = m_LocalMatrix.Multiply(m_ModelAABB);
-			m_WorldAABB = m_WorldMatrix.Multiply(m_ModelAABB);
+			m_LocalAABB = GetLocalMatrix().Multiply(m_ModelAABB);
+			m_WorldAABB = GetWorldMatrix().Multiply(m_ModelAABB);
 		}
 	}
 
@@ -233,27 +293,53 @@ namespace fury
 		return m_WorldAABB;
 	}
 
+	void SceneNode::SetStatic(bool value)
+	{
+		m_Static = value;
+	}
+
+	bool SceneNode::GetStatic() const
+	{
+		return m_Static;
+	}
+
 	//////////////////////////////////
 	// Transforms
 	//////////////////////////////////
 
-	void SceneNode::Recompose(bool force)
+	void SceneNode::MarkTransformDirty()
 	{
-		if (!force && !m_TransformDirty)
+		if (m_TransformStore != nullptr)
+		{
+			m_TransformStore->MarkDirty(m_TransformIndex);
 			return;
+		}
 
-		m_TransformDirty = false;
+		m_TransformDirty = true;
 
-		// update local matrix
-		m_LocalMatrix.Identity();
-		m_LocalMatrix.AppendTranslation(m_LocalPosition);
-		m_LocalMatrix.AppendRotation(m_LocalRotation);
-		m_LocalMatrix.AppendScale(m_LocalScale);
+		auto parent = m_Parent.lock();
+		while (parent != nullptr && !parent->m_ChildTransformDirty)
+		{
+			parent->m_ChildTransformDirty = true;
+			parent = parent->m_Parent.lock();
+		}
+	}
 
-		m_InvertLocalMatrix = m_LocalMatrix.Inverse();
+	void SceneNode::UpdateWorldTransform(const SceneNode *parent)
+	{
+		// update local matrix
+		if (m_TransformDirty)
+		{
+			m_LocalMatrix.Identity();
+			m_LocalMatrix.AppendTranslation(m_LocalPosition);
+			m_LocalMatrix.AppendRotation(m_LocalRotation);
+			m_LocalMatrix.AppendScale(m_LocalScale);
+			m_InvertLocalMatrix = m_LocalMatrix.Inverse();
+			m_TransformDirty = false;
+		}
 
 		// update world matrix
-		if (m_Parent.expired())
+		if (parent == nullptr)
 		{
 			m_WorldMatrix = m_LocalMatrix;
 			m_WorldPosition = m_LocalPosition;
@@ -262,7 +348,7 @@ namespace fury
 		}
 		else
 		{
-			Matrix4 matrix = m_Parent.lock()->GetWorldMatrix();
+			const Matrix4 &matrix = parent->m_WorldMatrix;
 			m_WorldMatrix = matrix * m_LocalMatrix;
 			m_WorldPosition = matrix.Multiply(m_LocalPosition);
 			m_WorldRotation = matrix.Multiply(m_LocalRotation);
@@ -271,22 +357,158 @@ namespace fury
 		m_InvertWorldMatrix = m_WorldMatrix.Inverse();
 
 		// update bounding box
-		SetModelAABB(m_ModelAABB);
+		UpdateAABB();
+	}
 
-		// update octree info
-		if (!m_OcTreeNode.expired())
-			m_OcTreeNode.lock()->GetManager().UpdateSceneNode(shared_from_this());
+	void SceneNode::UpdateTransforms(bool parallel)
+	{
+		if (m_TransformStore != nullptr)
+		{
+			m_TransformStore->Update(parallel);
+			return;
+		}
+
+		if (!m_TransformDirty && !m_ChildTransformDirty)
+			return;
+
+		std::vector<PendingTransform> possibleNodes;
+		std::vector<SceneNode*> changedNodes;
+		std::vector<SceneNode*> storeNodes;
 
-		// trigger event
-		OnTransformChange->Emit(shared_from_this());
+		auto parentPtr = m_Parent.lock();
+		possibleNodes.push_back(std::make_tuple(this, parentPtr.get(), false));
 
-		// force update child nodes' matrix
-		for (auto &child : m_Childs)
-			child->Recompose(true);
+		unsigned int workerCount = parallel ? ThreadUtil::Instance()->GetWorkerCount() : 0;
+		if (workerCount == 0)
+		{
+			while (!possibleNodes.empty())
+			{
+				auto pending = possibleNodes.back();
+				possibleNodes.pop_back();
+				UpdateTransform(pending, possibleNodes, changedNodes, storeNodes);
+			}
+		}
+		else
+		{
+			// go breadth first until there are enough subtrees to keep workers busy.
+			unsigned int head = 0;
+			while (head < possibleNodes.size() && possibleNodes.size() - head < workerCount * 4)
+				UpdateTransform(possibleNodes[head++], possibleNodes, changedNodes, storeNodes);
+
+			// each subtree is updated by one thread, results are merged in order.
+			unsigned int subtreeCount = possibleNodes.size() - head;
+			std::vector<std::vector<SceneNode*>> subtreeChangedNodes(subtreeCount);
+			std::vector<std::vector<SceneNode*>> subtreeStoreNodes(subtreeCount);
+
+			ThreadUtil::Instance()->ParallelFor(subtreeCount, [&](unsigned int index)
+			{
+				std::vector<PendingTransform> subtreeNodes;
+				subtreeNodes.push_back(possibleNodes[head + index]);
+
+				while (!subtreeNodes.empty())
+				{
+					auto pending = subtreeNodes.back();
+					subtreeNodes.pop_back();
+					UpdateTransform(pending, subtreeNodes, subtreeChangedNodes[index], subtreeStoreNodes[index]);
+				}
+			});
+
+			for (unsigned int i = 0; i < subtreeCount; i++)
+			{
+				changedNodes.insert(changedNodes.end(), subtreeChangedNodes[i].begin(), subtreeChangedNodes[i].end());
+				storeNodes.insert(storeNodes.end(), subtreeStoreNodes[i].begin(), subtreeStoreNodes[i].end());
+			}
+		}
+
+		ApplyTransformChanges(changedNodes);
+
+		// subtrees flattened into stores update themselves.
+		for (auto node : storeNodes)
+		{
+			if (node->m_TransformStore != nullptr)
+				node->m_TransformStore->Update(parallel);
+		}
+	}
+
+	void SceneNode::UpdateTransform(const PendingTransform &pending, std::vector<PendingTransform> &possibleNodes, 
+		std::vector<SceneNode*> &changedNodes, std::vector<SceneNode*> &storeNodes)
+	{
+		SceneNode *node = std::get<0>(pending);
+		SceneNode *parent = std::get<1>(pending);
+		bool changed = std::get<2>(pending) || node->m_TransformDirty;
+
+		if (node->m_TransformStore != nullptr)
+		{
+			// ancestors are being updated, don't mark them again.
+			if (changed)
+				node->m_TransformStore->m_Dirty[node->m_TransformIndex] = 1;
+
+			storeNodes.push_back(node);
+			return;
+		}
+
+		if (changed)
+		{
+			node->UpdateWorldTransform(parent);
+			changedNodes.push_back(node);
+		}
+
+		if (changed || node->m_ChildTransformDirty)
+		{
+			node->m_ChildTransformDirty = false;
+
+			// reversed, so childs are visited in order.
+			for (auto it = node->m_Childs.rbegin(); it != node->m_Childs.rend(); ++it)
+			{
+				SceneNode *child = it->get();
+				if (changed || child->m_TransformDirty || child->m_ChildTransformDirty)
+					possibleNodes.push_back(std::make_tuple(child, node, changed));
+			}
+		}
+	}
+
+	void SceneNode::ApplyTransformChanges(const std::vector<SceneNode*> &changedNodes)
+	{
+		// update octree info in one go
+		for (auto node : changedNodes)
+		{
+			if (!node->m_OcTreeNode.expired())
+				node->m_OcTreeNode.lock()->GetManager().UpdateSceneNode(node->shared_from_this());
+			else if (node->m_SceneManager != nullptr)
+				node->m_SceneManager->UpdateSceneNode(node->shared_from_this());
+		}
+
+		// trigger events
+		for (auto node : changedNodes)
+			node->OnTransformChange->Emit(node->shared_from_this());
+	}
+
+	void SceneNode::Recompose(bool force)
+	{
+		if (force)
+			MarkTransformDirty();
+
+		UpdateTransforms();
+	}
+
+	bool SceneNode::GetTransformDirty() const
+	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_Dirty[m_TransformIndex] != 0;
+
+		return m_TransformDirty || m_ChildTransformDirty;
+	}
+
+	TransformStore *SceneNode::GetTransformStore() const
+	{
+		return m_TransformStore;
 	}
 
 	Matrix4 SceneNode::GetLocalMatrix() const
 	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_LocalMatrices[m_TransformIndex];
+
 		return m_LocalMatrix;
 	}
 
@@ -297,6 +519,9 @@ namespace fury
 
 	Matrix4 SceneNode::GetWorldMatrix() const
 	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_WorldMatrices[m_TransformIndex];
+
 		return m_WorldMatrix;
 	}
 
@@ -307,40 +532,60 @@ namespace fury
 
 	Vector4 SceneNode::GetWorldPosition() const
 	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_WorldPositions[m_TransformIndex];
+
 		return m_WorldPosition;
 	}
 
 	Quaternion SceneNode::GetWorldRoattion() const
 	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_WorldRotations[m_TransformIndex];
+
 		return m_WorldRotation;
 	}
 
 	Vector4 SceneNode::GetWorldScale() const
 	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_WorldScales[m_TransformIndex];
+
 		return m_WorldScale;
 	}
 
 	Vector4 SceneNode::GetLocalPosition() const
 	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_LocalPositions[m_TransformIndex];
+
 		return m_LocalPosition;
 	}
 
 	Quaternion SceneNode::GetLocalRoattion() const
 	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_LocalRotations[m_TransformIndex];
+
 		return m_LocalRotation;
 	}
 
 	Vector4 SceneNode::GetLocalScale() const
 	{
+		if (m_TransformStore != nullptr)
+			return m_TransformStore->m_LocalScales[m_TransformIndex];
+
 		return m_LocalScale;
 	}
 
 	void SceneNode::SetLocalPosition(Vector4 position)
 	{
-		if (m_TransformDirty || m_LocalPosition != position)
+		if (m_TransformStore != nullptr)
+			m_TransformStore->SetLocalPosition(m_TransformIndex, position);
+		else if (m_TransformDirty || m_LocalPosition != position)
 		{
 			m_LocalPosition = position;
-			m_TransformDirty = true;
+			MarkTransformDirty();
 		}
 	}
 
@@ -351,10 +596,12 @@ namespace fury
 
 	void SceneNode::SetLocalRoattion(Quaternion rotation)
 	{
-		if (m_TransformDirty || m_LocalRotation != rotation)
+		if (m_TransformStore != nullptr)
+			m_TransformStore->SetLocalRoattion(m_TransformIndex, rotation);
+		else if (m_TransformDirty || m_LocalRotation != rotation)
 		{
 			m_LocalRotation = rotation;
-			m_TransformDirty = true;
+			MarkTransformDirty();
 		}
 	}
 
@@ -371,10 +618,12 @@ namespace fury
 
 	void SceneNode::SetLocalScale(Vector4 scale)
 	{
-		if (m_TransformDirty || m_LocalScale != scale)
+		if (m_TransformStore != nullptr)
+			m_TransformStore->SetLocalScale(m_TransformIndex, scale);
+		else if (m_TransformDirty || m_LocalScale != scale)
 		{
 			m_LocalScale = scale;
-			m_TransformDirty = true;
+			MarkTransformDirty();
 		}
 	}
 
@@ -389,8 +638,15 @@ namespace fury
 
 	void SceneNode::SetParent(const SceneNode::Ptr &parent)
 	{
+		// hierarchy changed, stores must be rebuilt.
+		if (m_TransformStore != nullptr)
+			m_TransformStore->Invalidate();
+
+		if (parent != nullptr && parent->m_TransformStore != nullptr)
+			parent->m_TransformStore->Invalidate();
+
 		m_Parent = parent;
-		Recompose(true);
+		MarkTransformDirty();
 	}
 
 	SceneNode::Ptr SceneNode::GetParent() const
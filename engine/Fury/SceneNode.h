@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <typeinfo>
+#include <tuple>
 #include <vector>
 
 #include "Fury/BoxBounds.h"
@@ -18,6 +19,10 @@ namespace fury
 
 	class OcTreeNode;
 
+	class SceneManager;
+
+	class TransformStore;
+
 	// To destory a scenenode.
 	// Call node.RemoveFromParent + node.RemoveFromOcTree(true) + node.reset.
 	// This node together with all it's childs will be destoried.
@@ -25,6 +30,8 @@ namespace fury
 	{
 		friend class OcTreeNode;
 
+		friend class TransformStore;
+
 	public:
 
 		typedef std::shared_ptr<SceneNode> Ptr;
@@ -36,8 +43,22 @@ namespace fury
 
 	protected:
 
+		// node, parent, parent's world transform changed
+		typedef std::tuple<SceneNode*, SceneNode*, bool> PendingTransform;
+
 		std::weak_ptr<OcTreeNode> m_OcTreeNode;
 
+		// index in m_OcTreeNode's scenenodes, set by OcTreeNode.
+		unsigned int m_OcTreeSlot;
+
+		// scene managers other than OcTree, see SetSceneManager.
+		SceneManager *m_SceneManager;
+
+		// where m_SceneManager keeps this node, meaning is up to the manager.
+		unsigned int m_SceneManagerCell;
+
+		unsigned int m_SceneManagerSlot;
+
 		std::weak_ptr<SceneNode> m_Parent;
 
 		std::vector<Ptr> m_Childs;
@@ -50,8 +71,15 @@ namespace fury
 
 		BoxBounds m_WorldAABB;
 
+		// won't move after load, see LinearOcTree.
+		bool m_Static;
+
+		// local transform changed since last update.
 		bool m_TransformDirty;
 
+		// some child in this subtree has m_TransformDirty set.
+		bool m_ChildTransformDirty;
+
 		Vector4 m_WorldPosition;
 
 		Vector4 m_WorldScale;
@@ -72,6 +100,11 @@ namespace fury
 
 		Matrix4 m_InvertWorldMatrix;
 
+		// when attached, transforms live in the store instead of members above.
+		TransformStore *m_TransformStore;
+
+		unsigned int m_TransformIndex;
+
 	public:
 
 		Signal<const Ptr&>::Ptr OnTransformChange;
@@ -87,10 +120,25 @@ namespace fury
 		// copies components and translations.
 		Ptr Clone(const std::string &name) const;
 
-		// remove this sceneNode from attached ocTree.
+		// remove this sceneNode from attached ocTree or scene manager.
 		// set recursively to true will call this on child nodes.
 		void RemoveFromOcTree(bool recursively = false);
 
+		std::shared_ptr<OcTreeNode> GetOcTreeNode() const;
+
+		// called by scene managers other than OcTree when they take or drop this node, 
+		// transform changes and removal are forwarded to the manager set here.
+		// the manager must reset it before it's destoried.
+		void SetSceneManager(SceneManager *manager, unsigned int cell = 0, unsigned int slot = 0);
+
+		SceneManager *GetSceneManager() const;
+
+		unsigned int GetSceneManagerCell() const;
+
+		unsigned int GetSceneManagerSlot() const;
+
+		void SetSceneManagerSlot(unsigned int slot);
+
 		void SetModelAABB(const BoxBounds &aabb);
 
 		BoxBounds GetModelAABB() const;
@@ -99,12 +147,32 @@ namespace fury
 
 		BoxBounds GetWorldAABB() const;
 
+		// static scenenodes are bulk built into LinearOcTree at load, 
+		// it's only a hint, moving one is still allowed but slower.
+		void SetStatic(bool value);
+
+		bool GetStatic() const;
+
 		//////////////////////////////////
 		// Transforms
 		//////////////////////////////////
 
+		// Setters and hierarchy changes only mark nodes dirty, 
+		// call UpdateTransforms on the root node once per frame to apply them.
+		// Walks dirty nodes of this subtree once, parent before child, 
+		// then updates changed nodes in octree and emits their OnTransformChange.
+		// If attached to a TransformStore, updates the whole store instead.
+		// parallel splits dirty subtrees across ThreadUtil workers, 
+		// octree updates and events still happen on calling thread.
+		void UpdateTransforms(bool parallel = false);
+
+		// UpdateTransforms on this subtree, force marks this node dirty first.
 		void Recompose(bool force = false);
 
+		bool GetTransformDirty() const;
+
+		TransformStore *GetTransformStore() const;
+
 		Matrix4 GetLocalMatrix() const;
 
 		Matrix4 GetInvertLocalMatrix() const;
@@ -201,6 +269,23 @@ namespace fury
 
 		void SetOcTreeNode(const std::shared_ptr<OcTreeNode> &ocTreeNode);
 
+		// mark local transform dirty, and let parent nodes know.
+		void MarkTransformDirty();
+
+		// recompute world transform from parent's world matrix.
+		void UpdateWorldTransform(const SceneNode *parent);
+
+		// recompute local and world aabb from model aabb.
+		void UpdateAABB();
+
+		// update changed nodes in octree, then emit their OnTransformChange.
+		static void ApplyTransformChanges(const std::vector<SceneNode*> &changedNodes);
+
+		// update one pending node, push it's childs that need update.
+		// scenenodes attached to a TransformStore are collected to storeNodes instead.
+		static void UpdateTransform(const PendingTransform &pending, std::vector<PendingTransform> &possibleNodes, 
+			std::vector<SceneNode*> &changedNodes, std::vector<SceneNode*> &storeNodes);
+
 		void SetParent(const Ptr &parent);
 	};
 
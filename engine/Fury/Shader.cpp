@@ -1,4 +1,10 @@
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "Fury/Camera.h"
+#include "Fury/GLStateCache.h"
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
 #include "Fury/EnumUtil.h"
@@ -7,6 +13,7 @@
 #include "Fury/Light.h"
 #include "Fury/Material.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshArena.h"
 #include "Fury/SceneNode.h"
 #include "Fury/Shader.h"
 #include "Fury/Texture.h"
@@ -14,11 +21,55 @@
 
 namespace fury
 {
+	namespace
+	{
+		typedef std::unordered_map<std::string, unsigned int> UniformIDMap;
+
+		// readers look names up in the latest snapshot without locking, 
+		// a new name copies it under the mutex and publishes the copy.
+		// names are few and added early, old snapshots are kept since readers might still hold one.
+		std::mutex s_UniformIDMutex;
+
+		std::vector<std::unique_ptr<UniformIDMap>> s_UniformIDSnapshots;
+
+		std::atomic<const UniformIDMap*> s_UniformIDs(nullptr);
+	}
+
 	Shader::Ptr Shader::Create(const std::string &name, ShaderType type, unsigned int textureFlags)
 	{
 		return std::make_shared<Shader>(name, type, textureFlags);
 	}
 
+	unsigned int Shader::GetUniformID(const std::string &name)
+	{
+		const UniformIDMap *uniformIDs = s_UniformIDs.load(std::memory_order_acquire);
+		if (uniformIDs != nullptr)
+		{
+			auto it = uniformIDs->find(name);
+			if (it != uniformIDs->end())
+				return it->second;
+		}
+
+		std::lock_guard<std::mutex> lock(s_UniformIDMutex);
+
+		// another thread might have added it meanwhile.
+		uniformIDs = s_UniformIDs.load(std::memory_order_relaxed);
+		if (uniformIDs != nullptr)
+		{
+			auto it = uniformIDs->find(name);
+			if (it != uniformIDs->end())
+				return it->second;
+		}
+
+		std::unique_ptr<UniformIDMap> snapshot(uniformIDs != nullptr ? new UniformIDMap(*uniformIDs) : new UniformIDMap());
+		unsigned int id = snapshot->size();
+		snapshot->emplace(name, id);
+
+		s_UniformIDs.store(snapshot.get(), std::memory_order_release);
+		s_UniformIDSnapshots.push_back(std::move(snapshot));
+		return id;
+	}
+
 	Shader::Shader(const std::string &name, ShaderType type, unsigned int textureFlags)
 		: Entity(name), m_Type(type), m_TextureFlags(textureFlags)
 	{
@@ -162,6 +213,11 @@ namespace fury
 		m_TextureFlags = flags;
 	}
 
+	bool Shader::HasUniformBlock(UniformBlock block) const
+	{
+		return (m_UniformBlocks & (1 << (unsigned int)block)) != 0;
+	}
+
 	void Shader::AddDefine(std::string define)
 	{
 		m_Defines.push_back(define);
@@ -301,6 +357,8 @@ namespace fury
 			if (m_UseGeomShader)
 				glAttachShader(m_Program, geometryShader);
 
+			MeshArena::BindAttribLocations(m_Program);
+
 			glLinkProgram(m_Program);
 
 			glDetachShader(m_Program, vertexShader);
@@ -334,6 +392,8 @@ namespace fury
 		}
 		
 		m_Dirty = false;
+		ReflectUniforms();
+
 		FURYD << m_Name << " compile & link success!";
 		return true;
 	}
@@ -342,10 +402,13 @@ namespace fury
 	{
 		if (m_Program != 0)
 		{
+			GLStateCache::ForgetProgram(m_Program);
 			glDeleteProgram(m_Program);
 			m_Program = 0;
 		}
 
+		m_UniformLocations.clear();
+		m_UniformBlocks = 0;
 		m_Dirty = true;
 	}
 
@@ -357,12 +420,18 @@ namespace fury
 			return;
 		}
 
-		glUseProgram(m_Program);
+		GLStateCache::Instance()->UseProgram(m_Program);
 		m_TextureID = GL_TEXTURE0;
 	}
 
 	void Shader::BindCamera(const std::shared_ptr<SceneNode> &camNode)
 	{
+		if (HasUniformBlock(UniformBlock::CAMERA))
+		{
+			UniformBuffer::Instance()->BindCamera(camNode);
+			return;
+		}
+
 		Vector4 camPos = camNode->GetWorldPosition();
 		if (auto camera = camNode->GetComponent<Camera>())
 		{
@@ -376,6 +445,12 @@ namespace fury
 
 	void Shader::BindLight(const std::shared_ptr<SceneNode> &lightNode)
 	{
+		if (HasUniformBlock(UniformBlock::LIGHT))
+		{
+			UniformBuffer::Instance()->BindLight(lightNode);
+			return;
+		}
+
 		static float pi = 3.141592653f;
 
 		Vector4 lightPos = lightNode->GetWorldPosition();
@@ -397,17 +472,22 @@ namespace fury
 
 	void Shader::BindTexture(const std::shared_ptr<Texture> &texture)
 	{
-		glActiveTexture(m_TextureID);
-		glBindTexture(texture->GetTypeUint(), texture->GetID());
+		GLStateCache::Instance()->ActiveTexture(m_TextureID);
+		GLStateCache::Instance()->BindTexture(texture->GetTypeUint(), texture->GetID());
 	}
 
 	void Shader::BindTexture(size_t textureId, TextureType type)
 	{
-		glActiveTexture(m_TextureID);
-		glBindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
+		GLStateCache::Instance()->ActiveTexture(m_TextureID);
+		GLStateCache::Instance()->BindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
 	}
 
 	void Shader::BindTexture(const std::string &name, const std::shared_ptr<Texture> &texture)
+	{
+		BindTexture(GetUniformID(name), texture);
+	}
+
+	void Shader::BindTexture(unsigned int uniformId, const std::shared_ptr<Texture> &texture)
 	{
 		if (texture->GetDirty())
 		{
@@ -415,12 +495,12 @@ namespace fury
 			return;
 		}
 
-		int id = GetUniformLocation(name);
+		int id = GetUniformLocation(uniformId);
 
 		if (id != -1)
 		{
-			glActiveTexture(m_TextureID);
-			glBindTexture(texture->GetTypeUint(), texture->GetID());
+			GLStateCache::Instance()->ActiveTexture(m_TextureID);
+			GLStateCache::Instance()->BindTexture(texture->GetTypeUint(), texture->GetID());
 			glUniform1i(id, m_TextureID - GL_TEXTURE0);
 
 			m_TextureID++;
@@ -433,29 +513,32 @@ namespace fury
 
 		if (id != -1)
 		{
-			glActiveTexture(m_TextureID);
-			glBindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
+			GLStateCache::Instance()->ActiveTexture(m_TextureID);
+			GLStateCache::Instance()->BindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
 			glUniform1i(id, m_TextureID - GL_TEXTURE0);
 
 			m_TextureID++;
 		}
 	}
 
-	void Shader::BindMaterial(const std::shared_ptr<Material> &material)
+	void Shader::BindMaterial(const std::shared_ptr<Material> &material, bool uniformBlock)
 	{
 		if (m_Dirty)
 			return;
 
-		for (auto it = material->m_Textures.begin(); it != material->m_Textures.end(); ++it)
+		if (uniformBlock && HasUniformBlock(UniformBlock::MATERIAL))
+			UniformBuffer::Instance()->Bind(UniformBlock::MATERIAL, material->GetUniformBlock());
+
+		for (auto &pair : material->m_TextureIDs)
 		{
-			BindTexture(it->first, it->second);
+			BindTexture(pair.first, pair.second);
 		}
 
-		for (auto it = material->m_Uniforms.begin(); it != material->m_Uniforms.end(); ++it)
+		for (auto &pair : material->m_UniformIDs)
 		{
-			UniformBase::Ptr &ptr = it->second;
-			if (ptr != nullptr)
-				ptr->Bind(m_Program, it->first.c_str());
+			int id = GetUniformLocation(pair.first);
+			if (id != -1)
+				pair.second->Bind(id);
 		}
 	}
 
@@ -466,9 +549,30 @@ namespace fury
 		int tangentFlag = glGetAttribLocation(m_Program, mesh->Tangents.Name.c_str());
 		int uvFlag = glGetAttribLocation(m_Program, mesh->UVs.Name.c_str());
 
-		glBindVertexArray(mesh->m_VAO);
+		if (mesh->IsInArena())
+		{
+			// attributes were set once on arena's vao, at the locations bound before linking.
+			GLStateCache::Instance()->BindVertexArray(MeshArena::Instance()->GetVertexArray());
+			BindFloat("position_offset", 0.0f, 0.0f, 0.0f);
+			BindFloat("position_scale", 1.0f, 1.0f, 1.0f);
+			BindInt("vertex_packed", 1);
+			return;
+		}
 
-		if (posFlag != -1)
+		GLStateCache::Instance()->BindVertexArray(mesh->m_VAO);
+
+		const VertexLayout &layout = mesh->GetVertexLayout();
+		bool packed = mesh->GetVertexFormat() != VertexFormat::SEPARATE;
+
+		BindFloat("position_offset", layout.positionOffset[0], layout.positionOffset[1], layout.positionOffset[2]);
+		BindFloat("position_scale", layout.positionScale[0], layout.positionScale[1], layout.positionScale[2]);
+		BindInt("vertex_packed", packed ? 1 : 0);
+
+		if (packed)
+		{
+			BindPackedMeshData(mesh, posFlag, normalFlag, tangentFlag, uvFlag);
+		}
+		else if (posFlag != -1)
 		{
 			if (!mesh->Positions.GetDirty())
 			{
@@ -481,7 +585,7 @@ namespace fury
 				FURYW << "Mesh " + mesh->GetName() + " Position data dirty!";
 			}
 		}
-		if (normalFlag != -1)
+		if (!packed && normalFlag != -1)
 		{
 			if (!mesh->Normals.GetDirty())
 			{
@@ -494,7 +598,7 @@ namespace fury
 				FURYW << "Mesh " + mesh->GetName() + " Normal data dirty!";
 			}
 		}
-		if (tangentFlag != -1)
+		if (!packed && tangentFlag != -1)
 		{
 			if (!mesh->Tangents.GetDirty())
 			{
@@ -507,7 +611,7 @@ namespace fury
 				FURYW << "Mesh" + mesh->GetName() + " Tangent data dirty!";
 			}
 		}
-		if (uvFlag != -1)
+		if (!packed && uvFlag != -1)
 		{
 			if (!mesh->UVs.GetDirty())
 			{
@@ -526,7 +630,12 @@ namespace fury
 			int idFlag = glGetAttribLocation(m_Program, mesh->IDs.Name.c_str());
 			int weightFlag = glGetAttribLocation(m_Program, mesh->Weights.Name.c_str());
 
-			if (idFlag != -1)
+			// packed joint data is set by BindPackedMeshData.
+			if (idFlag == -1)
+			{
+				FURYW << "Can't find " << mesh->IDs.Name << " in " << m_Name;
+			}
+			else if (!packed)
 			{
 				if (!mesh->IDs.GetDirty())
 				{
@@ -539,12 +648,12 @@ namespace fury
 					FURYW << "Mesh " + mesh->GetName() + " ID data dirty!";
 				}
 			}
-			else
+
+			if (weightFlag == -1)
 			{
-				FURYW << "Can't find " << mesh->IDs.Name << " in " << m_Name;
+				FURYW << "Can't find " << mesh->Weights.Name << " in " << m_Name;
 			}
-
-			if (weightFlag != -1)
+			else if (!packed)
 			{
 				if (!mesh->Weights.GetDirty())
 				{
@@ -557,10 +666,6 @@ namespace fury
 					FURYW << "Mesh " + mesh->GetName() + " Weight data dirty!";
 				}
 			}
-			else
-			{
-				FURYW << "Can't find " << mesh->Weights.Name << " in " << m_Name;
-			}
 
 			if (idFlag != -1 && weightFlag != -1)
 			{
@@ -592,12 +697,77 @@ namespace fury
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
+	void Shader::BindPackedMeshData(const std::shared_ptr<Mesh> &mesh, int posFlag, int normalFlag, int tangentFlag, int uvFlag)
+	{
+		if (mesh->Vertices.GetDirty())
+		{
+			FURYW << "Mesh " + mesh->GetName() + " Vertex data dirty!";
+			return;
+		}
+
+		const VertexLayout &layout = mesh->GetVertexLayout();
+		int stride = layout.stride;
+
+		glBindBuffer(GL_ARRAY_BUFFER, mesh->Vertices.GetID());
+
+		if (posFlag != -1)
+		{
+			if (layout.quantized)
+				glVertexAttribPointer(posFlag, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)(size_t)layout.position);
+			else
+				glVertexAttribPointer(posFlag, 3, GL_FLOAT, GL_FALSE, stride, (void*)(size_t)layout.position);
+			glEnableVertexAttribArray(posFlag);
+		}
+		if (normalFlag != -1 && layout.normal != -1)
+		{
+			glVertexAttribPointer(normalFlag, 2, GL_SHORT, GL_TRUE, stride, (void*)(size_t)layout.normal);
+			glEnableVertexAttribArray(normalFlag);
+		}
+		if (tangentFlag != -1 && layout.tangent != -1)
+		{
+			glVertexAttribPointer(tangentFlag, 2, GL_SHORT, GL_TRUE, stride, (void*)(size_t)layout.tangent);
+			glEnableVertexAttribArray(tangentFlag);
+		}
+		if (uvFlag != -1 && layout.uv != -1)
+		{
+			glVertexAttribPointer(uvFlag, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)(size_t)layout.uv);
+			glEnableVertexAttribArray(uvFlag);
+		}
+
+		if (layout.ids != -1)
+		{
+			int idFlag = glGetAttribLocation(m_Program, mesh->IDs.Name.c_str());
+			int weightFlag = glGetAttribLocation(m_Program, mesh->Weights.Name.c_str());
+
+			if (idFlag != -1)
+			{
+				glVertexAttribIPointer(idFlag, 4, GL_UNSIGNED_BYTE, stride, (void*)(size_t)layout.ids);
+				glEnableVertexAttribArray(idFlag);
+			}
+			if (weightFlag != -1)
+			{
+				glVertexAttribPointer(weightFlag, 3, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)(size_t)layout.weights);
+				glEnableVertexAttribArray(weightFlag);
+			}
+		}
+	}
+
 	void Shader::BindMesh(const std::shared_ptr<Mesh> &mesh)
 	{
 		if (mesh->GetDirty())
 			mesh->UpdateBuffer();
 
-		if (m_Dirty || mesh->GetDirty() || mesh->Indices.GetDirty())
+		if (m_Dirty || mesh->GetDirty())
+			return;
+
+		// arena's index buffer is part of its vao.
+		if (mesh->IsInArena())
+		{
+			BindMeshData(mesh);
+			return;
+		}
+
+		if (mesh->Indices.GetDirty())
 			return;
 
 		BindMeshData(mesh);
@@ -614,6 +784,10 @@ namespace fury
 			return;
 		}
 
+		// submesh draws only differ by their DrawRange.
+		if (mesh->IsInArena())
+			return;
+
 		if (subMesh->GetDirty())
 			subMesh->UpdateBuffer();
 
@@ -623,6 +797,44 @@ namespace fury
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, subMesh->Indices.GetID());
 	}
 
+	void Shader::BindInstances(const ArrayBufferf &instances, unsigned int offset)
+	{
+		int matrixFlag = glGetAttribLocation(m_Program, instances.Name.c_str());
+		if (matrixFlag == -1)
+			return;
+
+		if (instances.GetDirty())
+		{
+			FURYW << "Instance data dirty!";
+			return;
+		}
+
+		// a mat4 attribute takes 4 locations, one per column.
+		glBindBuffer(GL_ARRAY_BUFFER, instances.GetID());
+		for (int i = 0; i < 4; i++)
+		{
+			glVertexAttribPointer(matrixFlag + i, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16, 
+				(void*)(sizeof(float) * (offset * 16 + i * 4)));
+			glVertexAttribDivisor(matrixFlag + i, 1);
+			glEnableVertexAttribArray(matrixFlag + i);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void Shader::UnBindInstances(const ArrayBufferf &instances)
+	{
+		int matrixFlag = glGetAttribLocation(m_Program, instances.Name.c_str());
+		if (matrixFlag == -1)
+			return;
+
+		// vao is shared with other shaders, restore the divisors.
+		for (int i = 0; i < 4; i++)
+		{
+			glVertexAttribDivisor(matrixFlag + i, 0);
+			glDisableVertexAttribArray(matrixFlag + i);
+		}
+	}
+
 	void Shader::BindMatrix(const std::string &name, const Matrix4 &matrix)
 	{
 		BindMatrix(name, &matrix.Raw[0]);
@@ -630,14 +842,24 @@ namespace fury
 
 	void Shader::BindMatrix(const std::string &name, const float *raw)
 	{
-		int id = GetUniformLocation(name);
+		BindMatrix(GetUniformID(name), raw);
+	}
+
+	void Shader::BindMatrix(unsigned int uniformId, const float *raw)
+	{
+		int id = GetUniformLocation(uniformId);
 		if (id != -1)
 			glUniformMatrix4fv(id, 1, false, raw);
 	}
 
 	void Shader::BindMatrices(const std::string &name, int count, const float *raw)
 	{
-		int id = GetUniformLocation(name);
+		BindMatrices(GetUniformID(name), count, raw);
+	}
+
+	void Shader::BindMatrices(unsigned int uniformId, int count, const float *raw)
+	{
+		int id = GetUniformLocation(uniformId);
 		if (id != -1)
 			glUniformMatrix4fv(id, count, false, raw);
 	}
@@ -687,7 +909,12 @@ namespace fury
 
 	void Shader::BindFloat(const std::string &name, int size, int count, const float *value)
 	{
-		int id = GetUniformLocation(name);
+		BindFloat(GetUniformID(name), size, count, value);
+	}
+
+	void Shader::BindFloat(unsigned int uniformId, int size, int count, const float *value)
+	{
+		int id = GetUniformLocation(uniformId);
 		if (id == -1) return;
 
 		switch (size)
@@ -820,9 +1047,9 @@ namespace fury
 	{
 		m_TextureID = GL_TEXTURE0;
 
-		glUseProgram(0);
+		GLStateCache::Instance()->UseProgram(0);
 
-		glBindVertexArray(0);
+		GLStateCache::Instance()->BindVertexArray(0);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
@@ -831,7 +1058,70 @@ namespace fury
 		if (m_Dirty)
 			return -1;
 
-		return glGetUniformLocation(m_Program, name.c_str());
+		return GetUniformLocation(GetUniformID(name));
+	}
+
+	int Shader::GetUniformLocation(unsigned int uniformId) const
+	{
+		if (m_Dirty || uniformId >= m_UniformLocations.size())
+			return -1;
+
+		return m_UniformLocations[uniformId];
+	}
+
+	void Shader::ReflectUniforms()
+	{
+		m_UniformLocations.clear();
+
+		auto setLocation = [&](const std::string &name)
+		{
+			int location = glGetUniformLocation(m_Program, name.c_str());
+			if (location == -1)
+				return;
+
+			unsigned int id = GetUniformID(name);
+			if (id >= m_UniformLocations.size())
+				m_UniformLocations.resize(id + 1, -1);
+
+			m_UniformLocations[id] = location;
+		};
+
+		GLint count = 0, maxLength = 0;
+		glGetProgramiv(m_Program, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(m_Program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+		std::vector<GLchar> buffer(maxLength + 1);
+
+		for (GLint i = 0; i < count; i++)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_Program, i, maxLength + 1, &length, &size, &type, &buffer[0]);
+
+			// arrays are reported as name[0], they can be bound by name or by element.
+			std::string name(&buffer[0], length);
+			if (size > 1 && name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+			{
+				name.resize(name.size() - 3);
+				for (GLint j = 0; j < size; j++)
+					setLocation(name + "[" + std::to_string(j) + "]");
+			}
+
+			// members of uniform blocks have no location and are skipped.
+			setLocation(name);
+		}
+
+		m_UniformBlocks = 0;
+		for (unsigned int i = 0; i < (unsigned int)UniformBlock::LENGTH; i++)
+		{
+			auto index = glGetUniformBlockIndex(m_Program, UniformBuffer::GetBlockName((UniformBlock)i).c_str());
+			if (index != GL_INVALID_INDEX)
+			{
+				glUniformBlockBinding(m_Program, index, i);
+				m_UniformBlocks |= 1 << i;
+			}
+		}
 	}
 
 	void Shader::GetVersionInfo(const std::string &source, std::string &versionStr, std::string &mainStr)
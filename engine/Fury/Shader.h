@@ -3,9 +3,11 @@
 
 #include <iostream>
 
+#include "Fury/ArrayBuffers.h"
 #include "Fury/Entity.h"
 #include "Fury/EnumUtil.h"
 #include "Fury/Matrix4.h"
+#include "Fury/UniformBuffer.h"
 
 namespace fury
 {
@@ -26,6 +28,10 @@ namespace fury
 
 		static Ptr Create(const std::string &name, ShaderType type, unsigned int textureFlags = 0);
 
+		// returns a process wide id for the uniform name.
+		// binding by id skips the name lookup, ids never change once assigned.
+		static unsigned int GetUniformID(const std::string &name);
+
 	protected:
 
 		std::string m_FilePath;
@@ -44,6 +50,12 @@ namespace fury
 
 		bool m_UseGeomShader = false;
 
+		// uniform locations indexed by uniform id, reflected once after linking.
+		std::vector<int> m_UniformLocations;
+
+		// bit per UniformBlock the program declares.
+		unsigned int m_UniformBlocks = 0;
+
 	public:
 
 		Shader(const std::string &name, ShaderType type, unsigned int textureFlags = 0);
@@ -66,6 +78,9 @@ namespace fury
 
 		void SetTextureFlags(unsigned int flags);
 
+		// camera, light and material data of these blocks come from UniformBuffer.
+		bool HasUniformBlock(UniformBlock block) const;
+
 		void AddDefine(std::string define);
 
 		bool LoadAndCompile(const std::string &shaderPath, bool useGeomShader = false);
@@ -90,18 +105,31 @@ namespace fury
 
 		void BindTexture(const std::string &name, size_t textureId, TextureType type);
 
-		void BindMaterial(const std::shared_ptr<Material> &material);
+		void BindTexture(unsigned int uniformId, const std::shared_ptr<Texture> &texture);
+
+		// uniformBlock false leaves the material block to the caller, see CommandBuffer::BindMaterial.
+		void BindMaterial(const std::shared_ptr<Material> &material, bool uniformBlock = true);
 
 		void BindMesh(const std::shared_ptr<Mesh> &mesh);
 
 		void BindSubMesh(const std::shared_ptr<Mesh> &mesh, unsigned int index);
 
+		// bind per instance world matrices, starting from the offset'th matrix.
+		// call after BindMesh, and UnBindInstances before drawing without instances.
+		void BindInstances(const ArrayBufferf &instances, unsigned int offset);
+
+		void UnBindInstances(const ArrayBufferf &instances);
+
 		void BindMatrix(const std::string &name, const Matrix4 &matrix);
 
 		void BindMatrix(const std::string &name, const float *raw);
 
+		void BindMatrix(unsigned int uniformId, const float *raw);
+
 		void BindMatrices(const std::string &name, int count, const float *raw);
 
+		void BindMatrices(unsigned int uniformId, int count, const float *raw);
+
 		void BindMatrices(const std::string &name, int count, const Matrix4 *matrices);
 
 		void BindFloat(const std::string &name, float v0);
@@ -114,6 +142,8 @@ namespace fury
 
 		void BindFloat(const std::string &name, int size, int count, const float *value);
 
+		void BindFloat(unsigned int uniformId, int size, int count, const float *value);
+
 		void BindInt(const std::string &name, int v0);
 
 		void BindInt(const std::string &name, int v0, int v1);
@@ -140,8 +170,16 @@ namespace fury
 
 		void BindMeshData(const std::shared_ptr<Mesh> &mesh);
 
+		// attribute pointers into mesh's interleaved Vertices.
+		void BindPackedMeshData(const std::shared_ptr<Mesh> &mesh, int posFlag, int normalFlag, int tangentFlag, int uvFlag);
+
+		// cached location, no gl call.
 		int GetUniformLocation(const std::string &name) const;
 
+		int GetUniformLocation(unsigned int uniformId) const;
+
+		void ReflectUniforms();
+
 		void GetVersionInfo(const std::string &source, std::string &versionStr, std::string &mainStr);
 
 	};
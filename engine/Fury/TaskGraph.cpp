@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "Fury/Log.h"
+#include "Fury/TaskGraph.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	TaskGraph::Ptr TaskGraph::Create(const std::string &name)
+	{
+		return std::make_shared<TaskGraph>(name);
+	}
+
+	TaskGraph::TaskGraph(const std::string &name) 
+		: m_Name(name), m_FinishedCount(0), m_StartTime(0), m_ExecuteTime(0), m_DumpCriticalPath(false)
+	{
+
+	}
+
+	unsigned int TaskGraph::AddTask(const std::string &name, std::function<void()> func,
+		const std::vector<std::string> &reads, const std::vector<std::string> &writes, bool mainThread)
+	{
+		std::unique_ptr<TaskNode> task(new TaskNode());
+		task->name = name;
+		task->func = func;
+		task->mainThread = mainThread;
+
+		std::hash<std::string> hash;
+		for (auto &resource : reads)
+			task->reads.push_back(hash(resource));
+		for (auto &resource : writes)
+			task->writes.push_back(hash(resource));
+
+		auto overlaps = [](const std::vector<size_t> &a, const std::vector<size_t> &b)
+		{
+			for (auto x : a)
+			{
+				for (auto y : b)
+				{
+					if (x == y)
+						return true;
+				}
+			}
+			return false;
+		};
+
+		unsigned int index = m_Tasks.size();
+		for (unsigned int i = 0; i < index; i++)
+		{
+			auto &other = m_Tasks[i];
+			if (overlaps(task->reads, other->writes) || overlaps(task->writes, other->writes) || 
+				overlaps(task->writes, other->reads))
+			{
+				task->dependencies.push_back(i);
+				other->dependents.push_back(index);
+			}
+		}
+
+		m_Tasks.push_back(std::move(task));
+		return index;
+	}
+
+	void TaskGraph::RemoveAllTasks()
+	{
+		m_Tasks.clear();
+	}
+
+	void TaskGraph::Execute()
+	{
+		unsigned int taskCount = m_Tasks.size();
+		if (taskCount == 0)
+			return;
+
+		m_StartTime = GetTime();
+		m_FinishedCount = 0;
+
+		for (auto &task : m_Tasks)
+			task->remaining = task->dependencies.size();
+
+		for (unsigned int i = 0; i < taskCount; i++)
+		{
+			if (m_Tasks[i]->dependencies.empty())
+				Ready(i);
+		}
+
+		auto &threadUtil = ThreadUtil::Instance();
+		while (m_FinishedCount < taskCount)
+		{
+			int index = -1;
+			{
+				std::unique_lock<std::mutex> lock(m_MainThreadMutex);
+				if (!m_MainThreadTasks.empty())
+				{
+					index = m_MainThreadTasks.front();
+					m_MainThreadTasks.pop_front();
+				}
+			}
+
+			if (index >= 0)
+				Run(index);
+			else if (!threadUtil->RunJob())
+				std::this_thread::yield();
+		}
+
+		m_ExecuteTime = GetTime() - m_StartTime;
+
+		if (m_DumpCriticalPath)
+			DumpCriticalPath();
+	}
+
+	void TaskGraph::Ready(unsigned int index)
+	{
+		if (m_Tasks[index]->mainThread)
+		{
+			std::unique_lock<std::mutex> lock(m_MainThreadMutex);
+			m_MainThreadTasks.push_back(index);
+		}
+		else
+		{
+			ThreadUtil::Instance()->Submit([this, index] { Run(index); });
+		}
+	}
+
+	void TaskGraph::Run(unsigned int index)
+	{
+		auto &task = m_Tasks[index];
+
+		task->startTime = GetTime() - m_StartTime;
+		if (task->func)
+			task->func();
+		task->endTime = GetTime() - m_StartTime;
+
+		for (auto dependent : task->dependents)
+		{
+			if (--m_Tasks[dependent]->remaining == 0)
+				Ready(dependent);
+		}
+
+		m_FinishedCount++;
+	}
+
+	double TaskGraph::GetTime() const
+	{
+		return std::chrono::duration<double>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+	}
+
+	void TaskGraph::SetDumpCriticalPath(bool dump)
+	{
+		m_DumpCriticalPath = dump;
+	}
+
+	bool TaskGraph::GetDumpCriticalPath() const
+	{
+		return m_DumpCriticalPath;
+	}
+
+	std::vector<std::pair<std::string, float>> TaskGraph::GetCriticalPath() const
+	{
+		std::vector<std::pair<std::string, float>> path;
+
+		unsigned int taskCount = m_Tasks.size();
+		if (taskCount == 0)
+			return path;
+
+		// tasks are added in topological order.
+		std::vector<double> pathTimes(taskCount);
+		std::vector<int> previous(taskCount, -1);
+		unsigned int last = 0;
+
+		for (unsigned int i = 0; i < taskCount; i++)
+		{
+			auto &task = m_Tasks[i];
+
+			double start = 0;
+			for (auto dependency : task->dependencies)
+			{
+				if (pathTimes[dependency] > start)
+				{
+					start = pathTimes[dependency];
+					previous[i] = dependency;
+				}
+			}
+
+			pathTimes[i] = start + task->endTime - task->startTime;
+			if (pathTimes[i] > pathTimes[last])
+				last = i;
+		}
+
+		for (int i = last; i >= 0; i = previous[i])
+		{
+			auto &task = m_Tasks[i];
+			path.emplace_back(task->name, (float)((task->endTime - task->startTime) * 1000.0));
+		}
+
+		std::reverse(path.begin(), path.end());
+		return path;
+	}
+
+	void TaskGraph::DumpCriticalPath() const
+	{
+		auto path = GetCriticalPath();
+
+		float total = 0;
+		std::stringstream stream;
+		for (unsigned int i = 0; i < path.size(); i++)
+		{
+			if (i > 0)
+				stream << " -> ";
+			stream << path[i].first << " " << path[i].second << "ms";
+			total += path[i].second;
+		}
+
+		FURYD << m_Name << " critical path " << total << "ms of " << GetExecuteTime() << "ms: " << stream.str();
+	}
+
+	float TaskGraph::GetExecuteTime() const
+	{
+		return (float)(m_ExecuteTime * 1000.0);
+	}
+
+	unsigned int TaskGraph::GetTaskCount() const
+	{
+		return m_Tasks.size();
+	}
+
+	std::string TaskGraph::GetName() const
+	{
+		return m_Name;
+	}
+}
\ No newline at end of file
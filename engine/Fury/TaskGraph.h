@@ -0,0 +1,113 @@
+#ifndef _FURY_TASK_GRAPH_H_
+#define _FURY_TASK_GRAPH_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+
+#include "Fury/Macros.h"
+
+namespace fury
+{
+	// Graph of per-frame tasks, executed on ThreadUtil workers.
+	// Each task declares resources it reads and writes, a task depends on earlier added tasks 
+	// that write what it reads, or read/write what it writes, others run concurrently.
+	// Tasks that touch gl or gui should be marked mainThread.
+	class FURY_API TaskGraph
+	{
+	public:
+
+		typedef std::shared_ptr<TaskGraph> Ptr;
+
+		static Ptr Create(const std::string &name);
+
+	protected:
+
+		class TaskNode
+		{
+		public:
+
+			std::string name;
+
+			std::function<void()> func;
+
+			std::vector<size_t> reads;
+
+			std::vector<size_t> writes;
+
+			bool mainThread = false;
+
+			std::vector<unsigned int> dependencies;
+
+			std::vector<unsigned int> dependents;
+
+			std::atomic<int> remaining;
+
+			// in seconds since Execute started.
+			double startTime = 0;
+
+			double endTime = 0;
+		};
+
+		std::string m_Name;
+
+		std::vector<std::unique_ptr<TaskNode>> m_Tasks;
+
+		std::atomic<unsigned int> m_FinishedCount;
+
+		std::deque<unsigned int> m_MainThreadTasks;
+
+		std::mutex m_MainThreadMutex;
+
+		double m_StartTime;
+
+		double m_ExecuteTime;
+
+		bool m_DumpCriticalPath;
+
+	public:
+
+		TaskGraph(const std::string &name);
+
+		// returns task's index.
+		unsigned int AddTask(const std::string &name, std::function<void()> func, 
+			const std::vector<std::string> &reads, const std::vector<std::string> &writes, bool mainThread = false);
+
+		void RemoveAllTasks();
+
+		// returns when all tasks finished.
+		void Execute();
+
+		// log critical path after each Execute.
+		void SetDumpCriticalPath(bool dump);
+
+		bool GetDumpCriticalPath() const;
+
+		// longest chain of dependent tasks in last Execute, task names and durations in ms.
+		std::vector<std::pair<std::string, float>> GetCriticalPath() const;
+
+		void DumpCriticalPath() const;
+
+		// wall time of last Execute, in ms.
+		float GetExecuteTime() const;
+
+		unsigned int GetTaskCount() const;
+
+		std::string GetName() const;
+
+	protected:
+
+		// dependencies finished, run it or queue it.
+		void Ready(unsigned int index);
+
+		void Run(unsigned int index);
+
+		double GetTime() const;
+	};
+}
+
+#endif // _FURY_TASK_GRAPH_H_
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <sstream>
 
 #include "Fury/BufferManager.h"
+#include "Fury/GLStateCache.h"
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
 #include "Fury/FileUtil.h"
@@ -232,7 +233,7 @@ namespace fury
 			m_Dirty = false;
 
 			glGenTextures(1, &m_ID);
-			glBindTexture(m_TypeUint, m_ID);
+			GLStateCache::Instance()->BindTexture(m_TypeUint, m_ID);
 
 			glTexStorage2D(m_TypeUint, m_Mipmap ? FURY_MIPMAP_LEVEL : 1, internalFormat, m_Width, m_Height);
 			glTexSubImage2D(m_TypeUint, 0, 0, 0, m_Width, m_Height, imageFormat, GL_UNSIGNED_BYTE, &pixels[0]);
@@ -252,7 +253,7 @@ namespace fury
 			if (m_Mipmap)
 				glGenerateMipmap(m_TypeUint);
 
-			glBindTexture(m_TypeUint, 0);
+			GLStateCache::Instance()->BindTexture(m_TypeUint, 0);
 
 			FURYD << m_Name << " [" << m_Width << " x " << m_Height << " x " << EnumUtil::TextureTypeToString(m_Type) << "]";
 
@@ -280,7 +281,7 @@ namespace fury
 		unsigned int internalFormat = EnumUtil::TextureFormatToUint(format).second;
 
 		glGenTextures(1, &m_ID);
-		glBindTexture(m_TypeUint, m_ID);
+		GLStateCache::Instance()->BindTexture(m_TypeUint, m_ID);
 
 		if (m_Type == TextureType::TEXTURE_2D_ARRAY)
 		{
@@ -306,7 +307,7 @@ namespace fury
 		if (m_Mipmap)
 			glGenerateMipmap(m_TypeUint);
 
-		glBindTexture(m_TypeUint, 0);
+		GLStateCache::Instance()->BindTexture(m_TypeUint, 0);
 
 		FURYD << m_Name << " [" << m_Width << " x " << m_Height << " x " << EnumUtil::TextureTypeToString(m_Type) << "]";
 
@@ -321,13 +322,13 @@ namespace fury
 			return;
 		}
 
-		glBindTexture(m_TypeUint, m_ID);
+		GLStateCache::Instance()->BindTexture(m_TypeUint, m_ID);
 		glTexSubImage2D(m_TypeUint, 0, 0, 0, m_Width, m_Height, EnumUtil::TextureFormatToUint(m_Format).second, GL_UNSIGNED_BYTE, pixels);
 
 		if (m_Mipmap)
 			glGenerateMipmap(m_TypeUint);
 
-		glBindTexture(m_TypeUint, 0);
+		GLStateCache::Instance()->BindTexture(m_TypeUint, 0);
 	}
 
 	void Texture::UpdateBuffer()
@@ -350,6 +351,7 @@ namespace fury
 		if (m_ID != 0)
 		{
 			DecreaseMemory();
+			GLStateCache::ForgetTexture(m_ID);
 			glDeleteTextures(1, &m_ID);
 			m_ID = 0;
 			m_Width = m_Height = 0;
@@ -391,13 +393,13 @@ namespace fury
 			m_FilterMode = mode;
 			if (m_ID != 0)
 			{
-				glBindTexture(m_TypeUint, m_ID);
+				GLStateCache::Instance()->BindTexture(m_TypeUint, m_ID);
 
 				unsigned int filterMode = EnumUtil::FilterModeToUint(m_FilterMode);
 				glTexParameteri(m_TypeUint, GL_TEXTURE_MIN_FILTER, filterMode);
 				glTexParameteri(m_TypeUint, GL_TEXTURE_MAG_FILTER, filterMode);
 
-				glBindTexture(m_TypeUint, 0);
+				GLStateCache::Instance()->BindTexture(m_TypeUint, 0);
 			}
 		}
 	}
@@ -414,14 +416,14 @@ namespace fury
 			m_WrapMode = mode;
 			if (m_ID != 0)
 			{
-				glBindTexture(m_TypeUint, m_ID);
+				GLStateCache::Instance()->BindTexture(m_TypeUint, m_ID);
 
 				unsigned int wrapMode = EnumUtil::WrapModeToUint(m_WrapMode);
 				glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_S, wrapMode);
 				glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_T, wrapMode);
 				glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_R, wrapMode);
 
-				glBindTexture(m_TypeUint, 0);
+				GLStateCache::Instance()->BindTexture(m_TypeUint, 0);
 			}
 		}
 	}
@@ -438,12 +440,12 @@ namespace fury
 			m_BorderColor = color;
 			if (m_ID != 0)
 			{
-				glBindTexture(m_TypeUint, m_ID);
+				GLStateCache::Instance()->BindTexture(m_TypeUint, m_ID);
 
 				float color[] = { m_BorderColor.r, m_BorderColor.g, m_BorderColor.b, m_BorderColor.a };
 				glTexParameterfv(m_TypeUint, GL_TEXTURE_BORDER_COLOR, color);
 
-				glBindTexture(m_TypeUint, 0);
+				GLStateCache::Instance()->BindTexture(m_TypeUint, 0);
 			}
 		}
 	}
@@ -455,7 +457,7 @@ namespace fury
 
 		m_Mipmap = true;
 
-		glBindTexture(m_TypeUint, m_ID);
+		GLStateCache::Instance()->BindTexture(m_TypeUint, m_ID);
 		glGenerateMipmap(m_TypeUint);
 	}
 
@@ -1,6 +1,3 @@
-#include <stack>
-#include <list>
-
 #include "Fury/Log.h"
 #include "Fury/ThreadUtil.h"
 
@@ -10,8 +7,10 @@ namespace fury
 
 	size_t ThreadUtil::m_TaskKey = 0;
 
+	const unsigned int ThreadUtil::QUEUE_CAPACITY;
+
 	ThreadUtil::ThreadUtil(unsigned int numThreads)
-		: m_Stop(false)
+		: m_PendingJobs(0), m_SleepingWorkers(0), m_Ready(false), m_Stop(false)
 	{
 		unsigned int maxThreads = std::thread::hardware_concurrency();
 		if (numThreads > maxThreads)
@@ -20,32 +19,42 @@ namespace fury
 			FURYW << "Hardware supports " << maxThreads << " threads at most!";
 		}
 
+		for (unsigned int i = 0; i < numThreads; i++)
+			m_LocalJobs.emplace_back(new WorkStealingQueue<Job>(QUEUE_CAPACITY));
+
 		for (unsigned int i = 0; i < numThreads; i++)
 		{
-			m_Workers.emplace_back([this]
+			m_Workers.emplace_back([this, i]
 			{
+				// wait until all worker ids are known.
+				while (!this->m_Ready)
+					std::this_thread::yield();
+
 				while (true)
 				{
-					std::function<void()> task;
-
+					Job *job = this->TakeJob(i, true);
+					if (job != nullptr)
 					{
-						std::unique_lock<std::mutex> lock(this->m_QueueMutex);
-						this->m_Condiction.wait(lock, [this]
-						{
-							return this->m_Stop || !this->m_Tasks.empty();
-						});
-
-						if (this->m_Stop && this->m_Tasks.empty())
-							return;
-
-						task = std::move(this->m_Tasks.front());
-						this->m_Tasks.pop();
+						this->Execute(job);
+						continue;
 					}
 
-					task();
+					std::unique_lock<std::mutex> lock(this->m_QueueMutex);
+					this->m_SleepingWorkers++;
+					this->m_Condiction.wait(lock, [this]
+					{
+						return this->m_Stop || this->m_PendingJobs > 0;
+					});
+					this->m_SleepingWorkers--;
+
+					if (this->m_Stop && this->m_PendingJobs == 0)
+						return;
 				}
 			});
+			m_WorkerIds.push_back(m_Workers.back().get_id());
 		}
+
+		m_Ready = true;
 	}
 
 	ThreadUtil::~ThreadUtil()
@@ -53,77 +62,190 @@ namespace fury
 		{
 			std::unique_lock<std::mutex> lock(m_QueueMutex);
 			m_Stop = true;
-			m_TaskStates.clear();
 		}
 
 		m_Condiction.notify_all();
 		for (std::thread &worker : m_Workers)
 			worker.join();
+
+		m_TaskStates.clear();
+		m_FinishedTasks.clear();
 	}
 
 	size_t ThreadUtil::Enqueue(std::function<void(int&)> task, std::function<void()> callback, std::function<void(int)> progressChanged)
 	{
-		std::unique_lock<std::mutex> lock(m_QueueMutex);
+		auto state = CreateTaskState(progressChanged);
+		state->callback = callback;
 
-		// don't allow enqueueing after stopping the pool
-		if (m_Stop)
-			throw std::runtime_error("Enqueue on stopped ThreadPool");
+		Submit([this, task, state]()
+		{
+			task(state->progress);
+			FinishTask(state);
+		}, std::vector<Job::Ptr>(), true);
+
+		return state->id;
+	}
+
+	std::shared_ptr<ThreadUtil::TaskState> ThreadUtil::CreateTaskState(std::function<void(int)> progressChanged)
+	{
+		std::unique_lock<std::mutex> lock(m_TaskMutex);
 
 		size_t key = m_TaskKey++;
 		auto state = std::make_shared<TaskState>(key, nullptr);
-		state->callback = callback;
 		state->progressChanged = progressChanged;
 
-		m_Tasks.emplace([task, state]()
-		{
-			task(state->progress);
-			state->finished = true;
-		});
+		// progress has to be polled, others are only visited when finished.
+		if (progressChanged)
+			m_TaskStates.emplace(key, state);
 
-		m_TaskStates.emplace(key, state);
-		m_Condiction.notify_one();
-		return key;
+		return state;
+	}
+
+	void ThreadUtil::FinishTask(const std::shared_ptr<TaskState> &state)
+	{
+		std::unique_lock<std::mutex> lock(m_TaskMutex);
+		m_FinishedTasks.push_back(state);
 	}
 
 	void ThreadUtil::Update()
 	{
-		std::unique_lock<std::mutex> lock(m_QueueMutex);
+		// without workers, background tasks run here.
+		if (m_Workers.empty())
+		{
+			while (RunJob(true));
+		}
+
+		std::vector<std::shared_ptr<TaskState>> finishedTasks;
+
+		std::unique_lock<std::mutex> lock(m_TaskMutex);
 
-		std::list<size_t> finishedTasks;
 		for (auto &pair : m_TaskStates)
 		{
 			auto id = pair.first;
 			auto &state = pair.second;
 
-			if (state->progressChanged)
+			auto it = m_TaskProgresses.find(id);
+			if (it == m_TaskProgresses.end())
 			{
-				auto it = m_TaskProgresses.find(id);
-				if (it == m_TaskProgresses.end())
-				{
-					m_TaskProgresses.emplace(id, state->progress);
-					state->progressChanged(state->progress);
-				}
-				else if (it->second != state->progress)
-				{
-					m_TaskProgresses[id] = state->progress;
-					state->progressChanged(state->progress);
-				}
+				m_TaskProgresses.emplace(id, state->progress);
+				state->progressChanged(state->progress);
+			}
+			else if (it->second != state->progress)
+			{
+				it->second = state->progress;
+				state->progressChanged(state->progress);
 			}
+		}
+
+		finishedTasks.swap(m_FinishedTasks);
 
-			if (state->finished)
-				finishedTasks.emplace_back(id);
+		for (auto &state : finishedTasks)
+		{
+			m_TaskStates.erase(state->id);
+			m_TaskProgresses.erase(state->id);
 		}
 
-		for (auto &id : finishedTasks)
+		// callbacks may enqueue new tasks.
+		lock.unlock();
+
+		for (auto &state : finishedTasks)
 		{
-			auto state = m_TaskStates[id];
-			m_TaskStates.erase(id);
-			m_TaskProgresses.erase(id);
 			if (state->callback)
 				state->callback();
 		}
 	}
 
+	ThreadUtil::Job::Ptr ThreadUtil::Submit(std::function<void()> func, const std::vector<Job::Ptr> &dependencies, bool background)
+	{
+		// don't allow enqueueing after stopping the pool
+		if (m_Stop)
+			throw std::runtime_error("Enqueue on stopped ThreadPool");
+
+		auto job = std::make_shared<Job>(func, background);
+
+		for (auto &dependency : dependencies)
+		{
+			std::unique_lock<std::mutex> lock(dependency->m_Mutex);
+			if (!dependency->m_Finished)
+			{
+				job->m_Dependencies++;
+				dependency->m_Continuations.push_back(job);
+			}
+		}
+
+		// the last finished dependency schedules it.
+		if (--job->m_Dependencies == 0)
+			Schedule(job);
+
+		return job;
+	}
+
+	void ThreadUtil::Wait(const Job::Ptr &job)
+	{
+		// a waiting worker takes background jobs too, 
+		// the job might depend on one no other thread is free to run.
+		bool background = m_Workers.empty() || GetWorkerIndex() >= 0;
+
+		while (!job->m_Finished)
+		{
+			if (!RunJob(background))
+				std::this_thread::yield();
+		}
+	}
+
+	void ThreadUtil::ParallelFor(unsigned int count, const std::function<void(unsigned int)> &func)
+	{
+		if (count == 0)
+			return;
+
+		unsigned int helperCount = std::min((unsigned int)m_Workers.size(), count - 1);
+		if (helperCount == 0)
+		{
+			for (unsigned int i = 0; i < count; i++)
+				func(i);
+			return;
+		}
+
+		class ForState
+		{
+		public:
+
+			std::function<void(unsigned int)> func;
+
+			std::atomic<unsigned int> next;
+
+			std::atomic<unsigned int> finished;
+
+			ForState(const std::function<void(unsigned int)> &func) 
+				: func(func), next(0), finished(0) {}
+		};
+
+		auto state = std::make_shared<ForState>(func);
+
+		// helpers and the calling thread grab indices until none left.
+		auto work = [state, count]
+		{
+			unsigned int index;
+			while ((index = state->next++) < count)
+			{
+				state->func(index);
+				state->finished++;
+			}
+		};
+
+		for (unsigned int i = 0; i < helperCount; i++)
+			Submit(work);
+
+		work();
+
+		// indices may still be running on other threads, help them meanwhile.
+		while (state->finished != count)
+		{
+			if (!RunJob())
+				std::this_thread::yield();
+		}
+	}
+
 	size_t ThreadUtil::GetWorkerCount()
 	{
 		return m_Workers.size();
@@ -138,4 +260,121 @@ namespace fury
 	{
 		return std::this_thread::get_id() == m_MainThreadId;
 	}
+
+	int ThreadUtil::GetWorkerIndex() const
+	{
+		if (!m_Ready)
+			return -1;
+
+		auto id = std::this_thread::get_id();
+		for (unsigned int i = 0; i < m_WorkerIds.size(); i++)
+		{
+			if (m_WorkerIds[i] == id)
+				return i;
+		}
+		return -1;
+	}
+
+	void ThreadUtil::Schedule(const Job::Ptr &job)
+	{
+		job->m_Self = job;
+
+		// count it first, so sleeping workers won't miss it.
+		m_PendingJobs++;
+
+		int workerIndex = job->m_Background ? -1 : GetWorkerIndex();
+		if (workerIndex < 0 || !m_LocalJobs[workerIndex]->Push(job.get()))
+		{
+			std::unique_lock<std::mutex> lock(m_QueueMutex);
+			if (job->m_Background)
+				m_BackgroundJobs.push_back(job.get());
+			else
+				m_Jobs.push_back(job.get());
+		}
+
+		if (m_SleepingWorkers > 0)
+		{
+			std::unique_lock<std::mutex> lock(m_QueueMutex);
+			m_Condiction.notify_one();
+		}
+	}
+
+	ThreadUtil::Job *ThreadUtil::TakeJob(int workerIndex, bool background)
+	{
+		Job *job = nullptr;
+
+		if (workerIndex >= 0)
+			job = m_LocalJobs[workerIndex]->Pop();
+
+		if (job == nullptr)
+		{
+			std::unique_lock<std::mutex> lock(m_QueueMutex);
+			if (!m_Jobs.empty())
+			{
+				job = m_Jobs.front();
+				m_Jobs.pop_front();
+			}
+		}
+
+		if (job == nullptr)
+		{
+			unsigned int workerCount = m_LocalJobs.size();
+			unsigned int start = workerIndex >= 0 ? workerIndex + 1 : 0;
+			for (unsigned int i = 0; i < workerCount && job == nullptr; i++)
+			{
+				unsigned int victim = (start + i) % workerCount;
+				if ((int)victim != workerIndex)
+					job = m_LocalJobs[victim]->Steal();
+			}
+		}
+
+		if (job == nullptr && background)
+		{
+			std::unique_lock<std::mutex> lock(m_QueueMutex);
+			if (!m_BackgroundJobs.empty())
+			{
+				job = m_BackgroundJobs.front();
+				m_BackgroundJobs.pop_front();
+			}
+		}
+
+		if (job != nullptr)
+			m_PendingJobs--;
+
+		return job;
+	}
+
+	void ThreadUtil::Execute(Job *job)
+	{
+		auto self = std::move(job->m_Self);
+
+		if (job->m_Func)
+			job->m_Func();
+
+		// release captures as soon as possible.
+		job->m_Func = nullptr;
+
+		std::vector<Job::Ptr> continuations;
+		{
+			std::unique_lock<std::mutex> lock(job->m_Mutex);
+			job->m_Finished = true;
+			continuations.swap(job->m_Continuations);
+		}
+
+		for (auto &continuation : continuations)
+		{
+			if (--continuation->m_Dependencies == 0)
+				Schedule(continuation);
+		}
+	}
+
+	bool ThreadUtil::RunJob(bool background)
+	{
+		Job *job = TakeJob(GetWorkerIndex(), background);
+		if (job == nullptr)
+			return false;
+
+		Execute(job);
+		return true;
+	}
 }
\ No newline at end of file
@@ -3,8 +3,10 @@
 
 // Implimentation refers to: https://github.com/progschj/ThreadPool
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -13,15 +15,60 @@
 #include <unordered_map>
 
 #include "Fury/Singleton.h"
+#include "Fury/WorkStealingQueue.h"
 
 namespace fury
 {
+	// Work-stealing job system.
+	// Each worker owns a lock-free deque, jobs submitted from a worker go to it's own deque, 
+	// jobs submitted from other threads go to a shared queue, idle workers steal from others.
 	class FURY_API ThreadUtil : public Singleton<ThreadUtil, size_t>
 	{
 	public:
 
 		typedef std::shared_ptr<ThreadUtil> Ptr;
 
+		// capacity of each worker's deque, overflowed jobs go to shared queue.
+		static const unsigned int QUEUE_CAPACITY = 4096;
+
+		class Job
+		{
+			friend class ThreadUtil;
+
+		public:
+
+			typedef std::shared_ptr<Job> Ptr;
+
+		protected:
+
+			std::function<void()> m_Func;
+
+			// unfinished dependencies, +1 until submitted.
+			std::atomic<int> m_Dependencies;
+
+			std::atomic<bool> m_Finished;
+
+			// Enqueue-ed tasks, only executed by workers.
+			bool m_Background;
+
+			std::mutex m_Mutex;
+
+			std::vector<Ptr> m_Continuations;
+
+			// keeps this alive while it's in a queue.
+			Ptr m_Self;
+
+		public:
+
+			Job(std::function<void()> func, bool background)
+				: m_Func(func), m_Dependencies(1), m_Finished(false), m_Background(background) {}
+
+			bool IsFinished() const
+			{
+				return m_Finished;
+			}
+		};
+
 	protected:
 
 		class TaskState
@@ -32,8 +79,6 @@ namespace fury
 
 			int progress = 0;
 
-			bool finished = false;
-
 			std::shared_ptr<void> data;
 
 			std::function<void()> callback;
@@ -48,19 +93,38 @@ namespace fury
 
 		static size_t m_TaskKey;
 
+		// only tasks with progressChanged callback.
 		std::unordered_map<size_t, std::shared_ptr<TaskState>> m_TaskStates;
 
 		std::unordered_map<size_t, int> m_TaskProgresses;
 
-		std::queue<std::function<void()>> m_Tasks;
+		// workers push finished tasks here, Update only visits these.
+		std::vector<std::shared_ptr<TaskState>> m_FinishedTasks;
+
+		std::mutex m_TaskMutex;
 
 		std::vector<std::thread> m_Workers;
 
+		std::vector<std::thread::id> m_WorkerIds;
+
+		std::vector<std::unique_ptr<WorkStealingQueue<Job>>> m_LocalJobs;
+
+		std::deque<Job*> m_Jobs;
+
+		std::deque<Job*> m_BackgroundJobs;
+
+		// scheduled jobs not taken by any thread yet.
+		std::atomic<int> m_PendingJobs;
+
+		std::atomic<int> m_SleepingWorkers;
+
+		std::atomic<bool> m_Ready;
+
 		std::mutex m_QueueMutex;
 
 		std::condition_variable m_Condiction;
 
-		bool m_Stop;
+		std::atomic<bool> m_Stop;
 
 	public:
 
@@ -74,39 +138,89 @@ namespace fury
 		size_t Enqueue(std::function<std::shared_ptr<ReturnType>(int&)> task, std::function<void(std::shared_ptr<ReturnType>)> callback, 
 			std::function<void(int)> progressChanged = nullptr)
 		{
-			std::unique_lock<std::mutex> lock(m_QueueMutex);
-
-			// don't allow enqueueing after stopping the pool
-			if (m_Stop)
-				throw std::runtime_error("Enqueue on stopped ThreadPool");
-
-			size_t key = m_TaskKey++;
-			auto state = std::make_shared<TaskState>(key, nullptr);
+			auto state = CreateTaskState(progressChanged);
 			state->callback = [callback, state]
 			{
 				callback(std::static_pointer_cast<ReturnType>(state->data));
 			};
-			state->progressChanged = progressChanged;
 
-			m_Tasks.emplace([task, state]()
+			Submit([this, task, state]()
 			{
 				state->data = task(state->progress);
-				state->finished = true;
-			});
+				FinishTask(state);
+			}, std::vector<Job::Ptr>(), true);
 
-			m_TaskStates.emplace(key, state);
-			m_Condiction.notify_one();
-			return key;
+			return state->id;
 		}
 
+		// calls finished tasks' callbacks on main thread.
 		void Update();
 
+		// func runs after all dependencies finished.
+		Job::Ptr Submit(std::function<void()> func, const std::vector<Job::Ptr> &dependencies = std::vector<Job::Ptr>(), bool background = false);
+
+		// run other jobs until this one finishes, 
+		// background jobs too when called on a worker or there's no worker.
+		void Wait(const Job::Ptr &job);
+
+		// run one pending job on calling thread, returns false if no job was available.
+		bool RunJob(bool background = false);
+
+		// run func(0) ... func(count - 1) on workers, the calling thread helps too.
+		// returns when all of them finished, so func can safely capture locals.
+		void ParallelFor(unsigned int count, const std::function<void(unsigned int)> &func);
+
+		// reduce(... reduce(reduce(identity, map(0)), map(1)) ..., map(count - 1)), 
+		// reduce must be associative, partial results are combined in index order.
+		template<class ValueType, class MapFunc, class ReduceFunc>
+		ValueType ParallelReduce(unsigned int count, ValueType identity, MapFunc map, ReduceFunc reduce);
+
 		size_t GetWorkerCount();
 
 		void SetMainThread();
 
 		bool IsMainThread();
+
+	protected:
+
+		std::shared_ptr<TaskState> CreateTaskState(std::function<void(int)> progressChanged);
+
+		void FinishTask(const std::shared_ptr<TaskState> &state);
+
+		// -1 if calling thread is not a worker.
+		int GetWorkerIndex() const;
+
+		void Schedule(const Job::Ptr &job);
+
+		// take a job from own deque, shared queues or other workers.
+		Job *TakeJob(int workerIndex, bool background);
+
+		void Execute(Job *job);
 	};
+
+	template<class ValueType, class MapFunc, class ReduceFunc>
+	ValueType ThreadUtil::ParallelReduce(unsigned int count, ValueType identity, MapFunc map, ReduceFunc reduce)
+	{
+		// a few partitions per thread, to balance uneven work.
+		unsigned int partitionCount = std::min(count, (unsigned int)(m_Workers.size() + 1) * 4);
+		std::vector<ValueType> results(partitionCount, identity);
+
+		ParallelFor(partitionCount, [&](unsigned int index)
+		{
+			unsigned int first = (unsigned long long)count * index / partitionCount;
+			unsigned int last = (unsigned long long)count * (index + 1) / partitionCount;
+
+			ValueType result = identity;
+			for (unsigned int i = first; i < last; i++)
+				result = reduce(result, map(i));
+			results[index] = result;
+		});
+
+		ValueType result = identity;
+		for (auto &value : results)
+			result = reduce(result, value);
+		return result;
+	}
 }
 
 #endif // _FURY_THREAD_UTIL_H_
\ No newline at end of file
@@ -57,13 +57,13 @@ namespace fury
 		m_Matrix.AppendRotation(m_Rotation);
 		m_Matrix.AppendScale(m_Scale);
 
+		// applied in owner's next UpdateTransforms.
 		if (!m_Owner.expired())
 		{
 			auto node = m_Owner.lock();
 			node->SetLocalPosition(m_Position);
 			node->SetLocalRoattion(m_Rotation);
 			node->SetLocalScale(m_Scale);
-			node->Recompose(true);
 		}
 	}
 
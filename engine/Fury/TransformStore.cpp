@@ -0,0 +1,346 @@
+#include <algorithm>
+
+#include "Fury/Log.h"
+#include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
+#include "Fury/TransformStore.h"
+
+namespace fury
+{
+	const unsigned int TransformStore::GRAIN_SIZE = 512;
+
+	TransformStore::Ptr TransformStore::Create()
+	{
+		return std::make_shared<TransformStore>();
+	}
+
+	TransformStore::TransformStore() : m_Attached(false)
+	{
+
+	}
+
+	TransformStore::~TransformStore()
+	{
+		Invalidate();
+	}
+
+	void TransformStore::Attach(const std::shared_ptr<SceneNode> &root)
+	{
+		Detach();
+
+		if (root == nullptr || root->m_TransformStore != nullptr)
+		{
+			FURYE << "Root is null or already attached to a TransformStore!";
+			return;
+		}
+
+		m_Root = root;
+
+		// breadth first, so nodes are sorted by depth.
+		m_Nodes.push_back(root.get());
+		m_Parents.push_back(-1);
+
+		unsigned int levelStart = 0;
+		while (levelStart < m_Nodes.size())
+		{
+			unsigned int levelEnd = m_Nodes.size();
+			m_LevelOffsets.push_back(levelStart);
+
+			for (unsigned int i = levelStart; i < levelEnd; i++)
+			{
+				for (auto &child : m_Nodes[i]->m_Childs)
+				{
+					m_Nodes.push_back(child.get());
+					m_Parents.push_back(i);
+				}
+			}
+
+			levelStart = levelEnd;
+		}
+		m_LevelOffsets.push_back(m_Nodes.size());
+
+		unsigned int size = m_Nodes.size();
+		m_Dirty.resize(size);
+		m_Changed.resize(size);
+		m_LocalPositions.resize(size);
+		m_LocalRotations.resize(size);
+		m_LocalScales.resize(size);
+		m_LocalMatrices.resize(size);
+		m_WorldPositions.resize(size);
+		m_WorldRotations.resize(size);
+		m_WorldScales.resize(size);
+		m_WorldMatrices.resize(size);
+
+		for (unsigned int i = 0; i < size; i++)
+		{
+			SceneNode *node = m_Nodes[i];
+			m_Dirty[i] = node->m_TransformDirty ? 1 : 0;
+			m_Changed[i] = 0;
+			m_LocalPositions[i] = node->m_LocalPosition;
+			m_LocalRotations[i] = node->m_LocalRotation;
+			m_LocalScales[i] = node->m_LocalScale;
+			m_LocalMatrices[i] = node->m_LocalMatrix;
+			m_WorldPositions[i] = node->m_WorldPosition;
+			m_WorldRotations[i] = node->m_WorldRotation;
+			m_WorldScales[i] = node->m_WorldScale;
+			m_WorldMatrices[i] = node->m_WorldMatrix;
+
+			node->m_TransformStore = this;
+			node->m_TransformIndex = i;
+			node->m_TransformDirty = false;
+			node->m_ChildTransformDirty = false;
+		}
+
+		m_Attached = true;
+
+		// pending changes are kept, ancestors have to lead to them.
+		for (unsigned int i = 0; i < size; i++)
+		{
+			if (m_Dirty[i])
+				MarkDirty(i);
+		}
+	}
+
+	void TransformStore::Detach()
+	{
+		Invalidate();
+		m_Root.reset();
+	}
+
+	void TransformStore::Invalidate()
+	{
+		if (!m_Attached)
+			return;
+
+		m_Attached = false;
+
+		unsigned int size = m_Nodes.size();
+		for (unsigned int i = 0; i < size; i++)
+		{
+			SceneNode *node = m_Nodes[i];
+			node->m_TransformStore = nullptr;
+			node->m_LocalPosition = m_LocalPositions[i];
+			node->m_LocalRotation = m_LocalRotations[i];
+			node->m_LocalScale = m_LocalScales[i];
+			node->m_LocalMatrix = m_LocalMatrices[i];
+			node->m_WorldPosition = m_WorldPositions[i];
+			node->m_WorldRotation = m_WorldRotations[i];
+			node->m_WorldScale = m_WorldScales[i];
+			node->m_WorldMatrix = m_WorldMatrices[i];
+		}
+
+		// parent links are still valid here, so dirty flags can be propagated.
+		for (unsigned int i = 0; i < size; i++)
+		{
+			if (m_Dirty[i])
+				m_Nodes[i]->MarkTransformDirty();
+		}
+
+		m_Nodes.clear();
+		m_Parents.clear();
+		m_LevelOffsets.clear();
+		m_Dirty.clear();
+		m_Changed.clear();
+		m_LocalPositions.clear();
+		m_LocalRotations.clear();
+		m_LocalScales.clear();
+		m_LocalMatrices.clear();
+		m_WorldPositions.clear();
+		m_WorldRotations.clear();
+		m_WorldScales.clear();
+		m_WorldMatrices.clear();
+	}
+
+	void TransformStore::Update(bool parallel)
+	{
+		if (!m_Attached)
+		{
+			auto root = m_Root.lock();
+			if (root == nullptr)
+				return;
+
+			Attach(root);
+			if (!m_Attached)
+				return;
+		}
+
+		// root's parent is not in this store.
+		Matrix4 rootParentMatrix;
+		bool hasRootParent = false;
+		if (auto parent = m_Nodes[0]->GetParent())
+		{
+			rootParentMatrix = parent->GetWorldMatrix();
+			hasRootParent = true;
+		}
+
+		const Matrix4 *rootParentPtr = hasRootParent ? &rootParentMatrix : nullptr;
+		unsigned int size = m_Nodes.size();
+		unsigned int workerCount = parallel ? ThreadUtil::Instance()->GetWorkerCount() : 0;
+
+		// nodes of one level only read their parent's level, so each level can be split.
+		unsigned int levelCount = GetLevelCount();
+		for (unsigned int i = 0; i < levelCount; i++)
+		{
+			unsigned int first = m_LevelOffsets[i], last = m_LevelOffsets[i + 1];
+			if (workerCount == 0 || last - first < GRAIN_SIZE * 2)
+			{
+				UpdateRange(first, last, rootParentPtr);
+			}
+			else
+			{
+				ThreadUtil::Instance()->ParallelFor((last - first + GRAIN_SIZE - 1) / GRAIN_SIZE, [&](unsigned int index)
+				{
+					unsigned int rangeFirst = first + index * GRAIN_SIZE;
+					UpdateRange(rangeFirst, std::min(rangeFirst + GRAIN_SIZE, last), rootParentPtr);
+				});
+			}
+		}
+
+		// world aabbs and inverses only touch their own node.
+		auto updateNodes = [this](unsigned int first, unsigned int last)
+		{
+			for (unsigned int i = first; i < last; i++)
+			{
+				if (m_Changed[i])
+				{
+					SceneNode *node = m_Nodes[i];
+					node->m_InvertWorldMatrix = m_WorldMatrices[i].Inverse();
+					node->UpdateAABB();
+				}
+			}
+		};
+
+		if (workerCount == 0 || size < GRAIN_SIZE * 2)
+		{
+			updateNodes(0, size);
+		}
+		else
+		{
+			ThreadUtil::Instance()->ParallelFor((size + GRAIN_SIZE - 1) / GRAIN_SIZE, [&](unsigned int index)
+			{
+				unsigned int first = index * GRAIN_SIZE;
+				updateNodes(first, std::min(first + GRAIN_SIZE, size));
+			});
+		}
+
+		std::vector<SceneNode*> changedNodes;
+		for (unsigned int i = 0; i < size; i++)
+		{
+			if (m_Changed[i])
+				changedNodes.push_back(m_Nodes[i]);
+		}
+
+		// ancestors found this store through it.
+		m_Nodes[0]->m_ChildTransformDirty = false;
+
+		SceneNode::ApplyTransformChanges(changedNodes);
+	}
+
+	void TransformStore::MarkDirty(unsigned int index)
+	{
+		m_Dirty[index] = 1;
+
+		// root's own dirty flags are unused while attached, so this one only guides ancestors.
+		SceneNode *node = m_Nodes[0];
+		if (node->m_ChildTransformDirty)
+			return;
+
+		node->m_ChildTransformDirty = true;
+
+		auto parent = node->m_Parent.lock();
+		while (parent != nullptr && !parent->m_ChildTransformDirty)
+		{
+			parent->m_ChildTransformDirty = true;
+			parent = parent->m_Parent.lock();
+		}
+	}
+
+	void TransformStore::UpdateRange(unsigned int first, unsigned int last, const Matrix4 *rootParentMatrix)
+	{
+		for (unsigned int i = first; i < last; i++)
+		{
+			int parent = m_Parents[i];
+			bool changed = m_Dirty[i] || (parent >= 0 && m_Changed[parent]);
+			m_Changed[i] = changed ? 1 : 0;
+
+			if (!changed)
+				continue;
+
+			// update local matrix
+			if (m_Dirty[i])
+			{
+				Matrix4 &localMatrix = m_LocalMatrices[i];
+				localMatrix.Identity();
+				localMatrix.AppendTranslation(m_LocalPositions[i]);
+				localMatrix.AppendRotation(m_LocalRotations[i]);
+				localMatrix.AppendScale(m_LocalScales[i]);
+				m_Nodes[i]->m_InvertLocalMatrix = localMatrix.Inverse();
+				m_Dirty[i] = 0;
+			}
+
+			// update world matrix
+			const Matrix4 *parentMatrix = parent >= 0 ? &m_WorldMatrices[parent] : rootParentMatrix;
+			if (parentMatrix == nullptr)
+			{
+				m_WorldMatrices[i] = m_LocalMatrices[i];
+				m_WorldPositions[i] = m_LocalPositions[i];
+				m_WorldRotations[i] = m_LocalRotations[i];
+				m_WorldScales[i] = m_LocalScales[i];
+			}
+			else
+			{
+				m_WorldMatrices[i] = *parentMatrix * m_LocalMatrices[i];
+				m_WorldPositions[i] = parentMatrix->Multiply(m_LocalPositions[i]);
+				m_WorldRotations[i] = parentMatrix->Multiply(m_LocalRotations[i]);
+				m_WorldScales[i] = parentMatrix->Multiply(m_LocalScales[i]);
+			}
+		}
+	}
+
+	std::shared_ptr<SceneNode> TransformStore::GetRoot() const
+	{
+		return m_Root.lock();
+	}
+
+	bool TransformStore::GetAttached() const
+	{
+		return m_Attached;
+	}
+
+	unsigned int TransformStore::GetSize() const
+	{
+		return m_Nodes.size();
+	}
+
+	unsigned int TransformStore::GetLevelCount() const
+	{
+		return m_LevelOffsets.empty() ? 0 : m_LevelOffsets.size() - 1;
+	}
+
+	void TransformStore::SetLocalPosition(unsigned int index, Vector4 position)
+	{
+		if (m_Dirty[index] || m_LocalPositions[index] != position)
+		{
+			m_LocalPositions[index] = position;
+			MarkDirty(index);
+		}
+	}
+
+	void TransformStore::SetLocalRoattion(unsigned int index, Quaternion rotation)
+	{
+		if (m_Dirty[index] || m_LocalRotations[index] != rotation)
+		{
+			m_LocalRotations[index] = rotation;
+			MarkDirty(index);
+		}
+	}
+
+	void TransformStore::SetLocalScale(unsigned int index, Vector4 scale)
+	{
+		if (m_Dirty[index] || m_LocalScales[index] != scale)
+		{
+			m_LocalScales[index] = scale;
+			MarkDirty(index);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef _FURY_TRANSFORMSTORE_H_
+#define _FURY_TRANSFORMSTORE_H_
+
+#include <memory>
+#include <vector>
+
+#include "Fury/Matrix4.h"
+#include "Fury/Quaternion.h"
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	class SceneNode;
+
+	// Flattened transform storage for a scenenode hierarchy.
+	// Attach copies transforms of a subtree into contiguous arrays, ordered level by level, 
+	// so parents always come before childs, and parents are referenced by index.
+	// Attached scenenodes read and write their transforms from/to the store, 
+	// and UpdateTransforms on any of them becomes a linear sweep of the arrays.
+	// Dirty slots mark the root's ancestors, so UpdateTransforms on any of them reaches the store.
+	// Hierarchy changes detach the store, call Update or Attach to flatten the root again.
+	class FURY_API TransformStore
+	{
+		friend class SceneNode;
+
+	public:
+
+		typedef std::shared_ptr<TransformStore> Ptr;
+
+		static Ptr Create();
+
+		// nodes per job when updating in parallel.
+		static const unsigned int GRAIN_SIZE;
+
+	protected:
+
+		std::weak_ptr<SceneNode> m_Root;
+
+		bool m_Attached;
+
+		std::vector<SceneNode*> m_Nodes;
+
+		// -1 for root.
+		std::vector<int> m_Parents;
+
+		// [m_LevelOffsets[i], m_LevelOffsets[i + 1]) are nodes of depth i.
+		std::vector<unsigned int> m_LevelOffsets;
+
+		// local transform changed.
+		std::vector<unsigned char> m_Dirty;
+
+		// world transform changed in this update.
+		std::vector<unsigned char> m_Changed;
+
+		std::vector<Vector4> m_LocalPositions;
+
+		std::vector<Quaternion> m_LocalRotations;
+
+		std::vector<Vector4> m_LocalScales;
+
+		std::vector<Matrix4> m_LocalMatrices;
+
+		std::vector<Vector4> m_WorldPositions;
+
+		std::vector<Quaternion> m_WorldRotations;
+
+		std::vector<Vector4> m_WorldScales;
+
+		std::vector<Matrix4> m_WorldMatrices;
+
+	public:
+
+		TransformStore();
+
+		virtual ~TransformStore();
+
+		// flatten root's subtree into this store.
+		void Attach(const std::shared_ptr<SceneNode> &root);
+
+		// copy transforms back to scenenodes and forget the root.
+		void Detach();
+
+		// copy transforms back to scenenodes, they update on their own afterwards.
+		// root stays known, Update attaches it again.
+		void Invalidate();
+
+		// update world transforms of dirty nodes and their childs, 
+		// then apply changes to scenenodes. (aabb, octree, OnTransformChange)
+		// parallel splits large levels across ThreadUtil workers.
+		void Update(bool parallel = false);
+
+		std::shared_ptr<SceneNode> GetRoot() const;
+
+		bool GetAttached() const;
+
+		unsigned int GetSize() const;
+
+		unsigned int GetLevelCount() const;
+
+		void SetLocalPosition(unsigned int index, Vector4 position);
+
+		void SetLocalRoattion(unsigned int index, Quaternion rotation);
+
+		void SetLocalScale(unsigned int index, Vector4 scale);
+
+	protected:
+
+		// marks the slot dirty, and the path from root's parent up to scene root, 
+		// like SceneNode::MarkTransformDirty does.
+		void MarkDirty(unsigned int index);
+
+		// update world transforms of nodes in [first, last), their parents must be up to date.
+		void UpdateRange(unsigned int first, unsigned int last, const Matrix4 *rootParentMatrix);
+	};
+}
+
+#endif // _FURY_TRANSFORMSTORE_H_
\ No newline at end of file
@@ -25,7 +25,7 @@ namespace fury
 	};
 
 	UniformBase::UniformBase()
-		: m_TypeIndex(typeid(UniformBase)), m_Size(0)
+		: m_TypeIndex(typeid(UniformBase)), m_Size(0), m_Version(0)
 	{
 
 	}
@@ -40,6 +40,11 @@ namespace fury
 		return m_Size;
 	}
 
+	unsigned int UniformBase::GetVersion() const
+	{
+		return m_Version;
+	}
+
 	template<typename Datatype, unsigned int Size>
 	typename Uniform<Datatype, Size>::Ptr Uniform<Datatype, Size>::Create(std::initializer_list<Datatype> data)
 	{
@@ -56,13 +61,13 @@ namespace fury
 	}
 
 	template<typename Datatype, unsigned int Size>
-	void Uniform<Datatype, Size>::Bind(unsigned int program, const std::string &name)
+	void Uniform<Datatype, Size>::Bind(int location)
 	{
-		unsigned int id = glGetUniformLocation(program, name.c_str());
-
-		if (id == -1)
+		if (location == -1)
 			return;
 
+		int id = location;
+
 		if (std::is_floating_point<Datatype>::value)
 		{
 			switch (Size)
@@ -151,6 +156,7 @@ namespace fury
 		for (unsigned int i = 0; i < Size; i++)
 			m_Data[i] = raw[i];
 
+		m_Version++;
 		return true;
 	}
 
@@ -190,6 +196,8 @@ namespace fury
 		{
 			m_Data[it - data.begin()] = *it;
 		}
+
+		m_Version++;
 	}
 
 	template<typename Datatype, unsigned int Size>
@@ -201,6 +209,15 @@ namespace fury
 		return m_Data[index];
 	}
 
+	template<typename Datatype, unsigned int Size>
+	float Uniform<Datatype, Size>::GetFloatAt(unsigned int index) const
+	{
+		if (index >= Size)
+			return 0;
+
+		return (float)m_Data[index];
+	}
+
 	template class Uniform < float, 1 > ;
 
 	template class Uniform < float, 2 > ;
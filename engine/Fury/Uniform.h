@@ -19,7 +19,8 @@ namespace fury
 
 		UniformBase();
 
-		virtual void Bind(unsigned int program, const std::string &name) = 0;
+		// location comes from the bound shader.
+		virtual void Bind(int location) = 0;
 
 		virtual bool Load(const void* wrapper, bool object = true) override = 0;
 
@@ -27,14 +28,22 @@ namespace fury
 
 		virtual std::type_index GetTypeIndex() const override;
 
+		// 0 if index is out of range.
+		virtual float GetFloatAt(unsigned int index) const = 0;
+
 		unsigned int GetSize() const;
 
+		// increased whenever the data changes, so cached copies can tell they're stale.
+		unsigned int GetVersion() const;
+
 	protected:
 
 		std::type_index m_TypeIndex;
 
 		unsigned int m_Size;
 
+		unsigned int m_Version;
+
 		static const std::unordered_map<std::type_index, std::string> m_UniformTypeMap;
 	};
 
@@ -53,7 +62,7 @@ namespace fury
 
 		Uniform();
 
-		virtual void Bind(unsigned int program, const std::string &name) override;
+		virtual void Bind(int location) override;
 
 		virtual bool Load(const void* wrapper, bool object = true) override;
 
@@ -62,6 +71,8 @@ namespace fury
 		void SetData(std::initializer_list<Datatype> data);
 
 		Datatype GetDataAt(unsigned int index);
+
+		virtual float GetFloatAt(unsigned int index) const override;
 	};
 
 	typedef Uniform<float, 1> Uniform1f;
@@ -0,0 +1,269 @@
+#include <cstring>
+
+#include "Fury/Camera.h"
+#include "Fury/GLLoader.h"
+#include "Fury/Light.h"
+#include "Fury/Log.h"
+#include "Fury/Matrix4.h"
+#include "Fury/SceneNode.h"
+#include "Fury/UniformBuffer.h"
+
+namespace fury
+{
+	unsigned int Std140Block::AddFloat(float v0)
+	{
+		unsigned int offset = Allocate(4, 4);
+		std::memcpy(&m_Data[offset], &v0, 4);
+		return offset;
+	}
+
+	unsigned int Std140Block::AddInt(int v0)
+	{
+		unsigned int offset = Allocate(4, 4);
+		std::memcpy(&m_Data[offset], &v0, 4);
+		return offset;
+	}
+
+	unsigned int Std140Block::AddUInt(unsigned int v0)
+	{
+		unsigned int offset = Allocate(4, 4);
+		std::memcpy(&m_Data[offset], &v0, 4);
+		return offset;
+	}
+
+	unsigned int Std140Block::AddVec2(float v0, float v1)
+	{
+		float value[] = { v0, v1 };
+		unsigned int offset = Allocate(8, 8);
+		std::memcpy(&m_Data[offset], value, 8);
+		return offset;
+	}
+
+	unsigned int Std140Block::AddVec3(float v0, float v1, float v2)
+	{
+		// aligned like vec4, but the next scalar can use the last 4 bytes.
+		float value[] = { v0, v1, v2 };
+		unsigned int offset = Allocate(16, 12);
+		std::memcpy(&m_Data[offset], value, 12);
+		return offset;
+	}
+
+	unsigned int Std140Block::AddVec4(float v0, float v1, float v2, float v3)
+	{
+		float value[] = { v0, v1, v2, v3 };
+		unsigned int offset = Allocate(16, 16);
+		std::memcpy(&m_Data[offset], value, 16);
+		return offset;
+	}
+
+	unsigned int Std140Block::AddMatrix(const Matrix4 &matrix)
+	{
+		// 4 vec4 columns.
+		unsigned int offset = Allocate(16, 64);
+		std::memcpy(&m_Data[offset], matrix.Raw, 64);
+		return offset;
+	}
+
+	unsigned int Std140Block::AddFloatArray(const float *value, unsigned int count)
+	{
+		unsigned int offset = Allocate(16, count * 16);
+		for (unsigned int i = 0; i < count; i++)
+			std::memcpy(&m_Data[offset + i * 16], &value[i], 4);
+		return offset;
+	}
+
+	void Std140Block::Clear()
+	{
+		m_Data.clear();
+		m_Size = 0;
+	}
+
+	unsigned int Std140Block::GetSize() const
+	{
+		return m_Data.size();
+	}
+
+	const unsigned char *Std140Block::GetData() const
+	{
+		return m_Data.data();
+	}
+
+	bool Std140Block::operator == (const Std140Block &other) const
+	{
+		return m_Data == other.m_Data;
+	}
+
+	bool Std140Block::operator != (const Std140Block &other) const
+	{
+		return m_Data != other.m_Data;
+	}
+
+	unsigned int Std140Block::Allocate(unsigned int alignment, unsigned int size)
+	{
+		unsigned int offset = (m_Size + alignment - 1) / alignment * alignment;
+		m_Size = offset + size;
+
+		// padding is zeroed so equal blocks compare equal.
+		m_Data.resize((m_Size + 15) / 16 * 16, 0);
+		return offset;
+	}
+
+	const unsigned int UniformBuffer::DEFAULT_SIZE = 256 * 1024;
+
+	const std::string &UniformBuffer::GetBlockName(UniformBlock block)
+	{
+		static const std::string names[] = { "CameraBlock", "LightBlock", "MaterialBlock" };
+		return names[(unsigned int)block];
+	}
+
+	bool UniformBuffer::PackCamera(const std::shared_ptr<SceneNode> &camNode, Std140Block &block)
+	{
+		auto camera = camNode->GetComponent<Camera>();
+		if (camera == nullptr)
+			return false;
+
+		Vector4 camPos = camNode->GetWorldPosition();
+
+		block.Clear();
+		block.AddMatrix(camera->GetProjectionMatrix());
+		block.AddMatrix(camNode->GetInvertWorldMatrix());
+		block.AddVec3(camPos.x, camPos.y, camPos.z);
+		block.AddFloat(camera->GetFar());
+		block.AddFloat(camera->GetNear());
+		return true;
+	}
+
+	bool UniformBuffer::PackLight(const std::shared_ptr<SceneNode> &lightNode, Std140Block &block)
+	{
+		static float pi = 3.141592653f;
+
+		auto light = lightNode->GetComponent<Light>();
+		if (light == nullptr)
+			return false;
+
+		Vector4 lightPos = lightNode->GetWorldPosition();
+		Vector4 lightDir = lightNode->GetWorldMatrix().Multiply(Vector4(0, -1, 0, 0));
+		lightDir.Normalize();
+		Color color = light->GetColor();
+
+		block.Clear();
+		block.AddVec3(lightPos.x, lightPos.y, lightPos.z);
+		block.AddFloat(light->GetIntensity());
+		block.AddVec3(lightDir.x, lightDir.y, lightDir.z);
+		block.AddFloat(light->GetInnerAngle());
+		block.AddVec3(color.r / pi, color.g / pi, color.b / pi);
+		block.AddFloat(light->GetOutterAngle());
+		block.AddFloat(light->GetFalloff());
+		block.AddFloat(light->GetRadius());
+		return true;
+	}
+
+	UniformBuffer::UniformBuffer(unsigned int size) : m_Size(size)
+	{
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		if (alignment > 0)
+			m_Alignment = alignment;
+
+		// allocated once, wrapping around only orphans the storage.
+		glGenBuffers(1, &m_ID);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_ID);
+		glBufferData(GL_UNIFORM_BUFFER, m_Size, nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		if (m_ID != 0)
+			glDeleteBuffers(1, &m_ID);
+	}
+
+	void UniformBuffer::Bind(UniformBlock block, const Std140Block &data)
+	{
+		if (m_Bound[(unsigned int)block] == data)
+		{
+			m_ReuseCount++;
+			return;
+		}
+
+		unsigned int size = (data.GetSize() + m_Alignment - 1) / m_Alignment * m_Alignment;
+		if (size > m_Size)
+		{
+			FURYE << GetBlockName(block) << " is larger than the uniform buffer!";
+			return;
+		}
+
+		glBindBuffer(GL_UNIFORM_BUFFER, m_ID);
+
+		if (m_Offset + size > m_Size)
+		{
+			// orphan the storage, frames in flight keep the old one.
+			glBufferData(GL_UNIFORM_BUFFER, m_Size, nullptr, GL_STREAM_DRAW);
+			m_Offset = 0;
+
+			// ranges bound before now point into the new storage, upload them again.
+			for (unsigned int i = 0; i < m_Bound.size(); i++)
+			{
+				if (i != (unsigned int)block && m_Bound[i].GetSize() > 0)
+					Upload((UniformBlock)i, m_Bound[i]);
+			}
+		}
+
+		Upload(block, data);
+		m_Bound[(unsigned int)block] = data;
+
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	void UniformBuffer::BindCamera(const std::shared_ptr<SceneNode> &camNode)
+	{
+		auto &block = m_Staging[(unsigned int)UniformBlock::CAMERA];
+		if (PackCamera(camNode, block))
+			Bind(UniformBlock::CAMERA, block);
+	}
+
+	void UniformBuffer::BindLight(const std::shared_ptr<SceneNode> &lightNode)
+	{
+		auto &block = m_Staging[(unsigned int)UniformBlock::LIGHT];
+		if (PackLight(lightNode, block))
+			Bind(UniformBlock::LIGHT, block);
+	}
+
+	unsigned int UniformBuffer::GetUploadCount() const
+	{
+		return m_UploadCount;
+	}
+
+	unsigned int UniformBuffer::GetReuseCount() const
+	{
+		return m_ReuseCount;
+	}
+
+	void UniformBuffer::ResetCounters()
+	{
+		m_UploadCount = 0;
+		m_ReuseCount = 0;
+	}
+
+	void UniformBuffer::Upload(UniformBlock block, const Std140Block &data)
+	{
+		unsigned int size = data.GetSize();
+
+		// ranges are never rewritten before the storage is orphaned, so no need to sync.
+		void *ptr = glMapBufferRange(GL_UNIFORM_BUFFER, m_Offset, size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (ptr == nullptr)
+		{
+			FURYE << "Failed to map uniform buffer!";
+			return;
+		}
+
+		std::memcpy(ptr, data.GetData(), size);
+		glUnmapBuffer(GL_UNIFORM_BUFFER);
+
+		glBindBufferRange(GL_UNIFORM_BUFFER, (unsigned int)block, m_ID, m_Offset, size);
+
+		m_Offset += (size + m_Alignment - 1) / m_Alignment * m_Alignment;
+		m_UploadCount++;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#ifndef _FURY_UNIFORMBUFFER_H_
+#define _FURY_UNIFORMBUFFER_H_
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Fury/Singleton.h"
+
+namespace fury
+{
+	class Matrix4;
+
+	class SceneNode;
+
+	// binding points of the shared uniform blocks.
+	// shaders opt in by declaring a std140 block with the matching name,
+	// see the Lambert shaders for the member layouts.
+	enum class UniformBlock : unsigned int
+	{
+		CAMERA = 0,
+		LIGHT,
+		MATERIAL,
+		LENGTH
+	};
+
+	// packs values into a byte block with std140 layout rules.
+	// members must be added in the same order as declared in glsl.
+	class FURY_API Std140Block
+	{
+	protected:
+
+		// zero padded to 16 bytes.
+		std::vector<unsigned char> m_Data;
+
+		unsigned int m_Size = 0;
+
+	public:
+
+		// these return the member's byte offset.
+
+		unsigned int AddFloat(float v0);
+
+		unsigned int AddInt(int v0);
+
+		unsigned int AddUInt(unsigned int v0);
+
+		unsigned int AddVec2(float v0, float v1);
+
+		unsigned int AddVec3(float v0, float v1, float v2);
+
+		unsigned int AddVec4(float v0, float v1, float v2, float v3);
+
+		unsigned int AddMatrix(const Matrix4 &matrix);
+
+		// float array, every element takes 16 bytes.
+		unsigned int AddFloatArray(const float *value, unsigned int count);
+
+		// keeps the capacity.
+		void Clear();
+
+		// size rounded up to 16 bytes, same as gl reports for the block.
+		unsigned int GetSize() const;
+
+		const unsigned char *GetData() const;
+
+		bool operator == (const Std140Block &other) const;
+
+		bool operator != (const Std140Block &other) const;
+
+	protected:
+
+		unsigned int Allocate(unsigned int alignment, unsigned int size);
+	};
+
+	// one gl uniform buffer used as a ring, every changed block gets a new aligned range
+	// that is bound to the block's binding point. Blocks equal to what's already bound are skipped,
+	// so rebinding shaders doesn't upload the same camera again.
+	class FURY_API UniformBuffer final : public Singleton<UniformBuffer>
+	{
+	public:
+
+		typedef std::shared_ptr<UniformBuffer> Ptr;
+
+		static const unsigned int DEFAULT_SIZE;
+
+		static const std::string &GetBlockName(UniformBlock block);
+
+		// these pack a node's block without binding it, false if the node lacks the component.
+
+		static bool PackCamera(const std::shared_ptr<SceneNode> &camNode, Std140Block &block);
+
+		static bool PackLight(const std::shared_ptr<SceneNode> &lightNode, Std140Block &block);
+
+	private:
+
+		unsigned int m_ID = 0;
+
+		unsigned int m_Size = 0;
+
+		unsigned int m_Offset = 0;
+
+		unsigned int m_Alignment = 256;
+
+		unsigned int m_UploadCount = 0;
+
+		unsigned int m_ReuseCount = 0;
+
+		// what each binding point currently holds.
+		std::array<Std140Block, (unsigned int)UniformBlock::LENGTH> m_Bound;
+
+		std::array<Std140Block, (unsigned int)UniformBlock::LENGTH> m_Staging;
+
+	public:
+
+		UniformBuffer(unsigned int size = DEFAULT_SIZE);
+
+		~UniformBuffer();
+
+		void Bind(UniformBlock block, const Std140Block &data);
+
+		void BindCamera(const std::shared_ptr<SceneNode> &camNode);
+
+		void BindLight(const std::shared_ptr<SceneNode> &lightNode);
+
+		unsigned int GetUploadCount() const;
+
+		// binds skipped because the binding point already held the same data.
+		unsigned int GetReuseCount() const;
+
+		void ResetCounters();
+
+	private:
+
+		void Upload(UniformBlock block, const Std140Block &data);
+	};
+}
+
+#endif // _FURY_UNIFORMBUFFER_H_
\ No newline at end of file
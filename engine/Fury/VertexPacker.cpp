@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Fury/Mesh.h"
+#include "Fury/VertexPacker.h"
+
+namespace fury
+{
+	namespace
+	{
+		float SignNotZero(float value)
+		{
+			return value >= 0.0f ? 1.0f : -1.0f;
+		}
+
+		short ToSNorm16(float value)
+		{
+			value = std::min(std::max(value, -1.0f), 1.0f);
+			return (short)std::floor(value * 32767.0f + 0.5f);
+		}
+
+		float FromSNorm16(short value)
+		{
+			return std::max(value / 32767.0f, -1.0f);
+		}
+
+		template<class Type>
+		void Write(std::vector<unsigned char> &output, unsigned int offset, const Type *value, unsigned int count)
+		{
+			std::memcpy(&output[offset], value, sizeof(Type) * count);
+		}
+	}
+
+	void VertexPacker::EncodeOctahedral(float x, float y, float z, short &u, short &v)
+	{
+		float length = std::abs(x) + std::abs(y) + std::abs(z);
+		if (length == 0.0f)
+		{
+			u = v = 0;
+			return;
+		}
+
+		float ou = x / length;
+		float ov = y / length;
+
+		// fold the lower hemisphere over the diagonals.
+		if (z < 0.0f)
+		{
+			float fu = (1.0f - std::abs(ov)) * SignNotZero(ou);
+			float fv = (1.0f - std::abs(ou)) * SignNotZero(ov);
+			ou = fu;
+			ov = fv;
+		}
+
+		u = ToSNorm16(ou);
+		v = ToSNorm16(ov);
+	}
+
+	void VertexPacker::DecodeOctahedral(short u, short v, float &x, float &y, float &z)
+	{
+		x = FromSNorm16(u);
+		y = FromSNorm16(v);
+		z = 1.0f - std::abs(x) - std::abs(y);
+
+		if (z < 0.0f)
+		{
+			float fx = (1.0f - std::abs(y)) * SignNotZero(x);
+			float fy = (1.0f - std::abs(x)) * SignNotZero(y);
+			x = fx;
+			y = fy;
+		}
+
+		float length = std::sqrt(x * x + y * y + z * z);
+		x /= length;
+		y /= length;
+		z /= length;
+	}
+
+	unsigned short VertexPacker::FloatToHalf(float value)
+	{
+		unsigned int bits;
+		std::memcpy(&bits, &value, 4);
+
+		unsigned int sign = (bits >> 16) & 0x8000;
+		unsigned int exponent = (bits >> 23) & 0xff;
+		unsigned int mantissa = bits & 0x7fffff;
+
+		// inf and nan
+		if (exponent == 0xff)
+			return (unsigned short)(sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0));
+
+		int halfExponent = (int)exponent - 127 + 15;
+
+		// overflow to inf
+		if (halfExponent >= 31)
+			return (unsigned short)(sign | 0x7c00);
+
+		// denormal or zero
+		if (halfExponent <= 0)
+		{
+			if (halfExponent < -10)
+				return (unsigned short)sign;
+
+			mantissa |= 0x800000;
+			unsigned int shift = 14 - halfExponent;
+			unsigned int half = mantissa >> shift;
+			if ((mantissa >> (shift - 1)) & 1)
+				half++;
+			return (unsigned short)(sign | half);
+		}
+
+		// round to nearest, a carry moves into the exponent correctly.
+		unsigned int half = sign | (halfExponent << 10) | (mantissa >> 13);
+		if (mantissa & 0x1000)
+			half++;
+		return (unsigned short)half;
+	}
+
+	float VertexPacker::HalfToFloat(unsigned short value)
+	{
+		unsigned int sign = (value & 0x8000) << 16;
+		unsigned int exponent = (value >> 10) & 0x1f;
+		unsigned int mantissa = value & 0x3ff;
+
+		if (exponent == 0)
+		{
+			float result = mantissa / 16777216.0f;
+			return sign != 0 ? -result : result;
+		}
+
+		unsigned int bits;
+		if (exponent == 31)
+			bits = sign | 0x7f800000 | (mantissa << 13);
+		else
+			bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+
+		float result;
+		std::memcpy(&result, &bits, 4);
+		return result;
+	}
+
+	unsigned short VertexPacker::QuantizeUNorm16(float value, float min, float max)
+	{
+		float range = max - min;
+		if (range <= 0.0f)
+			return 0;
+
+		float t = std::min(std::max((value - min) / range, 0.0f), 1.0f);
+		return (unsigned short)std::floor(t * 65535.0f + 0.5f);
+	}
+
+	float VertexPacker::DequantizeUNorm16(unsigned short value, float min, float max)
+	{
+		return min + value / 65535.0f * (max - min);
+	}
+
+	unsigned char VertexPacker::QuantizeUNorm8(float value)
+	{
+		float t = std::min(std::max(value, 0.0f), 1.0f);
+		return (unsigned char)std::floor(t * 255.0f + 0.5f);
+	}
+
+	VertexLayout VertexPacker::Pack(const Mesh &mesh, VertexFormat format, std::vector<unsigned char> &output)
+	{
+		VertexLayout layout;
+
+		unsigned int count = mesh.Positions.Data.size() / 3;
+		bool hasNormals = mesh.Normals.Data.size() == count * 3;
+		bool hasTangents = mesh.Tangents.Data.size() == count * 3;
+		bool hasUVs = mesh.UVs.Data.size() == count * 2;
+		bool hasJoints = mesh.IsSkinnedMesh() && mesh.IDs.Data.size() == count * 4 && mesh.Weights.Data.size() == count * 3;
+
+		layout.quantized = format == VertexFormat::QUANTIZED;
+
+		// every attribute is 4 byte aligned.
+		layout.position = 0;
+		layout.stride = layout.quantized ? 8 : 12;
+
+		if (hasNormals)
+		{
+			layout.normal = layout.stride;
+			layout.stride += 4;
+		}
+		if (hasTangents)
+		{
+			layout.tangent = layout.stride;
+			layout.stride += 4;
+		}
+		if (hasUVs)
+		{
+			layout.uv = layout.stride;
+			layout.stride += 4;
+		}
+		if (hasJoints)
+		{
+			layout.ids = layout.stride;
+			layout.weights = layout.stride + 4;
+			layout.stride += 8;
+		}
+
+		Vector4 min, max;
+		if (layout.quantized && count > 0)
+		{
+			// mesh's aabb follows the animated pose, so bound the raw positions instead.
+			min = max = Vector4(mesh.Positions.Data[0], mesh.Positions.Data[1], mesh.Positions.Data[2]);
+			for (unsigned int i = 1; i < count; i++)
+			{
+				const float *pos = &mesh.Positions.Data[i * 3];
+				min = Vector4(std::min(min.x, pos[0]), std::min(min.y, pos[1]), std::min(min.z, pos[2]));
+				max = Vector4(std::max(max.x, pos[0]), std::max(max.y, pos[1]), std::max(max.z, pos[2]));
+			}
+
+			layout.positionOffset[0] = min.x;
+			layout.positionOffset[1] = min.y;
+			layout.positionOffset[2] = min.z;
+			layout.positionScale[0] = max.x - min.x;
+			layout.positionScale[1] = max.y - min.y;
+			layout.positionScale[2] = max.z - min.z;
+		}
+
+		Pack(mesh, layout, output);
+
+		return layout;
+	}
+
+	void VertexPacker::Pack(const Mesh &mesh, const VertexLayout &layout, std::vector<unsigned char> &output)
+	{
+		unsigned int count = mesh.Positions.Data.size() / 3;
+
+		// attributes the layout has room for but the mesh lacks are left zero.
+		bool hasNormals = layout.normal != -1 && mesh.Normals.Data.size() == count * 3;
+		bool hasTangents = layout.tangent != -1 && mesh.Tangents.Data.size() == count * 3;
+		bool hasUVs = layout.uv != -1 && mesh.UVs.Data.size() == count * 2;
+		bool hasJoints = layout.ids != -1 && mesh.IDs.Data.size() == count * 4 && mesh.Weights.Data.size() == count * 3;
+
+		Vector4 min(layout.positionOffset[0], layout.positionOffset[1], layout.positionOffset[2]);
+		Vector4 max = min + Vector4(layout.positionScale[0], layout.positionScale[1], layout.positionScale[2]);
+
+		output.assign(count * layout.stride, 0);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			unsigned int vertex = i * layout.stride;
+			const float *pos = &mesh.Positions.Data[i * 3];
+
+			if (layout.quantized)
+			{
+				unsigned short value[4] = 
+				{
+					QuantizeUNorm16(pos[0], min.x, max.x),
+					QuantizeUNorm16(pos[1], min.y, max.y),
+					QuantizeUNorm16(pos[2], min.z, max.z),
+					0
+				};
+				Write(output, vertex + layout.position, value, 4);
+			}
+			else
+			{
+				Write(output, vertex + layout.position, pos, 3);
+			}
+
+			if (hasNormals)
+			{
+				const float *normal = &mesh.Normals.Data[i * 3];
+				short value[2];
+				EncodeOctahedral(normal[0], normal[1], normal[2], value[0], value[1]);
+				Write(output, vertex + layout.normal, value, 2);
+			}
+
+			if (hasTangents)
+			{
+				const float *tangent = &mesh.Tangents.Data[i * 3];
+				short value[2];
+				EncodeOctahedral(tangent[0], tangent[1], tangent[2], value[0], value[1]);
+				Write(output, vertex + layout.tangent, value, 2);
+			}
+
+			if (hasUVs)
+			{
+				unsigned short value[2] = { FloatToHalf(mesh.UVs.Data[i * 2]), FloatToHalf(mesh.UVs.Data[i * 2 + 1]) };
+				Write(output, vertex + layout.uv, value, 2);
+			}
+
+			if (hasJoints)
+			{
+				unsigned char ids[4];
+				for (unsigned int j = 0; j < 4; j++)
+					ids[j] = (unsigned char)std::min(mesh.IDs.Data[i * 4 + j], 255u);
+				Write(output, vertex + layout.ids, ids, 4);
+
+				const float *weight = &mesh.Weights.Data[i * 3];
+				unsigned char weights[4] = { QuantizeUNorm8(weight[0]), QuantizeUNorm8(weight[1]), QuantizeUNorm8(weight[2]), 0 };
+				Write(output, vertex + layout.weights, weights, 4);
+			}
+		}
+	}
+}
\ No newline at end of file
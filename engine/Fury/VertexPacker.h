@@ -0,0 +1,76 @@
+#ifndef _FURY_VERTEXPACKER_H_
+#define _FURY_VERTEXPACKER_H_
+
+#include <vector>
+
+#include "Fury/EnumUtil.h"
+
+namespace fury
+{
+	class Mesh;
+
+	// where each attribute lives in one interleaved vertex.
+	struct FURY_API VertexLayout
+	{
+		unsigned int stride = 0;
+
+		// byte offsets, -1 if the attribute isn't packed.
+
+		int position = -1;
+
+		int normal = -1;
+
+		int tangent = -1;
+
+		int uv = -1;
+
+		int ids = -1;
+
+		int weights = -1;
+
+		// positions are 16 bit unorm, position = stored * positionScale + positionOffset.
+		bool quantized = false;
+
+		float positionOffset[3];
+
+		float positionScale[3];
+
+		VertexLayout()
+		{
+			positionOffset[0] = positionOffset[1] = positionOffset[2] = 0.0f;
+			positionScale[0] = positionScale[1] = positionScale[2] = 1.0f;
+		}
+	};
+
+	// cpu side encoding of VertexFormat::INTERLEAVED and VertexFormat::QUANTIZED.
+	// positions: 3 floats, or 4 unorm16 relative to the mesh's aabb when quantized.
+	// normals, tangents: 2 snorm16, octahedral encoded.
+	// uvs: 2 half floats.
+	// joint ids, weights: 4 uint8, 4 unorm8.
+	class FURY_API VertexPacker final
+	{
+	public:
+
+		static void EncodeOctahedral(float x, float y, float z, short &u, short &v);
+
+		static void DecodeOctahedral(short u, short v, float &x, float &y, float &z);
+
+		static unsigned short FloatToHalf(float value);
+
+		static float HalfToFloat(unsigned short value);
+
+		static unsigned short QuantizeUNorm16(float value, float min, float max);
+
+		static float DequantizeUNorm16(unsigned short value, float min, float max);
+
+		static unsigned char QuantizeUNorm8(float value);
+
+		// packs the mesh's separate vertex arrays into output.
+		static VertexLayout Pack(const Mesh &mesh, VertexFormat format, std::vector<unsigned char> &output);
+
+		// packs into a fixed layout, ie: one shared by many meshes.
+		static void Pack(const Mesh &mesh, const VertexLayout &layout, std::vector<unsigned char> &output);
+	};
+}
+
+#endif // _FURY_VERTEXPACKER_H_
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef _FURY_WORK_STEALING_QUEUE_H_
+#define _FURY_WORK_STEALING_QUEUE_H_
+
+// Implimentation refers to: 
+// Correct and Efficient Work-Stealing for Weak Memory Models, Le et al. 2013
+
+#include <atomic>
+#include <memory>
+
+namespace fury
+{
+	// Bounded lock-free deque, Push/Pop are only called by owner thread, 
+	// Steal can be called by any thread.
+	template<class ItemType>
+	class WorkStealingQueue
+	{
+	protected:
+
+		std::atomic<long long> m_Top;
+
+		std::atomic<long long> m_Bottom;
+
+		std::unique_ptr<std::atomic<ItemType*>[]> m_Items;
+
+		long long m_Mask;
+
+	public:
+
+		// capacity must be a power of 2.
+		WorkStealingQueue(unsigned int capacity);
+
+		// returns false when queue is full.
+		bool Push(ItemType *item);
+
+		// lifo, returns nullptr when queue is empty.
+		ItemType *Pop();
+
+		// fifo, returns nullptr when queue is empty or lost the race.
+		ItemType *Steal();
+	};
+
+	template<class ItemType>
+	WorkStealingQueue<ItemType>::WorkStealingQueue(unsigned int capacity)
+		: m_Top(0), m_Bottom(0), m_Items(new std::atomic<ItemType*>[capacity]), m_Mask(capacity - 1)
+	{
+		for (unsigned int i = 0; i < capacity; i++)
+			m_Items[i].store(nullptr, std::memory_order_relaxed);
+	}
+
+	template<class ItemType>
+	bool WorkStealingQueue<ItemType>::Push(ItemType *item)
+	{
+		long long bottom = m_Bottom.load(std::memory_order_relaxed);
+		long long top = m_Top.load(std::memory_order_acquire);
+		if (bottom - top > m_Mask)
+			return false;
+
+		m_Items[bottom & m_Mask].store(item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	template<class ItemType>
+	ItemType *WorkStealingQueue<ItemType>::Pop()
+	{
+		long long bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+		m_Bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long long top = m_Top.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		ItemType *item = m_Items[bottom & m_Mask].load(std::memory_order_relaxed);
+		if (top == bottom)
+		{
+			// last item, race against thieves.
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				item = nullptr;
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	template<class ItemType>
+	ItemType *WorkStealingQueue<ItemType>::Steal()
+	{
+		long long top = m_Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long long bottom = m_Bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return nullptr;
+
+		ItemType *item = m_Items[top & m_Mask].load(std::memory_order_relaxed);
+		if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return item;
+	}
+}
+
+#endif // _FURY_WORK_STEALING_QUEUE_H_
\ No newline at end of file
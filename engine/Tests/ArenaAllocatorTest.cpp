@@ -0,0 +1,187 @@
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "Fury/ArenaAllocator.h"
+
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	// live blocks stay inside the capacity, don't overlap and add up to GetUsed().
+	bool IsValid(const ArenaAllocator &allocator, const std::map<unsigned int, unsigned int> &live)
+	{
+		std::vector<bool> covered(allocator.GetCapacity(), false);
+		unsigned int used = 0;
+
+		for (const auto &pair : live)
+		{
+			unsigned int offset = allocator.GetOffset(pair.first);
+			unsigned int size = allocator.GetSize(pair.first);
+			if (size != pair.second || offset + size > allocator.GetCapacity())
+				return false;
+
+			for (unsigned int i = offset; i < offset + size; i++)
+			{
+				if (covered[i])
+					return false;
+				covered[i] = true;
+			}
+			used += size;
+		}
+
+		return used == allocator.GetUsed();
+	}
+}
+
+FURY_TEST(ArenaAllocator, AllocateAndFree)
+{
+	ArenaAllocator allocator(100);
+
+	unsigned int a = allocator.Allocate(10);
+	unsigned int b = allocator.Allocate(20);
+	unsigned int c = allocator.Allocate(30);
+	FURY_CHECK(allocator.GetOffset(a) == 0);
+	FURY_CHECK(allocator.GetOffset(b) == 10);
+	FURY_CHECK(allocator.GetOffset(c) == 30);
+
+	FURY_CHECK(allocator.Allocate(0) == ArenaAllocator::INVALID);
+	FURY_CHECK(allocator.Allocate(41) == ArenaAllocator::INVALID);
+
+	allocator.Free(b);
+	FURY_CHECK(allocator.GetFreeRangeCount() == 2);
+
+	// best fit takes the 20 hole over the 40 tail.
+	unsigned int d = allocator.Allocate(15);
+	FURY_CHECK(allocator.GetOffset(d) == 10);
+
+	// neighbouring free ranges merge.
+	allocator.Free(d);
+	allocator.Free(a);
+	FURY_CHECK(allocator.GetFreeRangeCount() == 2);
+	FURY_CHECK(allocator.GetLargestFreeRange() == 40);
+
+	allocator.Free(c);
+	FURY_CHECK(allocator.GetFreeRangeCount() == 1);
+	FURY_CHECK(allocator.GetLargestFreeRange() == 100);
+	FURY_CHECK(allocator.GetUsed() == 0);
+
+	// freeing twice is ignored.
+	allocator.Free(c);
+	FURY_CHECK(allocator.GetUsed() == 0);
+	FURY_CHECK(!allocator.IsLive(c));
+}
+
+FURY_TEST(ArenaAllocator, Defragment)
+{
+	ArenaAllocator allocator(100);
+
+	std::vector<unsigned int> handles;
+	for (unsigned int i = 0; i < 10; i++)
+		handles.push_back(allocator.Allocate(10));
+	for (unsigned int i = 0; i < 10; i += 2)
+		allocator.Free(handles[i]);
+
+	// half the space is free, but no range holds 20.
+	FURY_CHECK(allocator.Allocate(20) == ArenaAllocator::INVALID);
+	FURY_CHECK(allocator.GetCapacity() - allocator.GetUsed() == 50);
+
+	std::vector<ArenaMove> moves;
+	allocator.Defragment(moves);
+	FURY_CHECK(moves.size() == 5);
+	for (unsigned int i = 0; i < moves.size(); i++)
+	{
+		FURY_CHECK(moves[i].srcOffset == (2 * i + 1) * 10);
+		FURY_CHECK(moves[i].destOffset == i * 10);
+		FURY_CHECK(allocator.GetOffset(moves[i].handle) == i * 10);
+	}
+
+	FURY_CHECK(allocator.GetFreeRangeCount() == 1);
+	FURY_CHECK(allocator.GetLargestFreeRange() == 50);
+	FURY_CHECK(allocator.Allocate(50) != ArenaAllocator::INVALID);
+
+	allocator.Grow(150);
+	FURY_CHECK(allocator.GetFreeRangeCount() == 1);
+	FURY_CHECK(allocator.GetLargestFreeRange() == 50);
+
+	allocator.Clear();
+	FURY_CHECK(allocator.GetUsed() == 0);
+	FURY_CHECK(allocator.GetLargestFreeRange() == 150);
+}
+
+FURY_TEST(ArenaAllocator, RandomAgainstReference)
+{
+	std::srand(7);
+
+	// contents follow defragment moves, each unit holds its block's handle.
+	ArenaAllocator allocator(4096);
+	std::map<unsigned int, unsigned int> live;
+	std::vector<int> memory(allocator.GetCapacity(), -1);
+
+	unsigned int defragmentCount = 0;
+	for (unsigned int step = 0; step < 50000; step++)
+	{
+		if (!live.empty() && std::rand() % 3 == 0)
+		{
+			auto it = live.begin();
+			std::advance(it, std::rand() % live.size());
+			allocator.Free(it->first);
+			live.erase(it);
+			continue;
+		}
+
+		unsigned int size = 1 + std::rand() % 64;
+		unsigned int handle = allocator.Allocate(size);
+		if (handle == ArenaAllocator::INVALID)
+		{
+			if (allocator.GetCapacity() - allocator.GetUsed() < size)
+				continue;
+
+			std::vector<ArenaMove> moves;
+			allocator.Defragment(moves);
+			defragmentCount++;
+
+			std::map<unsigned int, unsigned int> sources;
+			for (const auto &move : moves)
+				sources[move.handle] = move.srcOffset;
+
+			std::vector<int> defragmented(allocator.GetCapacity(), -1);
+			for (const auto &pair : live)
+			{
+				unsigned int offset = allocator.GetOffset(pair.first);
+				auto it = sources.find(pair.first);
+				unsigned int source = it == sources.end() ? offset : it->second;
+				for (unsigned int i = 0; i < pair.second; i++)
+					defragmented[offset + i] = memory[source + i];
+			}
+			memory.swap(defragmented);
+
+			handle = allocator.Allocate(size);
+			if (!FURY_CHECK(handle != ArenaAllocator::INVALID))
+				return;
+		}
+
+		live[handle] = size;
+		for (unsigned int i = 0; i < size; i++)
+			memory[allocator.GetOffset(handle) + i] = (int)handle;
+
+		if (step % 997 == 0)
+		{
+			FURY_CHECK(IsValid(allocator, live));
+
+			bool intact = true;
+			for (const auto &pair : live)
+			{
+				for (unsigned int i = 0; i < pair.second; i++)
+					intact = intact && memory[allocator.GetOffset(pair.first) + i] == (int)pair.first;
+			}
+			FURY_CHECK(intact);
+		}
+	}
+
+	FURY_CHECK(defragmentCount > 0);
+	FURY_CHECK(IsValid(allocator, live));
+}
\ No newline at end of file
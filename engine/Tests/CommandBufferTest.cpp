@@ -0,0 +1,211 @@
+#include <string>
+#include <thread>
+
+#include "Fury/Camera.h"
+#include "Fury/CommandBuffer.h"
+#include "Fury/CommandExecutor.h"
+#include "Fury/EntityManager.h"
+#include "Fury/Light.h"
+#include "Fury/Material.h"
+#include "Fury/MathUtil.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/MeshUtil.h"
+#include "Fury/OcTree.h"
+#include "Fury/Pass.h"
+#include "Fury/PrelightPipeline.h"
+#include "Fury/RenderUtil.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Shader.h"
+
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	// a gbuffer pass over 4 meshes x 2 materials and a light pass with one spot light, 
+	// every node is inside the camera's frustum.
+	// RenderUtil has no gl context here, it only keeps the counters.
+	class FrameScene
+	{
+	public:
+
+		static const unsigned int nodeCount = 240;
+
+		OcTree::Ptr ocTree;
+
+		SceneNode::Ptr camera;
+
+		Light::Ptr light;
+
+		// MeshRender only keeps weak pointers.
+		std::vector<Mesh::Ptr> meshes;
+
+		std::vector<Material::Ptr> materials;
+
+		PrelightPipeline::Ptr pipeline;
+
+		NullCommandExecutor::Ptr executor;
+
+		unsigned int indexCount;
+
+		FrameScene()
+		{
+			RenderUtil::Initialize();
+
+			ocTree = OcTree::Create(Vector4(-1000.0f), Vector4(1000.0f), 4);
+
+			camera = SceneNode::Create("camera");
+			auto cameraPtr = Camera::Create();
+			cameraPtr->PerspectiveFov(MathUtil::DegToRad * 70.0f, 1.0f, 1.0f, 1000.0f);
+			camera->AddComponent(cameraPtr);
+			camera->UpdateTransforms();
+
+			for (unsigned int i = 0; i < 4; i++)
+				meshes.push_back(MeshUtil::CreateCube("mesh", Vector4(-1.0f), Vector4(1.0f)));
+
+			for (unsigned int i = 0; i < 2; i++)
+				materials.push_back(Material::Create("material"));
+
+			indexCount = 0;
+			for (unsigned int i = 0; i < nodeCount; i++)
+			{
+				auto mesh = meshes[i % meshes.size()];
+				auto node = SceneNode::Create("node");
+				node->SetLocalPosition(Vector4((float)(i % 12) - 6.0f, (float)(i % 5) - 2.0f, -20.0f - (float)(i / 12)));
+				node->AddComponent(MeshRender::Create(materials[(i / 4) % materials.size()], mesh));
+				node->UpdateTransforms();
+				ocTree->AddSceneNode(node);
+				indexCount += mesh->Indices.Data.size();
+			}
+
+			light = Light::Create();
+			light->SetType(LightType::SPOT);
+			light->SetRadius(50.0f);
+			light->SetOutterAngle(MathUtil::DegToRad * 60.0f);
+			light->SetCastShadows(false);
+
+			auto lightNode = SceneNode::Create("light");
+			lightNode->SetLocalPosition(Vector4(0.0f, 20.0f, -30.0f));
+			lightNode->AddComponent(light);
+			lightNode->UpdateTransforms();
+			ocTree->AddSceneNode(lightNode);
+
+			pipeline = PrelightPipeline::Create("pipeline");
+			pipeline->SetCurrentCamera(camera);
+
+			executor = NullCommandExecutor::Create();
+			pipeline->SetCommandExecutor(executor);
+
+			auto gbuffer = Pass::Create("gbuffer");
+			gbuffer->SetRenderIndex(0);
+			gbuffer->SetDrawMode(DrawMode::OPAQUE);
+			gbuffer->AddShader(Shader::Create("static_shader", ShaderType::STATIC_MESH));
+			gbuffer->AddShader(Shader::Create("instanced_shader", ShaderType::INSTANCED_MESH));
+
+			auto lighting = Pass::Create("lighting");
+			lighting->SetRenderIndex(1);
+			lighting->SetDrawMode(DrawMode::LIGHT);
+
+			auto entityManager = pipeline->GetEntityManager();
+			entityManager->Add(gbuffer);
+			entityManager->Add(lighting);
+			entityManager->Add(Shader::Create("spotlight_shader", ShaderType::OTHER));
+		}
+
+		~FrameScene()
+		{
+			ocTree->Clear();
+			RenderUtil::Instance().reset();
+		}
+
+		void Execute(bool instancing)
+		{
+			executor->Reset();
+			pipeline->SetSwitch(PipelineSwitch::INSTANCING, instancing);
+			pipeline->Execute(ocTree);
+		}
+	};
+}
+
+FURY_TEST(CommandBuffer, FrameDrawCounts)
+{
+	FrameScene scene;
+
+	// one draw per node, then the light volume.
+	scene.Execute(false);
+
+	auto &executor = scene.executor;
+	unsigned int volumeIndices = scene.light->GetMesh()->Indices.Data.size();
+	unsigned int drawCount = executor->GetDrawCount();
+
+	FURY_CHECK(drawCount == FrameScene::nodeCount + 1);
+	FURY_CHECK(executor->GetInstanceCount() == FrameScene::nodeCount + 1);
+	FURY_CHECK(executor->GetIndexCount() == scene.indexCount + volumeIndices);
+	FURY_CHECK(RenderUtil::Instance()->GetDrawCall() == drawCount);
+	FURY_CHECK(RenderUtil::Instance()->GetLightCount() == 1);
+
+	// gbuffer, lighting and the light volume, gui once per frame.
+	FURY_CHECK(executor->GetCommandCount(CommandType::BIND_PASS) == 3);
+	FURY_CHECK(executor->GetCommandCount(CommandType::UNBIND_PASS) == 3);
+	FURY_CHECK(executor->GetCommandCount(CommandType::BIND_LIGHT) == 1);
+	FURY_CHECK(executor->GetCommandCount(CommandType::RENDER_GUI) == 1);
+
+	// srgb on the last pass, plus depth test and culling of the light volume.
+	FURY_CHECK(executor->GetCommandCount(CommandType::ENABLE) + executor->GetCommandCount(CommandType::DISABLE) == 3);
+	FURY_CHECK(executor->GetCommandCount(CommandType::CULL_FACE) == 1);
+
+	// 8 mesh/material pairs, nodes sharing a pair become one instanced draw.
+	scene.Execute(true);
+
+	FURY_CHECK(executor->GetDrawCount() == 8 + 1);
+	FURY_CHECK(executor->GetCommandCount(CommandType::BIND_INSTANCES) == 8);
+	FURY_CHECK(executor->GetInstanceCount() == FrameScene::nodeCount + 1);
+	FURY_CHECK(executor->GetIndexCount() == scene.indexCount + volumeIndices);
+	FURY_CHECK(RenderUtil::Instance()->GetDrawCall() == drawCount + executor->GetDrawCount());
+}
+
+FURY_TEST(CommandBuffer, UniformIDs)
+{
+	// threads racing on new names agree on their ids.
+	const unsigned int nameCount = 200;
+	std::vector<std::vector<unsigned int>> threadIDs(4, std::vector<unsigned int>(nameCount));
+	std::vector<std::thread> threads;
+
+	for (unsigned int i = 0; i < threadIDs.size(); i++)
+	{
+		threads.emplace_back([&threadIDs, i]()
+		{
+			for (unsigned int j = 0; j < nameCount; j++)
+				threadIDs[i][j] = Shader::GetUniformID("test_uniform_" + std::to_string(j));
+		});
+	}
+
+	for (auto &thread : threads)
+		thread.join();
+
+	unsigned int mismatchCount = 0;
+	for (unsigned int j = 0; j < nameCount; j++)
+	{
+		unsigned int id = Shader::GetUniformID("test_uniform_" + std::to_string(j));
+		for (const auto &ids : threadIDs)
+			mismatchCount += ids[j] != id ? 1 : 0;
+
+		if (j > 0 && id == Shader::GetUniformID("test_uniform_" + std::to_string(j - 1)))
+			mismatchCount++;
+	}
+
+	FURY_CHECK(mismatchCount == 0);
+
+	// binding by name or by id records the same command.
+	auto shader = Shader::Create("test_shader", ShaderType::OTHER);
+	auto commandBuffer = CommandBuffer::Create();
+	float value = 1.0f;
+
+	commandBuffer->BindFloat(shader, "light_far", 1, &value);
+	commandBuffer->BindFloat(shader, Shader::GetUniformID("light_far"), 1, &value);
+
+	const auto &commands = commandBuffer->GetCommands();
+	FURY_CHECK(commands.size() == 2 && commands[0].args[1] == commands[1].args[1]);
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include <cmath>
+
+#include "Fury/DynamicBVH.h"
+
+#include "TestScene.h"
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	const float extent = 100.0f;
+
+	DynamicBVH::Ptr CreateTree(TestScene &scene)
+	{
+		auto tree = DynamicBVH::Create();
+		for (const auto &sceneNode : scene.sceneNodes)
+			tree->AddSceneNode(sceneNode);
+		return tree;
+	}
+
+	// balanced trees stay well below 2 * log2(n).
+	bool IsBalanced(const DynamicBVH::Ptr &tree)
+	{
+		unsigned int count = tree->GetSceneNodeCount();
+		return count < 2 || tree->GetHeight() <= 2 * (unsigned int)std::ceil(std::log2((float)count));
+	}
+
+	// builds a chain that no balancing would, every level leaves a leaf on the query stack.
+	class ChainBVH : public DynamicBVH
+	{
+	public:
+
+		ChainBVH() : DynamicBVH(0.5f) {}
+
+		void BuildChain(const std::vector<SceneNode::Ptr> &sceneNodes)
+		{
+			Clear();
+
+			std::vector<int> leafs;
+			for (const auto &sceneNode : sceneNodes)
+			{
+				int leaf = AllocateTreeNode();
+				TreeNode &treeNode = m_TreeNodes[leaf];
+				treeNode.aabb = treeNode.sceneNodeAABB = sceneNode->GetWorldAABB();
+				treeNode.sceneNode = sceneNode;
+
+				sceneNode->SetSceneManager(this, 0, leaf);
+				leafs.push_back(leaf);
+				m_SceneNodeCount++;
+			}
+
+			// child1 goes deeper and is popped first, child2 waits on the stack.
+			int child = leafs.back();
+			for (unsigned int i = leafs.size() - 1; i-- > 0;)
+			{
+				int parent = AllocateTreeNode();
+				TreeNode &treeNode = m_TreeNodes[parent];
+				treeNode.child1 = child;
+				treeNode.child2 = leafs[i];
+				treeNode.aabb = Combine(m_TreeNodes[child].aabb, m_TreeNodes[leafs[i]].aabb);
+				treeNode.height = m_TreeNodes[child].height + 1;
+
+				m_TreeNodes[child].parent = parent;
+				m_TreeNodes[leafs[i]].parent = parent;
+				child = parent;
+			}
+
+			m_Root = child;
+		}
+	};
+}
+
+FURY_TEST(DynamicBVH, Insert)
+{
+	TestScene scene(3000, extent);
+	auto tree = CreateTree(scene);
+
+	FURY_CHECK(tree->GetSceneNodeCount() == 3000);
+	FURY_CHECK(tree->GetTreeNodeCount() == 2 * 3000 - 1);
+	FURY_CHECK(IsBalanced(tree));
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(DynamicBVH, MoveAndRemove)
+{
+	TestScene scene(3000, extent);
+	auto tree = CreateTree(scene);
+
+	for (unsigned int i = 0; i < 6; i++)
+	{
+		// small moves stay in fat aabbs, big ones are reinserted.
+		scene.Move(i, 2, i % 2 == 0 ? extent * 0.002f : extent * 0.3f);
+
+		FURY_CHECK(IsBalanced(tree));
+		FURY_CHECK(scene.Check(*tree, extent * 1.5f));
+	}
+
+	FURY_CHECK(tree->GetUpdateSkipCount() > 0);
+	FURY_CHECK(tree->GetUpdateMoveCount() > 0);
+
+	for (unsigned int i = scene.sceneNodes.size(); i-- > 0;)
+	{
+		if (scene.Random(0.0f, 1.0f) < 0.6f)
+			scene.Remove(*tree, i);
+	}
+
+	FURY_CHECK(tree->GetSceneNodeCount() == scene.sceneNodes.size());
+	FURY_CHECK(IsBalanced(tree));
+	FURY_CHECK(scene.Check(*tree, extent * 1.5f));
+
+	// freed tree nodes are reused.
+	TestScene newScene(1000, extent, 4321);
+	for (const auto &sceneNode : newScene.sceneNodes)
+	{
+		tree->AddSceneNode(sceneNode);
+		scene.sceneNodes.push_back(sceneNode);
+	}
+
+	FURY_CHECK(IsBalanced(tree));
+	FURY_CHECK(scene.Check(*tree, extent * 1.5f));
+
+	while (!scene.sceneNodes.empty())
+		scene.Remove(*tree, scene.sceneNodes.size() - 1);
+
+	FURY_CHECK(tree->GetSceneNodeCount() == 0);
+	FURY_CHECK(tree->GetHeight() == 0);
+}
+
+FURY_TEST(DynamicBVH, InfiniteNodes)
+{
+	TestScene scene(500, extent);
+	auto infiniteNode = scene.AddInfiniteNode();
+	scene.Update();
+
+	auto tree = CreateTree(scene);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	// moving an infinite one changes nothing.
+	tree->ResetStatistics();
+	infiniteNode->SetLocalPosition(Vector4(10.0f, 0.0f, 0.0f));
+	scene.Update();
+
+	FURY_CHECK(tree->GetUpdateSkipCount() == 1);
+	FURY_CHECK(tree->GetUpdateMoveCount() == 0);
+
+	// finite and infinite again.
+	infiniteNode->SetModelAABB(BoxBounds(Vector4(-1.0f), Vector4(1.0f)));
+	FURY_CHECK(tree->GetUpdateMoveCount() == 1);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	BoxBounds aabb;
+	aabb.SetInfinite(true);
+	infiniteNode->SetModelAABB(aabb);
+	FURY_CHECK(tree->GetUpdateMoveCount() == 2);
+	FURY_CHECK(tree->GetSceneNodeCount() == 501);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(DynamicBVH, DeeperThanStack)
+{
+	TestScene scene(DynamicBVH::STACK_SIZE + 100, extent);
+
+	auto tree = std::make_shared<ChainBVH>();
+	tree->BuildChain(scene.sceneNodes);
+
+	FURY_CHECK(tree->GetHeight() > DynamicBVH::STACK_SIZE);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
\ No newline at end of file
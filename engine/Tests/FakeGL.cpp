@@ -0,0 +1,135 @@
+#include <cstring>
+
+#include "Fury/GLStateCache.h"
+
+#include "FakeGL.h"
+#include "Test.h"
+
+namespace fury
+{
+	namespace
+	{
+		GLuint nextName = 1;
+
+		void APIENTRY FakeGenBuffers(GLsizei n, GLuint *names)
+		{
+			for (GLsizei i = 0; i < n; i++)
+			{
+				names[i] = nextName++;
+				FakeGL::Buffers[names[i]];
+			}
+		}
+
+		void APIENTRY FakeDeleteBuffers(GLsizei n, const GLuint *names)
+		{
+			for (GLsizei i = 0; i < n; i++)
+				FakeGL::Buffers.erase(names[i]);
+		}
+
+		void APIENTRY FakeBindBuffer(GLenum target, GLuint buffer)
+		{
+			FakeGL::Bindings[target] = buffer;
+			if (target == GL_ARRAY_BUFFER && buffer != 0)
+				FakeGL::ArrayBuffer = buffer;
+		}
+
+		void APIENTRY FakeBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum)
+		{
+			auto &buffer = FakeGL::Buffers[FakeGL::Bindings[target]];
+			buffer.assign(size, 0xcd);
+			if (data != nullptr)
+				std::memcpy(buffer.data(), data, size);
+		}
+
+		void APIENTRY FakeBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+		{
+			auto &buffer = FakeGL::Buffers[FakeGL::Bindings[target]];
+			if (FURY_CHECK(offset + size <= (GLintptr)buffer.size()))
+				std::memcpy(buffer.data() + offset, data, size);
+		}
+
+		void APIENTRY FakeCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+		{
+			auto &read = FakeGL::Buffers[FakeGL::Bindings[readTarget]];
+			auto &write = FakeGL::Buffers[FakeGL::Bindings[writeTarget]];
+			if (FURY_CHECK(FakeGL::Bindings[readTarget] != FakeGL::Bindings[writeTarget]) && 
+				FURY_CHECK(readOffset + size <= (GLintptr)read.size() && writeOffset + size <= (GLintptr)write.size()))
+				std::memcpy(write.data() + writeOffset, read.data() + readOffset, size);
+		}
+
+		void APIENTRY FakeGenVertexArrays(GLsizei n, GLuint *names)
+		{
+			for (GLsizei i = 0; i < n; i++)
+				names[i] = nextName++;
+		}
+
+		void APIENTRY FakeDeleteVertexArrays(GLsizei, const GLuint *) {}
+
+		void APIENTRY FakeVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) {}
+
+		void APIENTRY FakeEnableVertexAttribArray(GLuint) {}
+
+		void FakeBindVertexArray(unsigned int) {}
+
+		// swaps a gl function pointer with a fake one, keeping the other in saved.
+		template<typename Func>
+		void Swap(Func &func, Func other, std::vector<void*> &saved)
+		{
+			saved.push_back((void*)func);
+			func = other;
+		}
+
+		template<typename Func>
+		void Restore(Func &func, std::vector<void*> &saved)
+		{
+			func = (Func)saved.back();
+			saved.pop_back();
+		}
+	}
+
+	std::map<GLuint, std::vector<unsigned char>> FakeGL::Buffers;
+
+	std::map<GLenum, GLuint> FakeGL::Bindings;
+
+	GLuint FakeGL::ArrayBuffer = 0;
+
+	FakeGL::FakeGL()
+	{
+		Buffers.clear();
+		Bindings.clear();
+		ArrayBuffer = 0;
+
+		Swap(glGenBuffers, FakeGenBuffers, m_Functions);
+		Swap(glDeleteBuffers, FakeDeleteBuffers, m_Functions);
+		Swap(glBindBuffer, FakeBindBuffer, m_Functions);
+		Swap(glBufferData, FakeBufferData, m_Functions);
+		Swap(glBufferSubData, FakeBufferSubData, m_Functions);
+		Swap(glCopyBufferSubData, FakeCopyBufferSubData, m_Functions);
+		Swap(glGenVertexArrays, FakeGenVertexArrays, m_Functions);
+		Swap(glDeleteVertexArrays, FakeDeleteVertexArrays, m_Functions);
+		Swap(glVertexAttribPointer, FakeVertexAttribPointer, m_Functions);
+		Swap(glEnableVertexAttribArray, FakeEnableVertexAttribArray, m_Functions);
+
+		auto functions = GLStateCache::GetGLFunctions();
+		functions.BindVertexArray = FakeBindVertexArray;
+		GLStateCache::Initialize();
+		GLStateCache::Instance()->SetFunctions(functions);
+	}
+
+	FakeGL::~FakeGL()
+	{
+		GLStateCache::Instance().reset();
+
+		// reverse order of the swaps.
+		Restore(glEnableVertexAttribArray, m_Functions);
+		Restore(glVertexAttribPointer, m_Functions);
+		Restore(glDeleteVertexArrays, m_Functions);
+		Restore(glGenVertexArrays, m_Functions);
+		Restore(glCopyBufferSubData, m_Functions);
+		Restore(glBufferSubData, m_Functions);
+		Restore(glBufferData, m_Functions);
+		Restore(glBindBuffer, m_Functions);
+		Restore(glDeleteBuffers, m_Functions);
+		Restore(glGenBuffers, m_Functions);
+	}
+}
\ No newline at end of file
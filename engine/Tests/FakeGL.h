@@ -0,0 +1,37 @@
+#ifndef _FURY_FAKEGL_H_
+#define _FURY_FAKEGL_H_
+
+#include <map>
+#include <vector>
+
+#include "Fury/GLLoader.h"
+
+namespace fury
+{
+	// Fakes gl's buffer and vertex array functions in cpu memory while an instance lives,
+	// enough for MeshArena's uploads and relocations without a context.
+	// A GLStateCache is created too, the previous functions come back on destruction.
+	class FakeGL
+	{
+	public:
+
+		static std::map<GLuint, std::vector<unsigned char>> Buffers;
+
+		static std::map<GLenum, GLuint> Bindings;
+
+		// last buffer bound to GL_ARRAY_BUFFER, MeshArena's vbo after SetupVertexArray.
+		static GLuint ArrayBuffer;
+
+	protected:
+
+		std::vector<void*> m_Functions;
+
+	public:
+
+		FakeGL();
+
+		~FakeGL();
+	};
+}
+
+#endif // _FURY_FAKEGL_H_
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "Fury/GLLoader.h"
+#include "Fury/GLStateCache.h"
+
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	// fake gl functions, they only count the calls reaching them.
+	unsigned int callCount = 0;
+
+	void FakeUInt(unsigned int) { callCount++; }
+
+	void FakeUInt2(unsigned int, unsigned int) { callCount++; }
+
+	void FakeInt4(int, int, int, int) { callCount++; }
+
+	void FakeUChar(unsigned char) { callCount++; }
+
+	GLFunctions GetFakeFunctions()
+	{
+		GLFunctions functions;
+		functions.Enable = FakeUInt;
+		functions.Disable = FakeUInt;
+		functions.UseProgram = FakeUInt;
+		functions.BindVertexArray = FakeUInt;
+		functions.BindFramebuffer = FakeUInt2;
+		functions.ActiveTexture = FakeUInt;
+		functions.BindTexture = FakeUInt2;
+		functions.Viewport = FakeInt4;
+		functions.DepthFunc = FakeUInt;
+		functions.DepthMask = FakeUChar;
+		functions.BlendFunc = FakeUInt2;
+		functions.BlendEquation = FakeUInt;
+		functions.CullFace = FakeUInt;
+		return functions;
+	}
+}
+
+FURY_TEST(GLStateCache, RedundantCallsSkipped)
+{
+	GLStateCache cache(GetFakeFunctions());
+	callCount = 0;
+
+	// 100 draws with the same pass state and program, the first texture changes each draw.
+	for (unsigned int i = 0; i < 100; i++)
+	{
+		cache.BindFramebuffer(3);
+		cache.Viewport(0, 0, 800, 600);
+		cache.Enable(GL_DEPTH_TEST);
+		cache.DepthFunc(GL_LESS);
+		cache.Disable(GL_BLEND);
+		cache.Enable(GL_CULL_FACE);
+		cache.CullFace(GL_BACK);
+		cache.UseProgram(7);
+		cache.ActiveTexture(GL_TEXTURE0);
+		cache.BindTexture(GL_TEXTURE_2D, 10 + i % 2);
+		cache.ActiveTexture(GL_TEXTURE1);
+		cache.BindTexture(GL_TEXTURE_2D, 20);
+		cache.BindVertexArray(5);
+	}
+
+	// 13 calls on the first draw, then both unit switches and the changed texture.
+	FURY_CHECK(cache.GetIssuedCount() == 13 + 99 * 3);
+	FURY_CHECK(cache.GetSkippedCount() == 99 * 10);
+	FURY_CHECK(callCount == cache.GetIssuedCount());
+}
+
+FURY_TEST(GLStateCache, UntrackedStatesIssued)
+{
+	GLStateCache cache(GetFakeFunctions());
+	callCount = 0;
+
+	// caps and texture units beyond the tracked ones.
+	cache.Enable(GL_STENCIL_TEST);
+	cache.Enable(GL_STENCIL_TEST);
+	FURY_CHECK(callCount == 2);
+
+	cache.ActiveTexture(GL_TEXTURE0 + GLStateCache::MAX_TEXTURE_UNITS);
+	cache.BindTexture(GL_TEXTURE_2D, 1);
+	cache.BindTexture(GL_TEXTURE_2D, 1);
+	FURY_CHECK(callCount == 5);
+}
+
+FURY_TEST(GLStateCache, Invalidate)
+{
+	GLStateCache cache(GetFakeFunctions());
+
+	cache.UseProgram(7);
+	cache.DepthMask(true);
+
+	callCount = 0;
+	cache.Invalidate();
+	cache.UseProgram(7);
+	cache.DepthMask(true);
+	FURY_CHECK(callCount == 2);
+}
+
+FURY_TEST(GLStateCache, ForgetDeletedNames)
+{
+	GLStateCache::Initialize();
+	GLStateCache::Instance()->SetFunctions(GetFakeFunctions());
+
+	GLStateCache::Instance()->BindVertexArray(9);
+	GLStateCache::ForgetVertexArray(9);
+
+	callCount = 0;
+	GLStateCache::Instance()->BindVertexArray(9);
+	FURY_CHECK(callCount == 1);
+
+	GLStateCache::Instance()->ActiveTexture(GL_TEXTURE2);
+	GLStateCache::Instance()->BindTexture(GL_TEXTURE_CUBE_MAP, 4);
+	GLStateCache::ForgetTexture(4);
+
+	callCount = 0;
+	GLStateCache::Instance()->BindTexture(GL_TEXTURE_CUBE_MAP, 4);
+	GLStateCache::Instance()->UseProgram(3);
+	GLStateCache::ForgetProgram(3);
+	GLStateCache::Instance()->UseProgram(3);
+	FURY_CHECK(callCount == 3);
+
+	// names of objects deleted at shutdown are forgotten without a cache.
+	GLStateCache::Instance().reset();
+	GLStateCache::ForgetTexture(4);
+}
\ No newline at end of file
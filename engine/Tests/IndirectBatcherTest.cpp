@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include "Fury/GLLoader.h"
+#include "Fury/IndirectBatcher.h"
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshArena.h"
+#include "Fury/MeshRender.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Vector4.h"
+
+#include "FakeGL.h"
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	// every 10th mesh stays out of the arena, every 7th has 2 sub meshes.
+	class BatcherScene
+	{
+	public:
+
+		std::mt19937 random;
+
+		std::vector<Material::Ptr> materials;
+
+		std::vector<Mesh::Ptr> meshes;
+
+		BatcherScene() : random(5)
+		{
+			std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+			for (unsigned int i = 0; i < 8; i++)
+				materials.push_back(Material::Create("material"));
+
+			for (unsigned int i = 0; i < 300; i++)
+			{
+				auto mesh = Mesh::Create("mesh");
+				for (unsigned int j = 0; j < 24 * 3; j++)
+					mesh->Positions.Data.push_back(distribution(random));
+				for (unsigned int j = 0; j < 36; j++)
+					mesh->Indices.Data.push_back(random() % 24);
+
+				for (unsigned int j = 0; i % 7 == 0 && j < 2; j++)
+				{
+					auto subMesh = SubMesh::Create();
+					for (unsigned int k = 0; k < 12; k++)
+						subMesh->Indices.Data.push_back(random() % 24);
+					mesh->AddSubMesh(subMesh);
+				}
+
+				mesh->SetUseArena(i % 10 != 0);
+				if (mesh->GetUseArena())
+					mesh->UpdateBuffer();
+
+				meshes.push_back(mesh);
+			}
+		}
+
+		SceneNode::Ptr CreateNode()
+		{
+			std::uniform_real_distribution<float> distribution(-500.0f, 500.0f);
+
+			auto node = SceneNode::Create("node");
+			node->SetLocalPosition(Vector4(distribution(random), distribution(random), distribution(random)));
+			node->UpdateTransforms();
+			return node;
+		}
+	};
+
+	DrawRange GetDrawRange(const RenderUnit &unit)
+	{
+		return unit.mesh->GetSubMeshCount() > 0 ? unit.mesh->GetDrawRange(unit.subMesh) : unit.mesh->GetDrawRange();
+	}
+}
+
+FURY_TEST(IndirectBatcher, CommandsMatchDrawRanges)
+{
+	FakeGL fakeGL;
+	MeshArena::Initialize();
+
+	{
+		BatcherScene scene;
+		for (unsigned int i = 0; i < scene.meshes.size(); i++)
+			FURY_CHECK(scene.meshes[i]->IsInArena() == (i % 10 != 0));
+
+		// sorted the way RenderQuery::Sort groups opaque units.
+		std::vector<RenderUnit> units;
+		for (unsigned int i = 0; i < 30000; i++)
+		{
+			auto mesh = scene.meshes[scene.random() % scene.meshes.size()];
+			auto material = scene.materials[scene.random() % scene.materials.size()];
+			units.push_back(RenderUnit(scene.CreateNode(), mesh, material, mesh->GetSubMeshCount() > 0 ? scene.random() % 2 : 0));
+		}
+		std::sort(units.begin(), units.end(), [](const RenderUnit &a, const RenderUnit &b)
+		{
+			if (a.material != b.material)
+				return a.material < b.material;
+			if (a.mesh != b.mesh)
+				return a.mesh < b.mesh;
+			return a.subMesh < b.subMesh;
+		});
+
+		auto batcher = IndirectBatcher::Create();
+		batcher->Build(units);
+
+		// batches cover all units in order, each command draws its units' ranges with their matrices.
+		unsigned int next = 0;
+		for (const auto &batch : batcher->GetBatches())
+		{
+			FURY_CHECK(batch.first == next);
+			next += batch.count;
+
+			if (!batch.IsIndirect())
+			{
+				FURY_CHECK(batch.count == 1);
+				continue;
+			}
+
+			FURY_CHECK(batch.count >= batcher->GetMinDraws());
+			FURY_CHECK(batch.indexType == GL_UNSIGNED_SHORT);
+
+			unsigned int unitIndex = batch.first;
+			for (unsigned int i = 0; i < batch.commandCount; i++)
+			{
+				auto command = batcher->GetCommand(batch.commandOffset + i);
+				const auto &drawData = batcher->GetDrawData()[batch.commandOffset + i];
+				FURY_CHECK(drawData.matrixIndex == command.baseInstance);
+
+				for (unsigned int j = 0; j < command.instanceCount; j++, unitIndex++)
+				{
+					const auto &unit = units[unitIndex];
+					FURY_CHECK(unit.material == units[batch.first].material);
+					FURY_CHECK(batcher->GetMaterials()[drawData.materialIndex] == unit.material);
+
+					auto range = GetDrawRange(unit);
+					FURY_CHECK(command.count == range.indexCount);
+					FURY_CHECK(command.firstIndex * sizeof(unsigned short) == range.indexOffset);
+					FURY_CHECK(command.baseVertex == range.baseVertex);
+					FURY_CHECK(std::memcmp(&batcher->Matrices.Data[(command.baseInstance + j) * 16], unit.node->GetWorldMatrix().Raw, 16 * sizeof(float)) == 0);
+				}
+			}
+
+			FURY_CHECK(unitIndex == batch.first + batch.count);
+		}
+
+		FURY_CHECK(next == units.size());
+		FURY_CHECK(batcher->GetIndirectBatchCount() > 0);
+		FURY_CHECK(batcher->GetMatrixCount() * 16 == batcher->Matrices.Data.size());
+		FURY_CHECK(batcher->GetCommandCount() * IndirectBatcher::COMMAND_SIZE == batcher->Commands.Data.size());
+		FURY_CHECK(batcher->GetDrawData().size() == batcher->GetCommandCount());
+	}
+
+	MeshArena::Instance().reset();
+}
+
+FURY_TEST(IndirectBatcher, Casters)
+{
+	FakeGL fakeGL;
+	MeshArena::Initialize();
+
+	{
+		BatcherScene scene;
+
+		ShadowCasters casters(4);
+		for (unsigned int group = 0; group < casters.size(); group++)
+		{
+			for (unsigned int i = 0; i < 500 * (group + 1); i++)
+			{
+				auto node = scene.CreateNode();
+				node->AddComponent(MeshRender::Create(scene.materials[0], scene.meshes[scene.random() % scene.meshes.size()]));
+				casters[group].push_back(node);
+			}
+		}
+
+		auto batcher = IndirectBatcher::Create();
+		batcher->Build(casters);
+
+		// casters draw whole meshes, grouped by list, 
+		// an indirect batch draws its list's arena casters in order.
+		unsigned int group = 0;
+		std::vector<unsigned int> drawn(casters.size(), 0);
+		for (const auto &batch : batcher->GetBatches())
+		{
+			FURY_CHECK(batch.group >= group);
+			group = batch.group;
+
+			const auto &nodes = casters[batch.group];
+			if (!batch.IsIndirect())
+			{
+				FURY_CHECK(!nodes[batch.first]->GetComponent<MeshRender>()->GetMesh()->IsInArena());
+				drawn[batch.group]++;
+				continue;
+			}
+
+			std::vector<SceneNode::Ptr> arenaNodes;
+			for (const auto &node : nodes)
+			{
+				if (node->GetComponent<MeshRender>()->GetMesh()->IsInArena())
+					arenaNodes.push_back(node);
+			}
+			FURY_CHECK(batch.count == arenaNodes.size());
+
+			unsigned int firstMatrix = batcher->GetCommand(batch.commandOffset).baseInstance;
+			for (unsigned int i = 0; i < batch.commandCount; i++)
+			{
+				auto command = batcher->GetCommand(batch.commandOffset + i);
+				for (unsigned int j = 0; j < command.instanceCount; j++)
+				{
+					const auto &node = arenaNodes[command.baseInstance + j - firstMatrix];
+					auto range = node->GetComponent<MeshRender>()->GetMesh()->GetDrawRange();
+					FURY_CHECK(command.count == range.indexCount);
+					FURY_CHECK(command.firstIndex * sizeof(unsigned short) == range.indexOffset);
+					FURY_CHECK(command.baseVertex == range.baseVertex);
+					FURY_CHECK(std::memcmp(&batcher->Matrices.Data[(command.baseInstance + j) * 16], node->GetWorldMatrix().Raw, 16 * sizeof(float)) == 0);
+				}
+				drawn[batch.group] += command.instanceCount;
+			}
+		}
+
+		for (unsigned int i = 0; i < casters.size(); i++)
+			FURY_CHECK(drawn[i] == casters[i].size());
+		FURY_CHECK(batcher->GetIndirectBatchCount() == casters.size());
+	}
+
+	MeshArena::Instance().reset();
+}
+
+FURY_TEST(IndirectBatcher, MinDraws)
+{
+	FakeGL fakeGL;
+	MeshArena::Initialize();
+
+	{
+		BatcherScene scene;
+		auto node = scene.CreateNode();
+
+		// 2 draws of one mesh share a command, the third mesh gets its own.
+		std::vector<RenderUnit> units;
+		units.push_back(RenderUnit(node, scene.meshes[1], scene.materials[0], 0));
+		units.push_back(RenderUnit(node, scene.meshes[1], scene.materials[0], 0));
+		units.push_back(RenderUnit(node, scene.meshes[2], scene.materials[0], 0));
+
+		auto batcher = IndirectBatcher::Create();
+		batcher->Build(units);
+
+		FURY_CHECK(batcher->GetBatchCount() == 1);
+		FURY_CHECK(batcher->GetCommandCount() == 2);
+		FURY_CHECK(batcher->GetCommand(0).instanceCount == 2);
+		FURY_CHECK(batcher->GetCommand(1).baseInstance == 2);
+
+		// the run gets too short.
+		batcher->SetMinDraws(4);
+		batcher->Build(units);
+
+		FURY_CHECK(batcher->GetBatchCount() == 3);
+		FURY_CHECK(batcher->GetCommandCount() == 0);
+	}
+
+	MeshArena::Instance().reset();
+}
\ No newline at end of file
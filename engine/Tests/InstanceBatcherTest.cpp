@@ -0,0 +1,110 @@
+#include <cstring>
+#include <random>
+
+#include "Fury/InstanceBatcher.h"
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Vector4.h"
+
+#include "Test.h"
+
+using namespace fury;
+
+FURY_TEST(InstanceBatcher, Runs)
+{
+	auto node = SceneNode::Create("node");
+	auto mesh0 = Mesh::Create("mesh0");
+	auto mesh1 = Mesh::Create("mesh1");
+	auto material = Material::Create("material");
+
+	// 2 plain units, 1 skinned unit, then 3 units of another mesh.
+	std::vector<RenderUnit> units;
+	units.push_back(RenderUnit(node, mesh0, material, -1));
+	units.push_back(RenderUnit(node, mesh0, material, -1));
+	units.push_back(RenderUnit(node, mesh0, material, 1));
+	units.push_back(RenderUnit(node, mesh1, material, -1));
+	units.push_back(RenderUnit(node, mesh1, material, -1));
+	units.push_back(RenderUnit(node, mesh1, material, -1));
+
+	auto batcher = InstanceBatcher::Create();
+	batcher->Build(units);
+
+	FURY_CHECK(batcher->GetBatchCount() == 3);
+	FURY_CHECK(batcher->GetInstancedBatchCount() == 2);
+	FURY_CHECK(batcher->GetInstanceCount() == 5);
+	FURY_CHECK(!batcher->GetBatches()[1].IsInstanced());
+	FURY_CHECK(batcher->GetBatches()[2].instanceOffset == 2);
+
+	// the first run gets too short.
+	batcher->SetMinInstances(3);
+	batcher->Build(units);
+
+	FURY_CHECK(batcher->GetBatchCount() == 4);
+	FURY_CHECK(batcher->GetInstancedBatchCount() == 1);
+	FURY_CHECK(batcher->GetInstanceCount() == 3);
+}
+
+FURY_TEST(InstanceBatcher, SortedQuery)
+{
+	std::mt19937 random(11);
+	auto Random = [&](float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(random);
+	};
+
+	std::vector<Material::Ptr> materials;
+	for (unsigned int i = 0; i < 8; i++)
+		materials.push_back(Material::Create("material"));
+
+	std::vector<Mesh::Ptr> meshes;
+	for (unsigned int i = 0; i < 30; i++)
+		meshes.push_back(Mesh::Create("mesh"));
+
+	const unsigned int unitCount = 5000;
+
+	RenderQuery query;
+	for (unsigned int i = 0; i < unitCount; i++)
+	{
+		auto node = SceneNode::Create("node");
+		node->SetLocalPosition(Vector4(Random(-500, 500), Random(-500, 500), Random(-500, 500)));
+		node->UpdateTransforms();
+		node->AddComponent(MeshRender::Create(materials[random() % materials.size()], meshes[random() % meshes.size()]));
+		query.AddRenderable(node);
+	}
+	query.Sort(Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+
+	auto batcher = InstanceBatcher::Create();
+	batcher->Build(query.opaqueUnits);
+
+	// batches cover all units in order, instanced ones share mesh and material, 
+	// and carry their units' world matrices.
+	unsigned int next = 0;
+	for (const auto &batch : batcher->GetBatches())
+	{
+		FURY_CHECK(batch.first == next);
+		next += batch.count;
+
+		if (!batch.IsInstanced())
+		{
+			FURY_CHECK(batch.count == 1);
+			continue;
+		}
+
+		FURY_CHECK(batch.count >= batcher->GetMinInstances());
+
+		const auto &first = query.opaqueUnits[batch.first];
+		for (unsigned int i = 0; i < batch.count; i++)
+		{
+			const auto &unit = query.opaqueUnits[batch.first + i];
+			FURY_CHECK(unit.mesh == first.mesh && unit.material == first.material);
+			FURY_CHECK(std::memcmp(&batcher->Instances.Data[(batch.instanceOffset + i) * 16], unit.node->GetWorldMatrix().Raw, 16 * sizeof(float)) == 0);
+		}
+	}
+
+	FURY_CHECK(next == unitCount);
+	FURY_CHECK(batcher->GetInstancedBatchCount() > 0);
+	FURY_CHECK(batcher->Instances.Data.size() == batcher->GetInstanceCount() * 16);
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "Fury/LinearOcTree.h"
+#include "Fury/OcTree.h"
+
+#include "TestScene.h"
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	const float extent = 100.0f;
+
+	// every other node is static, they're built into the linear tree.
+	LinearOcTree::Ptr CreateTree(TestScene &scene)
+	{
+		for (unsigned int i = 0; i < scene.sceneNodes.size(); i += 2)
+			scene.sceneNodes[i]->SetStatic(true);
+
+		auto tree = LinearOcTree::Create(Vector4(-extent), Vector4(extent), 6);
+		tree->AddSceneNodeRecursively(scene.root);
+
+		// test root is not one of the checked scenenodes.
+		tree->RemoveSceneNode(scene.root);
+		return tree;
+	}
+
+	bool IsStaticNode(const LinearOcTree::Ptr &tree, const SceneNode::Ptr &sceneNode)
+	{
+		return sceneNode->GetSceneManager() == tree.get() && sceneNode->GetOcTreeNode() == nullptr;
+	}
+
+	bool IsDynamicNode(const SceneNode::Ptr &sceneNode)
+	{
+		return sceneNode->GetSceneManager() == nullptr && sceneNode->GetOcTreeNode() != nullptr;
+	}
+}
+
+FURY_TEST(LinearOcTree, StaticDynamicSplit)
+{
+	TestScene scene(2000, extent);
+	auto infiniteNode = scene.AddInfiniteNode();
+	infiniteNode->SetStatic(true);
+	scene.Update();
+
+	auto tree = CreateTree(scene);
+
+	// infinite ones can't be sorted into the linear tree.
+	FURY_CHECK(tree->GetStaticSceneNodeCount() == 1000);
+	FURY_CHECK(tree->GetTreeNodeCount() > 1);
+	FURY_CHECK(IsDynamicNode(infiniteNode));
+
+	unsigned int wrongCount = 0;
+	for (unsigned int i = 0; i < 2000; i++)
+	{
+		const auto &sceneNode = scene.sceneNodes[i];
+		if (i % 2 == 0 ? !IsStaticNode(tree, sceneNode) : !IsDynamicNode(sceneNode))
+			wrongCount++;
+	}
+
+	FURY_CHECK(wrongCount == 0);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	// single adds go to the dynamic tree, static or not.
+	auto newNode = scene.AddNode(Vector4(1.0f), 1.0f);
+	newNode->SetStatic(true);
+	scene.Update();
+	tree->AddSceneNode(newNode);
+
+	FURY_CHECK(IsDynamicNode(newNode));
+	FURY_CHECK(tree->GetStaticSceneNodeCount() == 1000);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(LinearOcTree, RemoveUntilBuild)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+	unsigned int treeNodeCount = tree->GetTreeNodeCount();
+
+	// removed static scenenodes leave their slots empty, the tree keeps it's layout.
+	std::vector<SceneNode::Ptr> removedNodes;
+	for (unsigned int i = scene.sceneNodes.size(); i-- > 0;)
+	{
+		if (i % 5 == 0)
+		{
+			removedNodes.push_back(scene.sceneNodes[i]);
+			scene.Remove(*tree, i);
+		}
+	}
+
+	FURY_CHECK(tree->GetStaticSceneNodeCount() == 1000 - 200);
+	FURY_CHECK(tree->GetTreeNodeCount() == treeNodeCount);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	unsigned int linkedCount = 0;
+	for (const auto &sceneNode : removedNodes)
+	{
+		if (sceneNode->GetSceneManager() != nullptr || sceneNode->GetOcTreeNode() != nullptr)
+			linkedCount++;
+	}
+	FURY_CHECK(linkedCount == 0);
+
+	// rebuild drops the empty slots.
+	tree->Build();
+
+	FURY_CHECK(tree->GetStaticSceneNodeCount() == 1000 - 200);
+	FURY_CHECK(tree->GetTreeNodeCount() <= treeNodeCount);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	// existing static scenenodes are kept when more are built in.
+	TestScene moreScene(500, extent, 4321);
+	for (const auto &sceneNode : moreScene.sceneNodes)
+	{
+		sceneNode->SetStatic(true);
+		moreScene.root->RemoveChild(sceneNode);
+		scene.root->AddChild(sceneNode);
+		scene.sceneNodes.push_back(sceneNode);
+	}
+
+	scene.Update();
+	tree->AddSceneNodeRecursively(scene.root);
+	tree->RemoveSceneNode(scene.root);
+
+	FURY_CHECK(tree->GetStaticSceneNodeCount() == 1000 - 200 + 500);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(LinearOcTree, StaticNodeMoves)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+
+	// a moved static scenenode goes to the dynamic tree, and stays there after Build.
+	auto sceneNode = scene.sceneNodes[10];
+	FURY_CHECK(IsStaticNode(tree, sceneNode));
+
+	sceneNode->SetLocalPosition(sceneNode->GetLocalPosition() + Vector4(extent * 0.5f, 0.0f, 0.0f, 0.0f));
+	scene.Update();
+
+	FURY_CHECK(IsDynamicNode(sceneNode));
+	FURY_CHECK(tree->GetStaticSceneNodeCount() == 999);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	tree->Build();
+
+	FURY_CHECK(IsDynamicNode(sceneNode));
+	FURY_CHECK(tree->GetStaticSceneNodeCount() == 999);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	// removing it from the tree finds it in the dynamic one.
+	tree->RemoveSceneNode(sceneNode);
+	FURY_CHECK(sceneNode->GetOcTreeNode() == nullptr);
+}
+
+FURY_TEST(LinearOcTree, BruteForce)
+{
+	TestScene scene(3000, extent);
+	auto tree = CreateTree(scene);
+
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	// dynamic ones move every frame, a few static ones too.
+	for (unsigned int frame = 0; frame < 4; frame++)
+	{
+		scene.Move(1, 2, extent * 0.05f);
+		scene.Move(frame * 2, 50, extent * 0.2f);
+
+		FURY_CHECK(scene.Check(*tree, extent));
+	}
+
+	tree->Build();
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	for (unsigned int i = 0; i < scene.sceneNodes.size(); i += 7)
+		scene.Remove(*tree, i);
+
+	FURY_CHECK(scene.Check(*tree, extent));
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "Fury/LooseOcTree.h"
+
+#include "TestScene.h"
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	const float extent = 100.0f;
+
+	LooseOcTree::Ptr CreateTree(TestScene &scene)
+	{
+		auto tree = LooseOcTree::Create(Vector4(-extent), Vector4(extent), 6);
+		for (const auto &sceneNode : scene.sceneNodes)
+			tree->AddSceneNode(sceneNode);
+		return tree;
+	}
+}
+
+FURY_TEST(LooseOcTree, Insert)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+
+	FURY_CHECK(tree->GetSceneNodeCount() == 2000);
+	FURY_CHECK(tree->GetRootSceneNodeCount() < 100);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(LooseOcTree, Move)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+
+	// small moves mostly stay in their cell, big ones don't.
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		scene.Move(i, 3, extent * 0.01f);
+		FURY_CHECK(scene.Check(*tree, extent));
+	}
+
+	FURY_CHECK(tree->GetUpdateSkipCount() > tree->GetUpdateMoveCount());
+
+	tree->ResetStatistics();
+	scene.Move(0, 2, extent * 0.5f);
+
+	FURY_CHECK(tree->GetUpdateMoveCount() > 0);
+	FURY_CHECK(tree->GetUpdateMoveCount() + tree->GetUpdateSkipCount() == 1000);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(LooseOcTree, Remove)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+	unsigned int treeNodeCount = tree->GetTreeNodeCount();
+
+	for (unsigned int i = 0; i < scene.sceneNodes.size(); i += 3)
+		scene.Remove(*tree, i);
+
+	FURY_CHECK(tree->GetSceneNodeCount() == scene.sceneNodes.size());
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	// empty cells are freed, an empty tree is just root.
+	while (!scene.sceneNodes.empty())
+		scene.Remove(*tree, scene.sceneNodes.size() - 1);
+
+	FURY_CHECK(tree->GetSceneNodeCount() == 0);
+	FURY_CHECK(tree->GetTreeNodeCount() == 1);
+
+	// freed cells are reused.
+	TestScene newScene(2000, extent);
+	for (const auto &sceneNode : newScene.sceneNodes)
+		tree->AddSceneNode(sceneNode);
+
+	FURY_CHECK(tree->GetTreeNodeCount() <= treeNodeCount * 2);
+	FURY_CHECK(newScene.Check(*tree, extent));
+}
+
+FURY_TEST(LooseOcTree, CellsAreFreed)
+{
+	TestScene scene(0, extent);
+	auto tree = CreateTree(scene);
+
+	// a small node wandering around only keeps the cells on it's way from root.
+	auto sceneNode = scene.AddNode(Vector4(0.0f), extent * 0.001f);
+	scene.Update();
+	tree->AddSceneNode(sceneNode);
+
+	for (unsigned int i = 0; i < 200; i++)
+	{
+		sceneNode->SetLocalPosition(Vector4(scene.Random(-extent, extent), scene.Random(-extent, extent), scene.Random(-extent, extent)));
+		scene.Update();
+
+		if (!FURY_CHECK(tree->GetTreeNodeCount() <= tree->GetMaxDepth() + 1))
+			break;
+	}
+
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(LooseOcTree, OutOfBounds)
+{
+	TestScene scene(1000, extent);
+	auto tree = CreateTree(scene);
+	unsigned int rootCount = tree->GetRootSceneNodeCount();
+
+	// out of bounds and infinite ones live in root.
+	auto farNode = scene.AddNode(Vector4(extent * 3.0f, 0.0f, 0.0f), 1.0f);
+	auto infiniteNode = scene.AddInfiniteNode();
+	scene.Update();
+
+	tree->AddSceneNode(farNode);
+	tree->AddSceneNode(infiniteNode);
+
+	FURY_CHECK(tree->GetRootSceneNodeCount() == rootCount + 2);
+	FURY_CHECK(scene.Check(*tree, extent * 4.0f));
+
+	// back in bounds, and out again.
+	farNode->SetLocalPosition(Vector4(extent * 0.5f, 0.0f, 0.0f));
+	scene.Update();
+	FURY_CHECK(tree->GetRootSceneNodeCount() == rootCount + 1);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	farNode->SetLocalPosition(Vector4(0.0f, -extent * 5.0f, 0.0f));
+	scene.Update();
+	FURY_CHECK(tree->GetRootSceneNodeCount() == rootCount + 2);
+	FURY_CHECK(scene.Check(*tree, extent * 6.0f));
+}
\ No newline at end of file
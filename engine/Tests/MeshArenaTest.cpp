@@ -0,0 +1,102 @@
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Fury/MeshArena.h"
+
+#include "FakeGL.h"
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	struct ArenaMesh
+	{
+		unsigned int vertices;
+
+		unsigned int indices;
+
+		std::vector<unsigned char> vertexData;
+
+		std::vector<unsigned int> indexData;
+	};
+
+	// meshes read back from the arena's buffers match what was uploaded.
+	bool IsIntact(const MeshArena::Ptr &arena, const std::vector<ArenaMesh> &meshes)
+	{
+		unsigned int stride = MeshArena::GetVertexLayout().stride;
+		const auto &vertices = FakeGL::Buffers[FakeGL::ArrayBuffer];
+		const auto &indices = FakeGL::Buffers[FakeGL::Bindings[GL_ELEMENT_ARRAY_BUFFER]];
+
+		if (vertices.size() != arena->GetVertexCapacity() * stride || 
+			indices.size() != arena->GetIndexCapacity() * sizeof(unsigned short))
+			return false;
+
+		for (const auto &mesh : meshes)
+		{
+			if (std::memcmp(&vertices[arena->GetBaseVertex(mesh.vertices) * stride], mesh.vertexData.data(), mesh.vertexData.size()) != 0)
+				return false;
+
+			const unsigned short *data = (const unsigned short*)&indices[arena->GetIndexOffset(mesh.indices)];
+			for (unsigned int i = 0; i < mesh.indexData.size(); i++)
+			{
+				if (data[i] != mesh.indexData[i])
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+FURY_TEST(MeshArena, UploadsSurviveRelocation)
+{
+	FakeGL fakeGL;
+
+	// more than the default capacity, so the arena fragments, defragments and grows along the way.
+	auto arena = MeshArena::Initialize();
+	unsigned int stride = MeshArena::GetVertexLayout().stride;
+
+	std::srand(3);
+	std::vector<ArenaMesh> meshes;
+	for (unsigned int step = 0; step < 3000; step++)
+	{
+		if (!meshes.empty() && std::rand() % 3 == 0)
+		{
+			unsigned int index = std::rand() % meshes.size();
+			MeshArena::FreeVertices(meshes[index].vertices);
+			MeshArena::FreeIndices(meshes[index].indices);
+			meshes.erase(meshes.begin() + index);
+			continue;
+		}
+
+		ArenaMesh mesh;
+		unsigned int vertexCount = 1 + std::rand() % 200;
+		mesh.vertexData.resize(vertexCount * stride);
+		for (auto &value : mesh.vertexData)
+			value = (unsigned char)std::rand();
+		mesh.indexData.resize(3 * (1 + std::rand() % 300));
+		for (auto &value : mesh.indexData)
+			value = std::rand() % vertexCount;
+
+		mesh.vertices = arena->AllocateVertices(mesh.vertexData);
+		mesh.indices = arena->AllocateIndices(mesh.indexData);
+		FURY_CHECK(mesh.vertices != MeshArena::INVALID && mesh.indices != MeshArena::INVALID);
+		meshes.push_back(mesh);
+	}
+
+	FURY_CHECK(arena->GetDefragmentCount() > 0);
+	FURY_CHECK(arena->GetVertexCapacity() > MeshArena::DEFAULT_VERTEX_COUNT);
+	FURY_CHECK(IsIntact(arena, meshes));
+
+	arena->Defragment();
+	FURY_CHECK(IsIntact(arena, meshes));
+
+	// old buffers are deleted after each relocation.
+	FURY_CHECK(FakeGL::Buffers.size() == 2);
+
+	arena.reset();
+	MeshArena::Instance().reset();
+	FURY_CHECK(FakeGL::Buffers.empty());
+}
\ No newline at end of file
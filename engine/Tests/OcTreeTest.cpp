@@ -0,0 +1,225 @@
+#include <algorithm>
+
+#include "Fury/OcTree.h"
+
+#include "TestScene.h"
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	const float extent = 100.0f;
+
+	// bounds leave room around the scene, so only the tests that want it grow the tree.
+	OcTree::Ptr CreateTree(TestScene &scene)
+	{
+		auto tree = OcTree::Create(Vector4(-extent * 2.0f), Vector4(extent * 2.0f), 6);
+		for (const auto &sceneNode : scene.sceneNodes)
+			tree->AddSceneNode(sceneNode);
+		return tree;
+	}
+
+	unsigned int GetSceneNodeCount(const OcTree &tree)
+	{
+		unsigned int count = 0;
+		tree.WalkSceneFast(BoxBounds(Vector4(-extent * 1000.0f), Vector4(extent * 1000.0f)), [&](const SceneNode::Ptr &)
+		{
+			count++;
+		});
+		return count;
+	}
+
+	// WalkSceneFast gives each visible scenenode exactly once.
+	bool CheckFast(const OcTree &tree, const TestScene &scene, const Collidable &collider)
+	{
+		std::vector<SceneNode*> expected;
+		for (const auto &sceneNode : scene.sceneNodes)
+		{
+			if (collider.IsInsideFast(sceneNode->GetWorldAABB()))
+				expected.push_back(sceneNode.get());
+		}
+
+		std::vector<SceneNode*> walked;
+		tree.WalkSceneFast(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			walked.push_back(sceneNode.get());
+		});
+
+		std::sort(expected.begin(), expected.end());
+		std::sort(walked.begin(), walked.end());
+		return FURY_CHECK(walked == expected);
+	}
+}
+
+FURY_TEST(OcTree, Insert)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+
+	FURY_CHECK(GetSceneNodeCount(*tree) == 2000);
+	FURY_CHECK(tree->GetGrowCount() == 0);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(OcTree, WalkSceneFast)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+
+	for (const auto &frustum : scene.GetFrustums(extent))
+		CheckFast(*tree, scene, frustum);
+
+	for (const auto &box : scene.GetBoxes(extent))
+		CheckFast(*tree, scene, box);
+}
+
+FURY_TEST(OcTree, PlaneCulling)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+	auto frustums = scene.GetFrustums(extent);
+
+	// childs skip planes their parent is inside, so it's less than testing each scenenode.
+	tree->ResetStatistics();
+	CheckFast(*tree, scene, frustums[0]);
+	FURY_CHECK(tree->GetPlaneTestCount() > 0);
+	FURY_CHECK(tree->GetPlaneTestCount() < 6 * scene.sceneNodes.size());
+
+	// the same frustum again rejects tree nodes with the plane that rejected them last time.
+	tree->ResetStatistics();
+	CheckFast(*tree, scene, frustums[0]);
+	FURY_CHECK(tree->GetPlaneCacheHitCount() > 0);
+
+	// a cached plane from another frustum doesn't change the result.
+	for (unsigned int i = 0; i < 2; i++)
+	{
+		for (const auto &frustum : frustums)
+			CheckFast(*tree, scene, frustum);
+	}
+}
+
+FURY_TEST(OcTree, Update)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+
+	// small moves mostly stay in their tree node, big ones don't.
+	tree->ResetStatistics();
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		scene.Move(i, 3, extent * 0.01f);
+		FURY_CHECK(scene.Check(*tree, extent));
+	}
+
+	FURY_CHECK(tree->GetUpdateSkipCount() > tree->GetUpdateMoveCount());
+
+	tree->ResetStatistics();
+	scene.Move(0, 2, extent * 0.5f);
+
+	FURY_CHECK(tree->GetUpdateMoveCount() > 0);
+	FURY_CHECK(tree->GetUpdateMoveCount() + tree->GetUpdateSkipCount() == 1000);
+	FURY_CHECK(scene.Check(*tree, extent * 2.0f));
+}
+
+FURY_TEST(OcTree, Remove)
+{
+	TestScene scene(2000, extent);
+	auto tree = CreateTree(scene);
+
+	for (unsigned int i = 0; i < scene.sceneNodes.size(); i += 3)
+		scene.Remove(*tree, i);
+
+	FURY_CHECK(GetSceneNodeCount(*tree) == scene.sceneNodes.size());
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(OcTree, Grow)
+{
+	TestScene scene(1000, extent);
+	auto tree = CreateTree(scene);
+	unsigned int maxDepth = tree->GetMaxDepth();
+
+	// added out of bounds, root grows towards it.
+	auto farNode = scene.AddNode(Vector4(extent * 6.0f, 0.0f, 0.0f), 1.0f);
+	scene.Update();
+	tree->AddSceneNode(farNode);
+
+	FURY_CHECK(tree->GetGrowCount() > 0);
+	FURY_CHECK(tree->GetMaxDepth() > maxDepth);
+	FURY_CHECK(tree->GetOutOfBoundsSceneNodeCount() == 0);
+	FURY_CHECK(scene.Check(*tree, extent * 8.0f));
+
+	// moved out of the grown bounds, it's added again from the new root.
+	unsigned int growCount = tree->GetGrowCount();
+	scene.sceneNodes[0]->SetLocalPosition(Vector4(0.0f, -extent * 20.0f, 0.0f));
+	scene.Update();
+
+	FURY_CHECK(tree->GetGrowCount() > growCount);
+	FURY_CHECK(tree->GetOutOfBoundsSceneNodeCount() == 0);
+	FURY_CHECK(tree->GetBounds().IsInside(scene.sceneNodes[0]->GetWorldAABB()) == Side::IN);
+	FURY_CHECK(scene.Check(*tree, extent * 24.0f));
+}
+
+FURY_TEST(OcTree, Shrink)
+{
+	TestScene scene(1000, extent);
+	auto tree = CreateTree(scene);
+	BoxBounds bounds = tree->GetBounds();
+	unsigned int maxDepth = tree->GetMaxDepth();
+
+	auto farNode = scene.AddNode(Vector4(extent * 6.0f, extent * 6.0f, 0.0f), 1.0f);
+	scene.Update();
+	tree->AddSceneNode(farNode);
+	FURY_CHECK(tree->GetBounds() != bounds);
+
+	// without the far node, root collapses back to where it was.
+	scene.Remove(*tree, scene.sceneNodes.size() - 1);
+	tree->Shrink();
+
+	FURY_CHECK(tree->GetShrinkCount() > 0);
+	FURY_CHECK(tree->GetBounds() == bounds);
+	FURY_CHECK(tree->GetMaxDepth() == maxDepth);
+	FURY_CHECK(scene.Check(*tree, extent));
+
+	// an empty tree goes back to base bounds on next add.
+	auto newNode = scene.AddNode(Vector4(extent * 6.0f), 1.0f);
+	scene.Update();
+	tree->AddSceneNode(newNode);
+
+	while (!scene.sceneNodes.empty())
+		scene.Remove(*tree, scene.sceneNodes.size() - 1);
+
+	auto lastNode = scene.AddNode(Vector4(0.0f), 1.0f);
+	scene.Update();
+	tree->AddSceneNode(lastNode);
+
+	FURY_CHECK(tree->GetBounds() == bounds);
+	FURY_CHECK(tree->GetMaxDepth() == maxDepth);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
+
+FURY_TEST(OcTree, NoAutoResize)
+{
+	TestScene scene(1000, extent);
+	auto tree = CreateTree(scene);
+	tree->SetAutoResize(false);
+	BoxBounds bounds = tree->GetBounds();
+
+	// out of bounds ones stay in root, they're still found.
+	auto farNode = scene.AddNode(Vector4(extent * 6.0f, 0.0f, 0.0f), 1.0f);
+	auto infiniteNode = scene.AddInfiniteNode();
+	scene.Update();
+
+	tree->AddSceneNode(farNode);
+	tree->AddSceneNode(infiniteNode);
+
+	FURY_CHECK(tree->GetBounds() == bounds);
+	FURY_CHECK(tree->GetOutOfBoundsSceneNodeCount() == 2);
+	FURY_CHECK(scene.Check(*tree, extent * 8.0f));
+
+	farNode->SetLocalPosition(Vector4(extent * 0.5f, 0.0f, 0.0f));
+	scene.Update();
+	FURY_CHECK(tree->GetOutOfBoundsSceneNodeCount() == 1);
+	FURY_CHECK(scene.Check(*tree, extent));
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <random>
+
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/OcTree.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+
+#include "TestScene.h"
+#include "Test.h"
+#include "WorkerScope.h"
+
+using namespace fury;
+
+namespace
+{
+	class SortableRenderQuery : public RenderQuery
+	{
+	public:
+
+		using RenderQuery::SortEntry;
+
+		using RenderQuery::RadixSort;
+	};
+
+	typedef SortableRenderQuery::SortEntry SortEntry;
+
+	// entry's second is it's index, so a stable sort keeps ties in index order.
+	std::vector<SortEntry> CreateEntries(const std::vector<unsigned long long> &keys)
+	{
+		std::vector<SortEntry> entries;
+		for (unsigned int i = 0; i < keys.size(); i++)
+			entries.push_back(SortEntry(keys[i], i));
+		return entries;
+	}
+
+	bool SameUnits(const std::vector<RenderUnit> &a, const std::vector<RenderUnit> &b)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (unsigned int i = 0; i < a.size(); i++)
+		{
+			if (a[i].node != b[i].node || a[i].mesh != b[i].mesh || a[i].material != b[i].material || 
+				a[i].subMesh != b[i].subMesh || a[i].sortKey != b[i].sortKey)
+				return false;
+		}
+		return true;
+	}
+
+	bool CheckSort(const std::vector<unsigned long long> &keys)
+	{
+		auto expected = CreateEntries(keys);
+		std::stable_sort(expected.begin(), expected.end(), [](const SortEntry &a, const SortEntry &b)
+		{
+			return a.first < b.first;
+		});
+
+		auto sorted = CreateEntries(keys);
+		SortableRenderQuery::RadixSort(sorted);
+
+		return FURY_CHECK(sorted == expected);
+	}
+}
+
+FURY_TEST(RenderQuery, RadixSortRandomKeys)
+{
+	std::mt19937_64 random(1234);
+
+	std::vector<unsigned long long> keys;
+	for (unsigned int i = 0; i < 5000; i++)
+		keys.push_back(random());
+
+	CheckSort(keys);
+}
+
+FURY_TEST(RenderQuery, RadixSortTies)
+{
+	std::mt19937_64 random(1234);
+
+	// few distinct keys, most of them only differ in high bytes.
+	std::vector<unsigned long long> values;
+	for (unsigned int i = 0; i < 8; i++)
+		values.push_back((unsigned long long)(i * 37 % 8) << 56 | (unsigned long long)(i % 2) << 40 | 0x55);
+
+	std::vector<unsigned long long> keys;
+	for (unsigned int i = 0; i < 5000; i++)
+		keys.push_back(values[random() % values.size()]);
+
+	CheckSort(keys);
+}
+
+FURY_TEST(RenderQuery, RadixSortHighBytes)
+{
+	// the same low bytes everywhere, so only the top passes move anything.
+	std::vector<unsigned long long> keys;
+	for (unsigned int i = 0; i < 1000; i++)
+		keys.push_back((unsigned long long)((i * 7919) % 1000) << 48 | 0xFFFFFFull);
+
+	keys.push_back(~0ull);
+	keys.push_back(1ull << 63);
+	keys.push_back(0);
+
+	CheckSort(keys);
+}
+
+FURY_TEST(RenderQuery, RadixSortSameKeys)
+{
+	CheckSort(std::vector<unsigned long long>(100, 0x0123456789ABCDEFull));
+	CheckSort(std::vector<unsigned long long>(1, 42));
+	CheckSort(std::vector<unsigned long long>());
+}
+
+FURY_TEST(RenderQuery, GetRenderQuery)
+{
+	// chunks are only built in parallel with workers.
+	WorkerScope scope(1);
+
+	const float extent = 100.0f;
+	TestScene scene(8000, extent);
+
+	std::vector<Material::Ptr> materials;
+	std::vector<Mesh::Ptr> meshes;
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		materials.push_back(Material::Create("material"));
+		meshes.push_back(Mesh::Create("mesh"));
+	}
+
+	// a MeshRender whose mesh is gone isn't renderable.
+	auto expiredMesh = Mesh::Create("expired_mesh");
+
+	auto tree = OcTree::Create(Vector4(-extent * 2.0f), Vector4(extent * 2.0f), 6);
+	for (unsigned int i = 0; i < scene.sceneNodes.size(); i++)
+	{
+		auto &sceneNode = scene.sceneNodes[i];
+		if (i % 7 == 0)
+			sceneNode->AddComponent(MeshRender::Create(materials[0], expiredMesh));
+		else if (i % 5 != 0)
+			sceneNode->AddComponent(MeshRender::Create(materials[i % 3], meshes[i % 2]));
+
+		tree->AddSceneNode(sceneNode);
+	}
+	expiredMesh.reset();
+
+	BoxBounds box(Vector4(-extent * 0.8f), Vector4(extent * 0.8f));
+
+	auto query = RenderQuery::Create();
+	tree->GetRenderQuery(box, query);
+
+	unsigned int expectedCount = 0;
+	for (unsigned int i = 0; i < scene.sceneNodes.size(); i++)
+	{
+		if (i % 7 != 0 && i % 5 != 0 && box.IsInsideFast(scene.sceneNodes[i]->GetWorldAABB()))
+			expectedCount++;
+	}
+
+	FURY_CHECK(query->renderableNodes.size() == expectedCount);
+
+	// units built in chunks from the walk's MeshRenders match the ones built one by one.
+	RenderQuery serialQuery;
+	for (const auto &sceneNode : query->renderableNodes)
+		serialQuery.AddRenderable(sceneNode);
+
+	FURY_CHECK(query->renderableNodes.size() > RenderQuery::GRAIN_SIZE * 2);
+	FURY_CHECK(SameUnits(query->opaqueUnits, serialQuery.opaqueUnits));
+	FURY_CHECK(SameUnits(query->transparentUnits, serialQuery.transparentUnits));
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <thread>
+
+#include "Fury/Log.h"
+#include "Fury/ThreadUtil.h"
+
+#include "Test.h"
+
+namespace fury
+{
+	unsigned int Test::m_FailureCount = 0;
+
+	std::vector<Test::Entry> &Test::GetEntries()
+	{
+		// function local, so registering from other files' static init is safe.
+		static std::vector<Entry> entries;
+		return entries;
+	}
+
+	bool Test::Register(const std::string &suite, const std::string &name, const Func &func)
+	{
+		Entry entry;
+		entry.suite = suite;
+		entry.name = name;
+		entry.func = func;
+		GetEntries().push_back(entry);
+		return true;
+	}
+
+	bool Test::Check(bool condition, const char *expression, const char *file, int line)
+	{
+		if (!condition)
+		{
+			FURYE << file << "(" << line << "): check failed: " << expression;
+			m_FailureCount++;
+		}
+		return condition;
+	}
+
+	unsigned int Test::GetFailureCount()
+	{
+		return m_FailureCount;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	using namespace fury;
+
+	Log<0>::Initialize(LogLevel::INFO, nullptr, true, Formatter::Simple, false);
+
+	// parallel paths are taken with any worker, ThreadUtil can't log a warning before it exists, 
+	// so stay under hardware threads.
+	unsigned int threadCount = std::thread::hardware_concurrency();
+	ThreadUtil::Initialize(threadCount > 2 ? 2 : threadCount / 2);
+	ThreadUtil::Instance()->SetMainThread();
+
+	unsigned int runCount = 0;
+	for (const auto &entry : Test::GetEntries())
+	{
+		bool selected = argc < 2;
+		for (int i = 1; i < argc && !selected; i++)
+			selected = entry.suite == argv[i];
+
+		if (!selected)
+			continue;
+
+		unsigned int failureCount = Test::GetFailureCount();
+		entry.func();
+		runCount++;
+
+		// braces keep else away from the if inside log macros.
+		if (Test::GetFailureCount() != failureCount)
+		{
+			FURYE << entry.suite << "." << entry.name << " failed.";
+		}
+		else
+		{
+			FURYI << entry.suite << "." << entry.name << " passed.";
+		}
+	}
+
+	if (runCount == 0)
+	{
+		FURYE << "No test matches.";
+		return 1;
+	}
+
+	return Test::GetFailureCount() == 0 ? 0 : 1;
+}
\ No newline at end of file
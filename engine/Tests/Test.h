@@ -0,0 +1,55 @@
+#ifndef _FURY_TEST_H_
+#define _FURY_TEST_H_
+
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fury
+{
+	// Tests register themselves with FURY_TEST(suite, name),
+	// furytest runs all suites, or only the ones named in command line.
+	// Tests run without a gl context, failed checks are logged and the test goes on.
+	class Test
+	{
+	public:
+
+		typedef std::function<void()> Func;
+
+		struct Entry
+		{
+			std::string suite;
+
+			std::string name;
+
+			Func func;
+		};
+
+		static std::vector<Entry> &GetEntries();
+
+		static bool Register(const std::string &suite, const std::string &name, const Func &func);
+
+		// returns condition, logs a failure if it's false.
+		static bool Check(bool condition, const char *expression, const char *file, int line);
+
+		static unsigned int GetFailureCount();
+
+	protected:
+
+		static unsigned int m_FailureCount;
+	};
+}
+
+#define FURY_TEST(suite, name) \
+	static void suite##name##Test(); \
+	static bool suite##name##Registered = fury::Test::Register(#suite, #name, suite##name##Test); \
+	static void suite##name##Test()
+
+#define FURY_CHECK(condition) \
+	fury::Test::Check((condition), #condition, __FILE__, __LINE__)
+
+#define FURY_CHECK_NEAR(value, expected, epsilon) \
+	fury::Test::Check(std::fabs((value) - (expected)) <= (epsilon), #value " near " #expected, __FILE__, __LINE__)
+
+#endif // _FURY_TEST_H_
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Fury/Log.h"
+#include "Fury/MathUtil.h"
+#include "Fury/Matrix4.h"
+
+#include "TestScene.h"
+
+namespace fury
+{
+	namespace
+	{
+		std::vector<SceneNode*> Sorted(const std::vector<SceneNode::Ptr> &sceneNodes)
+		{
+			std::vector<SceneNode*> result;
+			for (const auto &sceneNode : sceneNodes)
+				result.push_back(sceneNode.get());
+
+			std::sort(result.begin(), result.end());
+			return result;
+		}
+	}
+
+	TestScene::TestScene(unsigned int nodeCount, float extent, unsigned int seed) : random(seed)
+	{
+		root = SceneNode::Create("test_root");
+
+		for (unsigned int i = 0; i < nodeCount; i++)
+		{
+			Vector4 position(Random(-extent, extent), Random(-extent, extent), Random(-extent, extent));
+			float size = i % 20 == 0 ? Random(0.05f, 0.2f) * extent : Random(0.001f, 0.01f) * extent;
+			AddNode(position, size);
+		}
+
+		Update();
+	}
+
+	float TestScene::Random(float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(random);
+	}
+
+	SceneNode::Ptr TestScene::AddNode(Vector4 position, float size)
+	{
+		auto sceneNode = SceneNode::Create("test_node");
+		sceneNode->SetModelAABB(BoxBounds(Vector4(-size), Vector4(size)));
+		sceneNode->SetLocalPosition(position);
+		root->AddChild(sceneNode);
+
+		sceneNodes.push_back(sceneNode);
+		return sceneNode;
+	}
+
+	SceneNode::Ptr TestScene::AddInfiniteNode()
+	{
+		BoxBounds aabb;
+		aabb.SetInfinite(true);
+
+		auto sceneNode = SceneNode::Create("test_infinite_node");
+		sceneNode->SetModelAABB(aabb);
+		root->AddChild(sceneNode);
+
+		sceneNodes.push_back(sceneNode);
+		return sceneNode;
+	}
+
+	void TestScene::Move(unsigned int first, unsigned int step, float distance)
+	{
+		for (unsigned int i = first; i < sceneNodes.size(); i += step)
+		{
+			auto &sceneNode = sceneNodes[i];
+			Vector4 offset(Random(-distance, distance), Random(-distance, distance), Random(-distance, distance), 0.0f);
+			sceneNode->SetLocalPosition(sceneNode->GetLocalPosition() + offset);
+		}
+
+		Update();
+	}
+
+	void TestScene::Update()
+	{
+		root->UpdateTransforms();
+	}
+
+	void TestScene::Remove(SceneManager &manager, unsigned int index)
+	{
+		auto sceneNode = sceneNodes[index];
+		manager.RemoveSceneNode(sceneNode);
+		sceneNode->RemoveFromParent();
+
+		sceneNodes.erase(sceneNodes.begin() + index);
+	}
+
+	std::vector<Frustum> TestScene::GetFrustums(float extent) const
+	{
+		std::vector<Frustum> frustums;
+
+		// from outside each side looking in, and from the center looking out.
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			float angle = i * 0.7854f;
+			float distance = i % 2 == 0 ? extent * 1.5f : 0.0f;
+
+			Frustum frustum;
+			frustum.Setup(1.0f, 16.0f / 9.0f, 0.1f, extent * 2.0f);
+
+			Matrix4 matrix;
+			matrix.AppendTranslation(Vector4(std::sin(angle) * distance, extent * 0.1f, std::cos(angle) * distance));
+			matrix.AppendRotation(MathUtil::EulerRadToQuat(angle, -0.1f, 0.0f));
+			frustum.Transform(matrix);
+
+			frustums.push_back(frustum);
+		}
+
+		return frustums;
+	}
+
+	std::vector<BoxBounds> TestScene::GetBoxes(float extent)
+	{
+		std::vector<BoxBounds> boxes;
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			Vector4 center(Random(-extent, extent), Random(-extent, extent), Random(-extent, extent));
+			Vector4 size(Random(0.05f, 0.5f) * extent);
+			size.w = 0.0f;
+			boxes.push_back(BoxBounds(center - size, center + size));
+		}
+
+		// everything
+		boxes.push_back(BoxBounds(Vector4(-extent * 100.0f), Vector4(extent * 100.0f)));
+		return boxes;
+	}
+
+	bool TestScene::Check(const SceneManager &manager, float extent)
+	{
+		bool passed = true;
+
+		for (const auto &frustum : GetFrustums(extent))
+			passed = Check(manager, frustum) && passed;
+
+		for (const auto &box : GetBoxes(extent))
+			passed = Check(manager, box) && passed;
+
+		return passed;
+	}
+
+	bool TestScene::Check(const SceneManager &manager, const Collidable &collider) const
+	{
+		std::vector<SceneNode::Ptr> expected;
+		for (const auto &sceneNode : sceneNodes)
+		{
+			if (collider.IsInsideFast(sceneNode->GetWorldAABB()))
+				expected.push_back(sceneNode);
+		}
+
+		std::vector<SceneNode::Ptr> walked;
+		manager.WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			walked.push_back(sceneNode);
+		});
+
+		std::vector<SceneNode::Ptr> visible;
+		manager.GetVisibleSceneNodes(collider, visible);
+
+		auto expectedNodes = Sorted(expected);
+		if (Sorted(walked) == expectedNodes && Sorted(visible) == expectedNodes)
+			return true;
+
+		FURYE << "expected " << expected.size() << " scenenodes, WalkScene found " << walked.size() 
+			<< ", GetVisibleSceneNodes found " << visible.size();
+		return false;
+	}
+}
\ No newline at end of file
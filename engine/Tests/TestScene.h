@@ -0,0 +1,57 @@
+#ifndef _FURY_TEST_SCENE_H_
+#define _FURY_TEST_SCENE_H_
+
+#include <random>
+#include <vector>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/Frustum.h"
+#include "Fury/SceneManager.h"
+#include "Fury/SceneNode.h"
+
+namespace fury
+{
+	// Random scenenodes under one root, for checking scene managers against a brute force scan.
+	// Nodes are added to the manager by the tests, moving them goes through UpdateTransforms 
+	// like in a real frame, so attached managers get UpdateSceneNode calls.
+	class TestScene
+	{
+	public:
+
+		SceneNode::Ptr root;
+
+		std::vector<SceneNode::Ptr> sceneNodes;
+
+		std::mt19937 random;
+
+		// nodeCount nodes centered in [-extent, extent], 1 in 20 is a big one.
+		TestScene(unsigned int nodeCount, float extent, unsigned int seed = 1234);
+
+		float Random(float min, float max);
+
+		SceneNode::Ptr AddNode(Vector4 position, float size);
+
+		// node with infinite aabb, visible from everywhere.
+		SceneNode::Ptr AddInfiniteNode();
+
+		// moves every step-th node by up to distance on each axis.
+		void Move(unsigned int first, unsigned int step, float distance);
+
+		void Update();
+
+		// removes the node from the scene and the manager.
+		void Remove(SceneManager &manager, unsigned int index);
+
+		// frustums looking at the scene from it's sides and center, and boxes around it.
+		std::vector<Frustum> GetFrustums(float extent) const;
+
+		std::vector<BoxBounds> GetBoxes(float extent);
+
+		// WalkScene and GetVisibleSceneNodes give the same nodes as the scan, for every frustum and box.
+		bool Check(const SceneManager &manager, float extent);
+
+		bool Check(const SceneManager &manager, const Collidable &collider) const;
+	};
+}
+
+#endif // _FURY_TEST_SCENE_H_
\ No newline at end of file
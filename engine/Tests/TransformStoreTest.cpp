@@ -0,0 +1,147 @@
+#include "Fury/Matrix4.h"
+#include "Fury/Scene.h"
+#include "Fury/SceneNode.h"
+#include "Fury/TransformStore.h"
+#include "Fury/Vector4.h"
+
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	// scene root -> group (store root) -> child -> grandchild, translations only.
+	class StoreScene
+	{
+	public:
+
+		Scene::Ptr scene;
+
+		SceneNode::Ptr group, child, grandchild;
+
+		TransformStore::Ptr store;
+
+		StoreScene()
+		{
+			scene = Scene::Create("test_scene", "");
+
+			group = SceneNode::Create("group");
+			child = SceneNode::Create("child");
+			grandchild = SceneNode::Create("grandchild");
+
+			scene->GetRootNode()->AddChild(group);
+			group->AddChild(child);
+			child->AddChild(grandchild);
+
+			group->SetLocalPosition(Vector4(1.0f, 0.0f, 0.0f));
+			child->SetLocalPosition(Vector4(0.0f, 2.0f, 0.0f));
+			grandchild->SetLocalPosition(Vector4(0.0f, 0.0f, 3.0f));
+			scene->GetRootNode()->UpdateTransforms();
+
+			store = TransformStore::Create();
+			store->Attach(group);
+		}
+
+		void Update()
+		{
+			scene->GetRootNode()->UpdateTransforms();
+		}
+	};
+
+	bool IsAt(const SceneNode::Ptr &node, Vector4 position)
+	{
+		Vector4 origin = node->GetWorldMatrix().Multiply(Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+		Vector4 invertOrigin = node->GetInvertWorldMatrix().Multiply(position);
+
+		return std::fabs(origin.x - position.x) < 1e-4f && std::fabs(origin.y - position.y) < 1e-4f &&
+			std::fabs(origin.z - position.z) < 1e-4f && std::fabs(invertOrigin.x) < 1e-4f &&
+			std::fabs(invertOrigin.y) < 1e-4f && std::fabs(invertOrigin.z) < 1e-4f;
+	}
+}
+
+FURY_TEST(TransformStore, Attach)
+{
+	StoreScene test;
+
+	FURY_CHECK(test.store->GetAttached());
+	FURY_CHECK(test.store->GetSize() == 3);
+	FURY_CHECK(test.store->GetLevelCount() == 3);
+	FURY_CHECK(test.grandchild->GetTransformStore() == test.store.get());
+	FURY_CHECK(IsAt(test.grandchild, Vector4(1.0f, 2.0f, 3.0f)));
+}
+
+FURY_TEST(TransformStore, SceneNodeEditReachesSceneRootUpdate)
+{
+	StoreScene test;
+
+	test.grandchild->SetLocalPosition(Vector4(0.0f, 0.0f, 5.0f));
+	FURY_CHECK(test.grandchild->GetTransformDirty());
+	FURY_CHECK(test.scene->GetRootNode()->GetTransformDirty());
+
+	test.Update();
+
+	FURY_CHECK(!test.grandchild->GetTransformDirty());
+	FURY_CHECK(!test.scene->GetRootNode()->GetTransformDirty());
+	FURY_CHECK(IsAt(test.grandchild, Vector4(1.0f, 2.0f, 5.0f)));
+}
+
+FURY_TEST(TransformStore, StoreEditReachesSceneRootUpdate)
+{
+	StoreScene test;
+
+	// level order, child is right after group.
+	test.store->SetLocalPosition(1, Vector4(0.0f, 4.0f, 0.0f));
+	test.Update();
+
+	FURY_CHECK(IsAt(test.child, Vector4(1.0f, 4.0f, 0.0f)));
+	FURY_CHECK(IsAt(test.grandchild, Vector4(1.0f, 4.0f, 3.0f)));
+}
+
+FURY_TEST(TransformStore, ParentOutsideStoreMoves)
+{
+	StoreScene test;
+
+	auto root = test.scene->GetRootNode();
+	root->SetLocalPosition(Vector4(10.0f, 0.0f, 0.0f));
+	test.Update();
+
+	FURY_CHECK(IsAt(test.group, Vector4(11.0f, 0.0f, 0.0f)));
+	FURY_CHECK(IsAt(test.grandchild, Vector4(11.0f, 2.0f, 3.0f)));
+}
+
+FURY_TEST(TransformStore, EditsPendingAtAttach)
+{
+	StoreScene test;
+
+	test.store->Detach();
+	test.grandchild->SetLocalPosition(Vector4(0.0f, 0.0f, 7.0f));
+	test.store->Attach(test.group);
+	test.Update();
+
+	FURY_CHECK(IsAt(test.grandchild, Vector4(1.0f, 2.0f, 7.0f)));
+}
+
+FURY_TEST(TransformStore, HierarchyChangeInvalidates)
+{
+	StoreScene test;
+
+	auto other = SceneNode::Create("other");
+	test.child->AddChild(other);
+	FURY_CHECK(!test.store->GetAttached());
+	FURY_CHECK(test.grandchild->GetTransformStore() == nullptr);
+
+	// plain scenenodes again, edits go through the usual dirty flags.
+	test.grandchild->SetLocalPosition(Vector4(0.0f, 0.0f, 6.0f));
+	test.Update();
+	FURY_CHECK(IsAt(test.grandchild, Vector4(1.0f, 2.0f, 6.0f)));
+	FURY_CHECK(IsAt(other, Vector4(1.0f, 2.0f, 0.0f)));
+
+	// Update attaches the root again, new child included.
+	test.store->Update();
+	FURY_CHECK(test.store->GetAttached());
+	FURY_CHECK(test.store->GetSize() == 4);
+
+	other->SetLocalPosition(Vector4(0.0f, 0.0f, -1.0f));
+	test.Update();
+	FURY_CHECK(IsAt(other, Vector4(1.0f, 2.0f, -1.0f)));
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <cstring>
+
+#include "Fury/Camera.h"
+#include "Fury/Light.h"
+#include "Fury/Material.h"
+#include "Fury/Matrix4.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Uniform.h"
+#include "Fury/UniformBuffer.h"
+
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	template<class Type>
+	Type ReadAt(const Std140Block &block, unsigned int offset)
+	{
+		Type value;
+		std::memcpy(&value, block.GetData() + offset, sizeof(Type));
+		return value;
+	}
+}
+
+FURY_TEST(UniformBuffer, Std140Rules)
+{
+	Matrix4 matrix;
+	float array[3] = { 1.0f, 2.0f, 3.0f };
+
+	Std140Block block;
+	FURY_CHECK(block.AddFloat(1.0f) == 0);
+	FURY_CHECK(block.AddVec2(1.0f, 2.0f) == 8);
+	FURY_CHECK(block.AddFloat(1.0f) == 16);
+	// vec3 aligns to 16, a scalar may follow in its last 4 bytes.
+	FURY_CHECK(block.AddVec3(1.0f, 2.0f, 3.0f) == 32);
+	FURY_CHECK(block.AddVec2(1.0f, 2.0f) == 48);
+	FURY_CHECK(block.AddVec4(1.0f, 2.0f, 3.0f, 4.0f) == 64);
+	FURY_CHECK(block.AddInt(-1) == 80);
+	FURY_CHECK(block.AddUInt(7) == 84);
+	// array elements take 16 bytes each, the member after it starts on a new 16 bytes.
+	FURY_CHECK(block.AddFloatArray(array, 3) == 96);
+	FURY_CHECK(block.AddFloat(1.0f) == 144);
+	FURY_CHECK(block.AddMatrix(matrix) == 160);
+	FURY_CHECK(block.GetSize() == 224);
+
+	FURY_CHECK(ReadAt<float>(block, 96 + 32) == 3.0f);
+	FURY_CHECK(ReadAt<int>(block, 80) == -1);
+	FURY_CHECK(ReadAt<unsigned int>(block, 84) == 7);
+
+	// size rounds up to 16 bytes.
+	block.Clear();
+	block.AddFloat(1.0f);
+	FURY_CHECK(block.GetSize() == 16);
+}
+
+FURY_TEST(UniformBuffer, PaddingIsZeroed)
+{
+	Std140Block a, b;
+	a.AddVec3(1.0f, 2.0f, 3.0f);
+	b.AddVec3(1.0f, 2.0f, 3.0f);
+	FURY_CHECK(a == b);
+
+	// a zero in the vec3's padding doesn't change the data.
+	b.AddFloat(0.0f);
+	FURY_CHECK(a == b);
+
+	b.AddFloat(1.0f);
+	FURY_CHECK(a != b);
+}
+
+FURY_TEST(UniformBuffer, CameraBlock)
+{
+	auto camera = Camera::Create();
+	camera->PerspectiveFov(1.0f, 1.0f, 0.5f, 300.0f);
+
+	auto camNode = SceneNode::Create("camera");
+	camNode->AddComponent(camera);
+	camNode->SetLocalPosition(Vector4(1.0f, 2.0f, 3.0f));
+	camNode->UpdateTransforms();
+
+	// projection, invert view, vec3 position, far in its padding, near.
+	Std140Block block;
+	FURY_CHECK(UniformBuffer::PackCamera(camNode, block));
+	FURY_CHECK(block.GetSize() == 160);
+	FURY_CHECK(ReadAt<float>(block, 128) == 1.0f);
+	FURY_CHECK(ReadAt<float>(block, 136) == 3.0f);
+	FURY_CHECK(ReadAt<float>(block, 140) == 300.0f);
+	FURY_CHECK(ReadAt<float>(block, 144) == 0.5f);
+	FURY_CHECK(std::memcmp(block.GetData() + 64, camNode->GetInvertWorldMatrix().Raw, 64) == 0);
+
+	FURY_CHECK(!UniformBuffer::PackCamera(SceneNode::Create("empty"), block));
+}
+
+FURY_TEST(UniformBuffer, LightBlock)
+{
+	auto light = Light::Create();
+	light->SetIntensity(2.0f);
+	light->SetInnerAngle(0.25f);
+	light->SetOutterAngle(0.5f);
+	light->SetFalloff(0.75f);
+	light->SetRadius(20.0f);
+
+	auto lightNode = SceneNode::Create("light");
+	lightNode->AddComponent(light);
+	lightNode->SetLocalPosition(Vector4(4.0f, 5.0f, 6.0f));
+	lightNode->UpdateTransforms();
+
+	// three vec3s, each with a scalar in its padding, then falloff and radius.
+	Std140Block block;
+	FURY_CHECK(UniformBuffer::PackLight(lightNode, block));
+	FURY_CHECK(block.GetSize() == 64);
+	FURY_CHECK(ReadAt<float>(block, 0) == 4.0f);
+	FURY_CHECK(ReadAt<float>(block, 12) == 2.0f);
+	FURY_CHECK_NEAR(ReadAt<float>(block, 20), -1.0f, 1e-6f);
+	FURY_CHECK(ReadAt<float>(block, 28) == 0.25f);
+	FURY_CHECK(ReadAt<float>(block, 44) == 0.5f);
+	FURY_CHECK(ReadAt<float>(block, 48) == 0.75f);
+	FURY_CHECK(ReadAt<float>(block, 52) == 20.0f);
+}
+
+FURY_TEST(UniformBuffer, MaterialBlock)
+{
+	auto material = Material::Create("material");
+	material->SetUniform(Material::DIFFUSE_FACTOR, Uniform1f::Create({ 0.5f }));
+	material->SetUniform(Material::DIFFUSE_COLOR, Uniform3f::Create({ 0.1f, 0.2f, 0.3f }));
+
+	// four vec3 colors with their factors, shininess, transparency, id.
+	const auto &block = material->GetUniformBlock();
+	FURY_CHECK(block.GetSize() == 80);
+	FURY_CHECK(ReadAt<float>(block, 12) == 1.0f);
+	FURY_CHECK(ReadAt<float>(block, 20) == 0.2f);
+	FURY_CHECK(ReadAt<float>(block, 28) == 0.5f);
+	FURY_CHECK(ReadAt<unsigned int>(block, 72) == material->GetID());
+
+	// repacked after a change.
+	material->SetUniform(Material::DIFFUSE_FACTOR, Uniform1f::Create({ 0.25f }));
+	FURY_CHECK(ReadAt<float>(material->GetUniformBlock(), 28) == 0.25f);
+
+	// and after changing the value in place.
+	auto factor = std::static_pointer_cast<Uniform1f>(material->GetUniform(Material::DIFFUSE_FACTOR));
+	factor->SetData({ 0.125f });
+	FURY_CHECK(ReadAt<float>(material->GetUniformBlock(), 28) == 0.125f);
+}
\ No newline at end of file
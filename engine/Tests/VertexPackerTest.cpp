@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include "Fury/Mesh.h"
+#include "Fury/VertexPacker.h"
+
+#include "Test.h"
+
+using namespace fury;
+
+namespace
+{
+	// angle between two unit vectors, in radians.
+	double GetAngle(const float *a, const float *b)
+	{
+		double dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+		return std::acos(std::min(dot, 1.0));
+	}
+
+	double RoundTripOctahedral(const float *normal)
+	{
+		short u, v;
+		float decoded[3];
+		VertexPacker::EncodeOctahedral(normal[0], normal[1], normal[2], u, v);
+		VertexPacker::DecodeOctahedral(u, v, decoded[0], decoded[1], decoded[2]);
+		return GetAngle(normal, decoded);
+	}
+}
+
+// bounds are the errors measured when the formats were added, 6.9e-4 rad is rounded up.
+
+FURY_TEST(VertexPacker, OctahedralNormals)
+{
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	double maxError = 0.0;
+	for (unsigned int i = 0; i < 200000; i++)
+	{
+		float normal[3] = { distribution(random), distribution(random), distribution(random) };
+		float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (length < 1e-3f)
+			continue;
+
+		for (auto &value : normal)
+			value /= length;
+
+		maxError = std::max(maxError, RoundTripOctahedral(normal));
+	}
+
+	// axes hit the octahedron's corners and the folded lower half.
+	const float axes[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+	for (const auto &axis : axes)
+		maxError = std::max(maxError, RoundTripOctahedral(axis));
+
+	FURY_CHECK(maxError <= 7e-4);
+}
+
+FURY_TEST(VertexPacker, HalfFloatUVs)
+{
+	std::mt19937 random(2);
+	std::uniform_real_distribution<float> distribution(-8.0f, 8.0f);
+
+	double maxError = 0.0;
+	for (unsigned int i = 0; i < 100000; i++)
+	{
+		float value = distribution(random);
+		if (std::fabs(value) < 1e-3f)
+			continue;
+
+		float decoded = VertexPacker::HalfToFloat(VertexPacker::FloatToHalf(value));
+		maxError = std::max(maxError, std::fabs((double)decoded - value) / std::fabs(value));
+	}
+
+	FURY_CHECK(maxError <= 4.9e-4);
+
+	// exact values and overflow.
+	FURY_CHECK(VertexPacker::HalfToFloat(VertexPacker::FloatToHalf(0.0f)) == 0.0f);
+	FURY_CHECK(VertexPacker::HalfToFloat(VertexPacker::FloatToHalf(1.0f)) == 1.0f);
+	FURY_CHECK(VertexPacker::HalfToFloat(VertexPacker::FloatToHalf(-2.5f)) == -2.5f);
+	FURY_CHECK(std::isinf(VertexPacker::HalfToFloat(VertexPacker::FloatToHalf(1e6f))));
+}
+
+FURY_TEST(VertexPacker, PackedMesh)
+{
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	// a flat box, so each axis gets its own scale.
+	const unsigned int vertexCount = 1000;
+	auto mesh = Mesh::Create("mesh");
+	for (unsigned int i = 0; i < vertexCount; i++)
+	{
+		mesh->Positions.Data.push_back(distribution(random) * 50.0f);
+		mesh->Positions.Data.push_back(distribution(random) * 3.0f + 10.0f);
+		mesh->Positions.Data.push_back(distribution(random) * 0.5f);
+
+		float normal[3] = { distribution(random), distribution(random), distribution(random) + 2.0f };
+		float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		for (auto value : normal)
+			mesh->Normals.Data.push_back(value / length);
+
+		mesh->UVs.Data.push_back(distribution(random) * 0.5f + 0.5f);
+		mesh->UVs.Data.push_back(distribution(random) * 0.5f + 0.5f);
+	}
+
+	for (auto format : { VertexFormat::INTERLEAVED, VertexFormat::QUANTIZED })
+	{
+		std::vector<unsigned char> output;
+		VertexLayout layout = VertexPacker::Pack(*mesh, format, output);
+
+		FURY_CHECK(layout.quantized == (format == VertexFormat::QUANTIZED));
+		FURY_CHECK(layout.stride == (layout.quantized ? 16u : 20u));
+		FURY_CHECK(output.size() == vertexCount * layout.stride);
+
+		double positionError[3] = { 0.0, 0.0, 0.0 };
+		double normalError = 0.0, uvError = 0.0;
+		for (unsigned int i = 0; i < vertexCount; i++)
+		{
+			const unsigned char *vertex = &output[i * layout.stride];
+
+			float position[3];
+			if (layout.quantized)
+			{
+				unsigned short stored[4];
+				std::memcpy(stored, vertex + layout.position, sizeof(stored));
+				for (unsigned int j = 0; j < 3; j++)
+					position[j] = stored[j] / 65535.0f * layout.positionScale[j] + layout.positionOffset[j];
+			}
+			else
+			{
+				std::memcpy(position, vertex + layout.position, sizeof(position));
+			}
+
+			for (unsigned int j = 0; j < 3; j++)
+				positionError[j] = std::max(positionError[j], (double)std::fabs(position[j] - mesh->Positions.Data[i * 3 + j]));
+
+			short normal[2];
+			float decoded[3];
+			std::memcpy(normal, vertex + layout.normal, sizeof(normal));
+			VertexPacker::DecodeOctahedral(normal[0], normal[1], decoded[0], decoded[1], decoded[2]);
+			normalError = std::max(normalError, GetAngle(&mesh->Normals.Data[i * 3], decoded));
+
+			unsigned short uv[2];
+			std::memcpy(uv, vertex + layout.uv, sizeof(uv));
+			for (unsigned int j = 0; j < 2; j++)
+				uvError = std::max(uvError, (double)std::fabs(VertexPacker::HalfToFloat(uv[j]) - mesh->UVs.Data[i * 2 + j]));
+		}
+
+		// half a unorm16 step of the axis' extent, plus float rounding.
+		for (unsigned int j = 0; j < 3; j++)
+		{
+			double bound = layout.quantized ? layout.positionScale[j] / 131070.0 + 1e-5 : 0.0;
+			FURY_CHECK(positionError[j] <= bound);
+		}
+
+		FURY_CHECK(normalError <= 7e-4);
+		// uvs are in [0, 1], relative error bounds the absolute one.
+		FURY_CHECK(uvError <= 4.9e-4);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef _FURY_WORKER_SCOPE_H_
+#define _FURY_WORKER_SCOPE_H_
+
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	// restarts ThreadUtil with workerCount workers, the old count is restored when it goes out of scope.
+	class WorkerScope
+	{
+	public:
+
+		size_t previousCount;
+
+		WorkerScope(size_t workerCount)
+		{
+			previousCount = ThreadUtil::Instance()->GetWorkerCount();
+			Restart(workerCount);
+		}
+
+		~WorkerScope()
+		{
+			Restart(previousCount);
+		}
+
+		void Restart(size_t workerCount)
+		{
+			ThreadUtil::Instance().reset();
+			ThreadUtil::Initialize(std::move(workerCount));
+			ThreadUtil::Instance()->SetMainThread();
+		}
+	};
+}
+
+#endif // _FURY_WORKER_SCOPE_H_
\ No newline at end of file
@@ -18,6 +18,10 @@ OcTree::Ptr m_OcTree;
 
 SceneNode::Ptr m_CamNode;
 
+TaskGraph::Ptr m_FrameGraph;
+
+float m_DeltaTime = 0.0f;
+
 void Pause();
 
 void Initialize();
@@ -124,14 +128,22 @@ void Initialize()
 	Pipeline::Active = PrelightPipeline::Create("pipeline");
 	Pipeline::Active->SetCurrentCamera(m_CamNode);
 	FileUtil::LoadFile(Pipeline::Active, FileUtil::GetAbsPath("Resource/Pipeline/DefferedLightingLambert.json"));
+
+	// per frame work, tasks that don't share resources run concurrently.
+	m_FrameGraph = TaskGraph::Create("frame");
+	m_FrameGraph->AddTask("engine", [] { Engine::Update(m_DeltaTime); }, {}, { "input", "animation" }, true);
+	m_FrameGraph->AddTask("scene_transforms", [] { Scene::Active->GetRootNode()->UpdateTransforms(true); }, 
+		{ "animation" }, { "transforms" });
+	m_FrameGraph->AddTask("camera_transform", [] { m_CamNode->UpdateTransforms(); }, { "input" }, { "camera" });
+	m_FrameGraph->AddTask("gui", [] { Gui::ShowDefault(m_DeltaTime); Gui::Render(); }, {}, { "gui", "pipeline" }, true);
+	m_FrameGraph->AddTask("render", [] { Pipeline::Active->Execute(m_OcTree); }, 
+		{ "transforms", "camera", "gui", "pipeline" }, { "framebuffer" }, true);
 }
 
 void Update(float dt)
 {
-	Engine::Update(dt);
-	Gui::ShowDefault(dt);
-	Gui::Render();
-	Pipeline::Active->Execute(m_OcTree);
+	m_DeltaTime = dt;
+	m_FrameGraph->Execute();
 }
 
 void FixedUpdate()
@@ -143,5 +155,6 @@ void Shutdown()
 {
 	m_OcTree = nullptr;
 	m_CamNode = nullptr;
+	m_FrameGraph = nullptr;
 	Engine::Shutdown();
 }
\ No newline at end of file
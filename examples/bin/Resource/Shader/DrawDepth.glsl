@@ -10,9 +10,14 @@ uniform mat4 projection_matrix;
 uniform mat4 invert_view_matrix;
 uniform mat4 world_matrix;
 
+// see VertexPacker, quantized positions.
+uniform vec3 position_offset;
+uniform vec3 position_scale = vec3(1.0);
+
 void main()
 {
-	vec4 viewPos = invert_view_matrix * world_matrix * vec4(vertex_position, 1.0);
+	vec3 position = vertex_position * position_scale + position_offset;
+	vec4 viewPos = invert_view_matrix * world_matrix * vec4(position, 1.0);
 	out_depth = -viewPos.z;
 
 	gl_Position = projection_matrix * viewPos;
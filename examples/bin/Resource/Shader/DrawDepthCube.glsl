@@ -10,9 +10,14 @@ uniform mat4 projection_matrix;
 uniform mat4 invert_view_matrix;
 uniform mat4 world_matrix;
 
+// see VertexPacker, quantized positions.
+uniform vec3 position_offset;
+uniform vec3 position_scale = vec3(1.0);
+
 void main()
 {
-	world_position = world_matrix * vec4(vertex_position, 1.0);
+	vec3 position = vertex_position * position_scale + position_offset;
+	world_position = world_matrix * vec4(position, 1.0);
 	gl_Position = projection_matrix * invert_view_matrix * world_position;
 }
 
@@ -6,11 +6,25 @@ in vec3 vertex_position;
 
 uniform mat4 projection_matrix;
 uniform mat4 invert_view_matrix;
+
+#ifdef INSTANCED_MESH
+in mat4 instance_matrix;
+#else
 uniform mat4 world_matrix;
+#endif
+
+// see VertexPacker, quantized positions.
+uniform vec3 position_offset;
+uniform vec3 position_scale = vec3(1.0);
 
 void main()
 {
-	gl_Position = projection_matrix * invert_view_matrix * world_matrix * vec4(vertex_position, 1.0);
+#ifdef INSTANCED_MESH
+	mat4 world_matrix = instance_matrix;
+#endif
+
+	vec3 position = vertex_position * position_scale + position_offset;
+	gl_Position = projection_matrix * invert_view_matrix * world_matrix * vec4(position, 1.0);
 }
 
 #endif
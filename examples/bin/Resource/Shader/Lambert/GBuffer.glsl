@@ -16,22 +16,56 @@ out vec3 out_normal;
 out vec2 out_uv;
 out float out_depth;
 
-uniform mat4 projection_matrix;
-uniform mat4 invert_view_matrix;
+layout (std140) uniform CameraBlock
+{
+	mat4 projection_matrix;
+	mat4 invert_view_matrix;
+	vec3 camera_pos;
+	float camera_far;
+	float camera_near;
+};
+
+#ifdef INSTANCED_MESH
+in mat4 instance_matrix;
+#else
 uniform mat4 world_matrix;
+#endif
+
+// see VertexPacker, quantized positions and octahedral normals.
+uniform vec3 position_offset;
+uniform vec3 position_scale = vec3(1.0);
+uniform bool vertex_packed;
+
+vec3 decode_normal(vec3 normal)
+{
+	if (!vertex_packed)
+		return normal;
+
+	vec3 n = vec3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+	if (n.z < 0.0)
+		n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	return normalize(n);
+}
 
 void main()
 {
+#ifdef INSTANCED_MESH
+	mat4 world_matrix = instance_matrix;
+#endif
+
+	vec3 position = vertex_position * position_scale + position_offset;
+	vec3 normal = decode_normal(vertex_normal);
+
 #ifdef SKINNED_MESH
 	mat4 bone_matrix = bone_matrices[bone_ids[0]] * bone_weights[0];
 	bone_matrix += bone_matrices[bone_ids[1]] * bone_weights[1];
 	bone_matrix += bone_matrices[bone_ids[2]] * bone_weights[2];
 	bone_matrix += bone_matrices[bone_ids[3]] * (1.0f - bone_weights[0] - bone_weights[1] - bone_weights[2]);
-	vec4 worldPos = world_matrix * bone_matrix * vec4(vertex_position, 1.0);
-	out_normal = normalize(invert_view_matrix * world_matrix * bone_matrix * vec4(vertex_normal, 0.0)).xyz;
+	vec4 worldPos = world_matrix * bone_matrix * vec4(position, 1.0);
+	out_normal = normalize(invert_view_matrix * world_matrix * bone_matrix * vec4(normal, 0.0)).xyz;
 #else
-	vec4 worldPos = world_matrix * vec4(vertex_position, 1.0);
-	out_normal = normalize(invert_view_matrix * world_matrix * vec4(vertex_normal, 0.0)).xyz;
+	vec4 worldPos = world_matrix * vec4(position, 1.0);
+	out_normal = normalize(invert_view_matrix * world_matrix * vec4(normal, 0.0)).xyz;
 #endif
 	
 	vec4 viewPos = invert_view_matrix * worldPos;
@@ -49,15 +83,32 @@ in vec3 out_normal;
 in vec2 out_uv;
 in float out_depth;
 
-uniform float camera_far = 10000;
-
-uniform vec3 ambient_color;
+layout (std140) uniform CameraBlock
+{
+	mat4 projection_matrix;
+	mat4 invert_view_matrix;
+	vec3 camera_pos;
+	float camera_far;
+	float camera_near;
+};
+
+layout (std140) uniform MaterialBlock
+{
+	vec3 ambient_color;
+	float ambient_factor;
+	vec3 diffuse_color;
+	float diffuse_factor;
+	vec3 specular_color;
+	float specular_factor;
+	vec3 emissive_color;
+	float emissive_factor;
+	float shininess;
+	float transparency;
+	uint material_id;
+};
 
 uniform sampler2D diffuse_texture;
 
-uniform float ambient_factor = 1;
-uniform float diffuse_factor = 1;
-
 // normal.xyz, shininess
 layout (location = 0) out vec4 rt0;
 // diffuse rgb, specular intensity
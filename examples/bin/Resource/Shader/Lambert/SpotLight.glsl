@@ -8,10 +8,27 @@ out vec3 vs_dir;
 out vec3 vs_pos;
 out vec4 ss_pos;
 
-uniform vec3 light_dir;
+layout (std140) uniform CameraBlock
+{
+	mat4 projection_matrix;
+	mat4 invert_view_matrix;
+	vec3 camera_pos;
+	float camera_far;
+	float camera_near;
+};
+
+layout (std140) uniform LightBlock
+{
+	vec3 light_pos;
+	float light_intensity;
+	vec3 light_dir;
+	float light_innerangle;
+	vec3 light_color;
+	float light_outterangle;
+	float light_falloff;
+	float light_radius;
+};
 
-uniform mat4 projection_matrix;
-uniform mat4 invert_view_matrix;
 uniform mat4 world_matrix;
 
 void main()
@@ -32,17 +49,26 @@ in vec3 vs_dir;
 in vec3 vs_pos;
 in vec4 ss_pos;
 
-uniform float camera_far = 10000;
-
-uniform mat4 invert_view_matrix;
-
-uniform vec3 light_pos;
-uniform vec3 light_color;
-uniform float light_falloff;
-uniform float light_radius;
-uniform float light_intensity;
-uniform float light_innerangle;
-uniform float light_outterangle;
+layout (std140) uniform CameraBlock
+{
+	mat4 projection_matrix;
+	mat4 invert_view_matrix;
+	vec3 camera_pos;
+	float camera_far;
+	float camera_near;
+};
+
+layout (std140) uniform LightBlock
+{
+	vec3 light_pos;
+	float light_intensity;
+	vec3 light_dir;
+	float light_innerangle;
+	vec3 light_color;
+	float light_outterangle;
+	float light_falloff;
+	float light_radius;
+};
 
 // linear depth
 uniform sampler2D gbuffer_depth;
@@ -8,12 +8,26 @@ out vec3 vs_dir;
 out vec3 vs_pos;
 out vec4 ss_pos;
 
-uniform float camera_far = 10000;
-
-uniform vec3 light_dir;
-
-uniform mat4 projection_matrix;
-uniform mat4 invert_view_matrix;
+layout (std140) uniform CameraBlock
+{
+	mat4 projection_matrix;
+	mat4 invert_view_matrix;
+	vec3 camera_pos;
+	float camera_far;
+	float camera_near;
+};
+
+layout (std140) uniform LightBlock
+{
+	vec3 light_pos;
+	float light_intensity;
+	vec3 light_dir;
+	float light_innerangle;
+	vec3 light_color;
+	float light_outterangle;
+	float light_falloff;
+	float light_radius;
+};
 
 void main()
 {
@@ -33,8 +47,26 @@ in vec3 vs_dir;
 in vec3 vs_pos;
 in vec4 ss_pos;
 
-uniform vec3 light_color;
-uniform float light_intensity;
+layout (std140) uniform CameraBlock
+{
+	mat4 projection_matrix;
+	mat4 invert_view_matrix;
+	vec3 camera_pos;
+	float camera_far;
+	float camera_near;
+};
+
+layout (std140) uniform LightBlock
+{
+	vec3 light_pos;
+	float light_intensity;
+	vec3 light_dir;
+	float light_innerangle;
+	vec3 light_color;
+	float light_outterangle;
+	float light_falloff;
+	float light_radius;
+};
 
 // linear depth
 uniform sampler2D gbuffer_depth;
@@ -43,7 +75,6 @@ uniform sampler2D gbuffer_normal;
 
 #ifdef CSM
 
-uniform mat4 projection_matrix;
 uniform mat4 shadow_matrix[4];
 uniform sampler2DArray shadow_buffer;
 